@@ -129,6 +129,40 @@ ResourceUID::ID ResourceLoader::get_resource_uid(const String &p_path) {
 	return ::ResourceLoader::get_resource_uid(p_path);
 }
 
+Error ResourceLoader::prefetch(const PackedStringArray &p_paths) {
+	return ::ResourceLoader::prefetch(p_paths);
+}
+
+void ResourceLoader::clear_prefetched() {
+	::ResourceLoader::clear_prefetched();
+}
+
+void ResourceLoader::set_prefetch_memory_budget(int64_t p_bytes) {
+	ERR_FAIL_COND_MSG(p_bytes < 0, "Prefetch memory budget can't be negative.");
+	::ResourceLoader::set_prefetch_memory_budget(p_bytes);
+}
+
+int64_t ResourceLoader::get_prefetch_memory_budget() const {
+	return ::ResourceLoader::get_prefetch_memory_budget();
+}
+
+int64_t ResourceLoader::get_prefetch_memory_usage() const {
+	return ::ResourceLoader::get_prefetch_memory_usage();
+}
+
+void ResourceLoader::set_retention_memory_budget(int64_t p_bytes) {
+	ERR_FAIL_COND_MSG(p_bytes < 0, "Retention memory budget can't be negative.");
+	ResourceCache::set_retention_budget(p_bytes);
+}
+
+int64_t ResourceLoader::get_retention_memory_budget() const {
+	return ResourceCache::get_retention_budget();
+}
+
+void ResourceLoader::clear_retained() {
+	ResourceCache::clear_retained();
+}
+
 void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "cache_mode"), &ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
@@ -145,6 +179,19 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("exists", "path", "type_hint"), &ResourceLoader::exists, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("get_resource_uid", "path"), &ResourceLoader::get_resource_uid);
 
+	ClassDB::bind_method(D_METHOD("prefetch", "paths"), &ResourceLoader::prefetch);
+	ClassDB::bind_method(D_METHOD("clear_prefetched"), &ResourceLoader::clear_prefetched);
+	ClassDB::bind_method(D_METHOD("set_prefetch_memory_budget", "bytes"), &ResourceLoader::set_prefetch_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_prefetch_memory_budget"), &ResourceLoader::get_prefetch_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_prefetch_memory_usage"), &ResourceLoader::get_prefetch_memory_usage);
+
+	ClassDB::bind_method(D_METHOD("set_retention_memory_budget", "bytes"), &ResourceLoader::set_retention_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_retention_memory_budget"), &ResourceLoader::get_retention_memory_budget);
+	ClassDB::bind_method(D_METHOD("clear_retained"), &ResourceLoader::clear_retained);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "prefetch_memory_budget", PROPERTY_HINT_NONE, "suffix:B"), "set_prefetch_memory_budget", "get_prefetch_memory_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "retention_memory_budget", PROPERTY_HINT_NONE, "suffix:B"), "set_retention_memory_budget", "get_retention_memory_budget");
+
 	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
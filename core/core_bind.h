@@ -87,6 +87,16 @@ public:
 	bool exists(const String &p_path, const String &p_type_hint = "");
 	ResourceUID::ID get_resource_uid(const String &p_path);
 
+	Error prefetch(const PackedStringArray &p_paths);
+	void clear_prefetched();
+	void set_prefetch_memory_budget(int64_t p_bytes);
+	int64_t get_prefetch_memory_budget() const;
+	int64_t get_prefetch_memory_usage() const;
+
+	void set_retention_memory_budget(int64_t p_bytes);
+	int64_t get_retention_memory_budget() const;
+	void clear_retained();
+
 	ResourceLoader() { singleton = this; }
 };
 
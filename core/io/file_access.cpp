@@ -291,6 +291,19 @@ Variant FileAccess::get_var(bool p_allow_objects) const {
 	return v;
 }
 
+Variant FileAccess::get_var_with_schema(const Ref<VariantSchema> &p_schema) const {
+	ERR_FAIL_COND_V(p_schema.is_null(), Variant());
+	uint32_t len = get_32();
+	Vector<uint8_t> buff = get_buffer(len);
+	ERR_FAIL_COND_V((uint32_t)buff.size() != len, Variant());
+
+	Variant v;
+	Error err = p_schema->decode(v, buff.ptr(), len);
+	ERR_FAIL_COND_V_MSG(err != OK, Variant(), "Error when trying to decode Variant with schema.");
+
+	return v;
+}
+
 double FileAccess::get_double() const {
 	MarshallDouble m;
 	m.l = get_64();
@@ -691,6 +704,22 @@ void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
 	store_buffer(buff);
 }
 
+void FileAccess::store_var_with_schema(const Variant &p_var, const Ref<VariantSchema> &p_schema) {
+	ERR_FAIL_COND(p_schema.is_null());
+	int len;
+	Error err = p_schema->encode(p_var, nullptr, len);
+	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant with schema.");
+
+	Vector<uint8_t> buff;
+	buff.resize(len);
+
+	err = p_schema->encode(p_var, buff.ptrw(), len);
+	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant with schema.");
+
+	store_32(len);
+	store_buffer(buff);
+}
+
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
 	Ref<FileAccess> f = FileAccess::open(p_path, READ, r_error);
 	if (f.is_null()) {
@@ -841,6 +870,7 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_big_endian", "big_endian"), &FileAccess::set_big_endian);
 	ClassDB::bind_method(D_METHOD("get_error"), &FileAccess::get_error);
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &FileAccess::get_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_var_with_schema", "schema"), &FileAccess::get_var_with_schema);
 
 	ClassDB::bind_method(D_METHOD("store_8", "value"), &FileAccess::store_8);
 	ClassDB::bind_method(D_METHOD("store_16", "value"), &FileAccess::store_16);
@@ -854,6 +884,7 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("store_csv_line", "values", "delim"), &FileAccess::store_csv_line, DEFVAL(","));
 	ClassDB::bind_method(D_METHOD("store_string", "string"), &FileAccess::store_string);
 	ClassDB::bind_method(D_METHOD("store_var", "value", "full_objects"), &FileAccess::store_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("store_var_with_schema", "value", "schema"), &FileAccess::store_var_with_schema);
 
 	ClassDB::bind_method(D_METHOD("store_pascal_string", "string"), &FileAccess::store_pascal_string);
 	ClassDB::bind_method(D_METHOD("get_pascal_string"), &FileAccess::get_pascal_string);
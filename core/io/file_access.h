@@ -32,6 +32,7 @@
 #define FILE_ACCESS_H
 
 #include "core/io/compression.h"
+#include "core/io/variant_schema.h"
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
@@ -147,6 +148,7 @@ public:
 	virtual real_t get_real() const;
 
 	Variant get_var(bool p_allow_objects = false) const;
+	Variant get_var_with_schema(const Ref<VariantSchema> &p_schema) const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
@@ -188,6 +190,7 @@ public:
 	void store_buffer(const Vector<uint8_t> &p_buffer);
 
 	void store_var(const Variant &p_var, bool p_full_objects = false);
+	void store_var_with_schema(const Variant &p_var, const Ref<VariantSchema> &p_schema);
 
 	virtual void close() = 0;
 
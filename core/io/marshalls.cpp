@@ -74,6 +74,55 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME (0b10 << 16)
 #define HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT (0b11 << 16)
 
+// Packed array payloads are tightly packed little-endian scalars, which is also
+// their in-memory layout on little-endian hosts. In that case whole arrays are
+// copied at once instead of going through per-component encode/decode calls.
+
+static_assert(sizeof(Vector2) == sizeof(real_t) * 2 && sizeof(Vector3) == sizeof(real_t) * 3 && sizeof(Vector4) == sizeof(real_t) * 4, "Vector types must be tightly packed for bulk marshalling.");
+static_assert(sizeof(Color) == sizeof(float) * 4, "Color must be tightly packed for bulk marshalling.");
+
+template <typename T>
+static _FORCE_INLINE_ void _encode_packed_components(const T *p_src, int p_count, uint8_t *r_dst) {
+#ifdef BIG_ENDIAN_ENABLED
+	for (int i = 0; i < p_count; i++) {
+		if constexpr (sizeof(T) == sizeof(uint64_t)) {
+			uint64_t u;
+			memcpy(&u, &p_src[i], sizeof(uint64_t));
+			encode_uint64(u, &r_dst[i * sizeof(uint64_t)]);
+		} else {
+			uint32_t u;
+			memcpy(&u, &p_src[i], sizeof(uint32_t));
+			encode_uint32(u, &r_dst[i * sizeof(uint32_t)]);
+		}
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(T));
+#endif
+}
+
+// `TEncoded` is the component type stored in the buffer, which may differ from `T`
+// (e.g. a 64-bit payload decoded into single-precision `real_t`).
+template <typename TEncoded, typename T>
+static _FORCE_INLINE_ void _decode_packed_components(const uint8_t *p_src, int p_count, T *r_dst) {
+#ifndef BIG_ENDIAN_ENABLED
+	if constexpr (std::is_same_v<TEncoded, T>) {
+		memcpy(r_dst, p_src, p_count * sizeof(T));
+		return;
+	}
+#endif
+	for (int i = 0; i < p_count; i++) {
+		if constexpr (std::is_same_v<TEncoded, double>) {
+			r_dst[i] = decode_double(&p_src[i * sizeof(double)]);
+		} else if constexpr (std::is_same_v<TEncoded, float>) {
+			r_dst[i] = decode_float(&p_src[i * sizeof(float)]);
+		} else if constexpr (sizeof(TEncoded) == sizeof(uint64_t)) {
+			r_dst[i] = decode_uint64(&p_src[i * sizeof(uint64_t)]);
+		} else {
+			r_dst[i] = decode_uint32(&p_src[i * sizeof(uint32_t)]);
+		}
+	}
+}
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -879,10 +928,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -906,12 +952,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_decode_packed_components<int32_t>(buf, count, data.ptrw());
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -930,12 +972,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_decode_packed_components<int64_t>(buf, count, data.ptrw());
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -954,12 +992,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_decode_packed_components<float>(buf, count, data.ptrw());
 			}
 			r_variant = data;
 
@@ -980,10 +1014,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_decode_packed_components<double>(buf, count, data.ptrw());
 			}
 			r_variant = data;
 
@@ -1035,12 +1066,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector2 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
-					}
+					_decode_packed_components<double>(buf, count * 2, &varray.ptrw()->coord[0]);
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -1060,12 +1086,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector2 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
-					}
+					_decode_packed_components<float>(buf, count * 2, &varray.ptrw()->coord[0]);
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1095,13 +1116,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector3 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
-					}
+					_decode_packed_components<double>(buf, count * 3, &varray.ptrw()->coord[0]);
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1121,13 +1136,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector3 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
-					}
+					_decode_packed_components<float>(buf, count * 3, &varray.ptrw()->coord[0]);
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1158,15 +1167,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				carray.resize(count);
-				Color *w = carray.ptrw();
-
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_decode_packed_components<float>(buf, count * 4, &carray.ptrw()->components[0]);
 
 				int adv = 4 * 4 * count;
 
@@ -1197,14 +1199,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector4 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
-						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
-					}
+					_decode_packed_components<double>(buf, count * 4, &varray.ptrw()->components[0]);
 
 					int adv = sizeof(double) * 4 * count;
 
@@ -1224,14 +1219,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 				if (count) {
 					varray.resize(count);
-					Vector4 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
-						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
-					}
+					_decode_packed_components<float>(buf, count * 4, &varray.ptrw()->components[0]);
 
 					int adv = sizeof(float) * 4 * count;
 
@@ -1856,10 +1844,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_encode_packed_components(data.ptr(), datalen, buf);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1873,10 +1858,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_encode_packed_components(data.ptr(), datalen, buf);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1890,10 +1872,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_encode_packed_components(data.ptr(), datalen, buf);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1907,10 +1886,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_encode_packed_components(data.ptr(), datalen, buf);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1958,14 +1934,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			r_len += 4;
 
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
+			if (buf && len) {
+				_encode_packed_components(&data.ptr()->coord[0], len * 2, buf);
+				buf += sizeof(real_t) * 2 * len;
 			}
 
 			r_len += sizeof(real_t) * 2 * len;
@@ -1982,15 +1953,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			r_len += 4;
 
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
+			if (buf && len) {
+				_encode_packed_components(&data.ptr()->coord[0], len * 3, buf);
+				buf += sizeof(real_t) * 3 * len;
 			}
 
 			r_len += sizeof(real_t) * 3 * len;
@@ -2007,16 +1972,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			r_len += 4;
 
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
+			if (buf && len) {
+				_encode_packed_components(&data.ptr()->components[0], len * 4, buf);
+				buf += 4 * 4 * len; // Colors should always be in single-precision.
 			}
 
 			r_len += 4 * 4 * len;
@@ -2033,16 +1991,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			r_len += 4;
 
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector4 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					encode_real(v.w, &buf[sizeof(real_t) * 3]);
-					buf += sizeof(real_t) * 4;
-				}
+			if (buf && len) {
+				_encode_packed_components(&data.ptr()->components[0], len * 4, buf);
+				buf += sizeof(real_t) * 4 * len;
 			}
 
 			r_len += sizeof(real_t) * 4 * len;
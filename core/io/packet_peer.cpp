@@ -113,6 +113,48 @@ Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
 	return put_packet(w, len);
 }
 
+Error PacketPeer::get_var_with_schema(Variant &r_variant, const Ref<VariantSchema> &p_schema) {
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+	const uint8_t *buffer;
+	int buffer_size;
+	Error err = get_packet(&buffer, buffer_size);
+	if (err) {
+		return err;
+	}
+
+	return p_schema->decode(r_variant, buffer, buffer_size);
+}
+
+Error PacketPeer::put_var_with_schema(const Variant &p_packet, const Ref<VariantSchema> &p_schema) {
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+	int len;
+	Error err = p_schema->encode(p_packet, nullptr, len); // compute len first
+	if (err) {
+		return err;
+	}
+
+	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
+
+	if (unlikely(encode_buffer.size() < len)) {
+		encode_buffer.resize(0); // Avoid realloc
+		encode_buffer.resize(next_power_of_2(len));
+	}
+
+	uint8_t *w = encode_buffer.ptrw();
+	err = p_schema->encode(p_packet, w, len);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant with schema.");
+
+	return put_packet(w, len);
+}
+
+Variant PacketPeer::_bnd_get_var_with_schema(const Ref<VariantSchema> &p_schema) {
+	Variant var;
+	Error err = get_var_with_schema(var, p_schema);
+
+	ERR_FAIL_COND_V(err != OK, Variant());
+	return var;
+}
+
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
 	Variant var;
 	Error err = get_var(var, p_allow_objects);
@@ -138,6 +180,8 @@ Error PacketPeer::_get_packet_error() const {
 void PacketPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &PacketPeer::_bnd_get_var, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("put_var", "var", "full_objects"), &PacketPeer::put_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_var_with_schema", "schema"), &PacketPeer::_bnd_get_var_with_schema);
+	ClassDB::bind_method(D_METHOD("put_var_with_schema", "var", "schema"), &PacketPeer::put_var_with_schema);
 
 	ClassDB::bind_method(D_METHOD("get_packet"), &PacketPeer::_get_packet);
 	ClassDB::bind_method(D_METHOD("put_packet", "buffer"), &PacketPeer::_put_packet);
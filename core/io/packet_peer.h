@@ -32,6 +32,7 @@
 #define PACKET_PEER_H
 
 #include "core/io/stream_peer.h"
+#include "core/io/variant_schema.h"
 #include "core/object/class_db.h"
 #include "core/templates/ring_buffer.h"
 
@@ -43,6 +44,7 @@ class PacketPeer : public RefCounted {
 	GDCLASS(PacketPeer, RefCounted);
 
 	Variant _bnd_get_var(bool p_allow_objects = false);
+	Variant _bnd_get_var_with_schema(const Ref<VariantSchema> &p_schema);
 
 	static void _bind_methods();
 
@@ -70,6 +72,9 @@ public:
 	virtual Error get_var(Variant &r_variant, bool p_allow_objects = false);
 	virtual Error put_var(const Variant &p_packet, bool p_full_objects = false);
 
+	Error get_var_with_schema(Variant &r_variant, const Ref<VariantSchema> &p_schema);
+	Error put_var_with_schema(const Variant &p_packet, const Ref<VariantSchema> &p_schema);
+
 	void set_encode_buffer_max_size(int p_max_size);
 	int get_encode_buffer_max_size() const;
 
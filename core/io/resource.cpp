@@ -581,6 +581,11 @@ Mutex ResourceCache::lock;
 RWLock ResourceCache::path_cache_lock;
 #endif
 
+LRUCache<String, ResourceCache::RetainedResource> ResourceCache::retained(INT32_MAX); // Bounded by bytes, not entries.
+uint64_t ResourceCache::retained_total_size = 0;
+uint64_t ResourceCache::retention_budget = 0;
+HashSet<String> ResourceCache::prefetched;
+
 void ResourceCache::clear() {
 	if (!resources.is_empty()) {
 		if (OS::get_singleton()->is_stdout_verbose()) {
@@ -594,6 +599,7 @@ void ResourceCache::clear() {
 	}
 
 	resources.clear();
+	prefetched.clear();
 }
 
 bool ResourceCache::has(const String &p_path) {
@@ -667,3 +673,131 @@ int ResourceCache::get_cached_resource_count() {
 	MutexLock mutex_lock(lock);
 	return resources.size();
 }
+
+bool ResourceCache::_is_retained_idle(const String &p_path, const RetainedResource &p_retained) {
+	// The prefetch cache may hold a reference too, which doesn't keep the resource in use either.
+	return p_retained.resource->get_reference_count() == 1 + (prefetched.has(p_path) ? 1 : 0);
+}
+
+uint64_t ResourceCache::_get_idle_retained_size() {
+	uint64_t size = 0;
+	retained.for_each_lru([&size](const String &p_path, const RetainedResource &p_retained) {
+		if (_is_retained_idle(p_path, p_retained)) {
+			size += p_retained.size;
+		}
+	});
+	return size;
+}
+
+bool ResourceCache::_touch_retained(const String &p_path) {
+	MutexLock mutex_lock(lock);
+	return retained.getptr(p_path) != nullptr;
+}
+
+void ResourceCache::_retain(const Ref<Resource> &p_resource, uint64_t p_size) {
+	LocalVector<Ref<Resource>> released;
+	{
+		MutexLock mutex_lock(lock);
+		if (retention_budget == 0 || p_size > retention_budget) {
+			return;
+		}
+
+		const String &path = p_resource->get_path();
+		const RetainedResource *existing = retained.getptr(path);
+		if (existing) {
+			retained_total_size -= existing->size;
+		}
+
+		RetainedResource entry;
+		entry.resource = p_resource;
+		entry.size = p_size;
+		retained.insert(path, entry);
+		retained_total_size += p_size;
+
+		_evict_retained(released);
+	}
+	// Released resources may be freed here, outside of the lock.
+}
+
+void ResourceCache::_evict_retained(LocalVector<Ref<Resource>> &r_released) {
+	if (retained_total_size <= retention_budget) {
+		return;
+	}
+
+	// Holding the cache lock, nobody can take a new reference to an idle resource while this runs.
+	uint64_t idle_size = 0;
+	LocalVector<String> idle_paths;
+	retained.for_each_lru([&idle_size, &idle_paths](const String &p_path, const RetainedResource &p_retained) {
+		if (_is_retained_idle(p_path, p_retained)) {
+			idle_size += p_retained.size;
+			idle_paths.push_back(p_path);
+		}
+	});
+
+	for (const String &path : idle_paths) {
+		if (idle_size <= retention_budget) {
+			break;
+		}
+		const RetainedResource *evicted = retained.getptr(path);
+		idle_size -= evicted->size;
+		retained_total_size -= evicted->size;
+		r_released.push_back(evicted->resource);
+		retained.erase(path);
+	}
+}
+
+bool ResourceCache::_is_prefetched_idle(const Ref<Resource> &p_resource) {
+	// Besides the prefetch reference, the retention cache may hold one too. Neither keeps the resource in use.
+	MutexLock mutex_lock(lock);
+	return p_resource->get_reference_count() == 1 + (retained.getptr(p_resource->get_path()) ? 1 : 0);
+}
+
+void ResourceCache::_set_prefetched(const String &p_path, bool p_prefetched) {
+	LocalVector<Ref<Resource>> released;
+	{
+		MutexLock mutex_lock(lock);
+		if (p_prefetched) {
+			prefetched.insert(p_path);
+			return;
+		}
+		prefetched.erase(p_path);
+		// The resource may have just become idle for the retention cache.
+		_evict_retained(released);
+	}
+}
+
+void ResourceCache::set_retention_budget(uint64_t p_bytes) {
+	LocalVector<Ref<Resource>> released;
+	{
+		MutexLock mutex_lock(lock);
+		retention_budget = p_bytes;
+		_evict_retained(released);
+	}
+}
+
+uint64_t ResourceCache::get_retention_budget() {
+	MutexLock mutex_lock(lock);
+	return retention_budget;
+}
+
+void ResourceCache::clear_retained() {
+	LocalVector<Ref<Resource>> released;
+	{
+		MutexLock mutex_lock(lock);
+		RetainedResource evicted;
+		while (retained.evict_lru(nullptr, &evicted)) {
+			released.push_back(evicted.resource);
+		}
+		retained_total_size = 0;
+	}
+}
+
+int ResourceCache::get_retained_count() {
+	MutexLock mutex_lock(lock);
+	return retained.get_size();
+}
+
+uint64_t ResourceCache::get_retained_memory_usage() {
+	MutexLock mutex_lock(lock);
+	return _get_idle_retained_size();
+}
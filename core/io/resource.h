@@ -35,6 +35,8 @@
 #include "core/object/class_db.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/lru.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 
@@ -163,6 +165,28 @@ class ResourceCache {
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
 #endif // TOOLS_ENABLED
+
+	struct RetainedResource {
+		Ref<Resource> resource;
+		uint64_t size = 0; // Estimated from the size of the file backing it.
+	};
+
+	// Keeps recently loaded resources alive after their last user lets go of them,
+	// so assets shared across scene changes don't have to be reloaded from disk.
+	// Only entries nothing else references are charged against the budget, since the ones in use would stay loaded anyway.
+	static LRUCache<String, RetainedResource> retained;
+	static uint64_t retained_total_size; // Including entries in use, so the budget can be checked without visiting them.
+	static uint64_t retention_budget;
+	static HashSet<String> prefetched; // Also kept alive by `ResourceLoader::prefetch()`.
+
+	static bool _is_retained_idle(const String &p_path, const RetainedResource &p_retained);
+	static uint64_t _get_idle_retained_size();
+	static bool _touch_retained(const String &p_path);
+	static void _retain(const Ref<Resource> &p_resource, uint64_t p_size);
+	static void _evict_retained(LocalVector<Ref<Resource>> &r_released);
+	static bool _is_prefetched_idle(const Ref<Resource> &p_resource);
+	static void _set_prefetched(const String &p_path, bool p_prefetched);
+
 	friend void unregister_core_types();
 	static void clear();
 	friend void register_core_types();
@@ -172,6 +196,12 @@ public:
 	static Ref<Resource> get_ref(const String &p_path);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static void set_retention_budget(uint64_t p_bytes);
+	static uint64_t get_retention_budget();
+	static void clear_retained();
+	static int get_retained_count();
+	static uint64_t get_retained_memory_usage();
 };
 
 #endif // RESOURCE_H
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -424,6 +425,11 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 		if (_loaded_callback) {
 			_loaded_callback(load_task.resource, load_task.local_path);
 		}
+
+		// Every load goes through here, including threaded ones and external resources of other resources.
+		if (!ignoring) {
+			_retain_loaded(load_task.resource);
+		}
 	} else if (!ignoring) {
 		Ref<Resource> existing = ResourceCache::get_ref(load_task.local_path);
 		if (existing.is_valid()) {
@@ -514,6 +520,23 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
+void ResourceLoader::_retain_loaded(const Ref<Resource> &p_resource) {
+	const String &path = p_resource->get_path();
+	if (ResourceCache::get_retention_budget() == 0 || !path.is_resource_file()) {
+		return;
+	}
+	if (ResourceCache::_touch_retained(path)) {
+		return; // Already retained, just marked as recently used.
+	}
+
+	uint64_t size = 0;
+	Ref<FileAccess> f = FileAccess::open(import_remap(_path_remap(path)), FileAccess::READ);
+	if (f.is_valid()) {
+		size = f->get_length();
+	}
+	ResourceCache::_retain(p_resource, size);
+}
+
 Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user) {
 	String local_path = _validate_local_path(p_path);
 
@@ -569,6 +592,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
 					//referencing is fine
+					ResourceCache::_touch_retained(local_path);
 					load_task.resource = existing;
 					load_task.status = THREAD_LOAD_LOADED;
 					load_task.progress = 1.0;
@@ -1218,6 +1242,9 @@ void ResourceLoader::clear_translation_remaps() {
 void ResourceLoader::clear_thread_load_tasks() {
 	// Bring the thing down as quickly as possible without causing deadlocks or leaks.
 
+	clear_prefetched();
+	ResourceCache::clear_retained();
+
 	MutexLock thread_load_lock(thread_load_mutex);
 	cleaning_tasks = true;
 
@@ -1349,6 +1376,220 @@ void ResourceLoader::remove_custom_loaders() {
 	}
 }
 
+String ResourceLoader::get_dependency_index_file() {
+	return "res://.godot/dependency_index.bin";
+}
+
+void ResourceLoader::_load_dependency_index() {
+	{
+		MutexLock lock(prefetch_mutex);
+		if (dependency_index_loaded) {
+			return;
+		}
+	}
+
+	// Exported projects ship a precomputed index, so dependencies can be resolved without opening every file.
+	// The file is read outside the lock, a concurrent prefetch may read it too but the result is the same.
+	Dictionary dict;
+	String index_file = get_dependency_index_file();
+	if (FileAccess::exists(index_file)) {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(index_file);
+		Variant index;
+		Error err = decode_variant(index, data.ptr(), data.size());
+		if (err == OK && index.get_type() == Variant::DICTIONARY) {
+			dict = index;
+		} else {
+			ERR_PRINT("Invalid dependency index: " + index_file);
+		}
+	}
+
+	MutexLock lock(prefetch_mutex);
+	if (dependency_index_loaded) {
+		return;
+	}
+	dependency_index_loaded = true;
+	List<Variant> keys;
+	dict.get_key_list(&keys);
+	for (const Variant &key : keys) {
+		dependency_index[key] = dict[key];
+	}
+}
+
+Vector<String> ResourceLoader::_prefetch_get_dependencies(const String &p_path) {
+	{
+		MutexLock lock(prefetch_mutex);
+		const Vector<String> *deps = dependency_index.getptr(p_path);
+		if (deps) {
+			return *deps;
+		}
+	}
+
+	// Not indexed, read them from the file without holding the lock.
+	List<String> dep_list;
+	get_dependencies(p_path, &dep_list);
+	Vector<String> deps;
+	for (const String &dep : dep_list) {
+		deps.push_back(dep);
+	}
+
+	MutexLock lock(prefetch_mutex);
+	dependency_index[p_path] = deps;
+	return deps;
+}
+
+void ResourceLoader::_prefetch_collect(const String &p_path, HashSet<String> &r_visited, Vector<String> &r_paths) {
+	if (r_visited.has(p_path)) {
+		return;
+	}
+	r_visited.insert(p_path);
+
+	const Vector<String> deps = _prefetch_get_dependencies(p_path);
+	for (const String &dep : deps) {
+		String path = dep.get_slice("::", 0);
+		if (path.begins_with("uid://")) {
+			ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(path);
+			path = ResourceUID::get_singleton()->has_id(uid) ? ResourceUID::get_singleton()->get_id_path(uid) : dep.get_slice("::", 2);
+		}
+		if (!path.is_empty()) {
+			_prefetch_collect(path, r_visited, r_paths);
+		}
+	}
+
+	// Post-order, so that dependencies are usually warm by the time their dependents load.
+	r_paths.push_back(p_path);
+}
+
+void ResourceLoader::_prefetch_task(void *p_userdata, uint32_t p_index) {
+	const PrefetchBatch *batch = (const PrefetchBatch *)p_userdata;
+	const String &path = batch->paths[p_index];
+
+	{
+		MutexLock lock(prefetch_mutex);
+		if (prefetched_resources.has(path)) {
+			return;
+		}
+	}
+
+	// Read the file backing the resource first to bring it into the OS page cache.
+	uint64_t size = 0;
+	Ref<FileAccess> f = FileAccess::open(import_remap(_path_remap(path)), FileAccess::READ);
+	if (f.is_valid()) {
+		uint8_t buffer[65536];
+		uint64_t read;
+		do {
+			read = f->get_buffer(buffer, sizeof(buffer));
+			size += read;
+		} while (read == sizeof(buffer));
+		f.unref();
+	}
+
+	Ref<Resource> res = load(path);
+	if (res.is_null()) {
+		return;
+	}
+
+	MutexLock lock(prefetch_mutex);
+	if (prefetched_resources.has(path)) {
+		return;
+	}
+	PrefetchedResource &prefetched = prefetched_resources[path];
+	prefetched.resource = res;
+	prefetched.size = size;
+	prefetch_memory_usage += size;
+	ResourceCache::_set_prefetched(path, true);
+	_prefetch_evict();
+}
+
+void ResourceLoader::_prefetch_evict() {
+	// Only drop resources nobody else references; the ones in use are cheap to keep alive.
+	for (HashMap<String, PrefetchedResource>::Iterator E = prefetched_resources.begin(); E && prefetch_memory_usage > prefetch_memory_budget;) {
+		HashMap<String, PrefetchedResource>::Iterator N = E;
+		++N;
+		if (ResourceCache::_is_prefetched_idle(E->value.resource)) {
+			const String path = E->key;
+			prefetch_memory_usage -= E->value.size;
+			prefetched_resources.remove(E);
+			ResourceCache::_set_prefetched(path, false);
+		}
+		E = N;
+	}
+}
+
+void ResourceLoader::_prefetch_reclaim_batches(bool p_wait) {
+	// Batch tasks take `prefetch_mutex`, so they are waited for without holding any lock.
+	LocalVector<PrefetchBatch *> finished;
+	{
+		MutexLock lock(prefetch_batches_mutex);
+		for (uint32_t i = 0; i < prefetch_batches.size(); i++) {
+			PrefetchBatch *batch = prefetch_batches[i];
+			if (!p_wait && !WorkerThreadPool::get_singleton()->is_group_task_completed(batch->group_id)) {
+				continue;
+			}
+			finished.push_back(batch);
+			prefetch_batches.remove_at_unordered(i);
+			i--;
+		}
+	}
+
+	for (PrefetchBatch *batch : finished) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+		memdelete(batch);
+	}
+}
+
+Error ResourceLoader::prefetch(const Vector<String> &p_paths) {
+	_prefetch_reclaim_batches(false);
+	_load_dependency_index();
+
+	PrefetchBatch *batch = memnew(PrefetchBatch);
+	HashSet<String> visited;
+	for (const String &path : p_paths) {
+		String local_path = _validate_local_path(path);
+		ERR_CONTINUE_MSG(!exists(local_path), "Cannot prefetch nonexistent resource: " + path);
+		_prefetch_collect(local_path, visited, batch->paths);
+	}
+
+	if (batch->paths.is_empty()) {
+		memdelete(batch);
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	batch->group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&ResourceLoader::_prefetch_task, batch, batch->paths.size(), -1, false, SNAME("ResourceLoader::prefetch"));
+	MutexLock lock(prefetch_batches_mutex);
+	prefetch_batches.push_back(batch);
+	return OK;
+}
+
+void ResourceLoader::clear_prefetched() {
+	_prefetch_reclaim_batches(true);
+	MutexLock lock(prefetch_mutex);
+	LocalVector<String> paths;
+	for (const KeyValue<String, PrefetchedResource> &E : prefetched_resources) {
+		paths.push_back(E.key);
+	}
+	prefetched_resources.clear();
+	prefetch_memory_usage = 0;
+	for (const String &path : paths) {
+		ResourceCache::_set_prefetched(path, false);
+	}
+}
+
+void ResourceLoader::set_prefetch_memory_budget(uint64_t p_bytes) {
+	MutexLock lock(prefetch_mutex);
+	prefetch_memory_budget = p_bytes;
+	_prefetch_evict();
+}
+
+uint64_t ResourceLoader::get_prefetch_memory_budget() {
+	MutexLock lock(prefetch_mutex);
+	return prefetch_memory_budget;
+}
+
+uint64_t ResourceLoader::get_prefetch_memory_usage() {
+	MutexLock lock(prefetch_mutex);
+	return prefetch_memory_usage;
+}
+
 bool ResourceLoader::is_cleaning_tasks() {
 	MutexLock lock(thread_load_mutex);
 	return cleaning_tasks;
@@ -1381,6 +1622,15 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+Mutex ResourceLoader::prefetch_mutex;
+Mutex ResourceLoader::prefetch_batches_mutex;
+HashMap<String, Vector<String>> ResourceLoader::dependency_index;
+bool ResourceLoader::dependency_index_loaded = false;
+HashMap<String, ResourceLoader::PrefetchedResource> ResourceLoader::prefetched_resources;
+LocalVector<ResourceLoader::PrefetchBatch *> ResourceLoader::prefetch_batches;
+uint64_t ResourceLoader::prefetch_memory_usage = 0;
+uint64_t ResourceLoader::prefetch_memory_budget = 256 * 1024 * 1024;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
@@ -207,6 +207,34 @@ private:
 
 	static bool _ensure_load_progress();
 
+	struct PrefetchedResource {
+		Ref<Resource> resource;
+		uint64_t size = 0; // Estimated from the size of the file backing it.
+	};
+
+	struct PrefetchBatch {
+		WorkerThreadPool::GroupID group_id = -1;
+		Vector<String> paths; // Dependencies come before their dependents.
+	};
+
+	static Mutex prefetch_mutex;
+	static Mutex prefetch_batches_mutex;
+	static HashMap<String, Vector<String>> dependency_index;
+	static bool dependency_index_loaded;
+	static HashMap<String, PrefetchedResource> prefetched_resources; // Insertion order doubles as age for eviction.
+	static LocalVector<PrefetchBatch *> prefetch_batches;
+	static uint64_t prefetch_memory_usage;
+	static uint64_t prefetch_memory_budget;
+
+	static void _load_dependency_index();
+	static Vector<String> _prefetch_get_dependencies(const String &p_path);
+	static void _prefetch_collect(const String &p_path, HashSet<String> &r_visited, Vector<String> &r_paths);
+	static void _prefetch_task(void *p_userdata, uint32_t p_index);
+	static void _prefetch_evict();
+	static void _prefetch_reclaim_batches(bool p_wait);
+
+	static void _retain_loaded(const Ref<Resource> &p_resource);
+
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
@@ -214,6 +242,13 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; };
 
+	static Error prefetch(const Vector<String> &p_paths);
+	static void clear_prefetched();
+	static void set_prefetch_memory_budget(uint64_t p_bytes);
+	static uint64_t get_prefetch_memory_budget();
+	static uint64_t get_prefetch_memory_usage();
+	static String get_dependency_index_file();
+
 	static Ref<Resource> load(const String &p_path, const String &p_type_hint = "", ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
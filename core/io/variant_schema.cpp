@@ -0,0 +1,564 @@
+/**************************************************************************/
+/*  variant_schema.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "variant_schema.h"
+
+#include "core/io/marshalls.h"
+
+// Zigzag mapping keeps small negative values small once varint-encoded.
+static _FORCE_INLINE_ uint64_t _zigzag_encode(int64_t p_value) {
+	return (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+}
+
+static _FORCE_INLINE_ int64_t _zigzag_decode(uint64_t p_value) {
+	return int64_t(p_value >> 1) ^ -int64_t(p_value & 1);
+}
+
+static void _encode_varint(uint64_t p_value, uint8_t *&r_buf, int &r_len) {
+	do {
+		uint8_t byte = p_value & 0x7F;
+		p_value >>= 7;
+		if (p_value) {
+			byte |= 0x80;
+		}
+		if (r_buf) {
+			*(r_buf++) = byte;
+		}
+		r_len++;
+	} while (p_value);
+}
+
+static Error _decode_varint(uint64_t &r_value, const uint8_t *&r_buf, int &r_remaining) {
+	r_value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		ERR_FAIL_COND_V(r_remaining < 1, ERR_INVALID_DATA);
+		uint8_t byte = *(r_buf++);
+		r_remaining--;
+		r_value |= uint64_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return OK;
+		}
+	}
+	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Varint is too long.");
+}
+
+// Number of components for math types stored as floats (or varints for integer types).
+static int _get_component_count(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+			return 2;
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+			return 3;
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::QUATERNION:
+		case Variant::PLANE:
+		case Variant::COLOR:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+static void _get_components(const Variant &p_value, double *r_components) {
+	switch (p_value.get_type()) {
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			r_components[3] = v.w;
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+			r_components[3] = v.w;
+		} break;
+		case Variant::RECT2: {
+			Rect2 r = p_value;
+			r_components[0] = r.position.x;
+			r_components[1] = r.position.y;
+			r_components[2] = r.size.x;
+			r_components[3] = r.size.y;
+		} break;
+		case Variant::RECT2I: {
+			Rect2i r = p_value;
+			r_components[0] = r.position.x;
+			r_components[1] = r.position.y;
+			r_components[2] = r.size.x;
+			r_components[3] = r.size.y;
+		} break;
+		case Variant::QUATERNION: {
+			Quaternion q = p_value;
+			r_components[0] = q.x;
+			r_components[1] = q.y;
+			r_components[2] = q.z;
+			r_components[3] = q.w;
+		} break;
+		case Variant::PLANE: {
+			Plane p = p_value;
+			r_components[0] = p.normal.x;
+			r_components[1] = p.normal.y;
+			r_components[2] = p.normal.z;
+			r_components[3] = p.d;
+		} break;
+		case Variant::COLOR: {
+			Color c = p_value;
+			r_components[0] = c.r;
+			r_components[1] = c.g;
+			r_components[2] = c.b;
+			r_components[3] = c.a;
+		} break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+}
+
+static Variant _make_from_components(Variant::Type p_type, const double *p_components) {
+	const double *c = p_components;
+	switch (p_type) {
+		case Variant::VECTOR2:
+			return Vector2(c[0], c[1]);
+		case Variant::VECTOR2I:
+			return Vector2i(c[0], c[1]);
+		case Variant::VECTOR3:
+			return Vector3(c[0], c[1], c[2]);
+		case Variant::VECTOR3I:
+			return Vector3i(c[0], c[1], c[2]);
+		case Variant::VECTOR4:
+			return Vector4(c[0], c[1], c[2], c[3]);
+		case Variant::VECTOR4I:
+			return Vector4i(c[0], c[1], c[2], c[3]);
+		case Variant::RECT2:
+			return Rect2(c[0], c[1], c[2], c[3]);
+		case Variant::RECT2I:
+			return Rect2i(c[0], c[1], c[2], c[3]);
+		case Variant::QUATERNION:
+			return Quaternion(c[0], c[1], c[2], c[3]);
+		case Variant::PLANE:
+			return Plane(c[0], c[1], c[2], c[3]);
+		case Variant::COLOR:
+			return Color(c[0], c[1], c[2], c[3]);
+		default:
+			ERR_FAIL_V(Variant());
+	}
+}
+
+static _FORCE_INLINE_ bool _is_integer_math_type(Variant::Type p_type) {
+	return p_type == Variant::VECTOR2I || p_type == Variant::VECTOR3I || p_type == Variant::VECTOR4I || p_type == Variant::RECT2I;
+}
+
+// Components are stored at their in-memory width, so double-precision builds don't lose precision.
+// Color is always single precision.
+static _FORCE_INLINE_ int _get_component_size(Variant::Type p_type) {
+	return p_type == Variant::COLOR ? (int)sizeof(float) : (int)sizeof(real_t);
+}
+
+static _FORCE_INLINE_ bool _has_compact_form(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+			return true;
+		default:
+			return _get_component_count(p_type) > 0;
+	}
+}
+
+Error VariantSchema::_encode_field(const Field &p_field, const Variant &p_value, uint8_t *&r_buf, int &r_len) const {
+	if (!_has_compact_form(p_field.type)) {
+		// No compact form for this type (or any type allowed), store it as a regular Variant.
+		int len;
+		Error err = encode_variant(p_value, r_buf, len);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (r_buf) {
+			r_buf += len;
+		}
+		r_len += len;
+		return OK;
+	}
+
+	Variant converted;
+	const Variant *value = &p_value;
+	if (p_value.get_type() != p_field.type) {
+		ERR_FAIL_COND_V_MSG(!Variant::can_convert_strict(p_value.get_type(), p_field.type), ERR_INVALID_PARAMETER, vformat("Value of type %s cannot be stored in schema field \"%s\" of type %s.", Variant::get_type_name(p_value.get_type()), p_field.name, Variant::get_type_name(p_field.type)));
+		Callable::CallError ce;
+		const Variant *args[1] = { &p_value };
+		Variant::construct(p_field.type, converted, args, 1, ce);
+		ERR_FAIL_COND_V(ce.error != Callable::CallError::CALL_OK, ERR_INVALID_PARAMETER);
+		value = &converted;
+	}
+
+	switch (p_field.type) {
+		case Variant::INT: {
+			_encode_varint(_zigzag_encode(value->operator int64_t()), r_buf, r_len);
+		} break;
+		case Variant::FLOAT: {
+			if (r_buf) {
+				r_buf += encode_double(value->operator double(), r_buf);
+			}
+			r_len += sizeof(double);
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			CharString utf8 = value->operator String().utf8();
+			_encode_varint(utf8.length(), r_buf, r_len);
+			if (r_buf) {
+				memcpy(r_buf, utf8.get_data(), utf8.length());
+				r_buf += utf8.length();
+			}
+			r_len += utf8.length();
+		} break;
+		default: {
+			int count = _get_component_count(p_field.type);
+			int component_size = _get_component_size(p_field.type);
+			double components[4];
+			_get_components(*value, components);
+			for (int i = 0; i < count; i++) {
+				if (_is_integer_math_type(p_field.type)) {
+					_encode_varint(_zigzag_encode(int64_t(components[i])), r_buf, r_len);
+				} else {
+					if (r_buf) {
+						r_buf += component_size == (int)sizeof(double) ? encode_double(components[i], r_buf) : encode_float(components[i], r_buf);
+					}
+					r_len += component_size;
+				}
+			}
+		} break;
+	}
+
+	return OK;
+}
+
+Error VariantSchema::_decode_field(const Field &p_field, Variant &r_value, const uint8_t *&r_buf, int &r_remaining) const {
+	if (!_has_compact_form(p_field.type)) {
+		int len;
+		Error err = decode_variant(r_value, r_buf, r_remaining, &len);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_buf += len;
+		r_remaining -= len;
+		return OK;
+	}
+
+	switch (p_field.type) {
+		case Variant::INT: {
+			uint64_t v;
+			Error err = _decode_varint(v, r_buf, r_remaining);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_value = _zigzag_decode(v);
+		} break;
+		case Variant::FLOAT: {
+			ERR_FAIL_COND_V(r_remaining < (int)sizeof(double), ERR_INVALID_DATA);
+			r_value = decode_double(r_buf);
+			r_buf += sizeof(double);
+			r_remaining -= sizeof(double);
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			uint64_t len;
+			Error err = _decode_varint(len, r_buf, r_remaining);
+			ERR_FAIL_COND_V(err != OK, err);
+			ERR_FAIL_COND_V(len > (uint64_t)r_remaining, ERR_INVALID_DATA);
+			String str;
+			if (str.parse_utf8((const char *)r_buf, len) != OK) {
+				ERR_FAIL_V(ERR_INVALID_DATA);
+			}
+			r_value = p_field.type == Variant::STRING_NAME ? Variant(StringName(str)) : Variant(str);
+			r_buf += len;
+			r_remaining -= len;
+		} break;
+		default: {
+			int count = _get_component_count(p_field.type);
+			int component_size = _get_component_size(p_field.type);
+			double components[4];
+			for (int i = 0; i < count; i++) {
+				if (_is_integer_math_type(p_field.type)) {
+					uint64_t v;
+					Error err = _decode_varint(v, r_buf, r_remaining);
+					ERR_FAIL_COND_V(err != OK, err);
+					components[i] = _zigzag_decode(v);
+				} else {
+					ERR_FAIL_COND_V(r_remaining < component_size, ERR_INVALID_DATA);
+					components[i] = component_size == (int)sizeof(double) ? decode_double(r_buf) : decode_float(r_buf);
+					r_buf += component_size;
+					r_remaining -= component_size;
+				}
+			}
+			r_value = _make_from_components(p_field.type, components);
+		} break;
+	}
+
+	return OK;
+}
+
+Error VariantSchema::encode_values(const Variant **p_values, uint8_t *r_buffer, int &r_len) const {
+	uint8_t *buf = r_buffer;
+	r_len = 0;
+
+	// Presence bits for every field, followed by the values of boolean fields.
+	const int presence_bytes = (fields.size() + 7) / 8;
+	const int bool_bytes = (bool_field_count + 7) / 8;
+	if (buf) {
+		memset(buf, 0, presence_bytes + bool_bytes);
+		uint32_t bool_index = 0;
+		for (uint32_t i = 0; i < fields.size(); i++) {
+			if (p_values[i]) {
+				buf[i / 8] |= 1 << (i % 8);
+			}
+			if (fields[i].type == Variant::BOOL) {
+				if (p_values[i] && p_values[i]->booleanize()) {
+					buf[presence_bytes + bool_index / 8] |= 1 << (bool_index % 8);
+				}
+				bool_index++;
+			}
+		}
+		buf += presence_bytes + bool_bytes;
+	}
+	r_len += presence_bytes + bool_bytes;
+
+	for (uint32_t i = 0; i < fields.size(); i++) {
+		if (!p_values[i] || fields[i].type == Variant::BOOL) {
+			continue;
+		}
+		Error err = _encode_field(fields[i], *p_values[i], buf, r_len);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	return OK;
+}
+
+Error VariantSchema::decode_values(Variant *r_values, bool *r_present, const uint8_t *p_buffer, int p_len, int *r_len) const {
+	const uint8_t *buf = p_buffer;
+	int remaining = p_len;
+
+	const int presence_bytes = (fields.size() + 7) / 8;
+	const int bool_bytes = (bool_field_count + 7) / 8;
+	ERR_FAIL_COND_V(remaining < presence_bytes + bool_bytes, ERR_INVALID_DATA);
+	const uint8_t *presence = buf;
+	const uint8_t *bools = buf + presence_bytes;
+	buf += presence_bytes + bool_bytes;
+	remaining -= presence_bytes + bool_bytes;
+
+	uint32_t bool_index = 0;
+	for (uint32_t i = 0; i < fields.size(); i++) {
+		const bool present = presence[i / 8] & (1 << (i % 8));
+		r_present[i] = present;
+		if (fields[i].type == Variant::BOOL) {
+			r_values[i] = bool(bools[bool_index / 8] & (1 << (bool_index % 8)));
+			bool_index++;
+		} else if (present) {
+			Error err = _decode_field(fields[i], r_values[i], buf, remaining);
+			ERR_FAIL_COND_V(err != OK, err);
+		}
+	}
+
+	if (r_len) {
+		*r_len = p_len - remaining;
+	}
+	return OK;
+}
+
+Error VariantSchema::encode(const Variant &p_value, uint8_t *r_buffer, int &r_len) const {
+	LocalVector<Variant> values;
+	LocalVector<const Variant *> valuesp;
+	values.resize(fields.size());
+	valuesp.resize(fields.size());
+
+	if (p_value.get_type() == Variant::DICTIONARY) {
+		const Dictionary dict = p_value;
+		for (uint32_t i = 0; i < fields.size(); i++) {
+			const Variant *v = dict.getptr(fields[i].name);
+			if (!v) {
+				v = dict.getptr(String(fields[i].name));
+			}
+			valuesp[i] = v;
+		}
+	} else if (p_value.get_type() == Variant::ARRAY) {
+		const Array arr = p_value;
+		ERR_FAIL_COND_V_MSG(arr.size() != (int)fields.size(), ERR_INVALID_PARAMETER, vformat("Array has %d elements, but the schema has %d fields.", arr.size(), fields.size()));
+		for (uint32_t i = 0; i < fields.size(); i++) {
+			values[i] = arr[i];
+			valuesp[i] = &values[i];
+		}
+	} else {
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Only a Dictionary or an Array can be encoded with a VariantSchema.");
+	}
+
+	return encode_values(valuesp.ptr(), r_buffer, r_len);
+}
+
+Error VariantSchema::decode(Variant &r_value, const uint8_t *p_buffer, int p_len, int *r_len) const {
+	LocalVector<Variant> values;
+	LocalVector<bool> present;
+	values.resize(fields.size());
+	present.resize(fields.size());
+
+	Error err = decode_values(values.ptr(), present.ptr(), p_buffer, p_len, r_len);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	Dictionary dict;
+	for (uint32_t i = 0; i < fields.size(); i++) {
+		if (present[i]) {
+			if (fields[i].string_name_key) {
+				dict[fields[i].name] = values[i];
+			} else {
+				dict[String(fields[i].name)] = values[i];
+			}
+		}
+	}
+	r_value = dict;
+	return OK;
+}
+
+PackedByteArray VariantSchema::_encode_var(const Variant &p_value) const {
+	int len;
+	Error err = encode(p_value, nullptr, len);
+	ERR_FAIL_COND_V_MSG(err != OK, PackedByteArray(), "Unexpected error encoding variable with schema.");
+
+	PackedByteArray barr;
+	barr.resize(len);
+	encode(p_value, barr.ptrw(), len);
+	return barr;
+}
+
+Variant VariantSchema::_decode_var(const PackedByteArray &p_buffer) const {
+	Variant ret;
+	Error err = decode(ret, p_buffer.ptr(), p_buffer.size());
+	ERR_FAIL_COND_V_MSG(err != OK, Variant(), "Not enough bytes for decoding bytes, or invalid format.");
+	return ret;
+}
+
+void VariantSchema::_add_field(const StringName &p_name, Variant::Type p_type, bool p_string_name_key) {
+	ERR_FAIL_INDEX(p_type, Variant::VARIANT_MAX);
+	ERR_FAIL_COND_MSG(find_field(p_name) != -1, vformat("Schema field \"%s\" already exists.", p_name));
+	Field field;
+	field.name = p_name;
+	field.type = p_type;
+	field.string_name_key = p_string_name_key;
+	fields.push_back(field);
+	if (p_type == Variant::BOOL) {
+		bool_field_count++;
+	}
+}
+
+void VariantSchema::add_field(const StringName &p_name, Variant::Type p_type) {
+	_add_field(p_name, p_type, false);
+}
+
+void VariantSchema::clear() {
+	fields.clear();
+	bool_field_count = 0;
+}
+
+void VariantSchema::create_from_template(const Dictionary &p_template) {
+	clear();
+	List<Variant> keys;
+	p_template.get_key_list(&keys);
+	for (const Variant &key : keys) {
+		_add_field(key, p_template[key].get_type(), key.get_type() == Variant::STRING_NAME);
+	}
+}
+
+int VariantSchema::get_field_count() const {
+	return fields.size();
+}
+
+StringName VariantSchema::get_field_name(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)fields.size(), StringName());
+	return fields[p_index].name;
+}
+
+Variant::Type VariantSchema::get_field_type(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)fields.size(), Variant::NIL);
+	return fields[p_index].type;
+}
+
+uint32_t VariantSchema::get_hash() const {
+	// Includes the float width, as peers built with different precisions encode math types differently.
+	uint32_t h = hash_murmur3_one_32(sizeof(real_t));
+	for (const Field &field : fields) {
+		h = hash_murmur3_one_32(field.name.hash(), h);
+		h = hash_murmur3_one_32(field.type, h);
+	}
+	return hash_fmix32(h);
+}
+
+int VariantSchema::find_field(const StringName &p_name) const {
+	for (uint32_t i = 0; i < fields.size(); i++) {
+		if (fields[i].name == p_name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void VariantSchema::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add_field", "name", "type"), &VariantSchema::add_field);
+	ClassDB::bind_method(D_METHOD("clear"), &VariantSchema::clear);
+	ClassDB::bind_method(D_METHOD("create_from_template", "template"), &VariantSchema::create_from_template);
+	ClassDB::bind_method(D_METHOD("get_field_count"), &VariantSchema::get_field_count);
+	ClassDB::bind_method(D_METHOD("get_field_name", "index"), &VariantSchema::get_field_name);
+	ClassDB::bind_method(D_METHOD("get_field_type", "index"), &VariantSchema::get_field_type);
+	ClassDB::bind_method(D_METHOD("find_field", "name"), &VariantSchema::find_field);
+	ClassDB::bind_method(D_METHOD("get_hash"), &VariantSchema::get_hash);
+	ClassDB::bind_method(D_METHOD("encode_var", "value"), &VariantSchema::_encode_var);
+	ClassDB::bind_method(D_METHOD("decode_var", "bytes"), &VariantSchema::_decode_var);
+}
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  variant_schema.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef VARIANT_SCHEMA_H
+#define VARIANT_SCHEMA_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Compact, header-less encoding of structured values whose layout is known
+// on both ends. Each field is written according to its declared type:
+// integers as zigzag varints, booleans as bits, math types at `real_t` precision.
+// Fields declared as `Variant::NIL` accept any value and fall back to `encode_variant`.
+class VariantSchema : public RefCounted {
+	GDCLASS(VariantSchema, RefCounted);
+
+	struct Field {
+		StringName name;
+		Variant::Type type = Variant::NIL;
+		bool string_name_key = false; // Decoded dictionaries use the key type of the template.
+	};
+
+	LocalVector<Field> fields;
+	uint32_t bool_field_count = 0;
+
+	Error _encode_field(const Field &p_field, const Variant &p_value, uint8_t *&r_buf, int &r_len) const;
+	Error _decode_field(const Field &p_field, Variant &r_value, const uint8_t *&r_buf, int &r_remaining) const;
+
+	void _add_field(const StringName &p_name, Variant::Type p_type, bool p_string_name_key);
+
+	PackedByteArray _encode_var(const Variant &p_value) const;
+	Variant _decode_var(const PackedByteArray &p_buffer) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void add_field(const StringName &p_name, Variant::Type p_type);
+	void clear();
+	void create_from_template(const Dictionary &p_template);
+
+	int get_field_count() const;
+	StringName get_field_name(int p_index) const;
+	Variant::Type get_field_type(int p_index) const;
+	int find_field(const StringName &p_name) const;
+	// Identifies the field layout, so that data encoded with another schema can be rejected.
+	uint32_t get_hash() const;
+
+	// Encodes one value per field, in field order. `p_values[i]` may be null for absent fields.
+	// As with `encode_variant`, pass a null `r_buffer` to compute the required length.
+	Error encode_values(const Variant **p_values, uint8_t *r_buffer, int &r_len) const;
+	Error decode_values(Variant *r_values, bool *r_present, const uint8_t *p_buffer, int p_len, int *r_len = nullptr) const;
+
+	// Encodes a `Dictionary` keyed by field names, or an `Array` in field order.
+	Error encode(const Variant &p_value, uint8_t *r_buffer, int &r_len) const;
+	Error decode(Variant &r_value, const uint8_t *p_buffer, int p_len, int *r_len = nullptr) const;
+
+	VariantSchema() {}
+};
+
+#endif // VARIANT_SCHEMA_H
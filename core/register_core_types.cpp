@@ -63,6 +63,7 @@
 #include "core/io/tcp_server.h"
 #include "core/io/translation_loader_po.h"
 #include "core/io/udp_server.h"
+#include "core/io/variant_schema.h"
 #include "core/io/xml_parser.h"
 #include "core/math/a_star.h"
 #include "core/math/a_star_grid_2d.h"
@@ -259,6 +260,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(AStar2D);
 	GDREGISTER_CLASS(AStarGrid2D);
 	GDREGISTER_CLASS(EncodedObjectAsID);
+	GDREGISTER_CLASS(VariantSchema);
 	GDREGISTER_CLASS(RandomNumberGenerator);
 
 	GDREGISTER_ABSTRACT_CLASS(ImageFormatLoader);
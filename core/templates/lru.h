@@ -84,6 +84,41 @@ public:
 		return _map.getptr(p_key);
 	}
 
+	bool erase(const TKey &p_key) {
+		Element *e = _map.getptr(p_key);
+		if (!e) {
+			return false;
+		}
+		_list.erase(*e);
+		_map.erase(p_key);
+		return true;
+	}
+
+	// Removes the least recently used entry, optionally handing it back to the caller.
+	bool evict_lru(TKey *r_key = nullptr, TData *r_data = nullptr) {
+		Element d = _list.back();
+		if (!d) {
+			return false;
+		}
+		if (r_key) {
+			*r_key = d->get().key;
+		}
+		if (r_data) {
+			*r_data = d->get().data;
+		}
+		_map.erase(d->get().key);
+		_list.pop_back();
+		return true;
+	}
+
+	// Visits every entry, from the least to the most recently used one, without changing their order.
+	template <typename F>
+	void for_each_lru(F p_callback) const {
+		for (const typename List<Pair>::Element *e = _list.back(); e; e = e->prev()) {
+			p_callback(e->get().key, e->get().data);
+		}
+	}
+
 	const TData &get(const TKey &p_key) {
 		Element *e = _map.getptr(p_key);
 		CRASH_COND(!e);
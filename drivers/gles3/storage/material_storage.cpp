@@ -2313,6 +2313,14 @@ RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_
 	return RS::ShaderNativeSourceCode();
 }
 
+void MaterialStorage::shader_compile_batch_begin() {
+	// OpenGL objects can only be created on the thread owning the context, so
+	// shaders keep compiling as soon as their code is set.
+}
+
+void MaterialStorage::shader_compile_batch_end() {
+}
+
 /* MATERIAL API */
 
 void MaterialStorage::_material_queue_update(GLES3::Material *material, bool p_uniform, bool p_texture) {
@@ -596,6 +596,9 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	virtual void shader_compile_batch_begin() override;
+	virtual void shader_compile_batch_end() override;
+
 	/* MATERIAL API */
 
 	Material *get_material(RID p_rid) { return material_owner.get_or_null(p_rid); };
@@ -35,6 +35,7 @@
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -1413,6 +1414,31 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 		}
 	}
 
+	// Store the dependencies of exported resources, so ResourceLoader::prefetch() doesn't have to open every file to find them.
+	{
+		Dictionary dependency_index;
+		for (const String &path : paths) {
+			int file_idx;
+			EditorFileSystemDirectory *dir = EditorFileSystem::get_singleton()->find_file(path, &file_idx);
+			if (!dir) {
+				continue;
+			}
+			Vector<String> deps = dir->get_file_deps(file_idx);
+			dependency_index[path] = PackedStringArray(deps);
+		}
+
+		int len;
+		err = encode_variant(dependency_index, nullptr, len);
+		ERR_FAIL_COND_V(err != OK, err);
+		Vector<uint8_t> array;
+		array.resize(len);
+		encode_variant(dependency_index, array.ptrw(), len);
+		err = p_func(p_udata, ResourceLoader::get_dependency_index_file(), array, idx, total, enc_in_filters, enc_ex_filters, key);
+		if (err != OK) {
+			return err;
+		}
+	}
+
 	String config_file = "project.binary";
 	String engine_cfb = EditorPaths::get_singleton()->get_cache_dir().path_join("tmp" + config_file);
 	ProjectSettings::get_singleton()->save_custom(engine_cfb, custom_map, custom_list);
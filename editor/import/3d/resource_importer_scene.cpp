@@ -307,6 +307,10 @@ bool ResourceImporterScene::get_option_visibility(const String &p_path, const St
 		return false;
 	}
 
+	if ((p_option == "meshes/hlod_distance" || p_option == "meshes/hlod_proxy_ratio") && float(p_options["meshes/hlod_cluster_size"]) <= 0.0) {
+		return false;
+	}
+
 	for (int i = 0; i < post_importer_plugins.size(); i++) {
 		Variant ret = post_importer_plugins.write[i]->get_option_visibility(p_path, _scene_import_type, p_option, p_options);
 		if (ret.get_type() == Variant::BOOL) {
@@ -2379,6 +2383,9 @@ void ResourceImporterScene::get_import_options(const String &p_path, List<Import
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Static,Static Lightmaps,Dynamic", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 1));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.2));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/force_disable_compression"), false));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/hlod_cluster_size", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater,suffix:m", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0.0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/hlod_distance", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater,suffix:m"), 100.0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/hlod_proxy_ratio", PROPERTY_HINT_RANGE, "0.01,1,0.01"), 0.1));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "skins/use_named_skins"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/import"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "animation/fps", PROPERTY_HINT_RANGE, "1,120,1"), 30));
@@ -2646,6 +2653,167 @@ Node *ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_
 	return p_node;
 }
 
+static void _collect_animated_nodes(Node *p_node, HashSet<Node *> &r_animated) {
+	AnimationMixer *mixer = Object::cast_to<AnimationMixer>(p_node);
+	Node *mixer_root = mixer ? mixer->get_node_or_null(mixer->get_root_node()) : nullptr;
+	if (mixer_root) {
+		List<StringName> animation_names;
+		mixer->get_animation_list(&animation_names);
+		for (const StringName &name : animation_names) {
+			Ref<Animation> animation = mixer->get_animation(name);
+			for (int i = 0; i < animation->get_track_count(); i++) {
+				Animation::TrackType type = animation->track_get_type(i);
+				if (type == Animation::TYPE_METHOD || type == Animation::TYPE_AUDIO || type == Animation::TYPE_ANIMATION) {
+					continue; // These don't change how the target looks.
+				}
+				const NodePath path = animation->track_get_path(i);
+				Node *target = mixer_root->get_node_or_null(NodePath(path.get_names(), path.is_absolute()));
+				if (target) {
+					r_animated.insert(target);
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_collect_animated_nodes(p_node->get_child(i), r_animated);
+	}
+}
+
+static void _collect_hlod_candidates(Node *p_node, const Transform3D &p_parent_xform, const HashSet<Node *> &p_animated, LocalVector<Pair<MeshInstance3D *, Transform3D>> &r_candidates) {
+	if (p_animated.has(p_node)) {
+		return; // A proxy is baked at rest pose, so neither this node nor anything under it can be merged.
+	}
+
+	Transform3D xform = p_parent_xform;
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d) {
+		xform = xform * node_3d->get_transform();
+	}
+
+	MeshInstance3D *mesh_node = Object::cast_to<MeshInstance3D>(p_node);
+	if (mesh_node && mesh_node->get_mesh().is_valid() && mesh_node->get_skin().is_null() && mesh_node->get_mesh()->get_blend_shape_count() == 0 && mesh_node->get_visibility_parent().is_empty() && mesh_node->get_visibility_range_begin() <= 0.0f && mesh_node->get_visibility_range_end() <= 0.0f && mesh_node->get_cast_shadows_setting() != GeometryInstance3D::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		// Only indexed triangle meshes can be merged and simplified.
+		Ref<Mesh> mesh = mesh_node->get_mesh();
+		bool mergeable = mesh->get_surface_count() > 0;
+		for (int i = 0; i < mesh->get_surface_count(); i++) {
+			if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES || !(mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX)) {
+				mergeable = false;
+				break;
+			}
+		}
+		if (mergeable) {
+			r_candidates.push_back(Pair<MeshInstance3D *, Transform3D>(mesh_node, xform));
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_collect_hlod_candidates(p_node->get_child(i), xform, p_animated, r_candidates);
+	}
+}
+
+static void _add_hlod_proxy_surface(const Ref<ArrayMesh> &p_proxy_mesh, const Ref<SurfaceTool> &p_surface_tool, const Ref<Material> &p_material, float p_proxy_ratio) {
+	Array arrays = p_surface_tool->commit_to_arrays();
+	PackedInt32Array indices = arrays[Mesh::ARRAY_INDEX];
+	PackedVector3Array vertices = arrays[Mesh::ARRAY_VERTEX];
+
+	uint32_t target_index_count = MAX(3u, uint32_t(indices.size() * p_proxy_ratio) / 3 * 3);
+	if (SurfaceTool::simplify_func && target_index_count < (uint32_t)indices.size()) {
+		LocalVector<float> positions;
+		positions.resize(vertices.size() * 3);
+		for (int i = 0; i < vertices.size(); i++) {
+			positions[i * 3 + 0] = vertices[i].x;
+			positions[i * 3 + 1] = vertices[i].y;
+			positions[i * 3 + 2] = vertices[i].z;
+		}
+
+		// The error limit is relative to the mesh extents. Allow any error,
+		// since the proxy is only seen from far away and should reach the target size.
+		PackedInt32Array simplified;
+		simplified.resize(indices.size());
+		float error = 0.0f;
+		size_t index_count = SurfaceTool::simplify_func((unsigned int *)simplified.ptrw(), (const unsigned int *)indices.ptr(), indices.size(), positions.ptr(), vertices.size(), sizeof(float) * 3, target_index_count, 1.0f, 0, &error);
+		if (index_count > 0) {
+			simplified.resize(index_count);
+			arrays[Mesh::ARRAY_INDEX] = simplified;
+		}
+	}
+
+	p_proxy_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+	p_proxy_mesh->surface_set_material(p_proxy_mesh->get_surface_count() - 1, p_material);
+}
+
+void ResourceImporterScene::_generate_hlod_proxies(Node *p_root, float p_cluster_size, float p_distance, float p_proxy_ratio) {
+	// Static meshes are grouped by the grid cell containing their center. Each group is merged
+	// into a single simplified proxy mesh, which replaces the whole group beyond the given distance.
+	// This uses visibility ranges: the proxy only shows past its range begin, and the group's
+	// meshes use it as visibility parent, so they only show while it is hidden.
+	HashSet<Node *> animated;
+	_collect_animated_nodes(p_root, animated);
+
+	LocalVector<Pair<MeshInstance3D *, Transform3D>> candidates;
+	for (int i = 0; i < p_root->get_child_count(); i++) {
+		_collect_hlod_candidates(p_root->get_child(i), Transform3D(), animated, candidates);
+	}
+
+	HashMap<Vector3i, LocalVector<uint32_t>> clusters;
+	for (uint32_t i = 0; i < candidates.size(); i++) {
+		AABB aabb = candidates[i].second.xform(candidates[i].first->get_mesh()->get_aabb());
+		Vector3i cell = (aabb.get_center() / p_cluster_size).floor();
+		clusters[cell].push_back(i);
+	}
+
+	int proxy_count = 0;
+	for (const KeyValue<Vector3i, LocalVector<uint32_t>> &E : clusters) {
+		if (E.value.size() < 2) {
+			continue; // Nothing to gain from a proxy for a single mesh, it can use its own LODs.
+		}
+
+		// SurfaceTool::append_from() expects every appended surface to have the same vertex format,
+		// so surfaces sharing a material are only merged when their formats match too.
+		HashMap<Ref<Material>, HashMap<uint64_t, Ref<SurfaceTool>>> surfaces_by_material;
+		for (uint32_t index : E.value) {
+			MeshInstance3D *mesh_node = candidates[index].first;
+			Ref<Mesh> mesh = mesh_node->get_mesh();
+			for (int i = 0; i < mesh->get_surface_count(); i++) {
+				Ref<Material> material = mesh_node->get_surface_override_material(i);
+				if (material.is_null()) {
+					material = mesh->surface_get_material(i);
+				}
+				Ref<SurfaceTool> &surface_tool = surfaces_by_material[material][mesh->surface_get_format(i)];
+				if (surface_tool.is_null()) {
+					surface_tool.instantiate();
+				}
+				surface_tool->append_from(mesh, i, candidates[index].second);
+			}
+		}
+
+		Ref<ArrayMesh> proxy_mesh;
+		proxy_mesh.instantiate();
+		for (const KeyValue<Ref<Material>, HashMap<uint64_t, Ref<SurfaceTool>>> &F : surfaces_by_material) {
+			for (const KeyValue<uint64_t, Ref<SurfaceTool>> &G : F.value) {
+				_add_hlod_proxy_surface(proxy_mesh, G.value, F.key, p_proxy_ratio);
+			}
+		}
+
+		MeshInstance3D *first_node = candidates[E.value[0]].first;
+
+		MeshInstance3D *proxy = memnew(MeshInstance3D);
+		proxy->set_name("HLODProxy" + itos(proxy_count++));
+		proxy->set_mesh(proxy_mesh);
+		proxy->set_gi_mode(first_node->get_gi_mode());
+		proxy->set_layer_mask(first_node->get_layer_mask());
+		proxy->set_visibility_range_begin(p_distance);
+		p_root->add_child(proxy, true);
+		proxy->set_owner(p_root);
+
+		for (uint32_t index : E.value) {
+			MeshInstance3D *mesh_node = candidates[index].first;
+			mesh_node->set_visibility_parent(mesh_node->get_path_to(proxy));
+		}
+	}
+}
+
 void ResourceImporterScene::_add_shapes(Node *p_node, const Vector<Ref<Shape3D>> &p_shapes) {
 	for (const Ref<Shape3D> &E : p_shapes) {
 		CollisionShape3D *cshape = memnew(CollisionShape3D);
@@ -3068,6 +3236,11 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 
 	scene = _generate_meshes(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches);
 
+	float hlod_cluster_size = p_options["meshes/hlod_cluster_size"];
+	if (hlod_cluster_size > 0.0f) {
+		_generate_hlod_proxies(scene, hlod_cluster_size, p_options["meshes/hlod_distance"], p_options["meshes/hlod_proxy_ratio"]);
+	}
+
 	if (mesh_lightmap_caches.size()) {
 		Ref<FileAccess> f = FileAccess::open(p_source_file + ".unwrap_cache", FileAccess::WRITE);
 		if (f.is_valid()) {
@@ -92,6 +92,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_OBSTACLE_COUNT);
+	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_RETAINED_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCE_RETAINED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -143,6 +145,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
 		PNAME("navigation/obstacles"),
+		PNAME("object/retained_resources"),
+		PNAME("memory/retained_resources"),
 
 	};
 
@@ -229,6 +233,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
 		case NAVIGATION_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
+		case OBJECT_RESOURCE_RETAINED_COUNT:
+			return ResourceCache::get_retained_count();
+		case MEMORY_RESOURCE_RETAINED:
+			return ResourceCache::get_retained_memory_usage();
 
 		default: {
 		}
@@ -277,6 +285,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
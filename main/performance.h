@@ -101,6 +101,8 @@ public:
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
 		NAVIGATION_OBSTACLE_COUNT,
+		OBJECT_RESOURCE_RETAINED_COUNT,
+		MEMORY_RESOURCE_RETAINED,
 		MONITOR_MAX
 	};
 
@@ -682,6 +682,18 @@ PackedStringArray GDScriptSyntaxHighlighter::_get_supported_languages() const {
 	return languages;
 }
 
+void GDScriptSyntaxHighlighter::_invalidate_highlighting_cache_from(int p_line) {
+	LocalVector<int> stale_lines;
+	for (const KeyValue<int, int> &E : color_region_cache) {
+		if (E.key >= p_line) {
+			stale_lines.push_back(E.key);
+		}
+	}
+	for (int line : stale_lines) {
+		color_region_cache.erase(line);
+	}
+}
+
 void GDScriptSyntaxHighlighter::_update_cache() {
 	class_names.clear();
 	reserved_keywords.clear();
@@ -110,6 +110,7 @@ private:
 
 public:
 	virtual void _update_cache() override;
+	virtual void _invalidate_highlighting_cache_from(int p_line) override;
 	virtual Dictionary _get_line_syntax_highlighting_impl(int p_line) override;
 
 	virtual String _get_name() const override;
@@ -77,7 +77,7 @@ int AudioStreamPlaybackMP3::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 					}
 				}
 				loop_fade_remaining = 0;
-				seek(mp3_stream->loop_offset);
+				_seek_decoder(mp3_stream->loop_offset);
 				loops++;
 			}
 		}
@@ -85,7 +85,7 @@ int AudioStreamPlaybackMP3::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 		else {
 			//EOF
 			if (use_loop) {
-				seek(mp3_stream->loop_offset);
+				_seek_decoder(mp3_stream->loop_offset);
 				loops++;
 			} else {
 				frames_mixed_this_step = p_frames - todo;
@@ -106,29 +106,85 @@ float AudioStreamPlaybackMP3::get_stream_sampling_rate() {
 }
 
 void AudioStreamPlaybackMP3::start(double p_from_pos) {
+	_request_decoder(DECODER_REQUEST_START, p_from_pos);
+}
+
+void AudioStreamPlaybackMP3::_decoder_start(double p_from_pos) {
 	active = true;
-	seek(p_from_pos);
+	_seek_decoder(p_from_pos);
 	loops = 0;
 	begin_resample();
 }
 
 void AudioStreamPlaybackMP3::stop() {
+	_request_decoder(DECODER_REQUEST_STOP);
+}
+
+void AudioStreamPlaybackMP3::_decoder_stop() {
 	active = false;
 }
 
 bool AudioStreamPlaybackMP3::is_playing() const {
-	return active;
+	return active || _has_decoded_frames() || _has_decoder_requests();
 }
 
 int AudioStreamPlaybackMP3::get_loop_count() const {
-	return loops;
+	return _is_decoding_ahead() ? _get_decoded_loop_count() : loops;
 }
 
 double AudioStreamPlaybackMP3::get_playback_position() const {
+	return _is_decoding_ahead() ? _get_decoded_position() : _get_decoder_position();
+}
+
+double AudioStreamPlaybackMP3::_get_decoder_position() const {
 	return double(frames_mixed) / mp3_stream->sample_rate;
 }
 
+int AudioStreamPlaybackMP3::_get_decoder_loop_count() const {
+	return loops;
+}
+
 void AudioStreamPlaybackMP3::seek(double p_time) {
+	_request_decoder(DECODER_REQUEST_SEEK, p_time);
+}
+
+void AudioStreamPlaybackMP3::_decoder_seek(double p_time) {
+	_seek_decoder(p_time);
+}
+
+bool AudioStreamPlaybackMP3::skip(double p_time) {
+	return _request_decoder(DECODER_REQUEST_SKIP, p_time);
+}
+
+bool AudioStreamPlaybackMP3::_decoder_skip(double p_position) {
+	double position = p_position;
+	if (!active) {
+		return false;
+	}
+
+	// Seeking past the end would restart from the beginning, so wrap around the loop like mix() does.
+	bool use_loop = looping_override ? looping : mp3_stream->loop;
+	double loop_end = mp3_stream->get_length();
+	if (use_loop && mp3_stream->get_bpm() > 0 && mp3_stream->get_beat_count() > 0) {
+		loop_end = mp3_stream->get_beat_count() * 60.0 / mp3_stream->get_bpm();
+	}
+	if (position >= loop_end) {
+		double loop_length = loop_end - mp3_stream->loop_offset;
+		if (!use_loop || loop_length <= 0.0) {
+			active = false;
+			return false;
+		}
+		double loop_time = position - mp3_stream->loop_offset;
+		loops += int(loop_time / loop_length);
+		position = mp3_stream->loop_offset + Math::fmod(loop_time, loop_length);
+	}
+
+	loop_fade_remaining = FADE_SIZE;
+	_seek_decoder(position);
+	return true;
+}
+
+void AudioStreamPlaybackMP3::_seek_decoder(double p_time) {
 	if (!active) {
 		return;
 	}
@@ -181,6 +237,7 @@ Variant AudioStreamPlaybackMP3::get_parameter(const StringName &p_name) const {
 }
 
 AudioStreamPlaybackMP3::~AudioStreamPlaybackMP3() {
+	_disable_decode_ahead();
 	mp3dec_ex_close(&mp3d);
 }
 
@@ -205,6 +262,8 @@ Ref<AudioStreamPlayback> AudioStreamMP3::instantiate_playback() {
 		ERR_FAIL_COND_V(errorcode, Ref<AudioStreamPlaybackMP3>());
 	}
 
+	mp3s->_enable_decode_ahead();
+
 	return mp3s;
 }
 
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  test_audio_stream_mp3.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_STREAM_MP3_H
+#define TEST_AUDIO_STREAM_MP3_H
+
+#include "../audio_stream_mp3.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioStreamMP3 {
+
+// MPEG-1 Layer III frames at 128 kbps, 44100 Hz, mono, without padding. Side information and
+// main data are all zeros, which decodes to 1152 samples of silence per frame.
+static Vector<uint8_t> _silent_mp3(int p_frames) {
+	const int frame_size = 417;
+	Vector<uint8_t> data;
+	data.resize(frame_size * p_frames);
+	uint8_t *w = data.ptrw();
+	memset(w, 0, data.size());
+	for (int i = 0; i < p_frames; i++) {
+		w[i * frame_size + 0] = 0xFF;
+		w[i * frame_size + 1] = 0xFB;
+		w[i * frame_size + 2] = 0x90;
+		w[i * frame_size + 3] = 0xC0;
+	}
+	return data;
+}
+
+TEST_CASE("[Audio][AudioStreamMP3] Skipping wraps around the loop") {
+	Ref<AudioStreamMP3> stream;
+	stream.instantiate();
+	stream->set_data(_silent_mp3(39));
+	const double length = stream->get_length();
+	REQUIRE(length == doctest::Approx(39 * 1152 / 44100.0).epsilon(0.001));
+
+	stream->set_loop(true);
+	stream->set_loop_offset(0.25);
+	const double loop_length = length - 0.25;
+
+	Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+	playback->start();
+
+	CHECK(playback->skip(0.5));
+	CHECK(playback->get_playback_position() == doctest::Approx(0.5).epsilon(0.001));
+	CHECK(playback->get_loop_count() == 0);
+
+	CHECK_MESSAGE(playback->skip(0.6), "Skipping past the end should keep looping playbacks playing.");
+	CHECK_MESSAGE(playback->get_playback_position() == doctest::Approx(0.25 + Math::fmod(1.1 - 0.25, loop_length)).epsilon(0.001), "Skipping past the end should continue from the loop offset.");
+	CHECK(playback->get_loop_count() == 1);
+
+	const double position = playback->get_playback_position();
+	CHECK(playback->skip(3.0));
+	CHECK_MESSAGE(playback->get_playback_position() == doctest::Approx(0.25 + Math::fmod(position + 3.0 - 0.25, loop_length)).epsilon(0.001), "Skipping several loops should wrap as many times.");
+	CHECK(playback->get_loop_count() == 1 + int((position + 3.0 - 0.25) / loop_length));
+
+	AudioFrame buffer[256];
+	CHECK_MESSAGE(playback->mix(buffer, 1.0, 256) == 256, "Playback should resume after skipping.");
+}
+
+TEST_CASE("[Audio][AudioStreamMP3] Skipping past the end stops playback") {
+	Ref<AudioStreamMP3> stream;
+	stream.instantiate();
+	stream->set_data(_silent_mp3(39));
+	stream->set_loop(false);
+
+	Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+	playback->start();
+
+	CHECK(playback->skip(0.5));
+	CHECK_FALSE_MESSAGE(playback->skip(0.6), "Skipping past the end should not restart from the beginning.");
+	CHECK_FALSE(playback->is_playing());
+}
+
+} // namespace TestAudioStreamMP3
+
+#endif // TEST_AUDIO_STREAM_MP3_H
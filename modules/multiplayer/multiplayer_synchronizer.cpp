@@ -110,6 +110,7 @@ void MultiplayerSynchronizer::reset() {
 	last_watch_usec = 0;
 	sync_started = false;
 	watchers.clear();
+	sync_schema.unref();
 }
 
 uint32_t MultiplayerSynchronizer::get_net_id() const {
@@ -252,6 +253,9 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_delta_interval", "milliseconds"), &MultiplayerSynchronizer::set_delta_interval);
 	ClassDB::bind_method(D_METHOD("get_delta_interval"), &MultiplayerSynchronizer::get_delta_interval);
 
+	ClassDB::bind_method(D_METHOD("set_compact_sync_state", "enabled"), &MultiplayerSynchronizer::set_compact_sync_state);
+	ClassDB::bind_method(D_METHOD("is_compact_sync_state"), &MultiplayerSynchronizer::is_compact_sync_state);
+
 	ClassDB::bind_method(D_METHOD("set_replication_config", "config"), &MultiplayerSynchronizer::set_replication_config);
 	ClassDB::bind_method(D_METHOD("get_replication_config"), &MultiplayerSynchronizer::get_replication_config);
 
@@ -270,6 +274,7 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compact_sync_state"), "set_compact_sync_state", "is_compact_sync_state");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
@@ -329,6 +334,7 @@ double MultiplayerSynchronizer::get_delta_interval() const {
 
 void MultiplayerSynchronizer::set_replication_config(Ref<SceneReplicationConfig> p_config) {
 	replication_config = p_config;
+	sync_schema.unref();
 }
 
 Ref<SceneReplicationConfig> MultiplayerSynchronizer::get_replication_config() {
@@ -361,6 +367,46 @@ NodePath MultiplayerSynchronizer::get_root_path() const {
 	return root_path;
 }
 
+void MultiplayerSynchronizer::set_compact_sync_state(bool p_enabled) {
+	compact_sync_state = p_enabled;
+}
+
+bool MultiplayerSynchronizer::is_compact_sync_state() const {
+	return compact_sync_state;
+}
+
+Ref<VariantSchema> MultiplayerSynchronizer::get_sync_schema() {
+	ERR_FAIL_COND_V(replication_config.is_null(), Ref<VariantSchema>());
+	// Any change to the configuration invalidates the schema, even one that keeps the number of properties.
+	if (sync_schema.is_valid() && sync_schema_version == replication_config->get_version()) {
+		return sync_schema;
+	}
+	const List<NodePath> &props = replication_config->get_sync_properties();
+	Node *node = get_root_node();
+	ERR_FAIL_NULL_V(node, Ref<VariantSchema>());
+
+	// Field types come from the declared property types, so that both peers derive the same schema.
+	// Untyped or nested (indexed) properties are stored as regular Variants.
+	sync_schema.instantiate();
+	for (const NodePath &prop : props) {
+		Variant::Type type = Variant::NIL;
+		const Object *obj = _get_prop_target(node, prop);
+		if (obj && prop.get_subname_count() == 1) {
+			List<PropertyInfo> plist;
+			obj->get_property_list(&plist);
+			for (const PropertyInfo &pi : plist) {
+				if (pi.name == prop.get_subname(0)) {
+					type = pi.type;
+					break;
+				}
+			}
+		}
+		sync_schema->add_field(prop.operator String(), type);
+	}
+	sync_schema_version = replication_config->get_version();
+	return sync_schema;
+}
+
 void MultiplayerSynchronizer::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	if (get_multiplayer_authority() == p_peer_id) {
 		return;
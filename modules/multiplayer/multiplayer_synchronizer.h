@@ -33,6 +33,7 @@
 
 #include "scene_replication_config.h"
 
+#include "core/io/variant_schema.h"
 #include "scene/main/node.h"
 
 class MultiplayerSynchronizer : public Node {
@@ -67,6 +68,9 @@ private:
 	uint16_t last_inbound_sync = 0;
 	uint32_t net_id = 0;
 	bool sync_started = false;
+	bool compact_sync_state = false;
+	Ref<VariantSchema> sync_schema;
+	uint64_t sync_schema_version = 0;
 
 	static Object *_get_prop_target(Object *p_obj, const NodePath &p_prop);
 	void _start();
@@ -104,6 +108,10 @@ public:
 
 	void set_root_path(const NodePath &p_path);
 	NodePath get_root_path() const;
+
+	void set_compact_sync_state(bool p_enabled);
+	bool is_compact_sync_state() const;
+	Ref<VariantSchema> get_sync_schema();
 	virtual void set_multiplayer_authority(int p_peer_id, bool p_recursive = true) override;
 
 	bool is_visibility_public() const;
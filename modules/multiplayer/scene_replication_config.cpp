@@ -105,6 +105,7 @@ void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) cons
 
 void SceneReplicationConfig::reset_state() {
 	dirty = false;
+	version++;
 	properties.clear();
 	sync_props.clear();
 	spawn_props.clear();
@@ -230,6 +231,7 @@ void SceneReplicationConfig::_update() {
 		return;
 	}
 	dirty = false;
+	version++;
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
@@ -250,6 +252,13 @@ void SceneReplicationConfig::_update() {
 	}
 }
 
+uint64_t SceneReplicationConfig::get_version() {
+	if (dirty) {
+		_update();
+	}
+	return version;
+}
+
 const List<NodePath> &SceneReplicationConfig::get_spawn_properties() {
 	if (dirty) {
 		_update();
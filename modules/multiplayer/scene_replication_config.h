@@ -68,6 +68,7 @@ private:
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
 	bool dirty = false;
+	uint64_t version = 0;
 
 	void _update();
 
@@ -82,6 +83,8 @@ public:
 	virtual void reset_state() override; // Required since we use variable amount of properties.
 
 	TypedArray<NodePath> get_properties() const;
+	// Incremented whenever the property lists are rebuilt, so users can tell when cached data derived from them is stale.
+	uint64_t get_version();
 
 	void add_property(const NodePath &p_path, int p_index = -1);
 	void remove_property(const NodePath &p_path);
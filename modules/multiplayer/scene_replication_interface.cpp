@@ -828,7 +828,14 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		Ref<VariantSchema> schema = sync->is_compact_sync_state() ? sync->get_sync_schema() : Ref<VariantSchema>();
+		if (schema.is_valid()) {
+			// Prefixed with the schema hash, so that peers with a different configuration reject it.
+			err = schema->encode_values(varp.ptrw(), nullptr, size);
+			size += 4;
+		} else {
+			err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+		}
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
@@ -840,7 +847,13 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			if (schema.is_valid()) {
+				int data_size;
+				encode_uint32(schema->get_hash(), &ptr[ofs]);
+				schema->encode_values(varp.ptrw(), &ptr[ofs + 4], data_size);
+			} else {
+				MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			}
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -888,7 +901,21 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		Vector<Variant> vars;
 		vars.resize(props.size());
 		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		Error err;
+		if (sync->is_compact_sync_state()) {
+			Ref<VariantSchema> schema = sync->get_sync_schema();
+			ERR_FAIL_COND_V(schema.is_null() || schema->get_field_count() != vars.size(), ERR_INVALID_DATA);
+			if (size < 4 || decode_uint32(&p_buffer[ofs]) != schema->get_hash()) {
+				// Same field count is not enough, the fields or their types may still differ.
+				ofs += size;
+				ERR_CONTINUE_MSG(true, vformat("Ignoring sync data encoded with a different schema: %s", node->get_path()));
+			}
+			LocalVector<bool> present;
+			present.resize(vars.size());
+			err = schema->decode_values(vars.ptrw(), present.ptr(), &p_buffer[ofs + 4], size - 4, &consumed);
+		} else {
+			err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		}
 		ERR_FAIL_COND_V(err, err);
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err, err);
@@ -398,31 +398,80 @@ int64_t TextServerAdvanced::_get_features() const {
 }
 
 void TextServerAdvanced::_free_rid(const RID &p_rid) {
+	// Shaping can take the server lock with the buffer mutex held, so buffers are freed without it.
+	if (shaped_owner.owns(p_rid)) {
+		ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_rid);
+		{
+			MutexLock lock(sd->mutex);
+			shaped_owner.free(p_rid);
+		}
+		memdelete(sd);
+		return;
+	}
+
 	_THREAD_SAFE_METHOD_
+	MutexLock pin_lock(pin_mutex);
 	if (font_owner.owns(p_rid)) {
-		MutexLock ftlock(ft_mutex);
-
 		FontAdvanced *fd = font_owner.get_or_null(p_rid);
 		{
 			MutexLock lock(fd->mutex);
 			font_owner.free(p_rid);
 		}
-		memdelete(fd);
+		if (fd->pins > 0) {
+			fd->freed = true;
+		} else {
+			MutexLock ftlock(ft_mutex);
+			memdelete(fd);
+		}
 	} else if (font_var_owner.owns(p_rid)) {
-		MutexLock ftlock(ft_mutex);
-
 		FontAdvancedLinkedVariation *fdv = font_var_owner.get_or_null(p_rid);
 		{
 			font_var_owner.free(p_rid);
 		}
-		memdelete(fdv);
-	} else if (shaped_owner.owns(p_rid)) {
-		ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_rid);
-		{
-			MutexLock lock(sd->mutex);
-			shaped_owner.free(p_rid);
+		if (fdv->pins > 0) {
+			fdv->freed = true;
+		} else {
+			memdelete(fdv);
+		}
+	}
+}
+
+TextServerAdvanced::FontPins::FontPins(const TextServerAdvanced *p_server, const ShapedTextDataAdvanced *p_sd) {
+	server = p_server;
+
+	MutexLock lock(server->pin_mutex);
+	for (const ShapedTextDataAdvanced::Span &span : p_sd->spans) {
+		for (int i = 0; i < span.fonts.size(); i++) {
+			RID rid = span.fonts[i];
+			FontAdvancedLinkedVariation *fdv = server->font_var_owner.get_or_null(rid);
+			if (fdv) {
+				fdv->pins++;
+				variations.push_back(fdv);
+				rid = fdv->base_font;
+			}
+			FontAdvanced *fd = server->font_owner.get_or_null(rid);
+			if (fd) {
+				fd->pins++;
+				fonts.push_back(fd);
+			}
+		}
+	}
+}
+
+TextServerAdvanced::FontPins::~FontPins() {
+	MutexLock lock(server->pin_mutex);
+	for (FontAdvancedLinkedVariation *fdv : variations) {
+		fdv->pins--;
+		if (fdv->pins == 0 && fdv->freed) {
+			memdelete(fdv);
+		}
+	}
+	for (FontAdvanced *fd : fonts) {
+		fd->pins--;
+		if (fd->pins == 0 && fd->freed) {
+			MutexLock ftlock(server->ft_mutex);
+			memdelete(fd);
 		}
-		memdelete(sd);
 	}
 }
 
@@ -1192,6 +1241,149 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_bitma
 /* Font Cache                                                            */
 /*************************************************************************/
 
+#ifdef MODULE_FREETYPE_ENABLED
+_FORCE_INLINE_ bool TextServerAdvanced::_load_glyph(const FontAdvanced *p_font_data, const FontForSizeAdvanced *p_data, FT_Face p_face, int32_t p_glyph, Vector2 &r_advance, FT_Render_Mode &r_aa_mode, bool &r_bgra) const {
+	int32_t glyph_index = p_glyph & 0xffffff; // Remove subpixel shifts.
+	FT_Int32 flags = FT_LOAD_DEFAULT;
+
+	bool outline = p_data->size.y > 0;
+	switch (p_font_data->hinting) {
+		case TextServer::HINTING_NONE:
+			flags |= FT_LOAD_NO_HINTING;
+			break;
+		case TextServer::HINTING_LIGHT:
+			flags |= FT_LOAD_TARGET_LIGHT;
+			break;
+		default:
+			flags |= FT_LOAD_TARGET_NORMAL;
+			break;
+	}
+	if (p_font_data->force_autohinter) {
+		flags |= FT_LOAD_FORCE_AUTOHINT;
+	}
+	if (outline || (p_font_data->disable_embedded_bitmaps && !FT_HAS_COLOR(p_face))) {
+		flags |= FT_LOAD_NO_BITMAP;
+	} else if (FT_HAS_COLOR(p_face)) {
+		flags |= FT_LOAD_COLOR;
+	}
+
+	FT_Fixed v, h;
+	FT_Get_Advance(p_face, glyph_index, flags, &h);
+	FT_Get_Advance(p_face, glyph_index, flags | FT_LOAD_VERTICAL_LAYOUT, &v);
+	r_advance = outline ? Vector2() : Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0;
+
+	int error = FT_Load_Glyph(p_face, glyph_index, flags);
+	if (error) {
+		return false;
+	}
+
+	if (!p_font_data->msdf) {
+		if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_data->size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
+			FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 4;
+			FT_Outline_Translate(&p_face->glyph->outline, xshift, 0);
+		} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_data->size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
+			FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 5;
+			FT_Outline_Translate(&p_face->glyph->outline, xshift, 0);
+		}
+	}
+
+	if (p_font_data->embolden != 0.f) {
+		FT_Pos strength = p_font_data->embolden * p_data->size.x * p_data->oversampling * 4; // 26.6 fractional units (1 / 64).
+		FT_Outline_Embolden(&p_face->glyph->outline, strength);
+	}
+
+	if (p_font_data->transform != Transform2D()) {
+		FT_Matrix mat = { FT_Fixed(p_font_data->transform[0][0] * 65536), FT_Fixed(p_font_data->transform[0][1] * 65536), FT_Fixed(p_font_data->transform[1][0] * 65536), FT_Fixed(p_font_data->transform[1][1] * 65536) }; // 16.16 fractional units (1 / 65536).
+		FT_Outline_Transform(&p_face->glyph->outline, &mat);
+	}
+
+	r_aa_mode = FT_RENDER_MODE_NORMAL;
+	r_bgra = false;
+	switch (p_font_data->antialiasing) {
+		case FONT_ANTIALIASING_NONE: {
+			r_aa_mode = FT_RENDER_MODE_MONO;
+		} break;
+		case FONT_ANTIALIASING_GRAY: {
+			r_aa_mode = FT_RENDER_MODE_NORMAL;
+		} break;
+		case FONT_ANTIALIASING_LCD: {
+			int aa_layout = (int)((p_glyph >> 24) & 7);
+			switch (aa_layout) {
+				case FONT_LCD_SUBPIXEL_LAYOUT_HRGB: {
+					r_aa_mode = FT_RENDER_MODE_LCD;
+					r_bgra = false;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_HBGR: {
+					r_aa_mode = FT_RENDER_MODE_LCD;
+					r_bgra = true;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_VRGB: {
+					r_aa_mode = FT_RENDER_MODE_LCD_V;
+					r_bgra = false;
+				} break;
+				case FONT_LCD_SUBPIXEL_LAYOUT_VBGR: {
+					r_aa_mode = FT_RENDER_MODE_LCD_V;
+					r_bgra = true;
+				} break;
+				default: {
+					r_aa_mode = FT_RENDER_MODE_NORMAL;
+				} break;
+			}
+		} break;
+	}
+	return true;
+}
+
+bool TextServerAdvanced::_render_glyph_bitmap(const FontAdvanced *p_font_data, const FontForSizeAdvanced *p_data, FT_Face p_face, RenderedGlyph &r_glyph) const {
+	// Only reads font settings, safe to call for the same font from multiple threads as long as each uses its own face.
+	FT_Render_Mode aa_mode = FT_RENDER_MODE_NORMAL;
+	if (!_load_glyph(p_font_data, p_data, p_face, r_glyph.glyph, r_glyph.advance, aa_mode, r_glyph.bgra)) {
+		return false;
+	}
+
+	FT_Bitmap_Init(&r_glyph.bitmap);
+	if (p_data->size.y == 0) {
+		if (FT_Render_Glyph(p_face->glyph, aa_mode) != 0) {
+			return false;
+		}
+		FT_Bitmap_Copy(ft_library, &p_face->glyph->bitmap, &r_glyph.bitmap);
+		r_glyph.top = p_face->glyph->bitmap_top;
+		r_glyph.left = p_face->glyph->bitmap_left;
+		r_glyph.rendered = true;
+	} else {
+		FT_Stroker stroker;
+		if (FT_Stroker_New(ft_library, &stroker) != 0) {
+			ERR_FAIL_V_MSG(false, "FreeType: Failed to load glyph stroker.");
+		}
+
+		FT_Stroker_Set(stroker, (int)(p_data->size.y * p_data->oversampling * 16.0), FT_STROKER_LINECAP_BUTT, FT_STROKER_LINEJOIN_ROUND, 0);
+		FT_Glyph glyph;
+		FT_BitmapGlyph glyph_bitmap;
+
+		if (FT_Get_Glyph(p_face->glyph, &glyph) != 0) {
+			goto cleanup_stroker;
+		}
+		if (FT_Glyph_Stroke(&glyph, stroker, 1) != 0) {
+			goto cleanup_glyph;
+		}
+		if (FT_Glyph_To_Bitmap(&glyph, aa_mode, nullptr, 1) != 0) {
+			goto cleanup_glyph;
+		}
+		glyph_bitmap = (FT_BitmapGlyph)glyph;
+		FT_Bitmap_Copy(ft_library, &glyph_bitmap->bitmap, &r_glyph.bitmap);
+		r_glyph.top = glyph_bitmap->top;
+		r_glyph.left = glyph_bitmap->left;
+		r_glyph.rendered = true;
+
+	cleanup_glyph:
+		FT_Done_Glyph(glyph);
+	cleanup_stroker:
+		FT_Stroker_Done(stroker);
+	}
+	return r_glyph.rendered;
+}
+#endif
+
 _FORCE_INLINE_ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_glyph, FontGlyph &r_glyph) const {
 	FontForSizeAdvanced *fd = nullptr;
 	ERR_FAIL_COND_V(!_ensure_cache_for_size(p_font_data, p_size, fd), false);
@@ -1213,148 +1405,140 @@ _FORCE_INLINE_ bool TextServerAdvanced::_ensure_glyph(FontAdvanced *p_font_data,
 #ifdef MODULE_FREETYPE_ENABLED
 	FontGlyph gl;
 	if (fd->face) {
-		FT_Int32 flags = FT_LOAD_DEFAULT;
-
-		bool outline = p_size.y > 0;
-		switch (p_font_data->hinting) {
-			case TextServer::HINTING_NONE:
-				flags |= FT_LOAD_NO_HINTING;
-				break;
-			case TextServer::HINTING_LIGHT:
-				flags |= FT_LOAD_TARGET_LIGHT;
-				break;
-			default:
-				flags |= FT_LOAD_TARGET_NORMAL;
-				break;
-		}
-		if (p_font_data->force_autohinter) {
-			flags |= FT_LOAD_FORCE_AUTOHINT;
-		}
-		if (outline || (p_font_data->disable_embedded_bitmaps && !FT_HAS_COLOR(fd->face))) {
-			flags |= FT_LOAD_NO_BITMAP;
-		} else if (FT_HAS_COLOR(fd->face)) {
-			flags |= FT_LOAD_COLOR;
+		if (p_font_data->msdf && p_size.y == 0) {
+			Vector2 advance;
+			FT_Render_Mode aa_mode;
+			bool bgra = false;
+			if (!_load_glyph(p_font_data, fd, fd->face, p_glyph, advance, aa_mode, bgra)) {
+				E = fd->glyph_map.insert(p_glyph, FontGlyph());
+				r_glyph = E->value;
+				return false;
+			}
+#ifdef MODULE_MSDFGEN_ENABLED
+			gl = rasterize_msdf(p_font_data, fd, p_font_data->msdf_range, rect_range, &fd->face->glyph->outline, advance);
+#else
+			fd->glyph_map[p_glyph] = FontGlyph();
+			ERR_FAIL_V_MSG(false, "Compiled without MSDFGEN support!");
+#endif
+		} else {
+			RenderedGlyph rg;
+			rg.glyph = p_glyph;
+			if (_render_glyph_bitmap(p_font_data, fd, fd->face, rg)) {
+				gl = rasterize_bitmap(fd, rect_range, rg.bitmap, rg.top, rg.left, rg.advance, rg.bgra);
+			}
+			FT_Bitmap_Done(ft_library, &rg.bitmap);
 		}
+		E = fd->glyph_map.insert(p_glyph, gl);
+		r_glyph = E->value;
+		return gl.found;
+	}
+#endif
+	E = fd->glyph_map.insert(p_glyph, FontGlyph());
+	r_glyph = E->value;
+	return false;
+}
 
-		FT_Fixed v, h;
-		FT_Get_Advance(fd->face, glyph_index, flags, &h);
-		FT_Get_Advance(fd->face, glyph_index, flags | FT_LOAD_VERTICAL_LAYOUT, &v);
+#ifdef MODULE_FREETYPE_ENABLED
+void TextServerAdvanced::_render_glyph_queue(GlyphRenderJob *p_job, FT_Face p_face) {
+	uint32_t count = p_job->glyphs.size();
+	RenderedGlyph *glyphs = p_job->glyphs.ptrw();
+	for (uint32_t i = p_job->next.postincrement(); i < count; i = p_job->next.postincrement()) {
+		p_job->server->_render_glyph_bitmap(p_job->font_data, p_job->size_data, p_face, glyphs[i]);
+	}
+}
 
-		int error = FT_Load_Glyph(fd->face, glyph_index, flags);
-		if (error) {
-			E = fd->glyph_map.insert(p_glyph, FontGlyph());
-			r_glyph = E->value;
-			return false;
-		}
+void TextServerAdvanced::_render_glyphs_threaded(void *p_job, uint32_t p_index) {
+	GlyphRenderJob *job = static_cast<GlyphRenderJob *>(p_job);
+	const FontForSizeAdvanced *fd = job->size_data;
 
-		if (!p_font_data->msdf) {
-			if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
-				FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 4;
-				FT_Outline_Translate(&fd->face->glyph->outline, xshift, 0);
-			} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
-				FT_Pos xshift = (int)((p_glyph >> 27) & 3) << 5;
-				FT_Outline_Translate(&fd->face->glyph->outline, xshift, 0);
+	// FreeType faces can't be shared between threads, open a private one with the same size and variation.
+	FT_Face face = nullptr;
+	{
+		MutexLock ftlock(job->server->ft_mutex);
+		FT_Open_Args fargs;
+		memset(&fargs, 0, sizeof(FT_Open_Args));
+		fargs.memory_base = (unsigned char *)job->font_data->data_ptr;
+		fargs.memory_size = job->font_data->data_size;
+		fargs.flags = FT_OPEN_MEMORY;
+		if (FT_Open_Face(job->server->ft_library, &fargs, fd->face->face_index, &face) != 0) {
+			if (face) {
+				FT_Done_Face(face);
 			}
+			return; // Remaining glyphs are picked up by the other workers.
 		}
+	}
+	FT_Set_Pixel_Sizes(face, 0, double(fd->size.x * fd->oversampling));
+	if (!job->coords.is_empty()) {
+		FT_Set_Var_Design_Coordinates(face, job->coords.size(), const_cast<FT_Fixed *>(job->coords.ptr()));
+	}
 
-		if (p_font_data->embolden != 0.f) {
-			FT_Pos strength = p_font_data->embolden * p_size.x * fd->oversampling * 4; // 26.6 fractional units (1 / 64).
-			FT_Outline_Embolden(&fd->face->glyph->outline, strength);
-		}
+	_render_glyph_queue(job, face);
 
-		if (p_font_data->transform != Transform2D()) {
-			FT_Matrix mat = { FT_Fixed(p_font_data->transform[0][0] * 65536), FT_Fixed(p_font_data->transform[0][1] * 65536), FT_Fixed(p_font_data->transform[1][0] * 65536), FT_Fixed(p_font_data->transform[1][1] * 65536) }; // 16.16 fractional units (1 / 65536).
-			FT_Outline_Transform(&fd->face->glyph->outline, &mat);
-		}
+	MutexLock ftlock(job->server->ft_mutex);
+	FT_Done_Face(face);
+}
+#endif
 
-		FT_Render_Mode aa_mode = FT_RENDER_MODE_NORMAL;
-		bool bgra = false;
-		switch (p_font_data->antialiasing) {
-			case FONT_ANTIALIASING_NONE: {
-				aa_mode = FT_RENDER_MODE_MONO;
-			} break;
-			case FONT_ANTIALIASING_GRAY: {
-				aa_mode = FT_RENDER_MODE_NORMAL;
-			} break;
-			case FONT_ANTIALIASING_LCD: {
-				int aa_layout = (int)((p_glyph >> 24) & 7);
-				switch (aa_layout) {
-					case FONT_LCD_SUBPIXEL_LAYOUT_HRGB: {
-						aa_mode = FT_RENDER_MODE_LCD;
-						bgra = false;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_HBGR: {
-						aa_mode = FT_RENDER_MODE_LCD;
-						bgra = true;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_VRGB: {
-						aa_mode = FT_RENDER_MODE_LCD_V;
-						bgra = false;
-					} break;
-					case FONT_LCD_SUBPIXEL_LAYOUT_VBGR: {
-						aa_mode = FT_RENDER_MODE_LCD_V;
-						bgra = true;
-					} break;
-					default: {
-						aa_mode = FT_RENDER_MODE_NORMAL;
-					} break;
-				}
-			} break;
-		}
+void TextServerAdvanced::_render_glyphs(FontAdvanced *p_font_data, const Vector2i &p_size, const Vector<int32_t> &p_glyphs) {
+	FontForSizeAdvanced *fd = nullptr;
+	ERR_FAIL_COND(!_ensure_cache_for_size(p_font_data, p_size, fd));
 
-		if (!outline) {
-			if (!p_font_data->msdf) {
-				error = FT_Render_Glyph(fd->face->glyph, aa_mode);
-			}
-			FT_GlyphSlot slot = fd->face->glyph;
-			if (!error) {
-				if (p_font_data->msdf) {
-#ifdef MODULE_MSDFGEN_ENABLED
-					gl = rasterize_msdf(p_font_data, fd, p_font_data->msdf_range, rect_range, &slot->outline, Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0);
-#else
-					fd->glyph_map[p_glyph] = FontGlyph();
-					ERR_FAIL_V_MSG(false, "Compiled without MSDFGEN support!");
-#endif
-				} else {
-					gl = rasterize_bitmap(fd, rect_range, slot->bitmap, slot->bitmap_top, slot->bitmap_left, Vector2((h + (1 << 9)) >> 10, (v + (1 << 9)) >> 10) / 64.0, bgra);
-				}
-			}
-		} else {
-			FT_Stroker stroker;
-			if (FT_Stroker_New(ft_library, &stroker) != 0) {
-				fd->glyph_map[p_glyph] = FontGlyph();
-				ERR_FAIL_V_MSG(false, "FreeType: Failed to load glyph stroker.");
+#ifdef MODULE_FREETYPE_ENABLED
+	GlyphRenderJob job;
+	HashSet<int32_t> queued;
+	for (int32_t glyph : p_glyphs) {
+		if ((glyph & 0xffffff) == 0) { // Non graphical or invalid glyph, do not render.
+			if (!fd->glyph_map.has(glyph)) {
+				fd->glyph_map.insert(glyph, FontGlyph());
 			}
+			continue;
+		}
+		if (!fd->glyph_map.has(glyph) && !queued.has(glyph)) {
+			RenderedGlyph rg;
+			rg.glyph = glyph;
+			job.glyphs.push_back(rg);
+			queued.insert(glyph);
+		}
+	}
 
-			FT_Stroker_Set(stroker, (int)(fd->size.y * fd->oversampling * 16.0), FT_STROKER_LINECAP_BUTT, FT_STROKER_LINEJOIN_ROUND, 0);
-			FT_Glyph glyph;
-			FT_BitmapGlyph glyph_bitmap;
+	// MSDF generation is already threaded per glyph, and color glyphs are rendered by FreeType hooks that share state between faces.
+	uint32_t task_count = 0;
+	if (fd->face && !p_font_data->msdf && !FT_HAS_COLOR(fd->face)) {
+		task_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), job.glyphs.size() / GLYPHS_PER_RASTER_TASK);
+	}
+	if (task_count > 1) {
+		job.server = this;
+		job.font_data = p_font_data;
+		job.size_data = fd;
+		if (fd->face->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS) {
+			FT_MM_Var *amaster;
+			FT_Get_MM_Var(fd->face, &amaster);
+			job.coords.resize(amaster->num_axis);
+			FT_Get_Var_Design_Coordinates(fd->face, job.coords.size(), job.coords.ptrw());
+			FT_Done_MM_Var(ft_library, amaster);
+		}
 
-			if (FT_Get_Glyph(fd->face->glyph, &glyph) != 0) {
-				goto cleanup_stroker;
-			}
-			if (FT_Glyph_Stroke(&glyph, stroker, 1) != 0) {
-				goto cleanup_glyph;
-			}
-			if (FT_Glyph_To_Bitmap(&glyph, aa_mode, nullptr, 1) != 0) {
-				goto cleanup_glyph;
-			}
-			glyph_bitmap = (FT_BitmapGlyph)glyph;
-			gl = rasterize_bitmap(fd, rect_range, glyph_bitmap->bitmap, glyph_bitmap->top, glyph_bitmap->left, Vector2(), bgra);
+		// The calling thread renders with the size cache face, the font lock is held so it's not used elsewhere.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&TextServerAdvanced::_render_glyphs_threaded, &job, task_count - 1, task_count - 1, true, String("FontServerRasterizeGlyphs"));
+		_render_glyph_queue(&job, fd->face);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-		cleanup_glyph:
-			FT_Done_Glyph(glyph);
-		cleanup_stroker:
-			FT_Stroker_Done(stroker);
+		// Pack in request order, so atlas layout doesn't depend on which worker finished first.
+		for (RenderedGlyph &rg : job.glyphs) {
+			FontGlyph gl;
+			if (rg.rendered) {
+				gl = rasterize_bitmap(fd, rect_range, rg.bitmap, rg.top, rg.left, rg.advance, rg.bgra);
+			}
+			FT_Bitmap_Done(ft_library, &rg.bitmap);
+			fd->glyph_map.insert(rg.glyph, gl);
 		}
-		E = fd->glyph_map.insert(p_glyph, gl);
-		r_glyph = E->value;
-		return gl.found;
+		return;
+	}
+	for (const RenderedGlyph &rg : job.glyphs) {
+		FontGlyph fgl;
+		_ensure_glyph(p_font_data, p_size, rg.glyph, fgl);
 	}
 #endif
-	E = fd->glyph_map.insert(p_glyph, FontGlyph());
-	r_glyph = E->value;
-	return false;
 }
 
 _FORCE_INLINE_ bool TextServerAdvanced::_ensure_cache_for_size(FontAdvanced *p_font_data, const Vector2i &p_size, FontForSizeAdvanced *&r_cache_for_size) const {
@@ -1858,6 +2042,11 @@ _FORCE_INLINE_ bool TextServerAdvanced::_ensure_cache_for_size(FontAdvanced *p_f
 	return true;
 }
 
+_FORCE_INLINE_ void TextServerAdvanced::_shape_run_cache_clear() {
+	MutexLock lock(shape_run_cache_mutex);
+	shape_run_cache.clear();
+}
+
 _FORCE_INLINE_ void TextServerAdvanced::_font_clear_cache(FontAdvanced *p_font_data) {
 	MutexLock ftlock(ft_mutex);
 
@@ -1869,6 +2058,7 @@ _FORCE_INLINE_ void TextServerAdvanced::_font_clear_cache(FontAdvanced *p_font_d
 	p_font_data->supported_features.clear();
 	p_font_data->supported_varaitions.clear();
 	p_font_data->supported_scripts.clear();
+	_shape_run_cache_clear();
 }
 
 hb_font_t *TextServerAdvanced::_font_get_hb_handle(const RID &p_font_rid, int64_t p_size) const {
@@ -2347,6 +2537,7 @@ void TextServerAdvanced::_font_set_fixed_size(const RID &p_font_rid, int64_t p_f
 
 	MutexLock lock(fd->mutex);
 	fd->fixed_size = p_fixed_size;
+	_shape_run_cache_clear();
 }
 
 int64_t TextServerAdvanced::_font_get_fixed_size(const RID &p_font_rid) const {
@@ -2363,6 +2554,7 @@ void TextServerAdvanced::_font_set_fixed_size_scale_mode(const RID &p_font_rid,
 
 	MutexLock lock(fd->mutex);
 	fd->fixed_size_scale_mode = p_fixed_size_scale_mode;
+	_shape_run_cache_clear();
 }
 
 TextServer::FixedSizeScaleMode TextServerAdvanced::_font_get_fixed_size_scale_mode(const RID &p_font_rid) const {
@@ -2379,6 +2571,7 @@ void TextServerAdvanced::_font_set_allow_system_fallback(const RID &p_font_rid,
 
 	MutexLock lock(fd->mutex);
 	fd->allow_system_fallback = p_allow_system_fallback;
+	_shape_run_cache_clear();
 }
 
 bool TextServerAdvanced::_font_is_allow_system_fallback(const RID &p_font_rid) const {
@@ -2433,6 +2626,7 @@ void TextServerAdvanced::_font_set_subpixel_positioning(const RID &p_font_rid, T
 
 	MutexLock lock(fd->mutex);
 	fd->subpixel_positioning = p_subpixel;
+	_shape_run_cache_clear();
 }
 
 TextServer::SubpixelPositioning TextServerAdvanced::_font_get_subpixel_positioning(const RID &p_font_rid) const {
@@ -2468,6 +2662,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 	if (fdv) {
 		if (fdv->extra_spacing[p_spacing] != p_value) {
 			fdv->extra_spacing[p_spacing] = p_value;
+			_shape_run_cache_clear();
 		}
 	} else {
 		FontAdvanced *fd = font_owner.get_or_null(p_font_rid);
@@ -2476,6 +2671,7 @@ void TextServerAdvanced::_font_set_spacing(const RID &p_font_rid, SpacingType p_
 		MutexLock lock(fd->mutex);
 		if (fd->extra_spacing[p_spacing] != p_value) {
 			fd->extra_spacing[p_spacing] = p_value;
+			_shape_run_cache_clear();
 		}
 	}
 }
@@ -2499,6 +2695,7 @@ void TextServerAdvanced::_font_set_baseline_offset(const RID &p_font_rid, double
 	if (fdv) {
 		if (fdv->baseline_offset != p_baseline_offset) {
 			fdv->baseline_offset = p_baseline_offset;
+			_shape_run_cache_clear();
 		}
 	} else {
 		FontAdvanced *fd = font_owner.get_or_null(p_font_rid);
@@ -2604,6 +2801,7 @@ void TextServerAdvanced::_font_clear_size_cache(const RID &p_font_rid) {
 		memdelete(E.value);
 	}
 	fd->cache.clear();
+	_shape_run_cache_clear();
 }
 
 void TextServerAdvanced::_font_remove_size_cache(const RID &p_font_rid, const Vector2i &p_size) {
@@ -2616,6 +2814,7 @@ void TextServerAdvanced::_font_remove_size_cache(const RID &p_font_rid, const Ve
 		memdelete(fd->cache[p_size]);
 		fd->cache.erase(p_size);
 	}
+	_shape_run_cache_clear();
 }
 
 void TextServerAdvanced::_font_set_ascent(const RID &p_font_rid, int64_t p_size, double p_ascent) {
@@ -2628,6 +2827,7 @@ void TextServerAdvanced::_font_set_ascent(const RID &p_font_rid, int64_t p_size,
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->ascent = p_ascent;
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_font_get_ascent(const RID &p_font_rid, int64_t p_size) const {
@@ -2662,6 +2862,7 @@ void TextServerAdvanced::_font_set_descent(const RID &p_font_rid, int64_t p_size
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->descent = p_descent;
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_font_get_descent(const RID &p_font_rid, int64_t p_size) const {
@@ -2697,6 +2898,7 @@ void TextServerAdvanced::_font_set_underline_position(const RID &p_font_rid, int
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->underline_position = p_underline_position;
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_font_get_underline_position(const RID &p_font_rid, int64_t p_size) const {
@@ -2732,6 +2934,7 @@ void TextServerAdvanced::_font_set_underline_thickness(const RID &p_font_rid, in
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->underline_thickness = p_underline_thickness;
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_font_get_underline_thickness(const RID &p_font_rid, int64_t p_size) const {
@@ -2773,6 +2976,7 @@ void TextServerAdvanced::_font_set_scale(const RID &p_font_rid, int64_t p_size,
 	}
 #endif
 	ffsd->scale = p_scale;
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_font_get_scale(const RID &p_font_rid, int64_t p_size) const {
@@ -2952,6 +3156,7 @@ void TextServerAdvanced::_font_clear_glyphs(const RID &p_font_rid, const Vector2
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 
 	ffsd->glyph_map.clear();
+	_shape_run_cache_clear();
 }
 
 void TextServerAdvanced::_font_remove_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) {
@@ -2964,6 +3169,7 @@ void TextServerAdvanced::_font_remove_glyph(const RID &p_font_rid, const Vector2
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 
 	ffsd->glyph_map.erase(p_glyph);
+	_shape_run_cache_clear();
 }
 
 double TextServerAdvanced::_get_extra_advance(RID p_font_rid, int p_font_size) const {
@@ -3038,6 +3244,7 @@ void TextServerAdvanced::_font_set_glyph_advance(const RID &p_font_rid, int64_t
 
 	fgl.advance = p_advance;
 	fgl.found = true;
+	_shape_run_cache_clear();
 }
 
 Vector2 TextServerAdvanced::_font_get_glyph_offset(const RID &p_font_rid, const Vector2i &p_size, int64_t p_glyph) const {
@@ -3408,6 +3615,7 @@ void TextServerAdvanced::_font_clear_kerning_map(const RID &p_font_rid, int64_t
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map.clear();
+	_shape_run_cache_clear();
 }
 
 void TextServerAdvanced::_font_remove_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair) {
@@ -3420,6 +3628,7 @@ void TextServerAdvanced::_font_remove_kerning(const RID &p_font_rid, int64_t p_s
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map.erase(p_glyph_pair);
+	_shape_run_cache_clear();
 }
 
 void TextServerAdvanced::_font_set_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair, const Vector2 &p_kerning) {
@@ -3432,6 +3641,7 @@ void TextServerAdvanced::_font_set_kerning(const RID &p_font_rid, int64_t p_size
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	ffsd->kerning_map[p_glyph_pair] = p_kerning;
+	_shape_run_cache_clear();
 }
 
 Vector2 TextServerAdvanced::_font_get_kerning(const RID &p_font_rid, int64_t p_size, const Vector2i &p_glyph_pair) const {
@@ -3627,6 +3837,26 @@ PackedInt32Array TextServerAdvanced::_font_get_supported_glyphs(const RID &p_fon
 	return glyphs;
 }
 
+_FORCE_INLINE_ void TextServerAdvanced::_get_glyph_variants(const FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_index, Vector<int32_t> &r_glyphs) const {
+	if (p_font_data->msdf) {
+		r_glyphs.push_back(p_index);
+		return;
+	}
+	for (int aa = 0; aa < ((p_font_data->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
+		if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
+			r_glyphs.push_back(p_index | (0 << 27) | (aa << 24));
+			r_glyphs.push_back(p_index | (1 << 27) | (aa << 24));
+			r_glyphs.push_back(p_index | (2 << 27) | (aa << 24));
+			r_glyphs.push_back(p_index | (3 << 27) | (aa << 24));
+		} else if ((p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (p_font_data->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && p_size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
+			r_glyphs.push_back(p_index | (1 << 27) | (aa << 24));
+			r_glyphs.push_back(p_index | (0 << 27) | (aa << 24));
+		} else {
+			r_glyphs.push_back(p_index | (aa << 24));
+		}
+	}
+}
+
 void TextServerAdvanced::_font_render_range(const RID &p_font_rid, const Vector2i &p_size, int64_t p_start, int64_t p_end) {
 	FontAdvanced *fd = _get_font_data(p_font_rid);
 	ERR_FAIL_NULL(fd);
@@ -3637,31 +3867,40 @@ void TextServerAdvanced::_font_render_range(const RID &p_font_rid, const Vector2
 	Vector2i size = _get_size_outline(fd, p_size);
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
-	for (int64_t i = p_start; i <= p_end; i++) {
 #ifdef MODULE_FREETYPE_ENABLED
-		int32_t idx = FT_Get_Char_Index(ffsd->face, i);
-		if (ffsd->face) {
-			FontGlyph fgl;
-			if (fd->msdf) {
-				_ensure_glyph(fd, size, (int32_t)idx, fgl);
-			} else {
-				for (int aa = 0; aa < ((fd->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
-					if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
-						_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (2 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (3 << 27) | (aa << 24), fgl);
-					} else if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
-						_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-						_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-					} else {
-						_ensure_glyph(fd, size, (int32_t)idx | (aa << 24), fgl);
-					}
-				}
-			}
+	if (ffsd->face) {
+		Vector<int32_t> glyphs;
+		for (int64_t i = p_start; i <= p_end; i++) {
+			_get_glyph_variants(fd, size, (int32_t)FT_Get_Char_Index(ffsd->face, i), glyphs);
 		}
+		_render_glyphs(fd, size, glyphs);
+	}
 #endif
+}
+
+void TextServerAdvanced::_font_render_string(const RID &p_font_rid, const Vector2i &p_size, const String &p_text) {
+	FontAdvanced *fd = _get_font_data(p_font_rid);
+	ERR_FAIL_NULL(fd);
+
+	MutexLock lock(fd->mutex);
+	Vector2i size = _get_size_outline(fd, p_size);
+	FontForSizeAdvanced *ffsd = nullptr;
+	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
+#ifdef MODULE_FREETYPE_ENABLED
+	if (ffsd->face) {
+		HashSet<char32_t> chars;
+		Vector<int32_t> glyphs;
+		const char32_t *text = p_text.ptr();
+		for (int i = 0; i < p_text.length(); i++) {
+			if (is_control(text[i]) || chars.has(text[i])) {
+				continue;
+			}
+			chars.insert(text[i]);
+			_get_glyph_variants(fd, size, (int32_t)FT_Get_Char_Index(ffsd->face, text[i]), glyphs);
+		}
+		_render_glyphs(fd, size, glyphs);
 	}
+#endif
 }
 
 void TextServerAdvanced::_font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) {
@@ -3675,24 +3914,9 @@ void TextServerAdvanced::_font_render_glyph(const RID &p_font_rid, const Vector2
 #ifdef MODULE_FREETYPE_ENABLED
 	int32_t idx = p_index & 0xffffff; // Remove subpixel shifts.
 	if (ffsd->face) {
-		FontGlyph fgl;
-		if (fd->msdf) {
-			_ensure_glyph(fd, size, (int32_t)idx, fgl);
-		} else {
-			for (int aa = 0; aa < ((fd->antialiasing == FONT_ANTIALIASING_LCD) ? FONT_LCD_SUBPIXEL_LAYOUT_MAX : 1); aa++) {
-				if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_QUARTER) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_QUARTER_MAX_SIZE)) {
-					_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (2 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (3 << 27) | (aa << 24), fgl);
-				} else if ((fd->subpixel_positioning == SUBPIXEL_POSITIONING_ONE_HALF) || (fd->subpixel_positioning == SUBPIXEL_POSITIONING_AUTO && size.x <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE)) {
-					_ensure_glyph(fd, size, (int32_t)idx | (1 << 27) | (aa << 24), fgl);
-					_ensure_glyph(fd, size, (int32_t)idx | (0 << 27) | (aa << 24), fgl);
-				} else {
-					_ensure_glyph(fd, size, (int32_t)idx | (aa << 24), fgl);
-				}
-			}
-		}
+		Vector<int32_t> glyphs;
+		_get_glyph_variants(fd, size, idx, glyphs);
+		_render_glyphs(fd, size, glyphs);
 	}
 #endif
 }
@@ -4023,6 +4247,7 @@ void TextServerAdvanced::_font_set_opentype_feature_overrides(const RID &p_font_
 	FontForSizeAdvanced *ffsd = nullptr;
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size, ffsd));
 	fd->feature_overrides = p_overrides;
+	_shape_run_cache_clear();
 }
 
 Dictionary TextServerAdvanced::_font_get_opentype_feature_overrides(const RID &p_font_rid) const {
@@ -4236,10 +4461,10 @@ TextServer::Direction TextServerAdvanced::_shaped_text_get_inferred_direction(co
 }
 
 void TextServerAdvanced::_shaped_text_set_custom_punctuation(const RID &p_shaped, const String &p_punct) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL(sd);
 
+	MutexLock lock(sd->mutex);
 	if (sd->custom_punct != p_punct) {
 		if (sd->parent != RID()) {
 			full_copy(sd);
@@ -4250,23 +4475,26 @@ void TextServerAdvanced::_shaped_text_set_custom_punctuation(const RID &p_shaped
 }
 
 String TextServerAdvanced::_shaped_text_get_custom_punctuation(const RID &p_shaped) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, String());
+
+	MutexLock lock(sd->mutex);
 	return sd->custom_punct;
 }
 
 void TextServerAdvanced::_shaped_text_set_custom_ellipsis(const RID &p_shaped, int64_t p_char) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL(sd);
+
+	MutexLock lock(sd->mutex);
 	sd->el_char = p_char;
 }
 
 int64_t TextServerAdvanced::_shaped_text_get_custom_ellipsis(const RID &p_shaped) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, 0);
+
+	MutexLock lock(sd->mutex);
 	return sd->el_char;
 }
 
@@ -4442,9 +4670,10 @@ bool TextServerAdvanced::_shaped_text_add_string(const RID &p_shaped, const Stri
 }
 
 bool TextServerAdvanced::_shaped_text_add_object(const RID &p_shaped, const Variant &p_key, const Size2 &p_size, InlineAlignment p_inline_align, int64_t p_length, double p_baseline) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
+
+	MutexLock lock(sd->mutex);
 	ERR_FAIL_COND_V(p_key == Variant(), false);
 	ERR_FAIL_COND_V(sd->objects.has(p_key), false);
 
@@ -4618,7 +4847,6 @@ void TextServerAdvanced::_realign(ShapedTextDataAdvanced *p_sd) const {
 }
 
 RID TextServerAdvanced::_shaped_text_substr(const RID &p_shaped, int64_t p_start, int64_t p_length) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, RID());
 
@@ -4646,7 +4874,12 @@ RID TextServerAdvanced::_shaped_text_substr(const RID &p_shaped, int64_t p_start
 		new_sd->extra_spacing[i] = sd->extra_spacing[i];
 	}
 
-	if (!_shape_substr(new_sd, sd, p_start, p_length)) {
+	bool ok;
+	{
+		FontPins pins(this, sd);
+		ok = _shape_substr(new_sd, sd, p_start, p_length);
+	}
+	if (!ok) {
 		memdelete(new_sd);
 		return RID();
 	}
@@ -5030,6 +5263,7 @@ double TextServerAdvanced::_shaped_text_tab_align(const RID &p_shaped, const Pac
 }
 
 RID TextServerAdvanced::_find_sys_font_for_text(const RID &p_fdef, const String &p_script_code, const String &p_language, const String &p_text) {
+	_THREAD_SAFE_METHOD_ // System font cache is shared by all shaping threads.
 	RID f;
 	// Try system fallback.
 	String font_name = _font_get_name(p_fdef);
@@ -6096,6 +6330,7 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 		return;
 	}
 
+	// Span fonts are pinned by the caller (see FontPins), system fallback fonts live until cleanup.
 	FontAdvanced *fd = _get_font_data(f);
 	ERR_FAIL_NULL(fd);
 	MutexLock lock(fd->mutex);
@@ -6274,7 +6509,10 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 		for (unsigned int i = 0; i < glyph_count; i++) {
 			if ((w[i].flags & GRAPHEME_IS_VALID) == GRAPHEME_IS_VALID) {
 				if (failed_subrun_start != p_end + 1) {
+					// Fallback may take the server lock, which comes before font locks.
+					lock.temp_unlock();
 					_shape_run(p_sd, failed_subrun_start, failed_subrun_end, p_script, p_direction, p_fonts, p_span, p_fb_index + 1, p_start, p_end, (p_fb_index >= p_fonts.size()) ? f : RID());
+					lock.temp_relock();
 					failed_subrun_start = p_end + 1;
 					failed_subrun_end = p_start;
 				}
@@ -6304,7 +6542,9 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 		}
 		memfree(w);
 		if (failed_subrun_start != p_end + 1) {
+			lock.temp_unlock();
 			_shape_run(p_sd, failed_subrun_start, failed_subrun_end, p_script, p_direction, p_fonts, p_span, p_fb_index + 1, p_start, p_end, (p_fb_index >= p_fonts.size()) ? f : RID());
+			lock.temp_relock();
 		}
 		p_sd->ascent = MAX(p_sd->ascent, _font_get_ascent(f, fs) + _font_get_spacing(f, SPACING_TOP));
 		p_sd->descent = MAX(p_sd->descent, _font_get_descent(f, fs) + _font_get_spacing(f, SPACING_BOTTOM));
@@ -6313,8 +6553,98 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 	}
 }
 
+void TextServerAdvanced::_shape_run_cached(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, hb_script_t p_script, hb_direction_t p_direction, const TypedArray<RID> &p_fonts, int64_t p_span) {
+	const ShapedTextDataAdvanced::Span &span = p_sd->spans[p_span];
+
+	ShapeRunKey key;
+	int64_t ctx_start = MAX(0, p_start - SHAPE_RUN_CONTEXT_LENGTH);
+	int64_t ctx_end = MIN(p_sd->text.length(), p_end + SHAPE_RUN_CONTEXT_LENGTH);
+	key.text = p_sd->text.substr(ctx_start, ctx_end - ctx_start);
+	key.run_start = p_start - ctx_start;
+	key.run_end = p_end - ctx_start;
+	key.fonts = p_fonts;
+	key.font_size = span.font_size;
+	key.language = span.language.is_empty() ? TranslationServer::get_singleton()->get_tool_locale() : span.language;
+	key.features = span.features;
+	key.script = p_script;
+	key.direction = p_direction;
+	key.orientation = p_sd->orientation;
+	key.extra_spacing[0] = p_sd->extra_spacing[SPACING_SPACE];
+	key.extra_spacing[1] = p_sd->extra_spacing[SPACING_GLYPH];
+	key.preserve_invalid = p_sd->preserve_invalid;
+	key.preserve_control = p_sd->preserve_control;
+	key.last_run = (p_sd->end == p_end);
+
+	int64_t offset = p_sd->start + p_start;
+
+	ShapeRunData run;
+	bool found = false;
+	{
+		MutexLock lock(shape_run_cache_mutex);
+		HashMap<ShapeRunKey, ShapeRunData, ShapeRunKeyHasher>::Iterator E = shape_run_cache.find(key);
+		if (E) {
+			run = E->value;
+			found = true;
+
+			// Move to the most recently used end.
+			shape_run_cache.remove(E);
+			shape_run_cache.insert(key, run);
+		}
+	}
+
+	// Run metrics are collected separately and merged, so cached and freshly shaped runs produce identical results.
+	double ascent = p_sd->ascent;
+	double descent = p_sd->descent;
+	double width = p_sd->width;
+	double upos = p_sd->upos;
+	double uthk = p_sd->uthk;
+
+	if (found) {
+		for (const Glyph &F : run.glyphs) {
+			Glyph gl = F;
+			gl.start += offset;
+			gl.end += offset;
+			p_sd->glyphs.push_back(gl);
+		}
+	} else {
+		int glyph_from = p_sd->glyphs.size();
+		p_sd->ascent = 0.0;
+		p_sd->descent = 0.0;
+		p_sd->width = 0.0;
+		p_sd->upos = 0.0;
+		p_sd->uthk = 0.0;
+
+		_shape_run(p_sd, p_start, p_end, p_script, p_direction, p_fonts, p_span, 0, 0, 0, RID());
+
+		run.ascent = p_sd->ascent;
+		run.descent = p_sd->descent;
+		run.width = p_sd->width;
+		run.upos = p_sd->upos;
+		run.uthk = p_sd->uthk;
+		run.glyphs = p_sd->glyphs.slice(glyph_from);
+		Glyph *w = run.glyphs.ptrw();
+		for (int i = 0; i < run.glyphs.size(); i++) {
+			w[i].start -= offset;
+			w[i].end -= offset;
+		}
+
+		MutexLock lock(shape_run_cache_mutex);
+		shape_run_cache.insert(key, run);
+		while (shape_run_cache.size() > SHAPE_RUN_CACHE_SIZE) {
+			shape_run_cache.remove(shape_run_cache.begin());
+		}
+	}
+
+	p_sd->ascent = MAX(ascent, run.ascent);
+	p_sd->descent = MAX(descent, run.descent);
+	p_sd->width = width + run.width;
+	p_sd->upos = MAX(upos, run.upos);
+	p_sd->uthk = MAX(uthk, run.uthk);
+}
+
 bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
-	_THREAD_SAFE_METHOD_
+	// Buffers are only guarded by their own mutex, so independent buffers can be shaped on different threads.
+	// Their fonts are pinned instead of holding the server lock, see FontPins.
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
 
@@ -6328,6 +6658,7 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 		_shaped_text_shape(sd->parent);
 		ShapedTextDataAdvanced *parent_sd = shaped_owner.get_or_null(sd->parent);
 		ERR_FAIL_COND_V(!parent_sd->valid.is_set(), false);
+		FontPins pins(this, parent_sd);
 		ERR_FAIL_COND_V(!_shape_substr(sd, parent_sd, sd->start, sd->end - sd->start), false);
 		return true;
 	}
@@ -6337,6 +6668,8 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 		return true;
 	}
 
+	FontPins pins(this, sd);
+
 	sd->utf16 = sd->text.utf16();
 	const UChar *data = sd->utf16.get_data();
 
@@ -6517,7 +6850,7 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 							}
 							fonts.append_array(fonts_scr_only);
 							fonts.append_array(fonts_no_match);
-							_shape_run(sd, MAX(sd->spans[k].start - sd->start, script_run_start), MIN(sd->spans[k].end - sd->start, script_run_end), sd->script_iter->script_ranges[j].script, bidi_run_direction, fonts, k, 0, 0, 0, RID());
+							_shape_run_cached(sd, MAX(sd->spans[k].start - sd->start, script_run_start), MIN(sd->spans[k].end - sd->start, script_run_end), sd->script_iter->script_ranges[j].script, bidi_run_direction, fonts, k);
 						}
 					}
 				}
@@ -7504,7 +7837,12 @@ bool TextServerAdvanced::_is_valid_letter(uint64_t p_unicode) const {
 }
 
 void TextServerAdvanced::_update_settings() {
-	lcd_subpixel_layout.set((TextServer::FontLCDSubpixelLayout)(int)GLOBAL_GET("gui/theme/lcd_subpixel_layout"));
+	const TextServer::FontLCDSubpixelLayout layout = (TextServer::FontLCDSubpixelLayout)(int)GLOBAL_GET("gui/theme/lcd_subpixel_layout");
+	if (lcd_subpixel_layout.get() != layout) {
+		lcd_subpixel_layout.set(layout);
+		// Cached runs have the layout baked into their glyph indices.
+		_shape_run_cache_clear();
+	}
 }
 
 TextServerAdvanced::TextServerAdvanced() {
@@ -7524,6 +7862,7 @@ void TextServerAdvanced::_cleanup() {
 	}
 	system_fonts.clear();
 	system_font_data.clear();
+	_shape_run_cache_clear();
 }
 
 TextServerAdvanced::~TextServerAdvanced() {
@@ -117,6 +117,7 @@ using namespace godot;
 #include FT_ADVANCES_H
 #include FT_MULTIPLE_MASTERS_H
 #include FT_BBOX_H
+#include FT_BITMAP_H
 #include FT_MODULE_H
 #include FT_CONFIG_OPTIONS_H
 #if !defined(FT_CONFIG_OPTION_USE_BROTLI) && !defined(_MSC_VER)
@@ -302,6 +303,10 @@ class TextServerAdvanced : public TextServerExtension {
 		RID base_font;
 		int extra_spacing[4] = { 0, 0, 0, 0 };
 		double baseline_offset = 0.0;
+
+		// See FontPins, protected by pin_mutex.
+		uint32_t pins = 0;
+		bool freed = false;
 	};
 
 	struct FontAdvanced {
@@ -349,6 +354,10 @@ class TextServerAdvanced : public TextServerExtension {
 		size_t data_size;
 		int face_index = 0;
 
+		// See FontPins, protected by pin_mutex.
+		uint32_t pins = 0;
+		bool freed = false;
+
 		~FontAdvanced() {
 			for (const KeyValue<Vector2i, FontForSizeAdvanced *> &E : cache) {
 				memdelete(E.value);
@@ -364,7 +373,38 @@ class TextServerAdvanced : public TextServerExtension {
 #ifdef MODULE_FREETYPE_ENABLED
 	_FORCE_INLINE_ FontGlyph rasterize_bitmap(FontForSizeAdvanced *p_data, int p_rect_margin, FT_Bitmap p_bitmap, int p_yofs, int p_xofs, const Vector2 &p_advance, bool p_bgra) const;
 #endif
+#ifdef MODULE_FREETYPE_ENABLED
+	// Glyph bitmap rendered without touching the cache textures, packed later by the font owner.
+	struct RenderedGlyph {
+		int32_t glyph = 0;
+		bool rendered = false;
+		bool bgra = false;
+		FT_Bitmap bitmap = {};
+		int top = 0;
+		int left = 0;
+		Vector2 advance;
+	};
+
+	// Batch of glyphs rasterized in parallel, each worker uses its own copy of the size cache face.
+	struct GlyphRenderJob {
+		TextServerAdvanced *server = nullptr;
+		const FontAdvanced *font_data = nullptr;
+		const FontForSizeAdvanced *size_data = nullptr;
+		Vector<FT_Fixed> coords;
+		Vector<RenderedGlyph> glyphs;
+		SafeNumeric<uint32_t> next;
+	};
+
+	static const uint32_t GLYPHS_PER_RASTER_TASK = 32;
+
+	_FORCE_INLINE_ bool _load_glyph(const FontAdvanced *p_font_data, const FontForSizeAdvanced *p_data, FT_Face p_face, int32_t p_glyph, Vector2 &r_advance, FT_Render_Mode &r_aa_mode, bool &r_bgra) const;
+	bool _render_glyph_bitmap(const FontAdvanced *p_font_data, const FontForSizeAdvanced *p_data, FT_Face p_face, RenderedGlyph &r_glyph) const;
+	static void _render_glyph_queue(GlyphRenderJob *p_job, FT_Face p_face);
+	static void _render_glyphs_threaded(void *p_job, uint32_t p_index);
+#endif
+	void _render_glyphs(FontAdvanced *p_font_data, const Vector2i &p_size, const Vector<int32_t> &p_glyphs);
 	_FORCE_INLINE_ bool _ensure_glyph(FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_glyph, FontGlyph &r_glyph) const;
+	_FORCE_INLINE_ void _get_glyph_variants(const FontAdvanced *p_font_data, const Vector2i &p_size, int32_t p_index, Vector<int32_t> &r_glyphs) const;
 	_FORCE_INLINE_ bool _ensure_cache_for_size(FontAdvanced *p_font_data, const Vector2i &p_size, FontForSizeAdvanced *&r_cache_for_size) const;
 	_FORCE_INLINE_ void _font_clear_cache(FontAdvanced *p_font_data);
 	static void _generateMTSDF_threaded(void *p_td, uint32_t p_y);
@@ -550,9 +590,25 @@ class TextServerAdvanced : public TextServerExtension {
 	// Common data.
 
 	double oversampling = 1.0;
-	mutable RID_PtrOwner<FontAdvancedLinkedVariation> font_var_owner;
-	mutable RID_PtrOwner<FontAdvanced> font_owner;
-	mutable RID_PtrOwner<ShapedTextDataAdvanced> shaped_owner;
+	// Thread-safe, text buffers are shaped concurrently without holding the server lock.
+	mutable RID_PtrOwner<FontAdvancedLinkedVariation, true> font_var_owner;
+	mutable RID_PtrOwner<FontAdvanced, true> font_owner;
+	mutable RID_PtrOwner<ShapedTextDataAdvanced, true> shaped_owner;
+
+	// Keeps the fonts of a buffer alive while it's shaped without the server lock. Freeing
+	// a pinned font only frees its RID, the last pin deletes the data. Fonts are pinned with
+	// the buffer mutex held, so pins have their own lock instead of the server lock.
+	mutable Mutex pin_mutex;
+
+	class FontPins {
+		const TextServerAdvanced *server = nullptr;
+		Vector<FontAdvanced *> fonts;
+		Vector<FontAdvancedLinkedVariation *> variations;
+
+	public:
+		FontPins(const TextServerAdvanced *p_server, const ShapedTextDataAdvanced *p_sd);
+		~FontPins();
+	};
 
 	_FORCE_INLINE_ FontAdvanced *_get_font_data(const RID &p_font_rid) const {
 		RID rid = p_font_rid;
@@ -652,6 +708,65 @@ class TextServerAdvanced : public TextServerExtension {
 	mutable HashMap<SystemFontKey, SystemFontCache, SystemFontKeyHasher> system_fonts;
 	mutable HashMap<String, PackedByteArray> system_font_data;
 
+	// Shaped run cache, shared by all shaped text buffers. Reused runs skip HarfBuzz and font fallback entirely.
+
+	// Number of characters on each side of a run HarfBuzz uses as pre/post-context (HB_BUFFER_CONTEXT_LENGTH).
+	static const int SHAPE_RUN_CONTEXT_LENGTH = 5;
+	// Maximum number of cached runs, least recently used runs are evicted first.
+	static const int SHAPE_RUN_CACHE_SIZE = 8192;
+
+	struct ShapeRunKey {
+		String text; // Run text with surrounding context.
+		int run_start = 0; // Run range in the text.
+		int run_end = 0;
+		Array fonts;
+		int font_size = 0;
+		String language;
+		Dictionary features;
+		uint32_t script = 0;
+		int direction = 0;
+		int orientation = 0;
+		int extra_spacing[2] = { 0, 0 }; // Buffer space and glyph spacing.
+		bool preserve_invalid = true;
+		bool preserve_control = false;
+		bool last_run = false;
+
+		bool operator==(const ShapeRunKey &p_b) const {
+			return (run_start == p_b.run_start) && (run_end == p_b.run_end) && (font_size == p_b.font_size) && (script == p_b.script) && (direction == p_b.direction) && (orientation == p_b.orientation) && (extra_spacing[0] == p_b.extra_spacing[0]) && (extra_spacing[1] == p_b.extra_spacing[1]) && (preserve_invalid == p_b.preserve_invalid) && (preserve_control == p_b.preserve_control) && (last_run == p_b.last_run) && (text == p_b.text) && (language == p_b.language) && (fonts == p_b.fonts) && (features == p_b.features);
+		}
+	};
+
+	struct ShapeRunKeyHasher {
+		_FORCE_INLINE_ static uint32_t hash(const ShapeRunKey &p_a) {
+			uint32_t hash = p_a.text.hash();
+			hash = hash_murmur3_one_32(p_a.fonts.hash(), hash);
+			hash = hash_murmur3_one_32(p_a.language.hash(), hash);
+			hash = hash_murmur3_one_32(p_a.features.hash(), hash);
+			hash = hash_murmur3_one_32(p_a.run_start, hash);
+			hash = hash_murmur3_one_32(p_a.run_end, hash);
+			hash = hash_murmur3_one_32(p_a.font_size, hash);
+			hash = hash_murmur3_one_32(p_a.script, hash);
+			hash = hash_murmur3_one_32(p_a.extra_spacing[0], hash);
+			hash = hash_murmur3_one_32(p_a.extra_spacing[1], hash);
+			return hash_fmix32(hash_murmur3_one_32(p_a.direction | (p_a.orientation << 8) | ((int)p_a.preserve_invalid << 16) | ((int)p_a.preserve_control << 17) | ((int)p_a.last_run << 18), hash));
+		}
+	};
+
+	struct ShapeRunData {
+		Vector<Glyph> glyphs; // Glyph ranges are relative to the run start.
+		double ascent = 0.0;
+		double descent = 0.0;
+		double width = 0.0;
+		double upos = 0.0;
+		double uthk = 0.0;
+	};
+
+	// Insertion ordered, a reused run is moved to the back, eviction starts from the front.
+	HashMap<ShapeRunKey, ShapeRunData, ShapeRunKeyHasher> shape_run_cache;
+	Mutex shape_run_cache_mutex;
+
+	_FORCE_INLINE_ void _shape_run_cache_clear();
+
 	void _update_chars(ShapedTextDataAdvanced *p_sd) const;
 	void _realign(ShapedTextDataAdvanced *p_sd) const;
 	int64_t _convert_pos(const String &p_utf32, const Char16String &p_utf16, int64_t p_pos) const;
@@ -659,6 +774,7 @@ class TextServerAdvanced : public TextServerExtension {
 	int64_t _convert_pos_inv(const ShapedTextDataAdvanced *p_sd, int64_t p_pos) const;
 	bool _shape_substr(ShapedTextDataAdvanced *p_new_sd, const ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_length) const;
 	void _shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, hb_script_t p_script, hb_direction_t p_direction, TypedArray<RID> p_fonts, int64_t p_span, int64_t p_fb_index, int64_t p_prev_start, int64_t p_prev_end, RID p_prev_font);
+	void _shape_run_cached(ShapedTextDataAdvanced *p_sd, int64_t p_start, int64_t p_end, hb_script_t p_script, hb_direction_t p_direction, const TypedArray<RID> &p_fonts, int64_t p_span);
 	Glyph _shape_single_glyph(ShapedTextDataAdvanced *p_sd, char32_t p_char, hb_script_t p_script, hb_direction_t p_direction, const RID &p_font, int64_t p_font_size);
 	_FORCE_INLINE_ RID _find_sys_font_for_text(const RID &p_fdef, const String &p_script_code, const String &p_language, const String &p_text);
 
@@ -879,6 +995,7 @@ public:
 	MODBIND1RC(PackedInt32Array, font_get_supported_glyphs, const RID &);
 
 	MODBIND4(font_render_range, const RID &, const Vector2i &, int64_t, int64_t);
+	MODBIND3(font_render_string, const RID &, const Vector2i &, const String &);
 	MODBIND3(font_render_glyph, const RID &, const Vector2i &, int64_t);
 
 	MODBIND6C(font_draw_glyph, const RID &, const RID &, int64_t, const Vector2 &, int64_t, const Color &);
@@ -2606,6 +2606,17 @@ void TextServerFallback::_font_render_range(const RID &p_font_rid, const Vector2
 	}
 }
 
+void TextServerFallback::_font_render_string(const RID &p_font_rid, const Vector2i &p_size, const String &p_text) {
+	HashSet<char32_t> chars;
+	for (int i = 0; i < p_text.length(); i++) {
+		if (is_control(p_text[i]) || chars.has(p_text[i])) {
+			continue;
+		}
+		chars.insert(p_text[i]);
+		_font_render_range(p_font_rid, p_size, p_text[i], p_text[i]);
+	}
+}
+
 void TextServerFallback::_font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) {
 	FontFallback *fd = _get_font_data(p_font_rid);
 	ERR_FAIL_NULL(fd);
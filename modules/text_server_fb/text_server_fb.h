@@ -747,6 +747,7 @@ public:
 	MODBIND1RC(PackedInt32Array, font_get_supported_glyphs, const RID &);
 
 	MODBIND4(font_render_range, const RID &, const Vector2i &, int64_t, int64_t);
+	MODBIND3(font_render_string, const RID &, const Vector2i &, const String &);
 	MODBIND3(font_render_glyph, const RID &, const Vector2i &, int64_t);
 
 	MODBIND6C(font_draw_glyph, const RID &, const RID &, int64_t, const Vector2 &, int64_t, const Color &);
@@ -116,7 +116,7 @@ int AudioStreamPlaybackOggVorbis::_mix_internal(AudioFrame *p_buffer, int p_fram
 					loop_fade_remaining = 0;
 				}
 
-				seek(vorbis_stream->loop_offset);
+				_seek_decoder(vorbis_stream->loop_offset);
 				loops++;
 				// We still have buffer to fill, start from this element in the next iteration.
 				continue;
@@ -129,7 +129,7 @@ int AudioStreamPlaybackOggVorbis::_mix_internal(AudioFrame *p_buffer, int p_fram
 			if (use_loop && is_not_empty) {
 				//loop
 
-				seek(vorbis_stream->loop_offset);
+				_seek_decoder(vorbis_stream->loop_offset);
 				loops++;
 				// We still have buffer to fill, start from this element in the next iteration.
 
@@ -231,29 +231,45 @@ bool AudioStreamPlaybackOggVorbis::_alloc_vorbis() {
 
 void AudioStreamPlaybackOggVorbis::start(double p_from_pos) {
 	ERR_FAIL_COND(!ready);
+	_request_decoder(DECODER_REQUEST_START, p_from_pos);
+}
+
+void AudioStreamPlaybackOggVorbis::_decoder_start(double p_from_pos) {
 	loop_fade_remaining = FADE_SIZE;
 	active = true;
-	seek(p_from_pos);
+	_seek_decoder(p_from_pos);
 	loops = 0;
 	begin_resample();
 }
 
 void AudioStreamPlaybackOggVorbis::stop() {
+	_request_decoder(DECODER_REQUEST_STOP);
+}
+
+void AudioStreamPlaybackOggVorbis::_decoder_stop() {
 	active = false;
 }
 
 bool AudioStreamPlaybackOggVorbis::is_playing() const {
-	return active;
+	return active || _has_decoded_frames() || _has_decoder_requests();
 }
 
 int AudioStreamPlaybackOggVorbis::get_loop_count() const {
-	return loops;
+	return _is_decoding_ahead() ? _get_decoded_loop_count() : loops;
 }
 
 double AudioStreamPlaybackOggVorbis::get_playback_position() const {
+	return _is_decoding_ahead() ? _get_decoded_position() : _get_decoder_position();
+}
+
+double AudioStreamPlaybackOggVorbis::_get_decoder_position() const {
 	return double(frames_mixed) / (double)vorbis_data->get_sampling_rate();
 }
 
+int AudioStreamPlaybackOggVorbis::_get_decoder_loop_count() const {
+	return loops;
+}
+
 void AudioStreamPlaybackOggVorbis::tag_used_streams() {
 	vorbis_stream->tag_used(get_playback_position());
 }
@@ -278,6 +294,46 @@ Variant AudioStreamPlaybackOggVorbis::get_parameter(const StringName &p_name) co
 }
 
 void AudioStreamPlaybackOggVorbis::seek(double p_time) {
+	_request_decoder(DECODER_REQUEST_SEEK, p_time);
+}
+
+void AudioStreamPlaybackOggVorbis::_decoder_seek(double p_time) {
+	_seek_decoder(p_time);
+}
+
+bool AudioStreamPlaybackOggVorbis::skip(double p_time) {
+	return _request_decoder(DECODER_REQUEST_SKIP, p_time);
+}
+
+bool AudioStreamPlaybackOggVorbis::_decoder_skip(double p_position) {
+	double position = p_position;
+	if (!active) {
+		return false;
+	}
+
+	// Seeking past the end would restart from the beginning, so wrap around the loop like mix() does.
+	bool use_loop = looping_override ? looping : vorbis_stream->loop;
+	double loop_end = vorbis_stream->get_length();
+	if (use_loop && vorbis_stream->get_bpm() > 0 && vorbis_stream->get_beat_count() > 0) {
+		loop_end = vorbis_stream->get_beat_count() * 60.0 / vorbis_stream->get_bpm();
+	}
+	if (position >= loop_end) {
+		double loop_length = loop_end - vorbis_stream->loop_offset;
+		if (!use_loop || loop_length <= 0.0) {
+			active = false;
+			return false;
+		}
+		double loop_time = position - vorbis_stream->loop_offset;
+		loops += int(loop_time / loop_length);
+		position = vorbis_stream->loop_offset + Math::fmod(loop_time, loop_length);
+	}
+
+	loop_fade_remaining = FADE_SIZE;
+	_seek_decoder(position);
+	return true;
+}
+
+void AudioStreamPlaybackOggVorbis::_seek_decoder(double p_time) {
 	ERR_FAIL_COND(!ready);
 	ERR_FAIL_COND(vorbis_stream.is_null());
 	if (!active) {
@@ -393,6 +449,7 @@ void AudioStreamPlaybackOggVorbis::set_sample_playback(const Ref<AudioSamplePlay
 }
 
 AudioStreamPlaybackOggVorbis::~AudioStreamPlaybackOggVorbis() {
+	_disable_decode_ahead();
 	if (block_is_allocated) {
 		vorbis_block_clear(&block);
 	}
@@ -419,6 +476,7 @@ Ref<AudioStreamPlayback> AudioStreamOggVorbis::instantiate_playback() {
 	ovs->active = false;
 	ovs->loops = 0;
 	if (ovs->_alloc_vorbis()) {
+		ovs->_enable_decode_ahead();
 		return ovs;
 	}
 	// Failed to allocate data structures.
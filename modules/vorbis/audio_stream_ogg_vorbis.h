@@ -84,9 +84,17 @@ class AudioStreamPlaybackOggVorbis : public AudioStreamPlaybackResampled {
 	// Allocates vorbis data structures. Returns true upon success, false on failure.
 	bool _alloc_vorbis();
 
+	void _seek_decoder(double p_time);
+
 protected:
 	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) override;
 	virtual float get_stream_sampling_rate() override;
+	virtual double _get_decoder_position() const override;
+	virtual int _get_decoder_loop_count() const override;
+	virtual void _decoder_start(double p_from_pos) override;
+	virtual void _decoder_stop() override;
+	virtual void _decoder_seek(double p_time) override;
+	virtual bool _decoder_skip(double p_position) override;
 
 public:
 	virtual void start(double p_from_pos = 0.0) override;
@@ -97,6 +105,7 @@ public:
 
 	virtual double get_playback_position() const override;
 	virtual void seek(double p_time) override;
+	virtual bool skip(double p_time) override;
 
 	virtual void tag_used_streams() override;
 
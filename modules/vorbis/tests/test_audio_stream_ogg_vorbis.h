@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  test_audio_stream_ogg_vorbis.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_STREAM_OGG_VORBIS_H
+#define TEST_AUDIO_STREAM_OGG_VORBIS_H
+
+#include "../audio_stream_ogg_vorbis.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestAudioStreamOggVorbis {
+
+TEST_CASE("[Audio][AudioStreamOggVorbis] Skipping wraps around the loop") {
+	Ref<AudioStreamOggVorbis> stream = AudioStreamOggVorbis::load_from_file(TestUtils::get_data_path("audio/sine_440hz_1s.ogg"));
+	REQUIRE(stream.is_valid());
+	const double length = stream->get_length();
+	CHECK(length == doctest::Approx(1.0).epsilon(0.01));
+
+	stream->set_loop(true);
+	stream->set_loop_offset(0.25);
+	const double loop_length = length - 0.25;
+
+	Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+	playback->start();
+
+	CHECK(playback->skip(0.5));
+	CHECK(playback->get_playback_position() == doctest::Approx(0.5).epsilon(0.001));
+	CHECK(playback->get_loop_count() == 0);
+
+	CHECK_MESSAGE(playback->skip(0.6), "Skipping past the end should keep looping playbacks playing.");
+	CHECK_MESSAGE(playback->get_playback_position() == doctest::Approx(0.25 + Math::fmod(1.1 - 0.25, loop_length)).epsilon(0.001), "Skipping past the end should continue from the loop offset.");
+	CHECK(playback->get_loop_count() == 1);
+
+	const double position = playback->get_playback_position();
+	CHECK(playback->skip(3.0));
+	CHECK_MESSAGE(playback->get_playback_position() == doctest::Approx(0.25 + Math::fmod(position + 3.0 - 0.25, loop_length)).epsilon(0.001), "Skipping several loops should wrap as many times.");
+	CHECK(playback->get_loop_count() == 1 + int((position + 3.0 - 0.25) / loop_length));
+
+	AudioFrame buffer[256];
+	CHECK_MESSAGE(playback->mix(buffer, 1.0, 256) == 256, "Playback should resume after skipping.");
+}
+
+TEST_CASE("[Audio][AudioStreamOggVorbis] Skipping past the end stops playback") {
+	Ref<AudioStreamOggVorbis> stream = AudioStreamOggVorbis::load_from_file(TestUtils::get_data_path("audio/sine_440hz_1s.ogg"));
+	REQUIRE(stream.is_valid());
+	stream->set_loop(false);
+
+	Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+	playback->start();
+
+	CHECK(playback->skip(0.5));
+	CHECK_FALSE_MESSAGE(playback->skip(0.6), "Skipping past the end should not restart from the beginning.");
+	CHECK_FALSE(playback->is_playing());
+}
+
+} // namespace TestAudioStreamOggVorbis
+
+#endif // TEST_AUDIO_STREAM_OGG_VORBIS_H
@@ -35,6 +35,7 @@
 #include "scene/3d/skeleton_3d.h"
 #include "scene/resources/3d/concave_polygon_shape_3d.h"
 #include "scene/resources/3d/convex_polygon_shape_3d.h"
+#include "servers/rendering/storage/cpu_skinning.h"
 
 bool MeshInstance3D::_set(const StringName &p_name, const Variant &p_value) {
 	//this is not _too_ bad performance wise, really. it only arrives here if the property was not set anywhere else.
@@ -671,6 +672,83 @@ Ref<ArrayMesh> MeshInstance3D::bake_mesh_from_current_blend_shape_mix(Ref<ArrayM
 	return bake_mesh;
 }
 
+Ref<ArrayMesh> MeshInstance3D::bake_mesh_from_current_skeleton_pose(Ref<ArrayMesh> p_existing) {
+	Ref<ArrayMesh> source_mesh = get_mesh();
+	ERR_FAIL_NULL_V_MSG(source_mesh, Ref<ArrayMesh>(), "The source mesh must be a valid ArrayMesh.");
+
+	Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(get_node_or_null(skeleton_path));
+	ERR_FAIL_NULL_V_MSG(skeleton, Ref<ArrayMesh>(), "The skeleton path must point to a valid Skeleton3D.");
+	ERR_FAIL_COND_V_MSG(skin_ref.is_null() || skin_ref->get_skin().is_null(), Ref<ArrayMesh>(), "The mesh instance is not bound to its skeleton yet.");
+
+	Ref<ArrayMesh> bake_mesh;
+
+	if (p_existing.is_valid()) {
+		ERR_FAIL_COND_V_MSG(source_mesh == p_existing, Ref<ArrayMesh>(), "The source mesh can not be the same mesh as the existing mesh.");
+
+		bake_mesh = p_existing;
+	} else {
+		bake_mesh.instantiate();
+	}
+
+	// Build the same bone matrices the skeleton hands to the RenderingServer,
+	// so the result matches what is rendered.
+	Ref<Skin> skin = skin_ref->get_skin();
+	const int bind_count = skin->get_bind_count();
+	LocalVector<float> bones;
+	bones.resize(bind_count * CPUSkinning::BONE_STRIDE);
+
+	for (int i = 0; i < bind_count; i++) {
+		const StringName bind_name = skin->get_bind_name(i);
+		const int bone_index = bind_name != StringName() ? skeleton->find_bone(bind_name) : skin->get_bind_bone(i);
+
+		Transform3D bone_transform;
+		if (bone_index >= 0 && bone_index < skeleton->get_bone_count()) {
+			bone_transform = skeleton->get_bone_global_pose(bone_index) * skin->get_bind_pose(i);
+		}
+		CPUSkinning::store_bone_transform(bone_transform, bones.ptr() + i * CPUSkinning::BONE_STRIDE);
+	}
+
+	LocalVector<float> blend_weights;
+	for (int i = 0; i < source_mesh->get_blend_shape_count(); i++) {
+		blend_weights.push_back(get_blend_shape_value(i));
+	}
+
+	Mesh::BlendShapeMode blend_shape_mode = source_mesh->get_blend_shape_mode();
+	int mesh_surface_count = source_mesh->get_surface_count();
+
+	bake_mesh->clear_surfaces();
+	bake_mesh->set_blend_shape_mode(blend_shape_mode);
+
+	for (int surface_index = 0; surface_index < mesh_surface_count; surface_index++) {
+		Array mesh_arrays = source_mesh->surface_get_arrays(surface_index);
+
+		CPUSkinning::Surface surface;
+		ERR_CONTINUE(CPUSkinning::surface_from_arrays(mesh_arrays, source_mesh->surface_get_blend_shape_arrays(surface_index), surface) != OK);
+
+		CPUSkinning::Result result;
+		const float *weights = blend_weights.size() >= surface.blend_shape_count ? blend_weights.ptr() : nullptr;
+		CPUSkinning::evaluate(surface, weights, RS::BlendShapeMode(blend_shape_mode), bones.ptr(), bind_count, result);
+		ERR_CONTINUE(result.vertices.size() != surface.vertex_count * 3);
+
+		mesh_arrays[Mesh::ARRAY_VERTEX] = result.get_vertex_array();
+		if (surface.has_normals) {
+			mesh_arrays[Mesh::ARRAY_NORMAL] = result.get_normal_array();
+		}
+		if (surface.has_tangents) {
+			mesh_arrays[Mesh::ARRAY_TANGENT] = result.get_tangent_array(surface);
+		}
+
+		// The pose is baked into the vertices now, skinning them again would apply it twice.
+		mesh_arrays[Mesh::ARRAY_BONES] = Variant();
+		mesh_arrays[Mesh::ARRAY_WEIGHTS] = Variant();
+		uint64_t surface_format = source_mesh->surface_get_format(surface_index) & ~uint64_t(Mesh::ARRAY_FORMAT_BONES | Mesh::ARRAY_FORMAT_WEIGHTS | Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS);
+
+		bake_mesh->add_surface_from_arrays(source_mesh->surface_get_primitive_type(surface_index), mesh_arrays, Array(), Dictionary(), surface_format);
+	}
+
+	return bake_mesh;
+}
+
 void MeshInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_mesh", "mesh"), &MeshInstance3D::set_mesh);
 	ClassDB::bind_method(D_METHOD("get_mesh"), &MeshInstance3D::get_mesh);
@@ -700,6 +778,7 @@ void MeshInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_debug_tangents"), &MeshInstance3D::create_debug_tangents);
 
 	ClassDB::bind_method(D_METHOD("bake_mesh_from_current_blend_shape_mix", "existing"), &MeshInstance3D::bake_mesh_from_current_blend_shape_mix, DEFVAL(Ref<ArrayMesh>()));
+	ClassDB::bind_method(D_METHOD("bake_mesh_from_current_skeleton_pose", "existing"), &MeshInstance3D::bake_mesh_from_current_skeleton_pose, DEFVAL(Ref<ArrayMesh>()));
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_mesh", "get_mesh");
 	ADD_GROUP("Skeleton", "");
@@ -423,9 +423,9 @@ float RichTextLabel::_resize_line(ItemFrame *p_frame, int p_line, const Ref<Font
 	return _calculate_line_vertical_offset(l);
 }
 
-float RichTextLabel::_shape_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, float p_h, int *r_char_offset) {
-	ERR_FAIL_NULL_V(p_frame, p_h);
-	ERR_FAIL_COND_V(p_line < 0 || p_line >= (int)p_frame->lines.size(), p_h);
+void RichTextLabel::_build_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, int *r_char_offset) {
+	ERR_FAIL_NULL(p_frame);
+	ERR_FAIL_COND(p_line < 0 || p_line >= (int)p_frame->lines.size());
 
 	Line &l = p_frame->lines[p_line];
 	MutexLock lock(l.text_buf->get_mutex());
@@ -648,6 +648,16 @@ float RichTextLabel::_shape_line(ItemFrame *p_frame, int p_line, const Ref<Font>
 	l.text_buf->set_bidi_override(structured_text_parser(_find_stt(l.from), st_args, txt));
 
 	*r_char_offset = l.char_offset + l.char_count;
+}
+
+float RichTextLabel::_shape_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, float p_h, int *r_char_offset) {
+	ERR_FAIL_NULL_V(p_frame, p_h);
+	ERR_FAIL_COND_V(p_line < 0 || p_line >= (int)p_frame->lines.size(), p_h);
+
+	_build_line(p_frame, p_line, p_base_font, p_base_font_size, p_width, r_char_offset);
+
+	Line &l = p_frame->lines[p_line];
+	MutexLock lock(l.text_buf->get_mutex());
 
 	l.offset.y = p_h;
 	return _calculate_line_vertical_offset(l);
@@ -2773,6 +2783,36 @@ void RichTextLabel::_thread_function(void *p_userdata) {
 	callable_mp(this, &RichTextLabel::_thread_end).call_deferred();
 }
 
+void RichTextLabel::_shape_paragraphs(void *p_userdata) {
+	ParagraphBatch *batch = (ParagraphBatch *)p_userdata;
+	for (int i = batch->next.fetch_add(1); i < batch->to; i = batch->next.fetch_add(1)) {
+		if (stop_thread.load()) {
+			return;
+		}
+		Line &l = batch->frame->lines[i];
+		MutexLock lock(l.text_buf->get_mutex());
+		l.text_buf->get_size(); // Shapes the paragraph and breaks it into lines.
+	}
+}
+
+void RichTextLabel::_shape_paragraphs_parallel(ItemFrame *p_frame, int p_from, int p_to) {
+	ParagraphBatch batch;
+	batch.frame = p_frame;
+	batch.to = p_to;
+	batch.next.store(p_from);
+
+	// The calling thread takes paragraphs from the batch as well, helpers that start late find no work left.
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	int task_count = MIN(WorkerThreadPool::get_singleton()->get_thread_count(), p_to - p_from) - 1;
+	for (int i = 0; i < task_count; i++) {
+		tasks.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &RichTextLabel::_shape_paragraphs, &batch, true, vformat("RichTextLabelShapeParagraphs:%x", (int64_t)get_instance_id())));
+	}
+	_shape_paragraphs(&batch);
+	for (const WorkerThreadPool::TaskID &E : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E);
+	}
+}
+
 void RichTextLabel::_thread_end() {
 	set_physics_process_internal(false);
 	if (!scroll_visible) {
@@ -2988,19 +3028,48 @@ void RichTextLabel::_process_line_caches() {
 		}
 	}
 
+	// Paragraph content is collected in order, since character offsets and list prefixes depend on the preceding paragraphs,
+	// then the batch is shaped in parallel and laid out in order. Batches stay small until the visible area is filled,
+	// so it can be drawn while the rest of the text is processed.
+	float visible_bottom = old_scroll + text_rect.size.height;
+	int small_batch = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	int line_count = main->lines.size();
+
 	total_height = (fi == 0) ? 0 : _calculate_line_vertical_offset(main->lines[fi - 1]);
-	for (int i = fi; i < (int)main->lines.size(); i++) {
-		total_height = _shape_line(main, i, theme_cache.normal_font, theme_cache.normal_font_size, text_rect.get_size().width - scroll_w, total_height, &total_chars);
-		total_height = _update_scroll_exceeds(total_height, ctrl_height, text_rect.get_size().width, i, old_scroll, text_rect.size.height);
+	int i = fi;
+	while (i < line_count) {
+		int to = MIN(i + ((total_height < visible_bottom) ? small_batch : PARAGRAPH_BATCH_SIZE), line_count);
 
-		main->first_invalid_line.store(i);
-		main->first_resized_line.store(i);
-		main->first_invalid_font_line.store(i);
+		int width = text_rect.get_size().width - scroll_w;
+		for (int j = i; j < to; j++) {
+			_build_line(main, j, theme_cache.normal_font, theme_cache.normal_font_size, width, &total_chars);
+		}
+		_shape_paragraphs_parallel(main, i, to);
+		if (stop_thread.load()) {
+			return;
+		}
+
+		for (; i < to; i++) {
+			if (width != text_rect.get_size().width - scroll_w) {
+				// Scroll bar visibility changed while laying out the batch.
+				total_height = _resize_line(main, i, theme_cache.normal_font, theme_cache.normal_font_size, text_rect.get_size().width - scroll_w, total_height);
+			} else {
+				Line &l = main->lines[i];
+				MutexLock lock(l.text_buf->get_mutex());
+				l.offset.y = total_height;
+				total_height = _calculate_line_vertical_offset(l);
+			}
+			total_height = _update_scroll_exceeds(total_height, ctrl_height, text_rect.get_size().width, i, old_scroll, text_rect.size.height);
+
+			main->first_invalid_line.store(i);
+			main->first_resized_line.store(i);
+			main->first_invalid_font_line.store(i);
+		}
 
 		if (stop_thread.load()) {
 			return;
 		}
-		loaded.store(double(i) / double(main->lines.size()));
+		loaded.store(double(i) / double(line_count));
 	}
 
 	main->first_invalid_line.store(main->lines.size());
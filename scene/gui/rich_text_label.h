@@ -491,8 +491,19 @@ private:
 
 	void _invalidate_current_line(ItemFrame *p_frame);
 
+	// Paragraphs shaped per batch once the visible area is laid out.
+	static const int PARAGRAPH_BATCH_SIZE = 64;
+
+	struct ParagraphBatch {
+		ItemFrame *frame = nullptr;
+		int to = 0;
+		std::atomic<int> next;
+	};
+
 	void _thread_function(void *p_userdata);
 	void _thread_end();
+	void _shape_paragraphs(void *p_userdata);
+	void _shape_paragraphs_parallel(ItemFrame *p_frame, int p_from, int p_to);
 	void _stop_thread();
 	bool _validate_line_caches();
 	void _process_line_caches();
@@ -555,6 +566,7 @@ private:
 	bool _search_line(ItemFrame *p_frame, int p_line, const String &p_string, int p_char_idx, bool p_reverse_search);
 	bool _search_table(ItemTable *p_table, List<Item *>::Element *p_from, const String &p_string, bool p_reverse_search);
 
+	void _build_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, int *r_char_offset);
 	float _shape_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, float p_h, int *r_char_offset);
 	float _resize_line(ItemFrame *p_frame, int p_line, const Ref<Font> &p_base_font, int p_base_font_size, int p_width, float p_h);
 
@@ -106,6 +106,7 @@ void TextEdit::Text::set_draw_control_chars(bool p_enabled) {
 
 int TextEdit::Text::get_line_width(int p_line, int p_wrap_index) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
+	_ensure_shaped(p_line);
 	if (p_wrap_index != -1) {
 		return text[p_line].data_buf->get_line_width(p_wrap_index);
 	}
@@ -132,8 +133,17 @@ BitField<TextServer::LineBreakFlag> TextEdit::Text::get_brk_flags() const {
 	return brk_flags;
 }
 
+_FORCE_INLINE_ bool TextEdit::Text::_is_single_row(int p_line) const {
+	// Without wrapping, line layout is known without shaping it.
+	return text[p_line].dirty && !text[p_line].has_linebreaks && (width <= 0 || (!brk_flags.has_flag(TextServer::BREAK_WORD_BOUND) && !brk_flags.has_flag(TextServer::BREAK_GRAPHEME_BOUND)));
+}
+
 int TextEdit::Text::get_line_wrap_amount(int p_line) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
+	if (_is_single_row(p_line)) {
+		return 0;
+	}
+	_ensure_shaped(p_line);
 
 	return text[p_line].data_buf->get_line_count() - 1;
 }
@@ -141,6 +151,11 @@ int TextEdit::Text::get_line_wrap_amount(int p_line) const {
 Vector<Vector2i> TextEdit::Text::get_line_wrap_ranges(int p_line) const {
 	Vector<Vector2i> ret;
 	ERR_FAIL_INDEX_V(p_line, text.size(), ret);
+	if (_is_single_row(p_line)) {
+		ret.push_back(Vector2i(0, text[p_line].data.length()));
+		return ret;
+	}
+	_ensure_shaped(p_line);
 
 	for (int i = 0; i < text[p_line].data_buf->get_line_count(); i++) {
 		ret.push_back(text[p_line].data_buf->get_line_range(i));
@@ -150,6 +165,7 @@ Vector<Vector2i> TextEdit::Text::get_line_wrap_ranges(int p_line) const {
 
 const Ref<TextParagraph> TextEdit::Text::get_line_data(int p_line) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), Ref<TextParagraph>());
+	_ensure_shaped(p_line);
 	return text[p_line].data_buf;
 }
 
@@ -157,7 +173,7 @@ _FORCE_INLINE_ const String &TextEdit::Text::operator[](int p_line) const {
 	return text[p_line].data;
 }
 
-void TextEdit::Text::_calculate_line_height() {
+void TextEdit::Text::_calculate_line_height() const {
 	int height = 0;
 	for (const Line &l : text) {
 		// Found another line with the same height...nothing to update.
@@ -170,7 +186,7 @@ void TextEdit::Text::_calculate_line_height() {
 	line_height = height;
 }
 
-void TextEdit::Text::_calculate_max_line_width() {
+void TextEdit::Text::_calculate_max_line_width() const {
 	int line_width = 0;
 	for (const Line &l : text) {
 		if (l.hidden) {
@@ -187,16 +203,23 @@ void TextEdit::Text::_calculate_max_line_width() {
 	max_width = line_width;
 }
 
-void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override) {
-	ERR_FAIL_INDEX(p_line, text.size());
+void TextEdit::Text::_shape_line(int p_line, const String &p_ime_text, const Array &p_bidi_override) const {
+	if (text[p_line].data_buf.is_null()) {
+		text.write[p_line].data_buf.instantiate();
+		text.write[p_line].text_changed = true;
+		shaped_count++;
+	}
 
 	if (font.is_null()) {
 		return; // Not in tree?
 	}
 
-	if (p_text_changed) {
+	const bool text_changed = text[p_line].text_changed;
+	if (text_changed) {
 		text.write[p_line].data_buf->clear();
 	}
+	text.write[p_line].dirty = false;
+	text.write[p_line].text_changed = false;
 
 	BitField<TextServer::LineBreakFlag> flags = brk_flags;
 	if (indent_wrapped_lines) {
@@ -210,14 +233,14 @@ void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_chan
 	text.write[p_line].data_buf->set_custom_punctuation(get_enabled_word_separators());
 
 	if (p_ime_text.length() > 0) {
-		if (p_text_changed) {
+		if (text_changed) {
 			text.write[p_line].data_buf->add_string(p_ime_text, font, font_size, language);
 		}
 		if (!p_bidi_override.is_empty()) {
 			TS->shaped_text_set_bidi_override(text.write[p_line].data_buf->get_rid(), p_bidi_override);
 		}
 	} else {
-		if (p_text_changed) {
+		if (text_changed) {
 			text.write[p_line].data_buf->add_string(text[p_line].data, font, font_size, language);
 		}
 		if (!text[p_line].bidi_override.is_empty()) {
@@ -225,7 +248,7 @@ void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_chan
 		}
 	}
 
-	if (!p_text_changed) {
+	if (!text_changed) {
 		RID r = text.write[p_line].data_buf->get_rid();
 		int spans = TS->shaped_get_span_count(r);
 		for (int i = 0; i < spans; i++) {
@@ -264,13 +287,48 @@ void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_chan
 	// If this line has shrunk, this may no longer the longest line.
 	if (old_width == max_width && line_width < max_width) {
 		_calculate_max_line_width();
-	} else if (!is_hidden(p_line)) {
+	} else if (!text[p_line].hidden) {
 		max_width = MAX(line_width, max_width);
 	}
 }
 
+void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override) {
+	ERR_FAIL_INDEX(p_line, text.size());
+
+	Line &line = text.write[p_line];
+	if (p_text_changed) {
+		line.has_linebreaks = false;
+		for (int i = 0; i < line.data.length(); i++) {
+			if (is_linebreak(line.data[i])) {
+				line.has_linebreaks = true;
+				break;
+			}
+		}
+	}
+
+	if (font.is_null()) {
+		return; // Not in tree?
+	}
+
+	line.text_changed = line.text_changed || p_text_changed;
+	line.dirty = true;
+	if (line.data_buf.is_null()) {
+		// Never shaped, assume the default height until it is.
+		line.height = font_height;
+		line_height = MAX(font_height, line_height);
+	}
+
+	if (p_ime_text.length() > 0) {
+		// IME preview is not stored in the line, shape it right away.
+		_shape_line(p_line, p_ime_text, p_bidi_override);
+	}
+}
+
 void TextEdit::Text::invalidate_all_lines() {
 	for (int i = 0; i < text.size(); i++) {
+		if (text[i].dirty) {
+			continue; // Picks up the new settings when shaped.
+		}
 		BitField<TextServer::LineBreakFlag> flags = brk_flags;
 		if (indent_wrapped_lines) {
 			flags.set_flag(TextServer::BREAK_TRIM_INDENT);
@@ -335,6 +393,7 @@ void TextEdit::Text::clear() {
 
 	max_width = -1;
 	line_height = -1;
+	shaped_count = 0;
 
 	Line line;
 	line.gutters.resize(gutter_count);
@@ -402,6 +461,12 @@ void TextEdit::Text::remove_range(int p_from_line, int p_to_line) {
 		}
 	}
 
+	for (int i = p_from_line + 1; i <= p_to_line; i++) {
+		if (text[i].data_buf.is_valid()) {
+			shaped_count--;
+		}
+	}
+
 	int diff = (p_to_line - p_from_line);
 	for (int i = p_to_line; i < text.size() - 1; i++) {
 		text.write[(i - diff) + 1] = text[i + 1];
@@ -419,6 +484,22 @@ void TextEdit::Text::remove_range(int p_from_line, int p_to_line) {
 	}
 }
 
+void TextEdit::Text::free_shaped_lines(int p_keep_from, int p_keep_to) {
+	for (int i = 0; i < text.size() && shaped_count > 0; i++) {
+		if ((i >= p_keep_from && i <= p_keep_to) || text[i].has_linebreaks) {
+			continue;
+		}
+		Line &line = text.write[i];
+		if (line.data_buf.is_valid()) {
+			// Keep the measured size, the line is shaped again when accessed.
+			line.data_buf.unref();
+			line.dirty = true;
+			line.text_changed = true;
+			shaped_count--;
+		}
+	}
+}
+
 void TextEdit::Text::add_gutter(int p_at) {
 	for (int i = 0; i < text.size(); i++) {
 		if (p_at < 0 || p_at > gutter_count) {
@@ -575,6 +656,10 @@ void TextEdit::_notification(int p_what) {
 			}
 		} break;
 
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_prefetch_lines();
+		} break;
+
 		case NOTIFICATION_DRAW: {
 			if (first_draw) {
 				// Size may not be the final one, so attempts to ensure caret was visible may have failed.
@@ -596,6 +681,7 @@ void TextEdit::_notification(int p_what) {
 			}
 
 			_update_scrollbars();
+			int text_max_width = text.get_max_width();
 
 			RID ci = get_canvas_item();
 			int xmargin_beg = theme_cache.style_normal->get_margin(SIDE_LEFT) + gutters_width + gutter_padding;
@@ -1563,6 +1649,14 @@ void TextEdit::_notification(int p_what) {
 				}
 			}
 
+			if (!draw_placeholder) {
+				// Lines shaped for the first time may be wider than the ones measured so far.
+				if (text.get_max_width() != text_max_width) {
+					callable_mp(this, &TextEdit::_update_scrollbars).call_deferred();
+				}
+				_queue_line_prefetch(first_vis_line - visible_rows, line + visible_rows);
+			}
+
 			if (has_focus()) {
 				_update_ime_window_position();
 			}
@@ -8161,6 +8255,49 @@ Dictionary TextEdit::_get_line_syntax_highlighting(int p_line) {
 	return (syntax_highlighter.is_null() || setting_text) ? Dictionary() : syntax_highlighter->get_line_syntax_highlighting(p_line);
 }
 
+void TextEdit::_queue_line_prefetch(int p_from, int p_to) {
+	p_from = MAX(0, p_from);
+	p_to = MIN(text.size() - 1, p_to);
+	// Rescan a finished window too, edits may have invalidated lines in the margin.
+	if (p_from != prefetch_from || p_to != prefetch_to || prefetch_next > prefetch_to) {
+		prefetch_next = p_from;
+	}
+
+	prefetch_from = p_from;
+	prefetch_to = p_to;
+	set_process_internal(prefetch_from <= prefetch_to);
+}
+
+void TextEdit::_prefetch_lines() {
+	prefetch_to = MIN(text.size() - 1, prefetch_to);
+
+	int text_max_width = text.get_max_width();
+	int processed = 0;
+	while (prefetch_next <= prefetch_to && processed < PREFETCH_LINES_PER_FRAME) {
+		int line = prefetch_next++;
+		if (text.is_shaped(line) || _is_line_hidden(line)) {
+			continue;
+		}
+		text.shape(line);
+		_get_line_syntax_highlighting(line);
+		processed++;
+	}
+
+	if (prefetch_next <= prefetch_to) {
+		return;
+	}
+	set_process_internal(false);
+
+	// Without wrapping only the cached widths are needed to scroll, so buffers far from the viewport can be dropped.
+	if (get_line_wrapping_mode() == LineWrappingMode::LINE_WRAPPING_NONE && text.get_shaped_count() > MAX_SHAPED_LINES) {
+		text.free_shaped_lines(prefetch_from, prefetch_to);
+	}
+
+	if (text.get_max_width() != text_max_width) {
+		_update_scrollbars();
+	}
+}
+
 /* Deprecated. */
 #ifndef DISABLE_DEPRECATED
 Vector<int> TextEdit::get_caret_index_edit_order() {
@@ -40,6 +40,7 @@
 
 class TextEdit : public Control {
 	GDCLASS(TextEdit, Control);
+	friend class TestTextEditInternalsAccessor;
 
 public:
 	/* Edit Actions. */
@@ -149,16 +150,15 @@ private:
 
 			String data;
 			Array bidi_override;
-			Ref<TextParagraph> data_buf;
+			Ref<TextParagraph> data_buf; // Created when the line is first shaped.
 
 			Color background_color = Color(0, 0, 0, 0);
 			bool hidden = false;
+			bool has_linebreaks = false; // Line is split by mandatory breaks even if wrapping is disabled.
+			bool dirty = true; // Shaping is deferred until the line is accessed.
+			bool text_changed = true;
 			int height = 0;
 			int width = 0;
-
-			Line() {
-				data_buf.instantiate();
-			}
 		};
 
 	private:
@@ -178,16 +178,26 @@ private:
 		bool use_default_word_separators = true;
 		bool use_custom_word_separators = false;
 
-		int line_height = -1;
-		int max_width = -1;
+		mutable int line_height = -1;
+		mutable int max_width = -1;
 		int width = -1;
 
 		int tab_size = 4;
 		int gutter_count = 0;
 		bool indent_wrapped_lines = false;
 
-		void _calculate_line_height();
-		void _calculate_max_line_width();
+		mutable int shaped_count = 0;
+
+		void _calculate_line_height() const;
+		void _calculate_max_line_width() const;
+
+		void _shape_line(int p_line, const String &p_ime_text = String(), const Array &p_bidi_override = Array()) const;
+		_FORCE_INLINE_ void _ensure_shaped(int p_line) const {
+			if (text[p_line].dirty) {
+				_shape_line(p_line);
+			}
+		}
+		_FORCE_INLINE_ bool _is_single_row(int p_line) const;
 
 	public:
 		void set_tab_size(int p_tab_size);
@@ -248,6 +258,12 @@ private:
 		void invalidate_all();
 		void invalidate_all_lines();
 
+		bool is_shaped(int p_line) const { return !text[p_line].dirty; }
+		void shape(int p_line) const { _ensure_shaped(p_line); }
+		int get_shaped_count() const { return shaped_count; }
+		// Only valid while wrapping is disabled, as wrapped rows are needed for scrolling.
+		void free_shaped_lines(int p_keep_from, int p_keep_to);
+
 		_FORCE_INLINE_ const String &operator[](int p_line) const;
 
 		/* Gutters. */
@@ -571,6 +587,19 @@ private:
 
 	Dictionary _get_line_syntax_highlighting(int p_line);
 
+	/* Line prefetch. */
+	// Lines around the viewport are shaped and highlighted a batch per frame,
+	// so scrolling does not stall on them.
+	const int PREFETCH_LINES_PER_FRAME = 32;
+	const int MAX_SHAPED_LINES = 4096;
+
+	int prefetch_from = 0;
+	int prefetch_to = -1;
+	int prefetch_next = 0;
+
+	void _queue_line_prefetch(int p_from, int p_to);
+	void _prefetch_lines();
+
 	/* Visual. */
 	struct ThemeCache {
 		float base_scale = 1.0;
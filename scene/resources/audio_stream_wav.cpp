@@ -86,6 +86,93 @@ void AudioStreamPlaybackWAV::seek(double p_time) {
 	offset = uint64_t(p_time * base->mix_rate) << MIX_FRAC_BITS;
 }
 
+bool AudioStreamPlaybackWAV::skip(double p_time) {
+	if (!base->data || !active) {
+		return false;
+	}
+	if (base->format == AudioStreamWAV::FORMAT_IMA_ADPCM) {
+		return true; // No seeking in IMA-ADPCM, resume where it was.
+	}
+
+	// Moves the offset the same way mix() does, without resampling anything.
+	int64_t loop_begin_fp = ((int64_t)base->loop_begin << MIX_FRAC_BITS);
+	int64_t loop_end_fp = ((int64_t)base->loop_end << MIX_FRAC_BITS);
+	int64_t loop_length_fp = loop_end_fp - loop_begin_fp;
+	int64_t length_fp = ((int64_t)_get_frame_count() << MIX_FRAC_BITS);
+	int64_t distance = int64_t(p_time * base->mix_rate * MIX_FRAC_LEN);
+
+	if (base->loop_mode == AudioStreamWAV::LOOP_DISABLED || loop_length_fp <= 0) {
+		offset += distance * sign;
+		if (offset < 0 || offset >= length_fp) {
+			active = false;
+			return false;
+		}
+		return true;
+	}
+
+	if (base->loop_mode == AudioStreamWAV::LOOP_BACKWARD) {
+		sign = -1;
+	}
+
+	if (sign > 0) {
+		offset += distance;
+		if (offset >= loop_end_fp) {
+			int64_t excess = offset - loop_end_fp;
+			if (base->loop_mode == AudioStreamWAV::LOOP_PINGPONG) {
+				excess %= loop_length_fp * 2;
+				if (excess < loop_length_fp) {
+					offset = loop_end_fp - excess;
+					sign = -1;
+				} else {
+					offset = loop_begin_fp + (excess - loop_length_fp);
+				}
+			} else {
+				offset = loop_begin_fp + excess % loop_length_fp;
+			}
+		}
+	} else {
+		offset -= distance;
+		if (offset < loop_begin_fp) {
+			int64_t excess = loop_begin_fp - offset;
+			if (base->loop_mode == AudioStreamWAV::LOOP_PINGPONG) {
+				excess %= loop_length_fp * 2;
+				if (excess < loop_length_fp) {
+					offset = loop_begin_fp + excess;
+					sign = 1;
+				} else {
+					offset = loop_end_fp - (excess - loop_length_fp);
+				}
+			} else {
+				offset = loop_end_fp - excess % loop_length_fp;
+			}
+		}
+	}
+	return true;
+}
+
+int AudioStreamPlaybackWAV::_get_frame_count() const {
+	int len = base->data_bytes;
+	switch (base->format) {
+		case AudioStreamWAV::FORMAT_8_BITS:
+			len /= 1;
+			break;
+		case AudioStreamWAV::FORMAT_16_BITS:
+			len /= 2;
+			break;
+		case AudioStreamWAV::FORMAT_IMA_ADPCM:
+			len *= 2;
+			break;
+		case AudioStreamWAV::FORMAT_QOA:
+			len = qoa.desc.samples * qoa.desc.channels;
+			break;
+	}
+
+	if (base->stereo) {
+		len /= 2;
+	}
+	return len;
+}
+
 template <typename Depth, bool is_stereo, bool is_ima_adpcm, bool is_qoa>
 void AudioStreamPlaybackWAV::do_resample(const Depth *p_src, AudioFrame *p_dst, int64_t &p_offset, int32_t &p_increment, uint32_t p_amount, IMA_ADPCM_State *p_ima_adpcm, QOA_State *p_qoa) {
 	// this function will be compiled branchless by any decent compiler
@@ -274,25 +361,7 @@ int AudioStreamPlaybackWAV::mix(AudioFrame *p_buffer, float p_rate_scale, int p_
 		return 0;
 	}
 
-	int len = base->data_bytes;
-	switch (base->format) {
-		case AudioStreamWAV::FORMAT_8_BITS:
-			len /= 1;
-			break;
-		case AudioStreamWAV::FORMAT_16_BITS:
-			len /= 2;
-			break;
-		case AudioStreamWAV::FORMAT_IMA_ADPCM:
-			len *= 2;
-			break;
-		case AudioStreamWAV::FORMAT_QOA:
-			len = qoa.desc.samples * qoa.desc.channels;
-			break;
-	}
-
-	if (base->stereo) {
-		len /= 2;
-	}
+	int len = _get_frame_count();
 
 	/* some 64-bit fixed point precaches */
 
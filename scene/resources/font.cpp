@@ -31,6 +31,7 @@
 #include "font.h"
 #include "font.compat.inc"
 
+#include "core/config/project_settings.h"
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/string/translation.h"
@@ -889,6 +890,9 @@ void FontFile::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_bitmap_font", "path"), &FontFile::load_bitmap_font);
 	ClassDB::bind_method(D_METHOD("load_dynamic_font", "path"), &FontFile::load_dynamic_font);
 
+	ClassDB::bind_method(D_METHOD("save_glyph_cache", "path"), &FontFile::save_glyph_cache);
+	ClassDB::bind_method(D_METHOD("load_glyph_cache", "path"), &FontFile::load_glyph_cache);
+
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &FontFile::set_data);
 	ClassDB::bind_method(D_METHOD("get_data"), &FontFile::get_data);
 
@@ -1015,6 +1019,7 @@ void FontFile::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_kerning", "cache_index", "size", "glyph_pair"), &FontFile::get_kerning);
 
 	ClassDB::bind_method(D_METHOD("render_range", "cache_index", "size", "start", "end"), &FontFile::render_range);
+	ClassDB::bind_method(D_METHOD("render_string", "cache_index", "size", "text"), &FontFile::render_string);
 	ClassDB::bind_method(D_METHOD("render_glyph", "cache_index", "size", "index"), &FontFile::render_glyph);
 
 	ClassDB::bind_method(D_METHOD("set_language_support_override", "language", "supported"), &FontFile::set_language_support_override);
@@ -2058,6 +2063,177 @@ Error FontFile::load_dynamic_font(const String &p_path) {
 	return OK;
 }
 
+uint32_t FontFile::_get_glyph_cache_hash() const {
+	// Everything that changes rasterized glyph images or their placement in the cache textures.
+	uint32_t hash = hash_murmur3_buffer(data_ptr, data_size);
+	hash = hash_murmur3_one_32(TS->get_name().hash(), hash);
+	hash = hash_murmur3_one_32(antialiasing, hash);
+	if (antialiasing == TextServer::FONT_ANTIALIASING_LCD) {
+		// Set on the text server from the project setting, and only used for LCD antialiasing.
+		hash = hash_murmur3_one_32((int)GLOBAL_GET("gui/theme/lcd_subpixel_layout"), hash);
+	}
+	hash = hash_murmur3_one_32(mipmaps, hash);
+	hash = hash_murmur3_one_32(disable_embedded_bitmaps, hash);
+	hash = hash_murmur3_one_32(msdf, hash);
+	hash = hash_murmur3_one_32(msdf_pixel_range, hash);
+	hash = hash_murmur3_one_32(msdf_size, hash);
+	hash = hash_murmur3_one_32(fixed_size, hash);
+	hash = hash_murmur3_one_32(force_autohinter, hash);
+	hash = hash_murmur3_one_32(hinting, hash);
+	hash = hash_murmur3_one_32(subpixel_positioning, hash);
+	hash = hash_murmur3_one_real(oversampling > 0.0 ? oversampling : TS->font_get_global_oversampling(), hash);
+	return hash_fmix32(hash);
+}
+
+Error FontFile::save_glyph_cache(const String &p_path) const {
+	ERR_FAIL_COND_V_MSG(data_size == 0, ERR_UNCONFIGURED, "Glyph cache can only be saved for dynamic fonts.");
+
+	// Store cache variation settings, and rendered glyphs with their textures, using the same keys as resource properties.
+	Dictionary entries;
+	List<PropertyInfo> plist;
+	_get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		Vector<String> tokens = E.name.split("/");
+		if (tokens.size() < 3 || tokens[0] != "cache") {
+			continue;
+		}
+		if (tokens.size() >= 5 && tokens[4] != "textures" && tokens[4] != "glyphs") {
+			continue;
+		}
+		Variant value;
+		_get(E.name, value);
+		Ref<Image> image = value;
+		if (image.is_valid()) {
+			Dictionary d;
+			d["width"] = image->get_width();
+			d["height"] = image->get_height();
+			d["mipmaps"] = image->has_mipmaps();
+			d["format"] = image->get_format();
+			d["data"] = image->get_data();
+			value = d;
+		}
+		entries[E.name] = value;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot write glyph cache to \"%s\".", p_path));
+	f->store_32(GLYPH_CACHE_MAGIC);
+	f->store_32(GLYPH_CACHE_VERSION);
+	f->store_32(_get_glyph_cache_hash());
+	f->store_var(entries);
+
+	return OK;
+}
+
+static bool _is_glyph_cache_key_valid(const Variant &p_key) {
+	if (p_key.get_type() != Variant::STRING) {
+		return false;
+	}
+	Vector<String> tokens = String(p_key).split("/");
+	if (tokens.size() < 3 || tokens[0] != "cache" || !tokens[1].is_valid_int() || tokens[1].to_int() < 0) {
+		return false;
+	}
+	return tokens.size() < 7 || (tokens[2].is_valid_int() && tokens[3].is_valid_int());
+}
+
+static bool _is_glyph_cache_image_valid(const Variant &p_value) {
+	if (p_value.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+	const Dictionary d = p_value;
+	const Variant width = d.get("width", Variant());
+	const Variant height = d.get("height", Variant());
+	const Variant mipmaps = d.get("mipmaps", Variant());
+	const Variant format = d.get("format", Variant());
+	const Variant data = d.get("data", Variant());
+	if (width.get_type() != Variant::INT || height.get_type() != Variant::INT || mipmaps.get_type() != Variant::BOOL || format.get_type() != Variant::INT || data.get_type() != Variant::PACKED_BYTE_ARRAY) {
+		return false;
+	}
+	if ((int64_t)width <= 0 || (int64_t)width > Image::MAX_WIDTH || (int64_t)height <= 0 || (int64_t)height > Image::MAX_HEIGHT || (int64_t)format < 0 || (int64_t)format >= Image::FORMAT_MAX) {
+		return false;
+	}
+	return PackedByteArray(data).size() == Image::get_image_data_size(width, height, (Image::Format)(int)format, mipmaps);
+}
+
+Error FontFile::load_glyph_cache(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(data_size == 0, ERR_UNCONFIGURED, "Glyph cache can only be loaded for dynamic fonts.");
+
+	// Missing or outdated cache is expected (first run, font or import settings changed), fail silently.
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	if (f->get_32() != GLYPH_CACHE_MAGIC || f->get_32() != GLYPH_CACHE_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (f->get_32() != _get_glyph_cache_hash()) {
+		return ERR_INVALID_DATA;
+	}
+	const Variant stored = f->get_var();
+	ERR_FAIL_COND_V_MSG(stored.get_type() != Variant::DICTIONARY, ERR_FILE_CORRUPT, vformat("Glyph cache \"%s\" is corrupt.", p_path));
+	Dictionary entries = stored;
+
+	// Everything is checked before the font is changed, so a damaged file leaves it as it was.
+	Array keys = entries.keys();
+	HashSet<int> stored_indices;
+	for (int i = 0; i < keys.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!_is_glyph_cache_key_valid(keys[i]), ERR_FILE_CORRUPT, vformat("Glyph cache \"%s\" is corrupt.", p_path));
+		Vector<String> tokens = String(keys[i]).split("/");
+		if (tokens[tokens.size() - 1] == "image") {
+			ERR_FAIL_COND_V_MSG(!_is_glyph_cache_image_valid(entries[keys[i]]), ERR_FILE_CORRUPT, vformat("Glyph cache \"%s\" is corrupt.", p_path));
+		}
+		stored_indices.insert(tokens[1].to_int());
+	}
+
+	// Cache variations that already exist are only updated if their settings match the stored ones.
+	HashSet<int> skipped;
+	for (int i = 0; i < keys.size(); i++) {
+		Vector<String> tokens = String(keys[i]).split("/");
+		if (tokens.size() != 3) {
+			continue;
+		}
+		int cache_index = tokens[1].to_int();
+		if (cache_index < cache.size()) {
+			Variant value;
+			_get(keys[i], value);
+			if (value != entries[keys[i]]) {
+				skipped.insert(cache_index);
+			}
+		}
+	}
+	if (!stored_indices.is_empty() && skipped.size() == stored_indices.size()) {
+		return ERR_INVALID_DATA;
+	}
+
+	// Glyph placement is only valid for the stored textures as a whole, drop glyphs rendered so far.
+	HashSet<String> cleared;
+	for (int i = 0; i < keys.size(); i++) {
+		Vector<String> tokens = String(keys[i]).split("/");
+		const Variant &value = entries[keys[i]];
+		int cache_index = tokens[1].to_int();
+		if (skipped.has(cache_index)) {
+			continue;
+		}
+		if (tokens.size() == 7) {
+			String prefix = tokens[1] + "/" + tokens[2] + "/" + tokens[3];
+			if (!cleared.has(prefix)) {
+				Vector2i sz = Vector2i(tokens[2].to_int(), tokens[3].to_int());
+				clear_textures(cache_index, sz);
+				clear_glyphs(cache_index, sz);
+				cleared.insert(prefix);
+			}
+		}
+		if (tokens[tokens.size() - 1] == "image") {
+			Dictionary d = value;
+			_set(keys[i], Image::create_from_data(d["width"], d["height"], d["mipmaps"], (Image::Format)(int)d["format"], d["data"]));
+		} else {
+			_set(keys[i], value);
+		}
+	}
+
+	return OK;
+}
+
 void FontFile::set_data_ptr(const uint8_t *p_data, size_t p_size) {
 	data.clear();
 	data_ptr = p_data;
@@ -2720,6 +2896,12 @@ void FontFile::render_range(int p_cache_index, const Vector2i &p_size, char32_t
 	TS->font_render_range(cache[p_cache_index], p_size, p_start, p_end);
 }
 
+void FontFile::render_string(int p_cache_index, const Vector2i &p_size, const String &p_text) {
+	ERR_FAIL_COND(p_cache_index < 0);
+	_ensure_rid(p_cache_index);
+	TS->font_render_string(cache[p_cache_index], p_size, p_text);
+}
+
 void FontFile::render_glyph(int p_cache_index, const Vector2i &p_size, int32_t p_index) {
 	ERR_FAIL_COND(p_cache_index < 0);
 	_ensure_rid(p_cache_index);
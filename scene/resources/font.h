@@ -210,6 +210,12 @@ class FontFile : public Font {
 	_FORCE_INLINE_ void _clear_cache();
 	_FORCE_INLINE_ void _ensure_rid(int p_cache_index, int p_make_linked_from = -1) const;
 
+	// Persistent glyph cache.
+	static const uint32_t GLYPH_CACHE_MAGIC = 0x43474647; // "GFGC"
+	static const uint32_t GLYPH_CACHE_VERSION = 1;
+
+	uint32_t _get_glyph_cache_hash() const;
+
 	void _convert_packed_8bit(Ref<Image> &p_source, int p_page, int p_sz);
 	void _convert_packed_4bit(Ref<Image> &p_source, int p_page, int p_sz);
 	void _convert_rgba_4bit(Ref<Image> &p_source, int p_page, int p_sz);
@@ -232,6 +238,9 @@ public:
 	Error load_bitmap_font(const String &p_path);
 	Error load_dynamic_font(const String &p_path);
 
+	Error save_glyph_cache(const String &p_path) const;
+	Error load_glyph_cache(const String &p_path);
+
 	// Font source data.
 	virtual void set_data_ptr(const uint8_t *p_data, size_t p_size);
 	virtual void set_data(const PackedByteArray &p_data);
@@ -365,6 +374,7 @@ public:
 	virtual Vector2 get_kerning(int p_cache_index, int p_size, const Vector2i &p_glyph_pair) const;
 
 	virtual void render_range(int p_cache_index, const Vector2i &p_size, char32_t p_start, char32_t p_end);
+	virtual void render_string(int p_cache_index, const Vector2i &p_size, const String &p_text);
 	virtual void render_glyph(int p_cache_index, const Vector2i &p_size, int32_t p_index);
 
 	// Language/script support override.
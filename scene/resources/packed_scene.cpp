@@ -125,6 +125,23 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 }
 
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && use_instantiation_plans && !Engine::get_singleton()->is_editor_hint()) {
+		bool plan_ready;
+		{
+			MutexLock lock(instantiation_plan_mutex);
+			if (instantiation_plan_status == INSTANTIATION_PLAN_NOT_COMPILED) {
+				instantiation_plan_status = _compile_instantiation_plan() ? INSTANTIATION_PLAN_READY : INSTANTIATION_PLAN_UNAVAILABLE;
+			}
+			plan_ready = instantiation_plan_status == INSTANTIATION_PLAN_READY;
+		}
+		if (plan_ready) {
+			Node *node = _instantiate_from_plan();
+			if (node) {
+				return node;
+			}
+		}
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -607,6 +624,255 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_compile_instantiation_plan() const {
+	instantiation_plan = InstantiationPlan();
+	InstantiationPlan &plan = instantiation_plan;
+
+	int nc = nodes.size();
+	int sname_count = names.size();
+	int prop_count = variants.size();
+	if (nc == 0 || base_scene_idx >= 0 || !editable_instances.is_empty()) {
+		return false;
+	}
+
+	const StringName pinned_properties_name = "metadata/_edit_pinned_properties_";
+	bool creating_missing_resources = ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled();
+
+	plan.nodes.resize(nc);
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::PlanNode &pn = plan.nodes[i];
+
+		// Parents and owners must be plain indices to nodes created earlier.
+		if (i == 0) {
+			if (n.parent != -1) {
+				return false;
+			}
+		} else if (n.parent < 0 || n.parent >= i) {
+			return false;
+		}
+		if (n.owner >= i || n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+		pn.parent = n.parent;
+		pn.owner = n.owner;
+		pn.name = n.name;
+		pn.index = n.index;
+
+		StringName type;
+		if (n.instance >= 0) {
+			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
+				return false;
+			}
+			int instance_idx = n.instance & FLAG_MASK;
+			if (instance_idx >= prop_count) {
+				return false;
+			}
+			Ref<PackedScene> sdata = variants[instance_idx];
+			if (sdata.is_null()) {
+				return false;
+			}
+			pn.instance = instance_idx;
+		} else {
+			if (n.type < 0 || n.type >= sname_count) {
+				return false; // Also covers nodes from an instantiated scene (TYPE_INSTANTIATED).
+			}
+			type = names[n.type];
+			if (!ClassDB::can_instantiate(type) || !ClassDB::is_parent_class(type, SNAME("Node"))) {
+				return false;
+			}
+			pn.type = n.type;
+		}
+
+		// Setters can only be called directly when nothing else intercepts Object::set().
+		bool resolve_setters = pn.type >= 0 && ClassDB::get_api_type(type) != ClassDB::API_EXTENSION;
+
+		pn.property_from = plan.properties.size();
+		for (const NodeData::Property &prop : n.properties) {
+			if (prop.name & FLAG_PATH_PROPERTY_IS_NODE || prop.name < 0 || prop.name >= sname_count || prop.value < 0 || prop.value >= prop_count) {
+				return false;
+			}
+
+			const Variant &value = variants[prop.value];
+			switch (value.get_type()) {
+				case Variant::ARRAY:
+				case Variant::DICTIONARY: {
+					return false; // May need typing or contain resources local to scene.
+				} break;
+				case Variant::OBJECT: {
+					Ref<Resource> res = value;
+					if (res.is_valid()) {
+						if (res->is_local_to_scene() || (creating_missing_resources && Object::cast_to<MissingResource>(*res))) {
+							return false;
+						}
+						plan.resources.push_back(res);
+					}
+				} break;
+				default: {
+				}
+			}
+
+			if (names[prop.name] == CoreStringName(script)) {
+				if (pn.instance >= 0) {
+					return false; // Replacing the script of a sub-scene needs its old state carried over.
+				}
+				resolve_setters = false; // The script may handle the properties that follow.
+			} else if (names[prop.name] == pinned_properties_name) {
+				pn.remove_pinned_properties = true;
+			}
+
+			InstantiationPlan::PlanProperty pp;
+			pp.name = prop.name;
+			pp.value = prop.value;
+			if (resolve_setters) {
+				pp.setter = ClassDB::get_property_setter_method(type, names[prop.name], &pp.setter_index);
+			}
+			plan.properties.push_back(pp);
+		}
+		pn.property_count = plan.properties.size() - pn.property_from;
+
+		pn.group_from = plan.groups.size();
+		for (int group : n.groups) {
+			if (group < 0 || group >= sname_count) {
+				return false;
+			}
+			plan.groups.push_back(group);
+		}
+		pn.group_count = plan.groups.size() - pn.group_from;
+	}
+
+	for (const ConnectionData &c : connections) {
+		if (c.from < 0 || c.from >= nc || c.to < 0 || c.to >= nc || c.signal < 0 || c.signal >= sname_count || c.method < 0 || c.method >= sname_count) {
+			return false; // Also covers connections to nodes referenced by path.
+		}
+
+		InstantiationPlan::PlanConnection pc;
+		pc.from = c.from;
+		pc.to = c.to;
+		pc.signal = c.signal;
+		pc.method = c.method;
+		pc.flags = CONNECT_PERSIST | c.flags | CONNECT_INHERITED;
+		pc.unbinds = c.unbinds;
+		if (c.unbinds <= 0) {
+			for (int bind : c.binds) {
+				if (bind < 0 || bind >= prop_count) {
+					return false;
+				}
+				pc.binds.push_back(variants[bind]);
+			}
+		}
+		plan.connections.push_back(pc);
+	}
+
+	return true;
+}
+
+Node *SceneState::_instantiate_from_plan() const {
+	const InstantiationPlan &plan = instantiation_plan;
+
+	for (const Ref<Resource> &res : plan.resources) {
+		if (unlikely(res->is_local_to_scene())) {
+			return nullptr;
+		}
+	}
+
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+
+	uint32_t nc = plan.nodes.size();
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	for (uint32_t i = 0; i < nc; i++) {
+		const InstantiationPlan::PlanNode &pn = plan.nodes[i];
+
+		Node *node = nullptr;
+		if (pn.instance >= 0) {
+			Ref<PackedScene> sdata = props[pn.instance];
+			node = sdata->instantiate(PackedScene::GEN_EDIT_STATE_DISABLED);
+		} else {
+			node = Object::cast_to<Node>(ClassDB::instantiate(snames[pn.type]));
+		}
+
+		if (unlikely(!node)) {
+			// Let the generic path deal with it, and report what went wrong.
+			if (i > 0) {
+				memdelete(ret_nodes[0]);
+			}
+			return nullptr;
+		}
+
+		const InstantiationPlan::PlanProperty *pprops = plan.properties.ptr() + pn.property_from;
+		for (uint32_t j = 0; j < pn.property_count; j++) {
+			const InstantiationPlan::PlanProperty &pp = pprops[j];
+			const Variant &value = props[pp.value];
+			if (pp.setter) {
+				Callable::CallError ce;
+				if (pp.setter_index >= 0) {
+					Variant index = pp.setter_index;
+					const Variant *args[2] = { &index, &value };
+					pp.setter->call(node, args, 2, ce);
+				} else {
+					const Variant *args[1] = { &value };
+					pp.setter->call(node, args, 1, ce);
+				}
+			} else {
+				node->set(snames[pp.name], value);
+			}
+		}
+
+		const int *pgroups = plan.groups.ptr() + pn.group_from;
+		for (uint32_t j = 0; j < pn.group_count; j++) {
+			node->add_to_group(snames[pgroups[j]], true);
+		}
+
+		if (i > 0) {
+			Node *parent = ret_nodes[pn.parent];
+			parent->_add_child_nocheck(node, snames[pn.name]);
+			if (pn.index >= 0 && pn.index < parent->get_child_count() - 1) {
+				parent->move_child(node, pn.index);
+			}
+		} else {
+			node->_set_name_nocheck(snames[pn.name]);
+		}
+
+		if (pn.owner >= 0) {
+			node->_set_owner_nocheck(ret_nodes[pn.owner]);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+
+		if (pn.remove_pinned_properties) {
+			node->remove_meta("_edit_pinned_properties_");
+		}
+
+		ret_nodes[i] = node;
+	}
+
+	for (const InstantiationPlan::PlanConnection &c : plan.connections) {
+		Callable callable(ret_nodes[c.to], snames[c.method]);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &c.binds[j];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		ret_nodes[c.from]->connect(snames[c.signal], callable, c.flags);
+	}
+
+	return ret_nodes[0];
+}
+
+void SceneState::_invalidate_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan = InstantiationPlan();
+	instantiation_plan_status = INSTANTIATION_PLAN_NOT_COMPILED;
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1215,6 +1481,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_invalidate_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1269,6 +1536,7 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
+	_invalidate_instantiation_plan();
 
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
@@ -1383,6 +1651,16 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::use_instantiation_plans = true;
+
+void SceneState::set_use_instantiation_plans(bool p_enable) {
+	use_instantiation_plans = p_enable;
+}
+
+bool SceneState::is_using_instantiation_plans() {
+	return use_instantiation_plans;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1425,6 +1703,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_invalidate_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1898,6 +2178,7 @@ int SceneState::add_name(const StringName &p_name) {
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_invalidate_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
@@ -1908,6 +2189,7 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_invalidate_instantiation_plan();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1926,6 +2208,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_invalidate_instantiation_plan();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	if (p_deferred_node_path) {
@@ -1938,11 +2222,13 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 void SceneState::add_node_group(int p_node, int p_group) {
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
+	_invalidate_instantiation_plan();
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_invalidate_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -1953,6 +2239,8 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	for (int i = 0; i < p_binds.size(); i++) {
 		ERR_FAIL_INDEX(p_binds[i], variants.size());
 	}
+	_invalidate_instantiation_plan();
+
 	ConnectionData c;
 	c.from = p_from;
 	c.to = p_to;
@@ -1965,10 +2253,12 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
+	_invalidate_instantiation_plan();
 	editable_instances.push_back(p_path);
 }
 
 bool SceneState::remove_group_references(const StringName &p_name) {
+	_invalidate_instantiation_plan();
 	bool edited = false;
 	for (NodeData &node : nodes) {
 		for (const int &group : node.groups) {
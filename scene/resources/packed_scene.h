@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -98,6 +99,64 @@ class SceneState : public RefCounted {
 
 	static bool disable_placeholders;
 
+	// Precomputed steps for instantiating this scene at runtime, used when it only contains
+	// plain nodes and values (no inheritance, placeholders, node path properties or scene-local
+	// resources). Property setters are resolved once instead of being looked up on every set().
+	struct InstantiationPlan {
+		struct PlanNode {
+			int parent = -1;
+			int owner = -1;
+			int type = -1; // Name index of the class to create, or -1 for sub-scene instances.
+			int instance = -1; // Variant index of the sub-scene to instantiate.
+			int name = 0;
+			int index = -1;
+			uint32_t property_from = 0;
+			uint32_t property_count = 0;
+			uint32_t group_from = 0;
+			uint32_t group_count = 0;
+			bool remove_pinned_properties = false;
+		};
+
+		struct PlanProperty {
+			int name = 0;
+			int value = 0;
+			MethodBind *setter = nullptr; // Falls back to Object::set() if not resolved.
+			int setter_index = -1;
+		};
+
+		struct PlanConnection {
+			int from = 0;
+			int to = 0;
+			int signal = 0;
+			int method = 0;
+			uint32_t flags = 0;
+			int unbinds = 0;
+			Vector<Variant> binds;
+		};
+
+		LocalVector<PlanNode> nodes;
+		LocalVector<PlanProperty> properties;
+		LocalVector<int> groups;
+		LocalVector<PlanConnection> connections;
+		LocalVector<Ref<Resource>> resources; // Checked before use, in case one was made local to scene since.
+	};
+
+	enum InstantiationPlanStatus {
+		INSTANTIATION_PLAN_NOT_COMPILED,
+		INSTANTIATION_PLAN_UNAVAILABLE,
+		INSTANTIATION_PLAN_READY,
+	};
+
+	static bool use_instantiation_plans;
+
+	mutable Mutex instantiation_plan_mutex;
+	mutable InstantiationPlan instantiation_plan;
+	mutable InstantiationPlanStatus instantiation_plan_status = INSTANTIATION_PLAN_NOT_COMPILED;
+
+	bool _compile_instantiation_plan() const;
+	Node *_instantiate_from_plan() const;
+	void _invalidate_instantiation_plan();
+
 	Vector<String> _get_node_groups(int p_idx) const;
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
@@ -136,6 +195,8 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_use_instantiation_plans(bool p_enable);
+	static bool is_using_instantiation_plans();
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -52,15 +52,26 @@ Dictionary SyntaxHighlighter::get_line_syntax_highlighting(int p_line) {
 }
 
 void SyntaxHighlighter::_lines_edited_from(int p_from_line, int p_to_line) {
-	if (highlighting_cache.size() < 1) {
+	int from_line = MIN(p_from_line, p_to_line) - 1;
+	if (!GDVIRTUAL_CALL(_invalidate_highlighting_cache_from, from_line)) {
+		_invalidate_highlighting_cache_from(from_line);
+	}
+
+	if (highlighting_cache.is_empty()) {
 		return;
 	}
 
-	int cache_size = highlighting_cache.back()->key();
-	for (int i = MIN(p_from_line, p_to_line) - 1; i <= cache_size; i++) {
-		if (highlighting_cache.has(i)) {
-			highlighting_cache.erase(i);
-		}
+	// Only the lines from the edit onwards are affected, skip straight to them.
+	RBMap<int, Dictionary>::Element *E = highlighting_cache.find_closest(from_line);
+	if (E == nullptr) {
+		E = highlighting_cache.front();
+	} else if (E->key() < from_line) {
+		E = E->next();
+	}
+	while (E) {
+		RBMap<int, Dictionary>::Element *N = E->next();
+		highlighting_cache.erase(E);
+		E = N;
 	}
 }
 
@@ -111,6 +122,7 @@ void SyntaxHighlighter::_bind_methods() {
 
 	GDVIRTUAL_BIND(_get_line_syntax_highlighting, "line")
 	GDVIRTUAL_BIND(_clear_highlighting_cache)
+	GDVIRTUAL_BIND(_invalidate_highlighting_cache_from, "line")
 	GDVIRTUAL_BIND(_update_cache)
 }
 
@@ -418,6 +430,19 @@ void CodeHighlighter::_clear_highlighting_cache() {
 	color_region_cache.clear();
 }
 
+void CodeHighlighter::_invalidate_highlighting_cache_from(int p_line) {
+	// Regions carry over between lines, so a stale entry would leak into the lines below the edit.
+	LocalVector<int> stale_lines;
+	for (const KeyValue<int, int> &E : color_region_cache) {
+		if (E.key >= p_line) {
+			stale_lines.push_back(E.key);
+		}
+	}
+	for (int line : stale_lines) {
+		color_region_cache.erase(line);
+	}
+}
+
 void CodeHighlighter::_update_cache() {
 	font_color = text_edit->get_font_color();
 }
@@ -51,6 +51,7 @@ protected:
 
 	GDVIRTUAL1RC(Dictionary, _get_line_syntax_highlighting, int)
 	GDVIRTUAL0(_clear_highlighting_cache)
+	GDVIRTUAL1(_invalidate_highlighting_cache_from, int)
 	GDVIRTUAL0(_update_cache)
 public:
 	Dictionary get_line_syntax_highlighting(int p_line);
@@ -58,6 +59,7 @@ public:
 
 	void clear_highlighting_cache();
 	virtual void _clear_highlighting_cache() {}
+	virtual void _invalidate_highlighting_cache_from(int p_line) {}
 
 	void update_cache();
 	virtual void _update_cache() {}
@@ -102,6 +104,7 @@ public:
 	virtual Dictionary _get_line_syntax_highlighting_impl(int p_line) override;
 
 	virtual void _clear_highlighting_cache() override;
+	virtual void _invalidate_highlighting_cache_from(int p_line) override;
 	virtual void _update_cache() override;
 
 	void add_keyword_color(const String &p_keyword, const Color &p_color);
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  audio_command_ring.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_COMMAND_RING_H
+#define AUDIO_COMMAND_RING_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+
+#include <atomic>
+#include <type_traits>
+
+// Bounded queue carrying commands from any number of threads to the audio thread.
+// Pushing and popping never lock or allocate. Each slot has a sequence number telling
+// whether it is free to write or ready to read, so producers only contend on claiming
+// a position and the consumer never waits for a producer that is still writing.
+// Commands must be plain values: copies are dropped on the audio thread, and a slot keeps
+// its last command until a producer reuses it, so nothing may need freeing.
+template <typename T>
+class AudioCommandRing {
+	static_assert(std::is_trivially_destructible<T>::value, "Commands must not own anything.");
+
+	struct Slot {
+		std::atomic<uint32_t> sequence = 0;
+		T command;
+	};
+
+	Slot *slots = nullptr;
+	uint32_t mask = 0;
+
+	std::atomic<uint32_t> push_position = 0;
+	std::atomic<uint32_t> pop_position = 0;
+
+public:
+	// p_size is rounded up to a power of two.
+	void init(uint32_t p_size) {
+		ERR_FAIL_COND(slots != nullptr);
+		ERR_FAIL_COND(p_size == 0);
+
+		const uint32_t size = next_power_of_2(p_size);
+		slots = memnew_arr(Slot, size);
+		mask = size - 1;
+		for (uint32_t i = 0; i < size; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		push_position.store(0);
+		pop_position.store(0);
+	}
+
+	void finish() {
+		if (slots) {
+			memdelete_arr(slots);
+			slots = nullptr;
+		}
+	}
+
+	bool is_initialized() const { return slots != nullptr; }
+
+	// Can be called from any thread. Returns false if the ring is full.
+	bool push(const T &p_command) {
+		uint32_t position = push_position.load(std::memory_order_relaxed);
+		while (true) {
+			Slot &slot = slots[position & mask];
+			const int32_t diff = int32_t(slot.sequence.load(std::memory_order_acquire) - position);
+			if (diff == 0) {
+				if (push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					slot.command = p_command;
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				// The consumer has not read this slot yet.
+				return false;
+			} else {
+				// Another producer claimed this position.
+				position = push_position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Must only be called by one thread at a time. Returns false if there is nothing to read,
+	// or the next command is still being written.
+	bool pop(T &r_command) {
+		const uint32_t position = pop_position.load(std::memory_order_relaxed);
+		Slot &slot = slots[position & mask];
+		if (int32_t(slot.sequence.load(std::memory_order_acquire) - (position + 1)) < 0) {
+			return false;
+		}
+		r_command = slot.command;
+		slot.sequence.store(position + mask + 1, std::memory_order_release);
+		pop_position.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Number of commands pushed and popped so far, wrapping around. A command pushed before
+	// get_push_position() returned p has been popped once int32_t(get_pop_position() - p) >= 0.
+	uint32_t get_push_position() const { return push_position.load(std::memory_order_acquire); }
+	uint32_t get_pop_position() const { return pop_position.load(std::memory_order_acquire); }
+
+	~AudioCommandRing() {
+		finish();
+	}
+};
+
+#endif // AUDIO_COMMAND_RING_H
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  audio_decode_ahead.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_decode_ahead.h"
+
+#include "core/os/os.h"
+#include "servers/audio/audio_stream.h"
+
+AudioDecodeAhead *AudioDecodeAhead::singleton = nullptr;
+
+void AudioDecodeAhead::_thread_func(void *p_self) {
+	AudioDecodeAhead *self = static_cast<AudioDecodeAhead *>(p_self);
+	Thread::set_name("AudioDecodeAhead");
+
+	// Rings are topped up a few times per lookahead, so a late wakeup never drains them.
+	const uint64_t idle_usec = CLAMP(uint64_t(self->lookahead * 1000000.0 / 4.0), uint64_t(1000), uint64_t(20000));
+
+	while (!self->exit_thread.is_set()) {
+		// One chunk per playback and pass, so a single long stream can't starve the others.
+		bool decoded = false;
+		{
+			MutexLock lock(self->mutex);
+			// Playbacks removed meanwhile shift the others, at worst one waits for the next pass.
+			for (uint32_t i = 0; i < self->playbacks.size(); i++) {
+				AudioStreamPlaybackResampled *playback = self->playbacks[i];
+				self->decoding_playback = playback;
+				lock.temp_unlock();
+				decoded = playback->_decode_ahead_chunk() || decoded;
+				lock.temp_relock();
+				self->decoding_playback = nullptr;
+				self->decoding_done.notify_all();
+			}
+		}
+		if (!decoded) {
+			OS::get_singleton()->delay_usec(idle_usec);
+		}
+	}
+}
+
+void AudioDecodeAhead::init(double p_lookahead) {
+	ERR_FAIL_COND(thread.is_started());
+
+#ifdef THREADS_ENABLED
+	lookahead = MAX(p_lookahead, 0.0);
+	if (lookahead > 0.0) {
+		exit_thread.clear();
+		thread.start(&AudioDecodeAhead::_thread_func, this);
+	}
+#endif
+}
+
+void AudioDecodeAhead::finish() {
+	if (thread.is_started()) {
+		exit_thread.set();
+		thread.wait_to_finish();
+	}
+	lookahead = 0.0;
+}
+
+void AudioDecodeAhead::add_playback(AudioStreamPlaybackResampled *p_playback) {
+	MutexLock lock(mutex);
+	playbacks.push_back(p_playback);
+}
+
+void AudioDecodeAhead::remove_playback(AudioStreamPlaybackResampled *p_playback) {
+	MutexLock lock(mutex);
+	playbacks.erase(p_playback);
+	while (decoding_playback == p_playback) {
+		decoding_done.wait(lock);
+	}
+}
+
+AudioDecodeAhead::AudioDecodeAhead() {
+	singleton = this;
+}
+
+AudioDecodeAhead::~AudioDecodeAhead() {
+	finish();
+	singleton = nullptr;
+}
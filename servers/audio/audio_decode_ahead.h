@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*  audio_decode_ahead.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_DECODE_AHEAD_H
+#define AUDIO_DECODE_AHEAD_H
+
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class AudioStreamPlaybackResampled;
+
+// Background thread decoding compressed audio streams ahead of the mix, so the
+// audio thread only copies PCM. Playbacks opt in with
+// AudioStreamPlaybackResampled::_enable_decode_ahead().
+class AudioDecodeAhead {
+	static AudioDecodeAhead *singleton;
+
+	Thread thread;
+	SafeFlag exit_thread;
+	double lookahead = 0.0;
+
+	// Only guards the list, playbacks are decoded without it so removing one doesn't wait for the others.
+	BinaryMutex mutex;
+	LocalVector<AudioStreamPlaybackResampled *> playbacks;
+	AudioStreamPlaybackResampled *decoding_playback = nullptr;
+	ConditionVariable decoding_done;
+
+	static void _thread_func(void *p_self);
+
+public:
+	static AudioDecodeAhead *get_singleton() { return singleton; }
+
+	// A lookahead of 0 disables decoding ahead, playbacks then decode while mixing.
+	void init(double p_lookahead);
+	void finish();
+
+	double get_lookahead() const { return lookahead; }
+
+	void add_playback(AudioStreamPlaybackResampled *p_playback);
+	// Waits until the thread is done decoding this playback, so it can be destroyed afterwards.
+	void remove_playback(AudioStreamPlaybackResampled *p_playback);
+
+	AudioDecodeAhead();
+	~AudioDecodeAhead();
+};
+
+#endif // AUDIO_DECODE_AHEAD_H
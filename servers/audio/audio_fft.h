@@ -0,0 +1,53 @@
+/**************************************************************************/
+/*  audio_fft.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_FFT_H
+#define AUDIO_FFT_H
+
+#include "core/typedefs.h"
+
+// FFT helpers shared by the spectral audio effects.
+class AudioFFT {
+public:
+	enum {
+		FORWARD = -1,
+		INVERSE = 1,
+	};
+
+	// In-place complex FFT of p_size (a power of 2) interleaved real/imaginary pairs.
+	// The inverse transform is not normalized, divide the result by p_size.
+	static void transform(float *p_buffer, int p_size, int p_sign);
+
+	// r[i] += a[i] * b[i] on complex numbers stored as separate real and imaginary arrays,
+	// which keeps the loop free of shuffles so the compiler can vectorize it.
+	static void complex_multiply_add(float *r_real, float *r_imag, const float *p_a_real, const float *p_a_imag, const float *p_b_real, const float *p_b_imag, int p_count);
+};
+
+#endif // AUDIO_FFT_H
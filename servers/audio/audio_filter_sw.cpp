@@ -241,20 +241,89 @@ void AudioFilterSW::Processor::update_coeffs(int p_interp_buffer_len) {
 	}
 }
 
+// Local copy of a processor, so the compiler can keep it in registers while filtering a block.
+struct AudioFilterSW::Processor::State {
+	Coeffs coeffs;
+	Coeffs incr_coeffs;
+	float ha1;
+	float ha2;
+	float hb1;
+	float hb2;
+
+	_ALWAYS_INLINE_ explicit State(const Processor &p_processor) :
+			coeffs(p_processor.coeffs),
+			incr_coeffs(p_processor.incr_coeffs),
+			ha1(p_processor.ha1),
+			ha2(p_processor.ha2),
+			hb1(p_processor.hb1),
+			hb2(p_processor.hb2) {}
+
+	_ALWAYS_INLINE_ void store(Processor &r_processor) const {
+		r_processor.coeffs = coeffs;
+		r_processor.ha1 = ha1;
+		r_processor.ha2 = ha2;
+		r_processor.hb1 = hb1;
+		r_processor.hb2 = hb2;
+	}
+
+	// Same operations, in the same order, as Processor::process_one() and Processor::process_one_interp().
+	template <bool p_interpolate>
+	_ALWAYS_INLINE_ float process(float p_sample) {
+		float out = (p_sample * coeffs.b0 + hb1 * coeffs.b1 + hb2 * coeffs.b2 + ha1 * coeffs.a1 + ha2 * coeffs.a2);
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = p_sample;
+		ha1 = out;
+
+		if constexpr (p_interpolate) {
+			coeffs.b0 += incr_coeffs.b0;
+			coeffs.b1 += incr_coeffs.b1;
+			coeffs.b2 += incr_coeffs.b2;
+			coeffs.a1 += incr_coeffs.a1;
+			coeffs.a2 += incr_coeffs.a2;
+		}
+		return out;
+	}
+};
+
+template <bool p_interpolate>
+void AudioFilterSW::Processor::_process(State &r_state, float *p_samples, int p_amount, int p_stride) {
+	for (int i = 0; i < p_amount; i++) {
+		*p_samples = r_state.process<p_interpolate>(*p_samples);
+		p_samples += p_stride;
+	}
+}
+
+template <bool p_interpolate>
+void AudioFilterSW::Processor::_process_stereo(State &r_left, State &r_right, AudioFrame *p_frames, int p_amount) {
+	for (int i = 0; i < p_amount; i++) {
+		p_frames[i].left = r_left.process<p_interpolate>(p_frames[i].left);
+		p_frames[i].right = r_right.process<p_interpolate>(p_frames[i].right);
+	}
+}
+
 void AudioFilterSW::Processor::process(float *p_samples, int p_amount, int p_stride, bool p_interpolate) {
 	if (!filter) {
 		return;
 	}
 
+	State state(*this);
 	if (p_interpolate) {
-		for (int i = 0; i < p_amount; i++) {
-			process_one_interp(*p_samples);
-			p_samples += p_stride;
-		}
+		_process<true>(state, p_samples, p_amount, p_stride);
 	} else {
-		for (int i = 0; i < p_amount; i++) {
-			process_one(*p_samples);
-			p_samples += p_stride;
-		}
+		_process<false>(state, p_samples, p_amount, p_stride);
+	}
+	state.store(*this);
+}
+
+void AudioFilterSW::Processor::process_stereo(Processor *p_left, Processor *p_right, AudioFrame *p_frames, int p_amount, bool p_interpolate) {
+	State left(*p_left);
+	State right(*p_right);
+	if (p_interpolate) {
+		_process_stereo<true>(left, right, p_frames, p_amount);
+	} else {
+		_process_stereo<false>(left, right, p_frames, p_amount);
 	}
+	left.store(*p_left);
+	right.store(*p_right);
 }
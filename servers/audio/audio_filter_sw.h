@@ -31,6 +31,7 @@
 #ifndef AUDIO_FILTER_SW_H
 #define AUDIO_FILTER_SW_H
 
+#include "core/math/audio_frame.h"
 #include "core/math/math_funcs.h"
 
 class AudioFilterSW {
@@ -64,9 +65,18 @@ public:
 		float hb2 = 0.0f;
 		Coeffs incr_coeffs;
 
+		struct State;
+		template <bool p_interpolate>
+		static void _process(State &r_state, float *p_samples, int p_amount, int p_stride);
+		template <bool p_interpolate>
+		static void _process_stereo(State &r_left, State &r_right, AudioFrame *p_frames, int p_amount);
+
 	public:
 		void set_filter(AudioFilterSW *p_filter, bool p_clear_history = true);
 		void process(float *p_samples, int p_amount, int p_stride = 1, bool p_interpolate = false);
+		// Same as calling process_one() (or process_one_interp()) on p_left and p_right for the channels of every
+		// frame, but both filter states stay in registers, instead of being reloaded after every store to p_frames.
+		static void process_stereo(Processor *p_left, Processor *p_right, AudioFrame *p_frames, int p_amount, bool p_interpolate = false);
 		void update_coeffs(int p_interp_buffer_len = 0);
 		_ALWAYS_INLINE_ void process_one(float &p_sample);
 		_ALWAYS_INLINE_ void process_one_interp(float &p_sample);
@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  audio_mix_thread_pool.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_mix_thread_pool.h"
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+
+void AudioMixThreadPool::_thread_func(void *p_self) {
+	AudioMixThreadPool *self = static_cast<AudioMixThreadPool *>(p_self);
+	Thread::set_name("AudioMixThread");
+
+	while (true) {
+		self->semaphore.wait();
+		if (self->exit_threads.load(std::memory_order_acquire)) {
+			break;
+		}
+		self->_process_items();
+	}
+}
+
+void AudioMixThreadPool::_process_items() {
+	uint64_t current = state.load(std::memory_order_acquire);
+
+	while (true) {
+		// The job is read before claiming an index. If run() moved on to another job
+		// in the meantime, the generation changed and the claim below fails.
+		Job current_job = job.load(std::memory_order_relaxed);
+		void *userdata = job_userdata.load(std::memory_order_relaxed);
+		uint32_t count = job_count.load(std::memory_order_relaxed);
+
+		uint32_t index = uint32_t(current & 0xFFFFFFFF);
+		if (index >= count) {
+			return;
+		}
+
+		if (state.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			current_job(userdata, index);
+			completed.fetch_add(1, std::memory_order_release);
+			current = state.load(std::memory_order_acquire);
+		}
+	}
+}
+
+void AudioMixThreadPool::run(Job p_job, void *p_userdata, uint32_t p_count) {
+	if (p_count == 0) {
+		return;
+	}
+
+	if (threads.is_empty() || p_count == 1) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_job(p_userdata, i);
+		}
+		return;
+	}
+
+	job.store(p_job, std::memory_order_relaxed);
+	job_userdata.store(p_userdata, std::memory_order_relaxed);
+	job_count.store(p_count, std::memory_order_relaxed);
+	completed.store(0, std::memory_order_relaxed);
+
+	uint64_t generation = (state.load(std::memory_order_relaxed) >> 32) + 1;
+	state.store(generation << 32, std::memory_order_release);
+
+	semaphore.post(MIN((uint32_t)threads.size(), p_count - 1));
+
+	_process_items();
+
+	while (completed.load(std::memory_order_acquire) < p_count) {
+		OS::get_singleton()->yield();
+	}
+}
+
+void AudioMixThreadPool::init(int p_thread_count) {
+	ERR_FAIL_COND(!threads.is_empty());
+
+#ifdef THREADS_ENABLED
+	exit_threads.store(false);
+
+	Thread::Settings settings;
+	settings.priority = Thread::PRIORITY_HIGH;
+
+	for (int i = 0; i < p_thread_count; i++) {
+		Thread *thread = memnew(Thread);
+		thread->start(&AudioMixThreadPool::_thread_func, this, settings);
+		threads.push_back(thread);
+	}
+#endif
+}
+
+void AudioMixThreadPool::finish() {
+	if (threads.is_empty()) {
+		return;
+	}
+
+	exit_threads.store(true, std::memory_order_release);
+	semaphore.post(threads.size());
+
+	for (Thread *thread : threads) {
+		thread->wait_to_finish();
+		memdelete(thread);
+	}
+	threads.clear();
+}
+
+AudioMixThreadPool::~AudioMixThreadPool() {
+	finish();
+}
@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  audio_mix_thread_pool.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_MIX_THREAD_POOL_H
+#define AUDIO_MIX_THREAD_POOL_H
+
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Small fixed set of high priority threads used to split the audio mix.
+// Unlike WorkerThreadPool, running a job never allocates or takes a lock
+// that non-audio code may hold, and the calling thread takes part in the
+// work, so a pool without threads simply runs everything inline.
+class AudioMixThreadPool {
+public:
+	typedef void (*Job)(void *p_userdata, uint32_t p_index);
+
+private:
+	LocalVector<Thread *> threads;
+	Semaphore semaphore;
+	std::atomic<bool> exit_threads = false;
+
+	// Written by run() before the generation in `state` is bumped.
+	std::atomic<Job> job = nullptr;
+	std::atomic<void *> job_userdata = nullptr;
+	std::atomic<uint32_t> job_count = 0;
+
+	// Generation in the high 32 bits, next index to claim in the low 32 bits.
+	std::atomic<uint64_t> state = 0;
+	std::atomic<uint32_t> completed = 0;
+
+	static void _thread_func(void *p_self);
+	void _process_items();
+
+public:
+	void init(int p_thread_count);
+	void finish();
+
+	int get_thread_count() const { return threads.size(); }
+
+	// Calls p_job for every index in [0, p_count) and returns once all calls are done.
+	// Must only be called from one thread at a time (the audio thread).
+	void run(Job p_job, void *p_userdata, uint32_t p_count);
+
+	~AudioMixThreadPool();
+};
+
+#endif // AUDIO_MIX_THREAD_POOL_H
@@ -48,27 +48,35 @@ template <int C>
 uint32_t AudioRBResampler::_resample(AudioFrame *p_dest, int p_todo, int32_t p_increment) {
 	uint32_t read = offset & MIX_FRAC_MASK;
 
+	// The offset wraps around the ring buffer, so every position computed from it is in range.
+	ERR_FAIL_COND_V((1u << rb_bits) != rb_len, 0);
+
+	// Work on local copies, stores to p_dest could otherwise alias the members.
+	const float *src = rb;
+	const uint32_t offset_mask = (1 << (rb_bits + MIX_FRAC_BITS)) - 1;
+	const uint32_t pos_mask = rb_mask;
+	uint32_t local_offset = offset;
+
 	for (int i = 0; i < p_todo; i++) {
-		offset = (offset + p_increment) & (((1 << (rb_bits + MIX_FRAC_BITS)) - 1));
+		local_offset = (local_offset + p_increment) & offset_mask;
 		read += p_increment;
-		uint32_t pos = offset >> MIX_FRAC_BITS;
-		float frac = float(offset & MIX_FRAC_MASK) / float(MIX_FRAC_LEN);
-		ERR_FAIL_COND_V(pos >= rb_len, 0);
-		uint32_t pos_next = (pos + 1) & rb_mask;
+		uint32_t pos = local_offset >> MIX_FRAC_BITS;
+		float frac = float(local_offset & MIX_FRAC_MASK) / float(MIX_FRAC_LEN);
+		uint32_t pos_next = (pos + 1) & pos_mask;
 
 		// since this is a template with a known compile time value (C), conditionals go away when compiling.
 		if constexpr (C == 1) {
-			float v0 = rb[pos];
-			float v0n = rb[pos_next];
+			float v0 = src[pos];
+			float v0n = src[pos_next];
 			v0 += (v0n - v0) * frac;
 			p_dest[i] = AudioFrame(v0, v0);
 		}
 
 		if constexpr (C == 2) {
-			float v0 = rb[(pos << 1) + 0];
-			float v1 = rb[(pos << 1) + 1];
-			float v0n = rb[(pos_next << 1) + 0];
-			float v1n = rb[(pos_next << 1) + 1];
+			float v0 = src[(pos << 1) + 0];
+			float v1 = src[(pos << 1) + 1];
+			float v0n = src[(pos_next << 1) + 0];
+			float v1n = src[(pos_next << 1) + 1];
 
 			v0 += (v0n - v0) * frac;
 			v1 += (v1n - v1) * frac;
@@ -77,20 +85,20 @@ uint32_t AudioRBResampler::_resample(AudioFrame *p_dest, int p_todo, int32_t p_i
 
 		// This will probably never be used, but added anyway
 		if constexpr (C == 4) {
-			float v0 = rb[(pos << 2) + 0];
-			float v1 = rb[(pos << 2) + 1];
-			float v0n = rb[(pos_next << 2) + 0];
-			float v1n = rb[(pos_next << 2) + 1];
+			float v0 = src[(pos << 2) + 0];
+			float v1 = src[(pos << 2) + 1];
+			float v0n = src[(pos_next << 2) + 0];
+			float v1n = src[(pos_next << 2) + 1];
 			v0 += (v0n - v0) * frac;
 			v1 += (v1n - v1) * frac;
 			p_dest[i] = AudioFrame(v0, v1);
 		}
 
 		if constexpr (C == 6) {
-			float v0 = rb[(pos * 6) + 0];
-			float v1 = rb[(pos * 6) + 1];
-			float v0n = rb[(pos_next * 6) + 0];
-			float v1n = rb[(pos_next * 6) + 1];
+			float v0 = src[(pos * 6) + 0];
+			float v1 = src[(pos * 6) + 1];
+			float v0n = src[(pos_next * 6) + 0];
+			float v1n = src[(pos_next * 6) + 1];
 
 			v0 += (v0n - v0) * frac;
 			v1 += (v1n - v1) * frac;
@@ -98,6 +106,8 @@ uint32_t AudioRBResampler::_resample(AudioFrame *p_dest, int p_todo, int32_t p_i
 		}
 	}
 
+	offset = local_offset;
+
 	return read >> MIX_FRAC_BITS; //rb_read_pos = offset >> MIX_FRAC_BITS;
 }
 
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "servers/audio/audio_decode_ahead.h"
 
 void AudioStreamPlayback::start(double p_from_pos) {
 	if (GDVIRTUAL_CALL(_start, p_from_pos)) {
@@ -70,6 +71,11 @@ void AudioStreamPlayback::seek(double p_time) {
 	GDVIRTUAL_CALL(_seek, p_time);
 }
 
+bool AudioStreamPlayback::skip(double p_time) {
+	seek(get_playback_position() + p_time);
+	return is_playing();
+}
+
 int AudioStreamPlayback::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	int ret = 0;
 	GDVIRTUAL_REQUIRED_CALL(_mix, p_buffer, p_rate_scale, p_frames, ret);
@@ -119,6 +125,197 @@ AudioStreamPlayback::~AudioStreamPlayback() {
 }
 //////////////////////////////
 
+bool AudioStreamPlaybackResampled::_request_decoder(DecoderRequest p_request, double p_time) {
+	const double skip_from = p_request == DECODER_REQUEST_SKIP ? get_playback_position() : 0.0;
+
+	decoder_requests_lock.lock();
+	switch (p_request) {
+		case DECODER_REQUEST_START: {
+			decoder_requests = DecoderRequests();
+			decoder_requests.start = true;
+			decoder_requests.start_position = p_time;
+		} break;
+		case DECODER_REQUEST_STOP: {
+			decoder_requests = DecoderRequests();
+			decoder_requests.stop = true;
+		} break;
+		case DECODER_REQUEST_SEEK: {
+			decoder_requests.seek = true;
+			decoder_requests.seek_position = p_time;
+			decoder_requests.skip = false;
+		} break;
+		case DECODER_REQUEST_SKIP: {
+			if (!decoder_requests.skip) {
+				decoder_requests.skip = true;
+				decoder_requests.skip_from = skip_from;
+				decoder_requests.skip_time = 0.0;
+			}
+			decoder_requests.skip_time += p_time;
+		} break;
+	}
+	decoder_requests_pending.store(true, std::memory_order_release);
+	decoder_requests_lock.unlock();
+
+	if (Thread::is_main_thread()) {
+		decoder_mutex.lock();
+	} else if (!decoder_mutex.try_lock()) {
+		return true;
+	}
+	const bool playing = _apply_decoder_requests();
+	decoder_mutex.unlock();
+	return playing;
+}
+
+bool AudioStreamPlaybackResampled::_apply_decoder_requests() {
+	decoder_requests_lock.lock();
+	const DecoderRequests requests = decoder_requests;
+	decoder_requests = DecoderRequests();
+	decoder_requests_pending.store(false, std::memory_order_release);
+	decoder_requests_lock.unlock();
+
+	if (requests.stop) {
+		_decoder_stop();
+	}
+	if (requests.start) {
+		_decoder_start(requests.start_position);
+	}
+	if (requests.seek) {
+		_decoder_seek(requests.seek_position);
+	}
+	bool playing = true;
+	if (requests.skip) {
+		// Skips after a start or a seek count from where those went, not from what was mixed.
+		double from = requests.skip_from;
+		if (requests.start) {
+			from = requests.start_position;
+		}
+		if (requests.seek) {
+			from = requests.seek_position;
+		}
+		playing = _decoder_skip(from + requests.skip_time);
+	}
+
+	// Nothing is decoded while the lock is held, so this drops exactly what was decoded before.
+	decoded_flush_pos.store(decoded_write_pos.load(std::memory_order_relaxed), std::memory_order_release);
+	decoded_position.store(_get_decoder_position(), std::memory_order_relaxed);
+	decoded_loop_count.store(_get_decoder_loop_count(), std::memory_order_relaxed);
+	decoder_ended.store(false, std::memory_order_relaxed);
+	return playing;
+}
+
+void AudioStreamPlaybackResampled::_enable_decode_ahead() {
+	AudioDecodeAhead *decode_ahead_thread = AudioDecodeAhead::get_singleton();
+	if (decode_ahead || !decode_ahead_thread || decode_ahead_thread->get_lookahead() <= 0.0) {
+		return;
+	}
+
+	decoded_chunk_count = MAX(2, (int)Math::ceil(decode_ahead_thread->get_lookahead() * get_stream_sampling_rate() / INTERNAL_BUFFER_LEN));
+	decoded_chunks.resize(next_power_of_2(decoded_chunk_count));
+	decode_ahead = true;
+	decode_ahead_thread->add_playback(this);
+}
+
+void AudioStreamPlaybackResampled::_disable_decode_ahead() {
+	if (!decode_ahead) {
+		return;
+	}
+	if (AudioDecodeAhead::get_singleton()) {
+		AudioDecodeAhead::get_singleton()->remove_playback(this);
+	}
+	decode_ahead = false;
+}
+
+bool AudioStreamPlaybackResampled::_has_decoded_frames() const {
+	if (!decode_ahead) {
+		return false;
+	}
+	const uint32_t read_pos = decoded_read_pos.load(std::memory_order_acquire);
+	const uint32_t flush_pos = decoded_flush_pos.load(std::memory_order_acquire);
+	const uint32_t write_pos = decoded_write_pos.load(std::memory_order_acquire);
+	return int32_t(write_pos - (int32_t(flush_pos - read_pos) > 0 ? flush_pos : read_pos)) > 0;
+}
+
+bool AudioStreamPlaybackResampled::_is_decoded_ring_full() const {
+	// Compared to the read position itself rather than the flush position, the chunk it points to may still be read.
+	return decoded_write_pos.load(std::memory_order_relaxed) - decoded_read_pos.load(std::memory_order_acquire) >= decoded_chunk_count;
+}
+
+bool AudioStreamPlaybackResampled::_decode_ahead_chunk() {
+	// Checked before locking too, so the mix rarely finds the lock taken.
+	if (decoder_ended.load(std::memory_order_relaxed) || _has_decoder_requests() || _is_decoded_ring_full()) {
+		return false;
+	}
+
+	MutexLock lock(decoder_mutex);
+	if (decoder_ended.load(std::memory_order_relaxed) || _has_decoder_requests() || _is_decoded_ring_full()) {
+		return false;
+	}
+
+	const uint32_t write_pos = decoded_write_pos.load(std::memory_order_relaxed);
+
+	DecodedChunk &chunk = decoded_chunks[write_pos & (decoded_chunks.size() - 1)];
+	chunk.frame_count = _mix_internal(chunk.frames, INTERNAL_BUFFER_LEN);
+	chunk.position = _get_decoder_position();
+	chunk.loop_count = _get_decoder_loop_count();
+	decoder_ended.store(chunk.frame_count < INTERNAL_BUFFER_LEN, std::memory_order_relaxed);
+	decoded_write_pos.store(write_pos + 1, std::memory_order_release);
+	return true;
+}
+
+int AudioStreamPlaybackResampled::_mix_decoded(AudioFrame *p_buffer) {
+	if (!decode_ahead) {
+		return _mix_internal(p_buffer, INTERNAL_BUFFER_LEN);
+	}
+
+	uint32_t read_pos = decoded_read_pos.load(std::memory_order_relaxed);
+	uint32_t flush_pos = decoded_flush_pos.load(std::memory_order_acquire);
+	if (int32_t(flush_pos - read_pos) > 0) {
+		read_pos = flush_pos;
+	}
+
+	if (read_pos == decoded_write_pos.load(std::memory_order_acquire)) {
+		// The decode thread fell behind, or did not start on this playback yet.
+		// Decode here as if decoding ahead was disabled, unless it is busy with this playback right now,
+		// in which case waiting could take longer than the mix has, and a short gap is inserted instead.
+		if (!decoder_mutex.try_lock()) {
+			decoded_read_pos.store(read_pos, std::memory_order_release);
+			memset(p_buffer, 0, sizeof(AudioFrame) * INTERNAL_BUFFER_LEN);
+			return INTERNAL_BUFFER_LEN;
+		}
+
+		flush_pos = decoded_flush_pos.load(std::memory_order_acquire);
+		if (int32_t(flush_pos - read_pos) > 0) {
+			read_pos = flush_pos;
+		}
+		decoded_read_pos.store(read_pos, std::memory_order_release);
+
+		if (read_pos == decoded_write_pos.load(std::memory_order_acquire)) {
+			// Nothing else decodes while the lock is held, so the frames stay in order.
+			const int mixed = _mix_internal(p_buffer, INTERNAL_BUFFER_LEN);
+			decoded_position.store(_get_decoder_position(), std::memory_order_relaxed);
+			decoded_loop_count.store(_get_decoder_loop_count(), std::memory_order_relaxed);
+			decoder_ended.store(mixed < INTERNAL_BUFFER_LEN, std::memory_order_relaxed);
+			decoder_mutex.unlock();
+			return mixed;
+		}
+		// A chunk was decoded in the meantime.
+		decoder_mutex.unlock();
+	}
+
+	const DecodedChunk &chunk = decoded_chunks[read_pos & (decoded_chunks.size() - 1)];
+	// Decoders fill the rest of the chunk with silence when they end, as the resampler expects.
+	memcpy(p_buffer, chunk.frames, sizeof(AudioFrame) * INTERNAL_BUFFER_LEN);
+	decoded_position.store(chunk.position, std::memory_order_relaxed);
+	decoded_loop_count.store(chunk.loop_count, std::memory_order_relaxed);
+	const int mixed = chunk.frame_count;
+	decoded_read_pos.store(read_pos + 1, std::memory_order_release);
+	return mixed;
+}
+
+AudioStreamPlaybackResampled::~AudioStreamPlaybackResampled() {
+	_disable_decode_ahead();
+}
+
 void AudioStreamPlaybackResampled::begin_resample() {
 	//clear cubic interpolation history
 	internal_buffer[0] = AudioFrame(0.0, 0.0);
@@ -149,6 +346,20 @@ void AudioStreamPlaybackResampled::_bind_methods() {
 }
 
 int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
+	if (_has_decoder_requests()) {
+		if (!decoder_mutex.try_lock()) {
+			// The decode thread is finishing a chunk, it won't take the lock again until the requests are applied.
+			memset(p_buffer, 0, sizeof(AudioFrame) * p_frames);
+			return p_frames;
+		}
+		const bool playing = _apply_decoder_requests();
+		decoder_mutex.unlock();
+		if (!playing) {
+			memset(p_buffer, 0, sizeof(AudioFrame) * p_frames);
+			return 0;
+		}
+	}
+
 	float target_rate = AudioServer::get_singleton()->get_mix_rate();
 	float playback_speed_scale = AudioServer::get_singleton()->get_playback_speed_scale();
 
@@ -156,38 +367,39 @@ int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 
 	int mixed_frames_total = -1;
 
-	int i;
-	for (i = 0; i < p_frames; i++) {
-		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
-		//standard cubic interpolation (great quality/performance ratio)
-		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
-		float mu = (mix_offset & FP_MASK) / float(FP_LEN);
-		AudioFrame y0 = internal_buffer[idx - 3];
-		AudioFrame y1 = internal_buffer[idx - 2];
-		AudioFrame y2 = internal_buffer[idx - 1];
-		AudioFrame y3 = internal_buffer[idx - 0];
-
-		if (idx >= internal_buffer_end && mixed_frames_total == -1) {
-			// The internal buffer ends somewhere in this range, and we haven't yet recorded the number of good frames we have.
-			mixed_frames_total = i;
+	int i = 0;
+	while (i < p_frames) {
+		// Interpolate every frame that can be produced before the internal buffer needs to be refilled,
+		// so the inner loop does not have to check for it.
+		int run = p_frames - i;
+		if (mix_increment > 0) {
+			const uint64_t to_end = (uint64_t(INTERNAL_BUFFER_LEN) << FP_BITS) - mix_offset;
+			run = (int)MIN((uint64_t)run, (to_end + mix_increment - 1) / mix_increment);
 		}
 
-		float mu2 = mu * mu;
-		AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
-		AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
-		AudioFrame a2 = y2 - y0;
-		AudioFrame a3 = 2 * y1;
-
-		p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+		if (mixed_frames_total == -1 && internal_buffer_end != (unsigned int)-1) {
+			// The internal buffer ends somewhere in this range, record the number of good frames we have.
+			uint64_t frames_to_end = 0;
+			if (internal_buffer_end > CUBIC_INTERP_HISTORY) {
+				const uint64_t end_offset = uint64_t(internal_buffer_end - CUBIC_INTERP_HISTORY) << FP_BITS;
+				if (mix_offset < end_offset) {
+					frames_to_end = mix_increment > 0 ? (end_offset - mix_offset + mix_increment - 1) / mix_increment : UINT64_MAX;
+				}
+			}
+			if (frames_to_end < (uint64_t)run) {
+				mixed_frames_total = i + (int)frames_to_end;
+			}
+		}
 
-		mix_offset += mix_increment;
+		mix_offset = _interpolate_cubic(p_buffer + i, internal_buffer, mix_offset, mix_increment, run);
+		i += run;
 
 		while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
 			internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
 			internal_buffer[1] = internal_buffer[INTERNAL_BUFFER_LEN + 1];
 			internal_buffer[2] = internal_buffer[INTERNAL_BUFFER_LEN + 2];
 			internal_buffer[3] = internal_buffer[INTERNAL_BUFFER_LEN + 3];
-			int mixed_frames = _mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+			int mixed_frames = _mix_decoded(internal_buffer + 4);
 			if (mixed_frames != INTERNAL_BUFFER_LEN) {
 				// internal_buffer[mixed_frames] is the first frame of silence.
 				internal_buffer_end = mixed_frames;
@@ -204,6 +416,30 @@ int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 	return mixed_frames_total;
 }
 
+uint64_t AudioStreamPlaybackResampled::_interpolate_cubic(AudioFrame *p_buffer, const AudioFrame *p_internal_buffer, uint64_t p_offset, uint64_t p_increment, int p_frames) {
+	for (int i = 0; i < p_frames; i++) {
+		uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(p_offset >> FP_BITS);
+		//standard cubic interpolation (great quality/performance ratio)
+		//this used to be moved to a LUT for greater performance, but nowadays CPU speed is generally faster than memory.
+		float mu = (p_offset & FP_MASK) / float(FP_LEN);
+		AudioFrame y0 = p_internal_buffer[idx - 3];
+		AudioFrame y1 = p_internal_buffer[idx - 2];
+		AudioFrame y2 = p_internal_buffer[idx - 1];
+		AudioFrame y3 = p_internal_buffer[idx - 0];
+
+		float mu2 = mu * mu;
+		AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
+		AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
+		AudioFrame a2 = y2 - y0;
+		AudioFrame a3 = 2 * y1;
+
+		p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+
+		p_offset += p_increment;
+	}
+	return p_offset;
+}
+
 ////////////////////////////////
 
 Ref<AudioStreamPlayback> AudioStream::instantiate_playback() {
@@ -33,6 +33,7 @@
 
 #include "core/io/image.h"
 #include "core/io/resource.h"
+#include "core/os/spin_lock.h"
 #include "scene/property_list_helper.h"
 #include "servers/audio/audio_filter_sw.h"
 #include "servers/audio_server.h"
@@ -102,6 +103,8 @@ public:
 
 	virtual double get_playback_position() const;
 	virtual void seek(double p_time);
+	// Advances by p_time seconds without mixing, used by virtual voices. Returns false if playback ended.
+	virtual bool skip(double p_time);
 
 	virtual void tag_used_streams();
 
@@ -134,7 +137,100 @@ class AudioStreamPlaybackResampled : public AudioStreamPlayback {
 	unsigned int internal_buffer_end = -1;
 	uint64_t mix_offset = 0;
 
+	// Decode-ahead: AudioDecodeAhead's thread calls _mix_internal() to keep a ring of
+	// chunks filled, and the mix only copies them. Chunks are consumed by the thread
+	// calling mix(). Positions only ever increase, chunks are indexed modulo the ring size.
+	struct DecodedChunk {
+		AudioFrame frames[INTERNAL_BUFFER_LEN];
+		int frame_count = 0;
+		double position = 0.0;
+		int loop_count = 0;
+	};
+
+	bool decode_ahead = false;
+	LocalVector<DecodedChunk> decoded_chunks;
+	uint32_t decoded_chunk_count = 0; // Usable chunks, the ring is rounded up to a power of 2.
+	std::atomic<uint32_t> decoded_write_pos = 0;
+	std::atomic<uint32_t> decoded_read_pos = 0;
+	// Chunks before this one were decoded before the decoder state last changed and are skipped.
+	std::atomic<uint32_t> decoded_flush_pos = 0;
+	std::atomic<double> decoded_position = 0.0;
+	std::atomic<int> decoded_loop_count = 0;
+
+	// Held while the decoder state is used or changed.
+	BinaryMutex decoder_mutex;
+	// Only changed with decoder_mutex held, read without it to skip playbacks that ended.
+	std::atomic<bool> decoder_ended = false;
+
+	// Decoder changes waiting for decoder_mutex, merged so they never need more room.
+	// A start or a stop replaces anything requested before it.
+	struct DecoderRequests {
+		bool stop = false;
+		bool start = false;
+		double start_position = 0.0;
+		bool seek = false;
+		double seek_position = 0.0;
+		bool skip = false;
+		double skip_from = 0.0;
+		double skip_time = 0.0;
+	};
+	SpinLock decoder_requests_lock;
+	DecoderRequests decoder_requests;
+	// Read without the lock, the decode thread leaves decoder_mutex alone while requests wait.
+	std::atomic<bool> decoder_requests_pending = false;
+
+	// Called with decoder_mutex held. Returns false if a skip ended the playback.
+	bool _apply_decoder_requests();
+
+	friend class AudioDecodeAhead;
+	// Called from AudioDecodeAhead's thread. Returns true if a chunk was decoded.
+	bool _decode_ahead_chunk();
+	bool _is_decoded_ring_full() const;
+	int _mix_decoded(AudioFrame *p_buffer);
+
+	// Returns the offset after the last interpolated frame.
+	static uint64_t _interpolate_cubic(AudioFrame *p_buffer, const AudioFrame *p_internal_buffer, uint64_t p_offset, uint64_t p_increment, int p_frames);
+
 protected:
+	enum DecoderRequest {
+		DECODER_REQUEST_START,
+		DECODER_REQUEST_STOP,
+		DECODER_REQUEST_SEEK,
+		DECODER_REQUEST_SKIP,
+	};
+
+	// Anything that changes the decoder state outside of _mix_internal(), such as start(), stop()
+	// and seek(), goes through here. The matching _decoder_*() method runs with the decoder locked,
+	// and what was decoded ahead is dropped. The main thread waits for the decode thread; other
+	// threads, such as the mix calling start() on a sub-stream, never do: if the decode thread holds
+	// the lock, the request is applied on the next mix() instead, and skips return true.
+	bool _request_decoder(DecoderRequest p_request, double p_time = 0.0);
+	bool _has_decoder_requests() const { return decoder_requests_pending.load(std::memory_order_acquire); }
+
+	virtual void _decoder_start(double p_from_pos) {}
+	virtual void _decoder_stop() {}
+	virtual void _decoder_seek(double p_time) {}
+	// Moves to p_position, the playback position plus the skipped time. Returns false if the playback ended.
+	virtual bool _decoder_skip(double p_position) {
+		_decoder_seek(p_position);
+		return true;
+	}
+
+	// For decoders too expensive to run in the mix. Call once the stream is set up, and
+	// call _disable_decode_ahead() first thing in the destructor, before the decoder is freed.
+	void _enable_decode_ahead();
+	void _disable_decode_ahead();
+	bool _is_decoding_ahead() const { return decode_ahead; }
+	// Decoder position and loop count right after the chunk being mixed was decoded,
+	// the same as the decoder itself reports when not decoding ahead.
+	double _get_decoded_position() const { return decoded_position.load(std::memory_order_relaxed); }
+	int _get_decoded_loop_count() const { return decoded_loop_count.load(std::memory_order_relaxed); }
+	// Whether decoded frames are waiting to be mixed.
+	bool _has_decoded_frames() const;
+	// Current decoder position and loop count, stored with every decoded chunk.
+	virtual double _get_decoder_position() const { return 0.0; }
+	virtual int _get_decoder_loop_count() const { return 0; }
+
 	void begin_resample();
 	// Returns the number of frames that were mixed.
 	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames);
@@ -149,6 +245,7 @@ public:
 	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override;
 
 	AudioStreamPlaybackResampled() { mix_offset = 0; }
+	~AudioStreamPlaybackResampled();
 };
 
 class AudioStream : public Resource {
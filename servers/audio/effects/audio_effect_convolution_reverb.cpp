@@ -0,0 +1,472 @@
+/**************************************************************************/
+/*  audio_effect_convolution_reverb.cpp                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_effect_convolution_reverb.h"
+
+#include "servers/audio/audio_fft.h"
+#include "servers/audio_server.h"
+
+void AudioEffectConvolutionReverbInstance::_update_kernel() {
+	if (kernel_version == base->kernel_version.get()) {
+		return;
+	}
+	// Never wait for the main thread, the new kernel is picked up on a later mix instead.
+	if (!base->kernel_mutex.try_lock()) {
+		return;
+	}
+	if (kernel) {
+		kernel->users--;
+	}
+	// The buffers come with the kernel, they belong to it and are freed with it.
+	kernel = base->kernel;
+	state = next_state;
+	next_state = nullptr;
+	if (kernel) {
+		kernel->users++;
+	}
+	kernel_version = base->kernel_version.get();
+	base->kernel_mutex.unlock();
+}
+
+void AudioEffectConvolutionReverbInstance::_process_partition() {
+	// Uniformly partitioned overlap-save convolution. Each partition of input is transformed once,
+	// then multiplied with every partition of the impulse response it overlaps with in the frequency domain.
+	const int partition_size = kernel->partition_size;
+	const int partition_count = kernel->partition_count;
+	const int fft_size = partition_size * 2;
+	const int bin_count = partition_size + 1;
+
+	// Both channels are real, so they share one complex FFT: left in the real part, right in the imaginary part.
+	float *fft = state->fft_buffer.ptr();
+	const AudioFrame *in = state->input.ptr();
+	for (int i = 0; i < fft_size; i++) {
+		fft[i * 2 + 0] = in[i].left;
+		fft[i * 2 + 1] = in[i].right;
+	}
+	AudioFFT::transform(fft, fft_size, AudioFFT::FORWARD);
+
+	// Split the channels back apart using the conjugate symmetry of real signals.
+	// The factor of 1/2 this needs is folded into the kernel.
+	state->spectrum_pos = state->spectrum_pos == 0 ? partition_count - 1 : state->spectrum_pos - 1;
+	float *left_real = state->spectrum_real[0].ptr() + state->spectrum_pos * bin_count;
+	float *left_imag = state->spectrum_imag[0].ptr() + state->spectrum_pos * bin_count;
+	float *right_real = state->spectrum_real[1].ptr() + state->spectrum_pos * bin_count;
+	float *right_imag = state->spectrum_imag[1].ptr() + state->spectrum_pos * bin_count;
+	for (int k = 0; k < bin_count; k++) {
+		const int n = (fft_size - k) & (fft_size - 1);
+		const float xr = fft[k * 2 + 0];
+		const float xi = fft[k * 2 + 1];
+		const float yr = fft[n * 2 + 0];
+		const float yi = fft[n * 2 + 1];
+		left_real[k] = xr + yr;
+		left_imag[k] = xi - yi;
+		right_real[k] = xi + yi;
+		right_imag[k] = yr - xr;
+	}
+
+	for (int i = 0; i < 2; i++) {
+		memset(state->accum_real[i].ptr(), 0, bin_count * sizeof(float));
+		memset(state->accum_imag[i].ptr(), 0, bin_count * sizeof(float));
+	}
+	for (int p = 0; p < partition_count; p++) {
+		// The spectrum p partitions old goes with the impulse response partition p.
+		int slot = state->spectrum_pos + p;
+		if (slot >= partition_count) {
+			slot -= partition_count;
+		}
+		for (int i = 0; i < 2; i++) {
+			AudioFFT::complex_multiply_add(state->accum_real[i].ptr(), state->accum_imag[i].ptr(),
+					state->spectrum_real[i].ptr() + slot * bin_count, state->spectrum_imag[i].ptr() + slot * bin_count,
+					kernel->real[i].ptr() + p * bin_count, kernel->imag[i].ptr() + p * bin_count, bin_count);
+		}
+	}
+
+	// Pack both channels into one spectrum again, the upper half mirrors the lower one.
+	const float *wet_left_real = state->accum_real[0].ptr();
+	const float *wet_left_imag = state->accum_imag[0].ptr();
+	const float *wet_right_real = state->accum_real[1].ptr();
+	const float *wet_right_imag = state->accum_imag[1].ptr();
+	for (int k = 0; k < bin_count; k++) {
+		fft[k * 2 + 0] = wet_left_real[k] - wet_right_imag[k];
+		fft[k * 2 + 1] = wet_left_imag[k] + wet_right_real[k];
+	}
+	for (int k = bin_count; k < fft_size; k++) {
+		const int m = fft_size - k;
+		fft[k * 2 + 0] = wet_left_real[m] + wet_right_imag[m];
+		fft[k * 2 + 1] = wet_right_real[m] - wet_left_imag[m];
+	}
+	AudioFFT::transform(fft, fft_size, AudioFFT::INVERSE);
+
+	// Only the second half is free of circular wraparound.
+	AudioFrame *out = state->output.ptr();
+	for (int i = 0; i < partition_size; i++) {
+		out[i] = AudioFrame(fft[(partition_size + i) * 2 + 0], fft[(partition_size + i) * 2 + 1]);
+	}
+	memcpy(state->input.ptr(), state->input.ptr() + partition_size, partition_size * sizeof(AudioFrame));
+}
+
+void AudioEffectConvolutionReverbInstance::process(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) {
+	_update_kernel();
+
+	const float dry = base->dry;
+	const float wet = base->wet;
+
+	if (!kernel || !state) {
+		for (int i = 0; i < p_frame_count; i++) {
+			p_dst_frames[i] = p_src_frames[i] * dry;
+		}
+		return;
+	}
+
+	// The wet signal lags one partition behind, the time it takes to fill it.
+	const int partition_size = kernel->partition_size;
+	int offset = 0;
+	while (offset < p_frame_count) {
+		const int to_fill = MIN(p_frame_count - offset, partition_size - state->fill_pos);
+		AudioFrame *in = state->input.ptr() + partition_size + state->fill_pos;
+		const AudioFrame *out = state->output.ptr() + state->fill_pos;
+		const AudioFrame *src = p_src_frames + offset;
+		AudioFrame *dst = p_dst_frames + offset;
+		for (int i = 0; i < to_fill; i++) {
+			in[i] = src[i];
+			dst[i] = src[i] * dry + out[i] * wet;
+		}
+
+		state->fill_pos += to_fill;
+		offset += to_fill;
+		if (state->fill_pos == partition_size) {
+			_process_partition();
+			state->fill_pos = 0;
+		}
+	}
+}
+
+AudioEffectConvolutionReverbInstance::~AudioEffectConvolutionReverbInstance() {
+	MutexLock lock(base->kernel_mutex);
+	base->instances.erase(this);
+	if (next_state) {
+		base->kernel->states.erase(next_state);
+		memdelete(next_state);
+	}
+	if (kernel) {
+		kernel->states.erase(state);
+		memdelete(state);
+		kernel->users--;
+	}
+}
+
+AudioEffectConvolutionReverbKernel::~AudioEffectConvolutionReverbKernel() {
+	for (AudioEffectConvolutionReverbState *state : states) {
+		memdelete(state);
+	}
+}
+
+AudioEffectConvolutionReverbState *AudioEffectConvolutionReverb::_create_state(AudioEffectConvolutionReverbKernel *p_kernel) {
+	const int partition_size = p_kernel->partition_size;
+	const int bin_count = partition_size + 1;
+
+	AudioEffectConvolutionReverbState *state = memnew(AudioEffectConvolutionReverbState);
+	state->input.resize(partition_size * 2);
+	state->output.resize(partition_size);
+	state->fft_buffer.resize(partition_size * 4);
+	for (int i = 0; i < 2; i++) {
+		state->spectrum_real[i].resize(p_kernel->partition_count * bin_count);
+		state->spectrum_imag[i].resize(p_kernel->partition_count * bin_count);
+		state->accum_real[i].resize(bin_count);
+		state->accum_imag[i].resize(bin_count);
+		memset(state->spectrum_real[i].ptr(), 0, state->spectrum_real[i].size() * sizeof(float));
+		memset(state->spectrum_imag[i].ptr(), 0, state->spectrum_imag[i].size() * sizeof(float));
+	}
+	memset(state->input.ptr(), 0, state->input.size() * sizeof(AudioFrame));
+	memset(state->output.ptr(), 0, state->output.size() * sizeof(AudioFrame));
+
+	p_kernel->states.push_back(state);
+	return state;
+}
+
+AudioEffectConvolutionReverbKernel *AudioEffectConvolutionReverb::_create_kernel(const AudioFrame *p_impulse, int p_frame_count, int p_partition_size) {
+	const int fft_size = p_partition_size * 2;
+	const int bin_count = p_partition_size + 1;
+
+	AudioEffectConvolutionReverbKernel *kernel = memnew(AudioEffectConvolutionReverbKernel);
+	kernel->partition_size = p_partition_size;
+	kernel->partition_count = MAX(1, (p_frame_count + p_partition_size - 1) / p_partition_size);
+	for (int i = 0; i < 2; i++) {
+		kernel->real[i].resize(kernel->partition_count * bin_count);
+		kernel->imag[i].resize(kernel->partition_count * bin_count);
+	}
+
+	// 1/2 to split the channels of the kernel, 1/2 to split the channels of the input,
+	// and 1/fft_size because the inverse transform is not normalized.
+	const float scale = 0.25 / fft_size;
+
+	LocalVector<float> fft;
+	fft.resize(fft_size * 2);
+	for (int p = 0; p < kernel->partition_count; p++) {
+		const int offset = p * p_partition_size;
+		const int count = CLAMP(p_frame_count - offset, 0, p_partition_size);
+		memset(fft.ptr(), 0, fft.size() * sizeof(float));
+		for (int i = 0; i < count; i++) {
+			fft[i * 2 + 0] = p_impulse[offset + i].left;
+			fft[i * 2 + 1] = p_impulse[offset + i].right;
+		}
+		AudioFFT::transform(fft.ptr(), fft_size, AudioFFT::FORWARD);
+
+		float *left_real = kernel->real[0].ptr() + p * bin_count;
+		float *left_imag = kernel->imag[0].ptr() + p * bin_count;
+		float *right_real = kernel->real[1].ptr() + p * bin_count;
+		float *right_imag = kernel->imag[1].ptr() + p * bin_count;
+		for (int k = 0; k < bin_count; k++) {
+			const int n = (fft_size - k) & (fft_size - 1);
+			const float xr = fft[k * 2 + 0];
+			const float xi = fft[k * 2 + 1];
+			const float yr = fft[n * 2 + 0];
+			const float yi = fft[n * 2 + 1];
+			left_real[k] = (xr + yr) * scale;
+			left_imag[k] = (xi - yi) * scale;
+			right_real[k] = (xi + yi) * scale;
+			right_imag[k] = (yr - xr) * scale;
+		}
+	}
+
+	return kernel;
+}
+
+int AudioEffectConvolutionReverb::_get_partition_frames(PartitionSize p_size) {
+	return 256 << p_size;
+}
+
+void AudioEffectConvolutionReverb::_prepare_kernel(void *p_userdata) {
+	LocalVector<AudioFrame> frames;
+	frames.resize(prepare_frame_count);
+
+	int rendered = 0;
+	prepare_playback->start(0);
+	while (rendered < prepare_frame_count && prepare_playback->is_playing() && !prepare_aborted.is_set()) {
+		const int to_mix = MIN(prepare_frame_count - rendered, 1024);
+		const int mixed = prepare_playback->mix(frames.ptr() + rendered, 1.0, to_mix);
+		if (mixed <= 0) {
+			break;
+		}
+		rendered += mixed;
+		if (mixed < to_mix) {
+			break;
+		}
+	}
+	prepare_playback->stop();
+
+	if (prepare_aborted.is_set()) {
+		return;
+	}
+
+	// Trailing silence would only add partitions that contribute nothing.
+	while (rendered > 0 && Math::abs(frames[rendered - 1].left) < CMP_EPSILON && Math::abs(frames[rendered - 1].right) < CMP_EPSILON) {
+		rendered--;
+	}
+
+	_set_kernel(_create_kernel(frames.ptr(), rendered, prepare_partition_size));
+}
+
+void AudioEffectConvolutionReverb::_set_kernel(AudioEffectConvolutionReverbKernel *p_kernel) {
+	MutexLock lock(kernel_mutex);
+
+	if (kernel) {
+		retired_kernels.push_back(kernel);
+	}
+	kernel = p_kernel;
+	// Buffers of the previous kernel not picked up yet are freed with it.
+	for (AudioEffectConvolutionReverbInstance *instance : instances) {
+		instance->next_state = kernel ? _create_state(kernel) : nullptr;
+	}
+	kernel_version.increment();
+
+	_free_retired_kernels();
+}
+
+void AudioEffectConvolutionReverb::_free_retired_kernels() {
+	uint32_t i = 0;
+	while (i < retired_kernels.size()) {
+		if (retired_kernels[i]->users == 0) {
+			memdelete(retired_kernels[i]);
+			retired_kernels.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void AudioEffectConvolutionReverb::_update_callback(void *p_userdata) {
+	// Instances let go of the kernels they used on the audio thread, they're freed from here instead.
+	AudioEffectConvolutionReverb *self = static_cast<AudioEffectConvolutionReverb *>(p_userdata);
+	MutexLock lock(self->kernel_mutex);
+	self->_free_retired_kernels();
+}
+
+void AudioEffectConvolutionReverb::_cancel_kernel_preparation() {
+	if (prepare_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	prepare_aborted.set();
+	wait_for_impulse();
+	prepare_aborted.clear();
+}
+
+void AudioEffectConvolutionReverb::_queue_kernel_preparation() {
+	_cancel_kernel_preparation();
+
+	if (impulse.is_null()) {
+		_set_kernel(nullptr);
+		return;
+	}
+
+	prepare_playback = impulse->instantiate_playback();
+	ERR_FAIL_COND_MSG(prepare_playback.is_null(), "The impulse response stream can't be played back.");
+
+	double length = impulse->get_length();
+	if (length <= 0.0 || length > MAX_IMPULSE_LENGTH) {
+		length = MAX_IMPULSE_LENGTH;
+	}
+	prepare_frame_count = length * AudioServer::get_singleton()->get_mix_rate();
+	prepare_partition_size = _get_partition_frames(partition_size);
+
+	prepare_task = WorkerThreadPool::get_singleton()->add_template_task(this, &AudioEffectConvolutionReverb::_prepare_kernel, nullptr, false, vformat("AudioEffectConvolutionReverbImpulse:%x", (int64_t)get_instance_id()));
+}
+
+void AudioEffectConvolutionReverb::wait_for_impulse() {
+	if (prepare_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(prepare_task);
+	prepare_task = WorkerThreadPool::INVALID_TASK_ID;
+	prepare_playback.unref();
+}
+
+Ref<AudioEffectInstance> AudioEffectConvolutionReverb::instantiate() {
+	Ref<AudioEffectConvolutionReverbInstance> ins;
+	ins.instantiate();
+	ins->base = Ref<AudioEffectConvolutionReverb>(this);
+
+	MutexLock lock(kernel_mutex);
+	instances.push_back(ins.ptr());
+	if (kernel) {
+		ins->kernel = kernel;
+		ins->state = _create_state(kernel);
+		kernel->users++;
+	}
+	ins->kernel_version = kernel_version.get();
+	return ins;
+}
+
+void AudioEffectConvolutionReverb::set_impulse(const Ref<AudioStream> &p_impulse) {
+	if (impulse == p_impulse) {
+		return;
+	}
+	impulse = p_impulse;
+	_queue_kernel_preparation();
+}
+
+Ref<AudioStream> AudioEffectConvolutionReverb::get_impulse() const {
+	return impulse;
+}
+
+void AudioEffectConvolutionReverb::set_partition_size(PartitionSize p_size) {
+	ERR_FAIL_INDEX(p_size, PARTITION_SIZE_MAX);
+	if (partition_size == p_size) {
+		return;
+	}
+	partition_size = p_size;
+	_queue_kernel_preparation();
+}
+
+AudioEffectConvolutionReverb::PartitionSize AudioEffectConvolutionReverb::get_partition_size() const {
+	return partition_size;
+}
+
+void AudioEffectConvolutionReverb::set_dry(float p_dry) {
+	dry = p_dry;
+}
+
+float AudioEffectConvolutionReverb::get_dry() const {
+	return dry;
+}
+
+void AudioEffectConvolutionReverb::set_wet(float p_wet) {
+	wet = p_wet;
+}
+
+float AudioEffectConvolutionReverb::get_wet() const {
+	return wet;
+}
+
+void AudioEffectConvolutionReverb::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_impulse", "impulse"), &AudioEffectConvolutionReverb::set_impulse);
+	ClassDB::bind_method(D_METHOD("get_impulse"), &AudioEffectConvolutionReverb::get_impulse);
+
+	ClassDB::bind_method(D_METHOD("set_partition_size", "size"), &AudioEffectConvolutionReverb::set_partition_size);
+	ClassDB::bind_method(D_METHOD("get_partition_size"), &AudioEffectConvolutionReverb::get_partition_size);
+
+	ClassDB::bind_method(D_METHOD("set_dry", "amount"), &AudioEffectConvolutionReverb::set_dry);
+	ClassDB::bind_method(D_METHOD("get_dry"), &AudioEffectConvolutionReverb::get_dry);
+
+	ClassDB::bind_method(D_METHOD("set_wet", "amount"), &AudioEffectConvolutionReverb::set_wet);
+	ClassDB::bind_method(D_METHOD("get_wet"), &AudioEffectConvolutionReverb::get_wet);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "impulse", PROPERTY_HINT_RESOURCE_TYPE, "AudioStream"), "set_impulse", "get_impulse");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "partition_size", PROPERTY_HINT_ENUM, "256,512,1024,2048"), "set_partition_size", "get_partition_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dry", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_dry", "get_dry");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "wet", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_wet", "get_wet");
+
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_256);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_512);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_1024);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_2048);
+	BIND_ENUM_CONSTANT(PARTITION_SIZE_MAX);
+}
+
+AudioEffectConvolutionReverb::AudioEffectConvolutionReverb() {
+	if (AudioServer::get_singleton()) {
+		AudioServer::get_singleton()->add_update_callback(&AudioEffectConvolutionReverb::_update_callback, this);
+	}
+}
+
+AudioEffectConvolutionReverb::~AudioEffectConvolutionReverb() {
+	if (AudioServer::get_singleton()) {
+		AudioServer::get_singleton()->remove_update_callback(&AudioEffectConvolutionReverb::_update_callback, this);
+	}
+	_cancel_kernel_preparation();
+
+	// Instances keep a reference to the effect, so none of them can still use a kernel.
+	if (kernel) {
+		memdelete(kernel);
+	}
+	for (AudioEffectConvolutionReverbKernel *retired : retired_kernels) {
+		memdelete(retired);
+	}
+}
@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  audio_effect_convolution_reverb.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_EFFECT_CONVOLUTION_REVERB_H
+#define AUDIO_EFFECT_CONVOLUTION_REVERB_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "servers/audio/audio_effect.h"
+#include "servers/audio/audio_stream.h"
+
+class AudioEffectConvolutionReverb;
+
+// Buffers of one instance for one kernel. They're allocated along with the kernel, never on
+// the audio thread, and freed with it.
+struct AudioEffectConvolutionReverbState {
+	// Last two partitions of input, the second one being filled.
+	LocalVector<AudioFrame> input;
+	// Wet output of the last complete partition, played while the next one is filled.
+	LocalVector<AudioFrame> output;
+	int fill_pos = 0;
+
+	LocalVector<float> fft_buffer;
+	// Input spectra of the last partition_count partitions, newest at spectrum_pos.
+	LocalVector<float> spectrum_real[2];
+	LocalVector<float> spectrum_imag[2];
+	int spectrum_pos = 0;
+	LocalVector<float> accum_real[2];
+	LocalVector<float> accum_imag[2];
+};
+
+// Impulse response cut into partitions of partition_size frames, each transformed
+// with a 2 * partition_size FFT. Only the partition_size + 1 non-redundant bins of
+// every partition are kept, as separate real and imaginary arrays per channel.
+struct AudioEffectConvolutionReverbKernel {
+	int partition_size = 0;
+	int partition_count = 0;
+	LocalVector<float> real[2];
+	LocalVector<float> imag[2];
+
+	// Buffers of the instances, protected by the effect's kernel_mutex.
+	LocalVector<AudioEffectConvolutionReverbState *> states;
+	// Instances processing with this kernel, protected by the effect's kernel_mutex.
+	uint32_t users = 0;
+
+	~AudioEffectConvolutionReverbKernel();
+};
+
+class AudioEffectConvolutionReverbInstance : public AudioEffectInstance {
+	GDCLASS(AudioEffectConvolutionReverbInstance, AudioEffectInstance);
+
+	friend class AudioEffectConvolutionReverb;
+	Ref<AudioEffectConvolutionReverb> base;
+
+	AudioEffectConvolutionReverbKernel *kernel = nullptr;
+	AudioEffectConvolutionReverbState *state = nullptr;
+	uint64_t kernel_version = 0;
+	// Buffers for the kernel set last, picked up along with it. Protected by the effect's kernel_mutex.
+	AudioEffectConvolutionReverbState *next_state = nullptr;
+
+	void _update_kernel();
+	void _process_partition();
+
+public:
+	virtual void process(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) override;
+
+	~AudioEffectConvolutionReverbInstance();
+};
+
+class AudioEffectConvolutionReverb : public AudioEffect {
+	GDCLASS(AudioEffectConvolutionReverb, AudioEffect);
+
+public:
+	enum PartitionSize {
+		PARTITION_SIZE_256,
+		PARTITION_SIZE_512,
+		PARTITION_SIZE_1024,
+		PARTITION_SIZE_2048,
+		PARTITION_SIZE_MAX
+	};
+
+	// Longer impulse responses are cut, the cost of the convolution grows linearly with their length.
+	static constexpr double MAX_IMPULSE_LENGTH = 10.0;
+
+private:
+	friend class AudioEffectConvolutionReverbInstance;
+
+	Ref<AudioStream> impulse;
+	PartitionSize partition_size = PARTITION_SIZE_512;
+	float dry = 1.0;
+	float wet = 0.5;
+
+	// The kernel is prepared on a worker thread, with buffers for every instance, and picked
+	// up by the instances between two partitions. Replaced kernels are kept until no instance
+	// uses them, and freed from AudioServer's update, so the audio thread never allocates or
+	// frees memory.
+	Mutex kernel_mutex;
+	AudioEffectConvolutionReverbKernel *kernel = nullptr;
+	LocalVector<AudioEffectConvolutionReverbKernel *> retired_kernels;
+	LocalVector<AudioEffectConvolutionReverbInstance *> instances;
+	SafeNumeric<uint64_t> kernel_version;
+
+	WorkerThreadPool::TaskID prepare_task = WorkerThreadPool::INVALID_TASK_ID;
+	Ref<AudioStreamPlayback> prepare_playback;
+	int prepare_frame_count = 0;
+	int prepare_partition_size = 0;
+	SafeFlag prepare_aborted;
+
+	void _prepare_kernel(void *p_userdata);
+	void _cancel_kernel_preparation();
+	void _queue_kernel_preparation();
+	void _set_kernel(AudioEffectConvolutionReverbKernel *p_kernel);
+	void _free_retired_kernels();
+	static void _update_callback(void *p_userdata);
+
+	static AudioEffectConvolutionReverbKernel *_create_kernel(const AudioFrame *p_impulse, int p_frame_count, int p_partition_size);
+	static AudioEffectConvolutionReverbState *_create_state(AudioEffectConvolutionReverbKernel *p_kernel);
+	static int _get_partition_frames(PartitionSize p_size);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Ref<AudioEffectInstance> instantiate() override;
+
+	void set_impulse(const Ref<AudioStream> &p_impulse);
+	Ref<AudioStream> get_impulse() const;
+
+	void set_partition_size(PartitionSize p_size);
+	PartitionSize get_partition_size() const;
+
+	void set_dry(float p_dry);
+	float get_dry() const;
+
+	void set_wet(float p_wet);
+	float get_wet() const;
+
+	// Blocks until the impulse response set last is ready to be convolved with.
+	void wait_for_impulse();
+
+	AudioEffectConvolutionReverb();
+	~AudioEffectConvolutionReverb();
+};
+
+VARIANT_ENUM_CAST(AudioEffectConvolutionReverb::PartitionSize);
+
+#endif // AUDIO_EFFECT_CONVOLUTION_REVERB_H
@@ -50,8 +50,6 @@ class SMBPitchShift {
 	float gSynMagn[MAX_FRAME_LENGTH] = {};
 	long gRover = 0;
 
-	void smbFft(float *fftBuffer, long fftFrameSize, long sign);
-
 public:
 	void PitchShift(float pitchShift, long numSampsToProcess, long fftFrameSize, long osamp, float sampleRate, float *indata, float *outdata, int stride);
 };
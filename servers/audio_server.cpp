@@ -334,17 +334,38 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 #endif
 }
 
+AudioFrame *AudioServer::_get_bus_channel_mix_buffer(Bus *p_bus, int p_channel) {
+	Bus::Channel &channel = p_bus->channels.write[p_channel];
+	AudioFrame *data = channel.buffer.ptrw();
+
+	if (!channel.used) {
+		channel.used = true;
+		channel.active = true;
+		channel.last_mix_with_audio = mix_frames;
+		for (uint32_t i = 0; i < buffer_size; i++) {
+			data[i] = AudioFrame(0, 0);
+		}
+	}
+
+	return data;
+}
+
 void AudioServer::_mix_step() {
+	_apply_commands();
+
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
 		Bus *bus = buses[i];
+		if (bus->index_cache != i) {
+			bus_graph_dirty = true;
+		}
 		bus->index_cache = i; //might be moved around by editor, so..
 		for (int k = 0; k < bus->channels.size(); k++) {
 			bus->channels.write[k].used = false;
 		}
 
-		if (bus->solo) {
+		if (bus->mix.solo) {
 			//solo chain
 			solo_mode = true;
 			bus->soloed = true;
@@ -375,6 +396,7 @@ void AudioServer::_mix_step() {
 		ci->callback(ci->userdata);
 	}
 
+	mix_playbacks.clear();
 	for (AudioStreamPlaybackListNode *playback : playback_list) {
 		// Paused streams are no-ops. Don't even mix audio from the stream playback.
 		if (playback->state.load() == AudioStreamPlaybackListNode::PAUSED) {
@@ -385,269 +407,630 @@ void AudioServer::_mix_step() {
 			continue;
 		}
 
-		bool fading_out = playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
+		mix_playbacks.push_back(playback);
+	}
 
-		AudioFrame *buf = mix_buffer.ptrw();
+	_update_voices(solo_mode);
 
-		// Copy the lookeahead buffer into the mix buffer.
-		for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-			buf[i] = playback->lookahead[i];
+	if (mix_thread_pool.get_thread_count() == 0) {
+		AudioFrame *buf = mix_buffer.ptrw();
+		for (AudioStreamPlaybackListNode *playback : mix_playbacks) {
+			_mix_playback(playback, buf);
+			_mix_playback_to_buses(playback, buf);
+		}
+	} else {
+		// Streams are mixed in parallel, each into its own buffer, but they are summed into
+		// the buses in list order so the result does not depend on the thread count.
+		// Scripted and extension streams are mixed here on the audio thread afterwards, like isolated buses.
+		const uint32_t stride = buffer_size + LOOKAHEAD_BUFFER_SIZE;
+		if (playback_mix_buffers.size() < mix_playbacks.size() * stride) {
+			playback_mix_buffers.resize(mix_playbacks.size() * stride);
 		}
 
-		// Mix the audio stream
-		unsigned int mixed_frames = playback->stream_playback->mix(&buf[LOOKAHEAD_BUFFER_SIZE], playback->pitch_scale.get(), buffer_size);
+		mix_thread_pool.run(&AudioServer::_mix_playback_job, this, mix_playbacks.size());
+
+		for (uint32_t i = 0; i < mix_playbacks.size(); i++) {
+			if (_is_playback_mixed_serially(mix_playbacks[i])) {
+				_mix_playback(mix_playbacks[i], &playback_mix_buffers[i * stride]);
+			}
+		}
 
-		if (tag_used_audio_streams && playback->stream_playback->is_playing()) {
-			playback->stream_playback->tag_used_streams();
+		for (uint32_t i = 0; i < mix_playbacks.size(); i++) {
+			_mix_playback_to_buses(mix_playbacks[i], &playback_mix_buffers[i * stride]);
 		}
+	}
+
+	_update_bus_graph();
+
+	BusProcessJob job;
+	job.server = this;
+	job.temp_buffers = temp_buffer.ptrw();
+	job.solo_mode = solo_mode;
+
+	for (uint32_t level = 0; level + 1 < bus_level_offsets.size(); level++) {
+		job.buses = &bus_schedule[bus_level_offsets[level]];
+		mix_thread_pool.run(&AudioServer::_process_bus_job, &job, bus_level_offsets[level + 1] - bus_level_offsets[level]);
+	}
 
-		if (mixed_frames != buffer_size) {
-			// We know we have at least the size of our lookahead buffer for fade-out purposes.
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-			float fadeout_base = 0.94;
-			float fadeout_coefficient = 1;
-			static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
-			// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
-			for (unsigned int idx = mixed_frames; idx < buffer_size; idx++) {
-				fadeout_coefficient *= fadeout_base;
-				buf[idx] *= fadeout_coefficient;
+void AudioServer::_update_bus_audibility(bool p_solo_mode) {
+	bus_audibility.resize(buses.size());
+	for (int i = 0; i < buses.size(); i++) {
+		const Bus *bus = buses[i];
+
+		float volume = Math::db_to_linear(bus->mix.volume_db);
+		// Same as in _process_bus().
+		if (p_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
 			}
-			AudioStreamPlaybackListNode::PlaybackState new_state;
-			new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
-			playback->state.store(new_state);
 		} else {
-			// Move the last little bit of what we just mixed into our lookahead buffer.
-			for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-				playback->lookahead[i] = buf[buffer_size + i];
+			if (bus->mix.mute) {
+				volume = 0.0;
 			}
 		}
 
-		AudioStreamPlaybackBusDetails *ptr = playback->bus_details.load();
-		ERR_FAIL_NULL(ptr);
-		// By putting null into the bus details pointers, we're taking ownership of their memory for the duration of this mix.
-		AudioStreamPlaybackBusDetails bus_details = *ptr;
-
-		// Mix to any active buses.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!bus_details.bus_active[idx]) {
-				continue;
+		if (i > 0) {
+			// Buses can only send to buses before them, anything else goes to master.
+			int send_index = 0;
+			HashMap<StringName, Bus *>::ConstIterator E = bus_map.find(bus->send);
+			if (E && E->value->index_cache < i) {
+				send_index = E->value->index_cache;
 			}
-			int bus_idx = thread_find_bus_index(bus_details.bus[idx]);
+			volume *= bus_audibility[send_index];
+		}
 
-			int prev_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (!playback->prev_bus_details->bus_active[search_idx]) {
-					continue;
-				}
-				if (playback->prev_bus_details->bus[search_idx].hash() == bus_details.bus[idx].hash()) {
-					prev_bus_idx = search_idx;
-				}
-			}
+		bus_audibility[i] = volume;
+	}
+}
 
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				if (fading_out) {
-					bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
-				}
-				AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
+float AudioServer::_get_voice_audibility(const AudioStreamPlaybackListNode *p_playback) {
+	const AudioStreamPlaybackBusDetails *bus_details = &p_playback->bus_details;
 
-				AudioFrame prev_channel_vol = AudioFrame(0, 0);
-				if (prev_bus_idx != -1) {
-					prev_channel_vol = playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
-				}
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, channel_vol, playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
-			}
+	// Effects on the buses are ignored, this only needs to be good enough to tell silent voices apart.
+	float audibility = 0.0;
+	for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+		if (!bus_details->bus_active[idx]) {
+			continue;
+		}
+		const float bus_volume = bus_audibility[bus_details->bus[idx]];
+		for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+			const AudioFrame &volume = bus_details->volume[idx][channel_idx];
+			audibility = MAX(audibility, MAX(ABS(volume.left), ABS(volume.right)) * bus_volume);
 		}
+	}
+	return audibility;
+}
 
-		// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!playback->prev_bus_details->bus_active[idx]) {
-				continue;
-			}
-			int bus_idx = thread_find_bus_index(playback->prev_bus_details->bus[idx]);
+void AudioServer::_update_voices(bool p_solo_mode) {
+	_update_bus_audibility(p_solo_mode);
 
-			int current_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (bus_details.bus[search_idx] == playback->prev_bus_details->bus[idx]) {
-					current_bus_idx = search_idx;
-				}
-			}
-			if (current_bus_idx != -1) {
-				// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
-				continue;
-			}
+	const float threshold = Math::db_to_linear(virtual_voice_threshold_db);
+	// Voices have to get a bit louder than the threshold before they are made real again, so they don't flicker.
+	const float real_threshold = threshold * Math::db_to_linear(VIRTUAL_VOICE_HYSTERESIS_DB);
 
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				AudioFrame prev_channel_vol = playback->prev_bus_details->volume[idx][channel_idx];
-				// Fade out to silence
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, AudioFrame(0, 0), playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
-			}
+	voice_candidates.clear();
+	for (uint32_t i = 0; i < mix_playbacks.size(); i++) {
+		AudioStreamPlaybackListNode *playback = mix_playbacks[i];
+		playback->voice_audible = true;
+		if (!playback->voice_managed || playback->state.load() != AudioStreamPlaybackListNode::PLAYING) {
+			// Voices that are fading out are mixed until they are done.
+			continue;
 		}
 
-		// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			playback->prev_bus_details->bus_active[i] = bus_details.bus_active[i];
+		const float audibility = _get_voice_audibility(playback);
+		if (audibility < (playback->is_virtual.is_set() ? real_threshold : threshold)) {
+			playback->voice_audible = false;
+			continue;
 		}
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			playback->prev_bus_details->bus[i] = bus_details.bus[i];
+
+		VoiceCandidate candidate;
+		candidate.playback = playback;
+		candidate.priority = playback->voice_priority;
+		candidate.audibility = audibility;
+		candidate.order = i;
+		voice_candidates.push_back(candidate);
+	}
+
+	if (voice_budget > 0 && voice_candidates.size() > (uint32_t)voice_budget) {
+		// Only the most important audible voices are mixed.
+		voice_candidates.sort();
+		for (uint32_t i = voice_budget; i < voice_candidates.size(); i++) {
+			voice_candidates[i].playback->voice_audible = false;
 		}
-		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
-			for (int j = 0; j < MAX_CHANNELS_PER_BUS; j++) {
-				playback->prev_bus_details->volume[i][j] = bus_details.volume[i][j];
+	}
+
+	const double step_time = buffer_size / double(get_mix_rate()) * playback_speed_scale;
+	uint32_t virtual_count = 0;
+	uint32_t mixed_count = 0;
+
+	for (uint32_t i = 0; i < mix_playbacks.size(); i++) {
+		AudioStreamPlaybackListNode *playback = mix_playbacks[i];
+
+		if (!playback->is_virtual.is_set()) {
+			if (playback->voice_audible) {
+				playback->virtualizing = false;
+				mix_playbacks[mixed_count++] = playback;
+				continue;
 			}
+			if (!playback->virtualizing) {
+				// Mix it one more time, fading out, so it does not pop.
+				playback->virtualizing = true;
+				mix_playbacks[mixed_count++] = playback;
+				continue;
+			}
+
+			playback->virtualizing = false;
+			playback->is_virtual.set();
+			playback->virtual_time = 0.0;
 		}
 
 		switch (playback->state.load()) {
 			case AudioStreamPlaybackListNode::AWAITING_DELETION:
 			case AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION:
-				playback_list.erase(playback, [](AudioStreamPlaybackListNode *p) {
-					delete p->prev_bus_details;
-					delete p->bus_details.load();
-					p->stream_playback.unref();
-					delete p;
-				});
-				break;
-			case AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE: {
-				// Pause the stream.
-				AudioStreamPlaybackListNode::PlaybackState old_state, new_state;
-				do {
-					old_state = playback->state.load();
-					new_state = AudioStreamPlaybackListNode::PAUSED;
-				} while (!playback->state.compare_exchange_strong(/* expected= */ old_state, new_state));
-			} break;
+				// Nothing to fade out.
+				_erase_playback_list_node(playback);
+				continue;
+			case AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE:
+				playback->state.store(AudioStreamPlaybackListNode::PAUSED);
+				continue;
 			case AudioStreamPlaybackListNode::PLAYING:
 			case AudioStreamPlaybackListNode::PAUSED:
-				// No-op!
 				break;
 		}
-	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
+		if (playback->voice_audible) {
+			// Make it real again where it would be had it been mixed all along, it fades in from silence.
+			playback->is_virtual.clear();
+			for (AudioFrame &frame : playback->lookahead) {
+				frame = AudioFrame(0, 0);
+			}
+			if (!playback->stream_playback->skip(playback->virtual_time)) {
+				_erase_playback_list_node(playback);
+				continue;
+			}
+			playback->virtual_time = 0.0;
+			mix_playbacks[mixed_count++] = playback;
+			continue;
+		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		playback->virtual_time += step_time * playback->pitch_scale;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] = AudioFrame(0, 0);
-				}
+		// Skipping can be as expensive as seeking, so it's only done every now and then.
+		if (playback->virtual_time >= VIRTUAL_VOICE_SKIP_INTERVAL) {
+			const bool playing = playback->stream_playback->skip(playback->virtual_time);
+			playback->virtual_time = 0.0;
+			if (!playing) {
+				_erase_playback_list_node(playback);
+				continue;
 			}
 		}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
-				if (!bus->effects[j].enabled) {
-					continue;
-				}
+		virtual_count++;
+	}
 
-#ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
-#endif
+	mix_playbacks.resize(mixed_count);
+	virtual_voice_count.set(virtual_count);
+}
 
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+void AudioServer::_erase_playback_list_node(AudioStreamPlaybackListNode *p_playback) {
+	// Commands pushed before this may still point to the playback, see _retire_playbacks().
+	playback_list.erase(p_playback, [this](AudioStreamPlaybackListNode *p) {
+		RetiredPlayback retired;
+		retired.playback = p;
+		retired.command_position = command_ring.get_push_position();
+		retired_playbacks.push_back(retired);
+	});
+}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
-				}
+void AudioServer::_mix_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf) {
+	p_playback->fading_out = p_playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || p_playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE || p_playback->virtualizing;
 
-#ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
-#endif
+	AudioFrame *buf = p_buf;
+
+	// Copy the lookeahead buffer into the mix buffer.
+	for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
+		buf[i] = p_playback->lookahead[i];
+	}
+
+	// Mix the audio stream
+	unsigned int mixed_frames = p_playback->stream_playback->mix(&buf[LOOKAHEAD_BUFFER_SIZE], p_playback->pitch_scale, buffer_size);
+
+	if (mixed_frames != buffer_size) {
+		// We know we have at least the size of our lookahead buffer for fade-out purposes.
+
+		float fadeout_base = 0.94;
+		float fadeout_coefficient = 1;
+		static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
+		// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
+		for (unsigned int idx = mixed_frames; idx < buffer_size; idx++) {
+			fadeout_coefficient *= fadeout_base;
+			buf[idx] *= fadeout_coefficient;
+		}
+		AudioStreamPlaybackListNode::PlaybackState new_state;
+		new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
+		p_playback->state.store(new_state);
+	} else {
+		// Move the last little bit of what we just mixed into our lookahead buffer.
+		for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
+			p_playback->lookahead[i] = buf[buffer_size + i];
+		}
+	}
+}
+
+bool AudioServer::_is_playback_mixed_serially(const AudioStreamPlaybackListNode *p_playback) const {
+	// Scripts can be attached at any time, so they are checked on every mix.
+	return p_playback->mix_serially || p_playback->stream_playback->get_script_instance() != nullptr;
+}
+
+void AudioServer::_mix_playback_job(void *p_userdata, uint32_t p_index) {
+	AudioServer *server = static_cast<AudioServer *>(p_userdata);
+	if (server->_is_playback_mixed_serially(server->mix_playbacks[p_index])) {
+		return;
+	}
+	server->_mix_playback(server->mix_playbacks[p_index], &server->playback_mix_buffers[p_index * (server->buffer_size + LOOKAHEAD_BUFFER_SIZE)]);
+}
+
+void AudioServer::_mix_playback_to_buses(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf) {
+	AudioStreamPlaybackListNode *playback = p_playback;
+	AudioFrame *buf = p_buf;
+
+	if (tag_used_audio_streams && playback->stream_playback->is_playing()) {
+		playback->stream_playback->tag_used_streams();
+	}
+
+	AudioStreamPlaybackBusDetails bus_details = playback->bus_details;
+
+	// Mix to any active buses.
+	for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+		if (!bus_details.bus_active[idx]) {
+			continue;
+		}
+		int bus_idx = bus_details.bus[idx];
+
+		int prev_bus_idx = -1;
+		for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+			if (!playback->prev_bus_details->bus_active[search_idx]) {
+				continue;
+			}
+			if (playback->prev_bus_details->bus[search_idx] == bus_details.bus[idx]) {
+				prev_bus_idx = search_idx;
 			}
 		}
 
-		//process send
+		for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+			AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+			if (playback->fading_out) {
+				bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
+			}
+			AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
 
-		Bus *send = nullptr;
+			AudioFrame prev_channel_vol = AudioFrame(0, 0);
+			if (prev_bus_idx != -1) {
+				prev_channel_vol = playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
+			}
+			_mix_step_for_channel(channel_buf, buf, prev_channel_vol, channel_vol, playback->attenuation_filter_cutoff_hz, playback->highshelf_gain, &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
+		}
+	}
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+	// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
+	for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+		if (!playback->prev_bus_details->bus_active[idx]) {
+			continue;
+		}
+		int bus_idx = playback->prev_bus_details->bus[idx];
+
+		int current_bus_idx = -1;
+		for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+			if (bus_details.bus_active[search_idx] && bus_details.bus[search_idx] == playback->prev_bus_details->bus[idx]) {
+				current_bus_idx = search_idx;
 			}
 		}
+		if (current_bus_idx != -1) {
+			// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
+			continue;
+		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+		for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+			AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+			AudioFrame prev_channel_vol = playback->prev_bus_details->volume[idx][channel_idx];
+			// Fade out to silence
+			_mix_step_for_channel(channel_buf, buf, prev_channel_vol, AudioFrame(0, 0), playback->attenuation_filter_cutoff_hz, playback->highshelf_gain, &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
+		}
+	}
+
+	// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		playback->prev_bus_details->bus_active[i] = bus_details.bus_active[i];
+	}
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		playback->prev_bus_details->bus[i] = bus_details.bus[i];
+	}
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		for (int j = 0; j < MAX_CHANNELS_PER_BUS; j++) {
+			playback->prev_bus_details->volume[i][j] = bus_details.volume[i][j];
+		}
+	}
+
+	switch (playback->state.load()) {
+		case AudioStreamPlaybackListNode::AWAITING_DELETION:
+		case AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION:
+			_erase_playback_list_node(playback);
+			break;
+		case AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE: {
+			// Pause the stream.
+			AudioStreamPlaybackListNode::PlaybackState old_state, new_state;
+			do {
+				old_state = playback->state.load();
+				new_state = AudioStreamPlaybackListNode::PAUSED;
+			} while (!playback->state.compare_exchange_strong(/* expected= */ old_state, new_state));
+		} break;
+		case AudioStreamPlaybackListNode::PLAYING:
+		case AudioStreamPlaybackListNode::PAUSED:
+			// No-op!
+			break;
+	}
+}
+
+bool AudioServer::_is_bus_reading_other_buses(const Bus *p_bus) const {
+	if (p_bus->mix.bypass) {
+		return false;
+	}
+	for (const Bus::Effect &effect : p_bus->effects) {
+		if (!effect.mix_enabled) {
+			continue;
+		}
+		const AudioEffectCompressor *compressor = Object::cast_to<AudioEffectCompressor>(effect.effect.ptr());
+		if (compressor && compressor->get_sidechain() != StringName()) {
+			return true;
+		}
+		// Effects implemented in scripts or extensions may access anything.
+		if (effect.extension || effect.effect->get_script_instance()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool AudioServer::_is_bus_sharing_effects(int p_bus) const {
+	// Effects like AudioEffectCapture keep their data in the effect, which is shared by every bus it's added to.
+	for (const Bus::Effect &effect : buses[p_bus]->effects) {
+		for (int i = 0; i < buses.size(); i++) {
+			if (i == p_bus) {
 				continue;
 			}
+			for (const Bus::Effect &other : buses[i]->effects) {
+				if (other.effect == effect.effect) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+void AudioServer::_update_bus_graph() {
+	const int bus_count = buses.size();
+	if (bus_count == 0) {
+		bus_level_offsets.clear();
+		return;
+	}
 
-			AudioFrame peak = AudioFrame(0, 0);
+	// Sidechains can be changed on the effects directly, everything else goes through the server.
+	bool changed = bus_graph_dirty || bus_isolated.size() != (uint32_t)bus_count;
+	for (int i = 0; i < bus_count && !changed; i++) {
+		changed = bool(bus_isolated[i] & 1) != _is_bus_reading_other_buses(buses[i]);
+	}
+	if (!changed) {
+		return;
+	}
+	bus_graph_dirty = false;
 
-			float volume = Math::db_to_linear(bus->volume_db);
+	// Bit 0: reads other buses, bit 1: shares effects with other buses.
+	bus_isolated.resize(bus_count);
+	for (int i = 0; i < bus_count; i++) {
+		bus_isolated[i] = (_is_bus_reading_other_buses(buses[i]) ? 1 : 0) | (_is_bus_sharing_effects(i) ? 2 : 0);
+	}
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+	// Resolve sends, an invalid send goes to master.
+	bus_send_index.resize(bus_count);
+	bus_send_index[0] = -1;
+	for (int i = 1; i < bus_count; i++) {
+		int send = 0;
+		HashMap<StringName, Bus *>::ConstIterator E = bus_map.find(buses[i]->send);
+		if (E && E->value->index_cache < i) {
+			send = E->value->index_cache;
+		}
+		bus_send_index[i] = send;
+	}
+
+	// Children of every bus, in the descending order they were summed in when buses were processed one by one.
+	bus_child_offsets.resize(bus_count + 1);
+	for (int i = 0; i <= bus_count; i++) {
+		bus_child_offsets[i] = 0;
+	}
+	for (int i = 1; i < bus_count; i++) {
+		bus_child_offsets[bus_send_index[i] + 1]++;
+	}
+	for (int i = 0; i < bus_count; i++) {
+		bus_child_offsets[i + 1] += bus_child_offsets[i];
+	}
+	bus_children.resize(bus_count - 1);
+	bus_child_fill.resize(bus_count);
+	for (int i = 0; i < bus_count; i++) {
+		bus_child_fill[i] = bus_child_offsets[i];
+	}
+	for (int i = bus_count - 1; i > 0; i--) {
+		bus_children[bus_child_fill[bus_send_index[i]]++] = i;
+	}
+
+	// Split the buses into levels, following the order they are processed in one by one (last to first).
+	// A bus goes after all the buses sending to it. A bus with effects reading other buses (sidechains)
+	// or sharing effects with other buses gets a level of its own between everything before and after it,
+	// so what it reads and writes is the same as when processing serially. Buses in the same level are
+	// processed in parallel.
+	bus_level.resize(bus_count);
+	uint32_t level_count = 0;
+	uint32_t min_level = 0;
+	for (int i = bus_count - 1; i >= 0; i--) {
+		uint32_t level = min_level;
+		for (uint32_t c = bus_child_offsets[i]; c < bus_child_offsets[i + 1]; c++) {
+			level = MAX(level, bus_level[bus_children[c]] + 1);
+		}
+		if (bus_isolated[i]) {
+			level = MAX(level, level_count);
+			min_level = level + 1;
+		}
+		bus_level[i] = level;
+		level_count = MAX(level_count, level + 1);
+	}
+
+	bus_schedule.resize(bus_count);
+	bus_level_offsets.resize(level_count + 1);
+	uint32_t scheduled = 0;
+	uint32_t max_level_size = 0;
+	for (uint32_t level = 0; level < level_count; level++) {
+		bus_level_offsets[level] = scheduled;
+		for (int i = bus_count - 1; i >= 0; i--) {
+			if (bus_level[i] == level) {
+				bus_schedule[scheduled++] = i;
+			}
+		}
+		max_level_size = MAX(max_level_size, scheduled - bus_level_offsets[level]);
+	}
+	bus_level_offsets[level_count] = scheduled;
+
+	// Every bus processed at the same time needs its own temporary buffers for the effects.
+	uint32_t temp_buffer_count = max_level_size * channel_count;
+	if ((uint32_t)temp_buffer.size() < temp_buffer_count) {
+		int from = temp_buffer.size();
+		temp_buffer.resize(temp_buffer_count);
+		for (int i = from; i < temp_buffer.size(); i++) {
+			temp_buffer.write[i].resize(buffer_size);
+		}
+	}
+}
+
+void AudioServer::_process_bus_job(void *p_userdata, uint32_t p_index) {
+	BusProcessJob *job = static_cast<BusProcessJob *>(p_userdata);
+	job->server->_process_bus(job->buses[p_index], job->temp_buffers + p_index * job->server->channel_count, job->solo_mode);
+}
+
+void AudioServer::_process_bus(int p_bus, Vector<AudioFrame> *p_temp_buffers, bool p_solo_mode) {
+	Bus *bus = buses[p_bus];
+
+	// Sum the buses sending to this one, they were all processed in a previous level.
+	for (uint32_t c = bus_child_offsets[p_bus]; c < bus_child_offsets[p_bus + 1]; c++) {
+		const Bus *child = buses[bus_children[c]];
+		for (int k = 0; k < child->channels.size(); k++) {
+			if (!child->channels[k].sent) {
+				continue;
 			}
 
-			//apply volume and compute peak
+			_mix_accumulate(_get_bus_channel_mix_buffer(bus, k), child->channels[k].buffer.ptr(), buffer_size);
+		}
+	}
+
+	for (int k = 0; k < bus->channels.size(); k++) {
+		bus->channels.write[k].sent = false;
+
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+
 			for (uint32_t j = 0; j < buffer_size; j++) {
-				buf[j] *= volume;
+				buf[j] = AudioFrame(0, 0);
+			}
+		}
+	}
+
+	//process effects
+	if (!bus->mix.bypass) {
+		for (int j = 0; j < bus->effects.size(); j++) {
+			if (!bus->effects[j].mix_enabled) {
+				continue;
+			}
+
+#ifdef DEBUG_ENABLED
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+#endif
 
-				float l = ABS(buf[j].left);
-				if (l > peak.left) {
-					peak.left = l;
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
-				float r = ABS(buf[j].right);
-				if (r > peak.right) {
-					peak.right = r;
+				bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), p_temp_buffers[k].ptrw(), buffer_size);
+			}
+
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				SWAP(bus->channels.write[k].buffer, p_temp_buffers[k]);
 			}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+#ifdef DEBUG_ENABLED
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+#endif
+		}
+	}
+
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (!bus->channels[k].active) {
+			bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
+
+		AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+		AudioFrame peak = AudioFrame(0, 0);
 
-				if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
+		float volume = Math::db_to_linear(bus->mix.volume_db);
+
+		if (p_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mix.mute) {
+				volume = 0.0;
 			}
+		}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+		//apply volume and compute peak
+		for (uint32_t j = 0; j < buffer_size; j++) {
+			buf[j] *= volume;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+			float l = ABS(buf[j].left);
+			if (l > peak.left) {
+				peak.left = l;
+			}
+			float r = ABS(buf[j].right);
+			if (r > peak.right) {
+				peak.right = r;
 			}
 		}
-	}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false;
+				continue; //went inactive, don't mix.
+			}
+		}
+
+		//if not master bus, the bus it sends to picks this up
+		bus->channels.write[k].sent = p_bus > 0;
+	}
 }
 
 void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
@@ -669,22 +1052,57 @@ void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_sou
 		p_processor_r->set_filter(&filter, /* clear_history= */ is_just_started);
 		p_processor_r->update_coeffs(buffer_size);
 
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			AudioFrame vol = p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start;
-			AudioFrame mixed = vol * p_source_buf[frame_idx];
-			p_processor_l->process_one_interp(mixed.left);
-			p_processor_r->process_one_interp(mixed.right);
-			p_out_buf[frame_idx] += mixed;
+		// The filter is a recurrence, so apply the volume ramp and accumulate in separate loops
+		// that the compiler can vectorize, and only filter sample by sample.
+		AudioFrame mixed[MIX_BLOCK_SIZE];
+		for (unsigned int block_from = 0; block_from < buffer_size; block_from += MIX_BLOCK_SIZE) {
+			const unsigned int block_size = MIN((unsigned int)MIX_BLOCK_SIZE, buffer_size - block_from);
+
+			_mix_volume_ramp(mixed, p_source_buf + block_from, p_vol_start, p_vol_final, block_from, block_size);
+			AudioFilterSW::Processor::process_stereo(p_processor_l, p_processor_r, mixed, block_size, true);
+			_mix_accumulate(p_out_buf + block_from, mixed, block_size);
 		}
 
 	} else {
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			p_out_buf[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source_buf[frame_idx];
-		}
+		_mix_volume_ramp_accumulate(p_out_buf, p_source_buf, p_vol_start, p_vol_final, buffer_size);
+	}
+}
+
+// The volume ramp helpers work on plain floats so the loops vectorize. They compute
+// exactly what the AudioFrame operators would, so the output does not change.
+
+void AudioServer::_mix_volume_ramp(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, unsigned int p_from, unsigned int p_count) const {
+	const float start_l = p_vol_start.left;
+	const float start_r = p_vol_start.right;
+	const float final_l = p_vol_final.left;
+	const float final_r = p_vol_final.right;
+
+	for (unsigned int i = 0; i < p_count; i++) {
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		const float lerp_param = (float)(p_from + i) / buffer_size;
+		p_out_buf[i].left = (final_l * lerp_param + (1 - lerp_param) * start_l) * p_source_buf[i].left;
+		p_out_buf[i].right = (final_r * lerp_param + (1 - lerp_param) * start_r) * p_source_buf[i].right;
+	}
+}
+
+void AudioServer::_mix_volume_ramp_accumulate(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, unsigned int p_count) const {
+	const float start_l = p_vol_start.left;
+	const float start_r = p_vol_start.right;
+	const float final_l = p_vol_final.left;
+	const float final_r = p_vol_final.right;
+
+	for (unsigned int i = 0; i < p_count; i++) {
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		const float lerp_param = (float)i / buffer_size;
+		p_out_buf[i].left += (final_l * lerp_param + (1 - lerp_param) * start_l) * p_source_buf[i].left;
+		p_out_buf[i].right += (final_r * lerp_param + (1 - lerp_param) * start_r) * p_source_buf[i].right;
+	}
+}
+
+void AudioServer::_mix_accumulate(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, unsigned int p_count) {
+	for (unsigned int i = 0; i < p_count; i++) {
+		p_out_buf[i].left += p_source_buf[i].left;
+		p_out_buf[i].right += p_source_buf[i].right;
 	}
 }
 
@@ -697,6 +1115,128 @@ AudioServer::AudioStreamPlaybackListNode *AudioServer::_find_playback_list_node(
 	return nullptr;
 }
 
+void AudioServer::_push_command(const Command &p_command) {
+	if (command_ring.push(p_command)) {
+		return;
+	}
+
+	// The audio thread is not keeping up, or not running. Commands are only ever applied
+	// with the driver locked, so it's safe to apply them here.
+	lock();
+	_apply_commands();
+	_apply_command(p_command);
+	unlock();
+}
+
+void AudioServer::_apply_commands() {
+	Command command;
+	while (command_ring.pop(command)) {
+		_apply_command(command);
+	}
+}
+
+void AudioServer::_apply_command(const Command &p_command) {
+	switch (p_command.type) {
+		case Command::BUS_SET_VOLUME_DB: {
+			p_command.bus->mix.volume_db = p_command.value;
+		} break;
+		case Command::BUS_SET_SOLO: {
+			p_command.bus->mix.solo = p_command.enabled;
+		} break;
+		case Command::BUS_SET_MUTE: {
+			p_command.bus->mix.mute = p_command.enabled;
+		} break;
+		case Command::BUS_SET_BYPASS: {
+			p_command.bus->mix.bypass = p_command.enabled;
+			bus_graph_dirty = true;
+		} break;
+		case Command::BUS_SET_EFFECT_ENABLED: {
+			ERR_FAIL_INDEX(p_command.index, p_command.bus->effects.size());
+			p_command.bus->effects.write[p_command.index].mix_enabled = p_command.enabled;
+			bus_graph_dirty = true;
+		} break;
+		case Command::PLAYBACK_SET_BUS_DETAILS: {
+			p_command.playback->bus_details = p_command.bus_details;
+		} break;
+		case Command::PLAYBACK_SET_PITCH_SCALE: {
+			p_command.playback->pitch_scale = p_command.value;
+		} break;
+		case Command::PLAYBACK_SET_HIGHSHELF_PARAMS: {
+			p_command.playback->highshelf_gain = p_command.value;
+			p_command.playback->attenuation_filter_cutoff_hz = p_command.value2;
+		} break;
+		case Command::PLAYBACK_SET_VOICE_PRIORITY: {
+			p_command.playback->voice_priority = p_command.index;
+			p_command.playback->voice_managed = true;
+		} break;
+	}
+}
+
+void AudioServer::_sync_bus_mix_state(Bus *p_bus) {
+	p_bus->mix.volume_db = p_bus->volume_db;
+	p_bus->mix.solo = p_bus->solo;
+	p_bus->mix.mute = p_bus->mute;
+	p_bus->mix.bypass = p_bus->bypass;
+	for (int i = 0; i < p_bus->effects.size(); i++) {
+		p_bus->effects.write[i].mix_enabled = p_bus->effects[i].enabled;
+	}
+}
+
+int AudioServer::_find_bus_index_or_master(const StringName &p_name) const {
+	// Like thread_find_bus_index(), without the index cache updated by the audio thread.
+	for (int i = 0; i < buses.size(); i++) {
+		if (buses[i]->name == p_name) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+LocalVector<StringName> AudioServer::_get_bus_names() const {
+	LocalVector<StringName> names;
+	names.resize(buses.size());
+	for (int i = 0; i < buses.size(); i++) {
+		names[i] = buses[i]->name;
+	}
+	return names;
+}
+
+void AudioServer::_update_playback_bus_indices(const LocalVector<StringName> &p_old_bus_names) {
+	// Called with bus_details_mutex held and the driver locked, after the pending commands were applied,
+	// so the details of every playback are the last ones requested.
+	for (AudioStreamPlaybackListNode *playback : playback_list) {
+		for (int i = 0; i < playback->requested_bus_count; i++) {
+			playback->bus_details.bus[i] = _find_bus_index_or_master(playback->requested_buses[i]);
+		}
+		// Keeps the volume ramps going on the buses mixed to last.
+		AudioStreamPlaybackBusDetails *prev_bus_details = playback->prev_bus_details;
+		for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+			if (prev_bus_details->bus_active[i]) {
+				const int old_index = prev_bus_details->bus[i];
+				prev_bus_details->bus[i] = old_index < (int)p_old_bus_names.size() ? _find_bus_index_or_master(p_old_bus_names[old_index]) : 0;
+			}
+		}
+	}
+}
+
+void AudioServer::_retire_playbacks() {
+	const uint32_t pop_position = command_ring.get_pop_position();
+	uint32_t i = 0;
+	while (i < retired_playbacks.size()) {
+		const RetiredPlayback &retired = retired_playbacks[i];
+		if (int32_t(pop_position - retired.command_position) < 0) {
+			// Commands pointing to it may still be in the ring.
+			i++;
+			continue;
+		}
+
+		delete retired.playback->prev_bus_details;
+		retired.playback->stream_playback.unref();
+		delete retired.playback;
+		retired_playbacks.remove_at_unordered(i);
+	}
+}
+
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
 	if (p_bus < 0 || p_bus >= buses.size()) {
 		return false;
@@ -711,18 +1251,7 @@ AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer)
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
 	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
 
-	AudioFrame *data = buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
-
-	if (!buses[p_bus]->channels[p_buffer].used) {
-		buses.write[p_bus]->channels.write[p_buffer].used = true;
-		buses.write[p_bus]->channels.write[p_buffer].active = true;
-		buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio = mix_frames;
-		for (uint32_t i = 0; i < buffer_size; i++) {
-			data[i] = AudioFrame(0, 0);
-		}
-	}
-
-	return data;
+	return _get_bus_channel_mix_buffer(buses[p_bus], p_buffer);
 }
 
 int AudioServer::thread_get_mix_buffer_size() const {
@@ -743,7 +1272,11 @@ void AudioServer::set_bus_count(int p_count) {
 
 	MARK_EDITED
 
+	MutexLock bus_details_lock(bus_details_mutex);
 	lock();
+	// Pending commands may point to the buses about to be deleted.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
 	int cb = buses.size();
 
 	if (p_count < buses.size()) {
@@ -754,6 +1287,7 @@ void AudioServer::set_bus_count(int p_count) {
 	}
 
 	buses.resize(p_count);
+	bus_graph_dirty = true;
 
 	for (int i = cb; i < buses.size(); i++) {
 		String attempt = "New Bus";
@@ -788,10 +1322,12 @@ void AudioServer::set_bus_count(int p_count) {
 		if (i > 0) {
 			buses[i]->send = SceneStringName(Master);
 		}
+		_sync_bus_mix_state(buses[i]);
 
 		bus_map[attempt] = buses[i];
 	}
 
+	_update_playback_bus_indices(old_bus_names);
 	unlock();
 
 	AudioDriver::get_singleton()->set_sample_bus_count(p_count);
@@ -805,10 +1341,16 @@ void AudioServer::remove_bus(int p_index) {
 
 	MARK_EDITED
 
+	MutexLock bus_details_lock(bus_details_mutex);
 	lock();
+	// Pending commands may point to the bus about to be deleted.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
 	bus_map.erase(buses[p_index]->name);
 	memdelete(buses[p_index]);
 	buses.remove_at(p_index);
+	bus_graph_dirty = true;
+	_update_playback_bus_indices(old_bus_names);
 	unlock();
 
 	AudioDriver::get_singleton()->remove_sample_bus(p_index);
@@ -858,7 +1400,13 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->mute = false;
 	bus->bypass = false;
 	bus->volume_db = 0;
+	_sync_bus_mix_state(bus);
 
+	MutexLock bus_details_lock(bus_details_mutex);
+	lock();
+	// Pending commands carry indices of the buses before this one is inserted.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
 	bus_map[attempt] = bus;
 
 	if (p_at_pos == -1) {
@@ -866,6 +1414,9 @@ void AudioServer::add_bus(int p_at_pos) {
 	} else {
 		buses.insert(p_at_pos, bus);
 	}
+	bus_graph_dirty = true;
+	_update_playback_bus_indices(old_bus_names);
+	unlock();
 
 	AudioDriver::get_singleton()->add_sample_bus(p_at_pos);
 
@@ -882,6 +1433,11 @@ void AudioServer::move_bus(int p_bus, int p_to_pos) {
 		return;
 	}
 
+	MutexLock bus_details_lock(bus_details_mutex);
+	lock();
+	// Pending commands carry indices of the buses before the move.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
 	Bus *bus = buses[p_bus];
 	buses.remove_at(p_bus);
 
@@ -892,6 +1448,9 @@ void AudioServer::move_bus(int p_bus, int p_to_pos) {
 	} else {
 		buses.insert(p_to_pos - 1, bus);
 	}
+	bus_graph_dirty = true;
+	_update_playback_bus_indices(old_bus_names);
+	unlock();
 
 	AudioDriver::get_singleton()->move_sample_bus(p_bus, p_to_pos);
 
@@ -910,6 +1469,7 @@ void AudioServer::set_bus_name(int p_bus, const String &p_name) {
 
 	MARK_EDITED
 
+	MutexLock bus_details_lock(bus_details_mutex);
 	lock();
 
 	StringName old_name = buses[p_bus]->name;
@@ -919,6 +1479,10 @@ void AudioServer::set_bus_name(int p_bus, const String &p_name) {
 		return;
 	}
 
+	// Pending commands carry indices resolved with the old name.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
+
 	String attempt = p_name;
 	int attempts = 1;
 
@@ -941,6 +1505,8 @@ void AudioServer::set_bus_name(int p_bus, const String &p_name) {
 	bus_map.erase(old_name);
 	buses[p_bus]->name = attempt;
 	bus_map[attempt] = buses[p_bus];
+	bus_graph_dirty = true;
+	_update_playback_bus_indices(old_bus_names);
 	unlock();
 
 	emit_signal(SNAME("bus_renamed"), p_bus, old_name, attempt);
@@ -967,6 +1533,12 @@ void AudioServer::set_bus_volume_db(int p_bus, float p_volume_db) {
 
 	buses[p_bus]->volume_db = p_volume_db;
 
+	Command command;
+	command.type = Command::BUS_SET_VOLUME_DB;
+	command.bus = buses[p_bus];
+	command.value = p_volume_db;
+	_push_command(command);
+
 	AudioDriver::get_singleton()->set_sample_bus_volume_db(p_bus, p_volume_db);
 }
 
@@ -985,7 +1557,10 @@ void AudioServer::set_bus_send(int p_bus, const StringName &p_send) {
 
 	MARK_EDITED
 
+	lock();
 	buses[p_bus]->send = p_send;
+	bus_graph_dirty = true;
+	unlock();
 
 	AudioDriver::get_singleton()->set_sample_bus_send(p_bus, p_send);
 }
@@ -1002,6 +1577,12 @@ void AudioServer::set_bus_solo(int p_bus, bool p_enable) {
 
 	buses[p_bus]->solo = p_enable;
 
+	Command command;
+	command.type = Command::BUS_SET_SOLO;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_command(command);
+
 	AudioDriver::get_singleton()->set_sample_bus_solo(p_bus, p_enable);
 }
 
@@ -1018,6 +1599,12 @@ void AudioServer::set_bus_mute(int p_bus, bool p_enable) {
 
 	buses[p_bus]->mute = p_enable;
 
+	Command command;
+	command.type = Command::BUS_SET_MUTE;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_command(command);
+
 	AudioDriver::get_singleton()->set_sample_bus_mute(p_bus, p_enable);
 }
 
@@ -1033,6 +1620,12 @@ void AudioServer::set_bus_bypass_effects(int p_bus, bool p_enable) {
 	MARK_EDITED
 
 	buses[p_bus]->bypass = p_enable;
+
+	Command command;
+	command.type = Command::BUS_SET_BYPASS;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_command(command);
 }
 
 bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
@@ -1042,6 +1635,10 @@ bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
 }
 
 void AudioServer::_update_bus_effects(int p_bus) {
+	for (int j = 0; j < buses[p_bus]->effects.size(); j++) {
+		const ClassDB::APIType api = ClassDB::get_api_type(buses[p_bus]->effects[j].effect->get_class_name());
+		buses.write[p_bus]->effects.write[j].extension = api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION;
+	}
 	for (int i = 0; i < buses[p_bus]->channels.size(); i++) {
 		buses.write[p_bus]->channels.write[i].effect_instances.resize(buses[p_bus]->effects.size());
 		for (int j = 0; j < buses[p_bus]->effects.size(); j++) {
@@ -1061,11 +1658,13 @@ void AudioServer::add_bus_effect(int p_bus, const Ref<AudioEffect> &p_effect, in
 	MARK_EDITED
 
 	lock();
+	_apply_commands();
 
 	Bus::Effect fx;
 	fx.effect = p_effect;
 	//fx.instance=p_effect->instantiate();
 	fx.enabled = true;
+	fx.mix_enabled = true;
 #ifdef DEBUG_ENABLED
 	fx.prof_time = 0;
 #endif
@@ -1077,6 +1676,7 @@ void AudioServer::add_bus_effect(int p_bus, const Ref<AudioEffect> &p_effect, in
 	}
 
 	_update_bus_effects(p_bus);
+	bus_graph_dirty = true;
 
 	unlock();
 }
@@ -1087,9 +1687,11 @@ void AudioServer::remove_bus_effect(int p_bus, int p_effect) {
 	MARK_EDITED
 
 	lock();
+	_apply_commands();
 
 	buses[p_bus]->effects.remove_at(p_effect);
 	_update_bus_effects(p_bus);
+	bus_graph_dirty = true;
 
 	unlock();
 }
@@ -1123,8 +1725,10 @@ void AudioServer::swap_bus_effects(int p_bus, int p_effect, int p_by_effect) {
 	MARK_EDITED
 
 	lock();
+	_apply_commands();
 	SWAP(buses.write[p_bus]->effects.write[p_effect], buses.write[p_bus]->effects.write[p_by_effect]);
 	_update_bus_effects(p_bus);
+	bus_graph_dirty = true;
 	unlock();
 }
 
@@ -1135,6 +1739,13 @@ void AudioServer::set_bus_effect_enabled(int p_bus, int p_effect, bool p_enabled
 	MARK_EDITED
 
 	buses.write[p_bus]->effects.write[p_effect].enabled = p_enabled;
+
+	Command command;
+	command.type = Command::BUS_SET_EFFECT_ENABLED;
+	command.bus = buses[p_bus];
+	command.index = p_effect;
+	command.enabled = p_enabled;
+	_push_command(command);
 }
 
 bool AudioServer::is_bus_effect_enabled(int p_bus, int p_effect) const {
@@ -1189,28 +1800,33 @@ void AudioServer::start_playback_stream(Ref<AudioStreamPlayback> p_playback, con
 	AudioStreamPlaybackListNode *playback_node = new AudioStreamPlaybackListNode();
 	playback_node->stream_playback = p_playback;
 	playback_node->stream_playback->start(p_start_time);
+	ClassDB::APIType api = ClassDB::get_api_type(p_playback->get_class_name());
+	playback_node->mix_serially = api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION;
+
+	MutexLock bus_details_lock(bus_details_mutex);
 
-	AudioStreamPlaybackBusDetails *new_bus_details = new AudioStreamPlaybackBusDetails();
 	int idx = 0;
 	for (KeyValue<StringName, Vector<AudioFrame>> pair : p_bus_volumes) {
 		if (pair.value.size() < channel_count || pair.value.size() != MAX_CHANNELS_PER_BUS) {
-			delete new_bus_details;
+			delete playback_node;
 			ERR_FAIL();
 		}
 
-		new_bus_details->bus_active[idx] = true;
-		new_bus_details->bus[idx] = pair.key;
+		// The node is not in the list yet, so the audio thread can't see it.
+		playback_node->bus_details.bus_active[idx] = true;
+		playback_node->bus_details.bus[idx] = _find_bus_index_or_master(pair.key);
 		for (int channel_idx = 0; channel_idx < MAX_CHANNELS_PER_BUS; channel_idx++) {
-			new_bus_details->volume[idx][channel_idx] = pair.value[channel_idx];
+			playback_node->bus_details.volume[idx][channel_idx] = pair.value[channel_idx];
 		}
+		playback_node->requested_buses[idx] = pair.key;
 		idx++;
 	}
-	playback_node->bus_details.store(new_bus_details);
+	playback_node->requested_bus_count = idx;
 	playback_node->prev_bus_details = new AudioStreamPlaybackBusDetails();
 
-	playback_node->pitch_scale.set(p_pitch_scale);
-	playback_node->highshelf_gain.set(p_highshelf_gain);
-	playback_node->attenuation_filter_cutoff_hz.set(p_attenuation_cutoff_hz);
+	playback_node->pitch_scale = p_pitch_scale;
+	playback_node->highshelf_gain = p_highshelf_gain;
+	playback_node->attenuation_filter_cutoff_hz = p_attenuation_cutoff_hz;
 
 	memset(playback_node->prev_bus_details->volume, 0, sizeof(playback_node->prev_bus_details->volume));
 
@@ -1271,8 +1887,12 @@ void AudioServer::set_playback_bus_volumes_linear(Ref<AudioStreamPlayback> p_pla
 	if (!playback_node) {
 		return;
 	}
-	AudioStreamPlaybackBusDetails *old_bus_details, *new_bus_details = new AudioStreamPlaybackBusDetails();
 
+	Command command;
+	command.type = Command::PLAYBACK_SET_BUS_DETAILS;
+	command.playback = playback_node;
+
+	StringName requested_buses[MAX_BUSES_PER_PLAYBACK];
 	int idx = 0;
 	for (KeyValue<StringName, Vector<AudioFrame>> pair : p_bus_volumes) {
 		if (idx >= MAX_BUSES_PER_PLAYBACK) {
@@ -1281,19 +1901,25 @@ void AudioServer::set_playback_bus_volumes_linear(Ref<AudioStreamPlayback> p_pla
 		ERR_FAIL_COND(pair.value.size() < channel_count);
 		ERR_FAIL_COND(pair.value.size() != MAX_CHANNELS_PER_BUS);
 
-		new_bus_details->bus_active[idx] = true;
-		new_bus_details->bus[idx] = pair.key;
+		command.bus_details.bus_active[idx] = true;
 		for (int channel_idx = 0; channel_idx < MAX_CHANNELS_PER_BUS; channel_idx++) {
-			new_bus_details->volume[idx][channel_idx] = pair.value[channel_idx];
+			command.bus_details.volume[idx][channel_idx] = pair.value[channel_idx];
 		}
+		requested_buses[idx] = pair.key;
 		idx++;
 	}
 
-	do {
-		old_bus_details = playback_node->bus_details.load();
-	} while (!playback_node->bus_details.compare_exchange_strong(old_bus_details, new_bus_details));
-
-	bus_details_graveyard.insert(old_bus_details);
+	// Held while pushing, so the command carries indices matching the current buses, and commands
+	// for the same playback from different threads arrive in the order the requests were made.
+	MutexLock bus_details_lock(bus_details_mutex);
+	for (int i = 0; i < MAX_BUSES_PER_PLAYBACK; i++) {
+		if (i < idx) {
+			command.bus_details.bus[i] = _find_bus_index_or_master(requested_buses[i]);
+		}
+		playback_node->requested_buses[i] = requested_buses[i];
+	}
+	playback_node->requested_bus_count = idx;
+	_push_command(command);
 }
 
 void AudioServer::set_playback_all_bus_volumes_linear(Ref<AudioStreamPlayback> p_playback, Vector<AudioFrame> p_volumes) {
@@ -1306,9 +1932,10 @@ void AudioServer::set_playback_all_bus_volumes_linear(Ref<AudioStreamPlayback> p
 	if (!playback_node) {
 		return;
 	}
-	for (int bus_idx = 0; bus_idx < MAX_BUSES_PER_PLAYBACK; bus_idx++) {
-		if (playback_node->bus_details.load()->bus_active[bus_idx]) {
-			map[playback_node->bus_details.load()->bus[bus_idx]] = p_volumes;
+	{
+		MutexLock bus_details_lock(bus_details_mutex);
+		for (int bus_idx = 0; bus_idx < playback_node->requested_bus_count; bus_idx++) {
+			map[playback_node->requested_buses[bus_idx]] = p_volumes;
 		}
 	}
 
@@ -1330,7 +1957,11 @@ void AudioServer::set_playback_pitch_scale(Ref<AudioStreamPlayback> p_playback,
 		return;
 	}
 
-	playback_node->pitch_scale.set(p_pitch_scale);
+	Command command;
+	command.type = Command::PLAYBACK_SET_PITCH_SCALE;
+	command.playback = playback_node;
+	command.value = p_pitch_scale;
+	_push_command(command);
 }
 
 void AudioServer::set_playback_paused(Ref<AudioStreamPlayback> p_playback, bool p_paused) {
@@ -1363,8 +1994,27 @@ void AudioServer::set_playback_highshelf_params(Ref<AudioStreamPlayback> p_playb
 		return;
 	}
 
-	playback_node->attenuation_filter_cutoff_hz.set(p_attenuation_cutoff_hz);
-	playback_node->highshelf_gain.set(p_gain);
+	Command command;
+	command.type = Command::PLAYBACK_SET_HIGHSHELF_PARAMS;
+	command.playback = playback_node;
+	command.value = p_gain;
+	command.value2 = p_attenuation_cutoff_hz;
+	_push_command(command);
+}
+
+void AudioServer::set_playback_voice_priority(Ref<AudioStreamPlayback> p_playback, int p_priority) {
+	ERR_FAIL_COND(p_playback.is_null());
+
+	AudioStreamPlaybackListNode *playback_node = _find_playback_list_node(p_playback);
+	if (!playback_node) {
+		return;
+	}
+
+	Command command;
+	command.type = Command::PLAYBACK_SET_VOICE_PRIORITY;
+	command.playback = playback_node;
+	command.index = p_priority;
+	_push_command(command);
 }
 
 bool AudioServer::is_playback_active(Ref<AudioStreamPlayback> p_playback) {
@@ -1410,6 +2060,38 @@ bool AudioServer::is_playback_paused(Ref<AudioStreamPlayback> p_playback) {
 	return playback_node->state.load() == AudioStreamPlaybackListNode::PAUSED || playback_node->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
 }
 
+bool AudioServer::is_playback_virtual(Ref<AudioStreamPlayback> p_playback) {
+	ERR_FAIL_COND_V(p_playback.is_null(), false);
+
+	AudioStreamPlaybackListNode *playback_node = _find_playback_list_node(p_playback);
+	if (!playback_node) {
+		return false;
+	}
+
+	return playback_node->is_virtual.is_set();
+}
+
+void AudioServer::set_voice_budget(int p_budget) {
+	ERR_FAIL_COND_MSG(p_budget < 0, "Voice budget must not be negative.");
+	voice_budget = p_budget;
+}
+
+int AudioServer::get_voice_budget() const {
+	return voice_budget;
+}
+
+void AudioServer::set_virtual_voice_threshold_db(float p_threshold_db) {
+	virtual_voice_threshold_db = p_threshold_db;
+}
+
+float AudioServer::get_virtual_voice_threshold_db() const {
+	return virtual_voice_threshold_db;
+}
+
+int AudioServer::get_virtual_voice_count() const {
+	return virtual_voice_count.get();
+}
+
 uint64_t AudioServer::get_mix_count() const {
 	return mix_count;
 }
@@ -1440,6 +2122,7 @@ void AudioServer::init_channels_and_buffers() {
 		}
 		_update_bus_effects(i);
 	}
+	bus_graph_dirty = true;
 }
 
 void AudioServer::init() {
@@ -1449,6 +2132,11 @@ void AudioServer::init() {
 
 	init_channels_and_buffers();
 
+	mix_thread_pool.init(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "audio/general/mixing_threads", PROPERTY_HINT_RANGE, "0,16,1"), 0));
+	decode_ahead.init(int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "audio/general/decode_ahead_ms", PROPERTY_HINT_RANGE, "0,1000,1,suffix:ms"), 0)) / 1000.0);
+	voice_budget = GLOBAL_DEF(PropertyInfo(Variant::INT, "audio/general/voice_budget", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), 0);
+	virtual_voice_threshold_db = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "audio/general/virtual_voice_threshold_db", PROPERTY_HINT_RANGE, "-100,0,0.1,suffix:dB"), -80.0);
+
 	mix_count = 0;
 	set_bus_count(1);
 	set_bus_name(0, "Master");
@@ -1540,15 +2228,7 @@ void AudioServer::update() {
 	update_callback_list.maybe_cleanup();
 	listener_changed_callback_list.maybe_cleanup();
 	playback_list.maybe_cleanup();
-	for (AudioStreamPlaybackBusDetails *bus_details : bus_details_graveyard_frame_old) {
-		bus_details_graveyard_frame_old.erase(bus_details, [](AudioStreamPlaybackBusDetails *d) { delete d; });
-	}
-	for (AudioStreamPlaybackBusDetails *bus_details : bus_details_graveyard) {
-		bus_details_graveyard_frame_old.insert(bus_details);
-		bus_details_graveyard.erase(bus_details);
-	}
-	bus_details_graveyard.maybe_cleanup();
-	bus_details_graveyard_frame_old.maybe_cleanup();
+	_retire_playbacks();
 }
 
 void AudioServer::load_default_bus_layout() {
@@ -1567,6 +2247,16 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	mix_thread_pool.finish();
+	decode_ahead.finish();
+
+	// Nothing is mixed anymore, so everything still in the ring can be dropped.
+	Command command;
+	while (command_ring.pop(command)) {
+	}
+	playback_list.maybe_cleanup();
+	_retire_playbacks();
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1662,7 +2352,11 @@ void AudioServer::remove_listener_changed_callback(AudioCallback p_callback, voi
 void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 	ERR_FAIL_COND(p_bus_layout.is_null() || p_bus_layout->buses.is_empty());
 
+	MutexLock bus_details_lock(bus_details_mutex);
 	lock();
+	// Pending commands may point to the buses about to be deleted.
+	_apply_commands();
+	const LocalVector<StringName> old_bus_names = _get_bus_names();
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1703,6 +2397,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 				bus->effects.push_back(bfx);
 			}
 		}
+		_sync_bus_mix_state(bus);
 
 		bus_map[bus->name] = bus;
 		buses.write[i] = bus;
@@ -1713,6 +2408,8 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		}
 		_update_bus_effects(i);
 	}
+	bus_graph_dirty = true;
+	_update_playback_bus_indices(old_bus_names);
 #ifdef TOOLS_ENABLED
 	set_edited(false);
 #endif
@@ -1915,6 +2612,12 @@ void AudioServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_playback_speed_scale", "scale"), &AudioServer::set_playback_speed_scale);
 	ClassDB::bind_method(D_METHOD("get_playback_speed_scale"), &AudioServer::get_playback_speed_scale);
 
+	ClassDB::bind_method(D_METHOD("set_voice_budget", "budget"), &AudioServer::set_voice_budget);
+	ClassDB::bind_method(D_METHOD("get_voice_budget"), &AudioServer::get_voice_budget);
+	ClassDB::bind_method(D_METHOD("set_virtual_voice_threshold_db", "threshold_db"), &AudioServer::set_virtual_voice_threshold_db);
+	ClassDB::bind_method(D_METHOD("get_virtual_voice_threshold_db"), &AudioServer::get_virtual_voice_threshold_db);
+	ClassDB::bind_method(D_METHOD("get_virtual_voice_count"), &AudioServer::get_virtual_voice_count);
+
 	ClassDB::bind_method(D_METHOD("lock"), &AudioServer::lock);
 	ClassDB::bind_method(D_METHOD("unlock"), &AudioServer::unlock);
 
@@ -1948,6 +2651,8 @@ void AudioServer::_bind_methods() {
 	// Override for class reference generation purposes.
 	ADD_PROPERTY_DEFAULT("input_device", "Default");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_speed_scale"), "set_playback_speed_scale", "get_playback_speed_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "voice_budget", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_voice_budget", "get_voice_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "virtual_voice_threshold_db", PROPERTY_HINT_RANGE, "-100,0,0.1,suffix:dB"), "set_virtual_voice_threshold_db", "get_virtual_voice_threshold_db");
 
 	ADD_SIGNAL(MethodInfo("bus_layout_changed"));
 	ADD_SIGNAL(MethodInfo("bus_renamed", PropertyInfo(Variant::INT, "bus_index"), PropertyInfo(Variant::STRING_NAME, "old_name"), PropertyInfo(Variant::STRING_NAME, "new_name")));
@@ -1965,6 +2670,7 @@ void AudioServer::_bind_methods() {
 
 AudioServer::AudioServer() {
 	singleton = this;
+	command_ring.init(COMMAND_RING_SIZE);
 }
 
 AudioServer::~AudioServer() {
@@ -33,11 +33,15 @@
 
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
 #include "core/templates/safe_list.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
+#include "servers/audio/audio_command_ring.h"
+#include "servers/audio/audio_decode_ahead.h"
 #include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/audio_mix_thread_pool.h"
 
 #include <atomic>
 
@@ -203,6 +207,8 @@ public:
 		MAX_CHANNELS_PER_BUS = 4,
 		MAX_BUSES_PER_PLAYBACK = 6,
 		LOOKAHEAD_BUFFER_SIZE = 64,
+		MIX_BLOCK_SIZE = 128,
+		COMMAND_RING_SIZE = 1024,
 	};
 
 	typedef void (*AudioCallback)(void *p_userdata);
@@ -226,6 +232,15 @@ private:
 
 	float playback_speed_scale = 1.0f;
 
+	// Virtual voices need to be this much louder than the threshold to be made real again.
+	static constexpr float VIRTUAL_VOICE_HYSTERESIS_DB = 3.0f;
+	// How often virtual voices are skipped forward, in seconds.
+	static constexpr double VIRTUAL_VOICE_SKIP_INTERVAL = 0.25;
+
+	int voice_budget = 0;
+	float virtual_voice_threshold_db = -80.0f;
+	SafeNumeric<uint32_t> virtual_voice_count;
+
 	bool tag_used_audio_streams = false;
 
 	struct Bus {
@@ -244,6 +259,8 @@ private:
 			Vector<AudioFrame> buffer;
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio = 0;
+			// Set once processed if the buffer should be summed into the bus this one sends to.
+			bool sent = false;
 			Channel() {}
 		};
 
@@ -252,6 +269,10 @@ private:
 		struct Effect {
 			Ref<AudioEffect> effect;
 			bool enabled = false;
+			// Copy of enabled used by the audio thread.
+			bool mix_enabled = false;
+			// Implemented in a GDExtension, so it's unknown what it accesses.
+			bool extension = false;
 #ifdef DEBUG_ENABLED
 			uint64_t prof_time = 0;
 #endif
@@ -261,11 +282,22 @@ private:
 		float volume_db = 0.0f;
 		StringName send;
 		int index_cache = 0;
+
+		// Copy of the parameters above used by the audio thread. The setters update it through
+		// commands, so changing them never blocks the mix. The send changes the bus graph, it's
+		// set with the driver locked instead.
+		struct MixState {
+			float volume_db = 0.0f;
+			bool solo = false;
+			bool mute = false;
+			bool bypass = false;
+		} mix;
 	};
 
 	struct AudioStreamPlaybackBusDetails {
 		bool bus_active[MAX_BUSES_PER_PLAYBACK] = {};
-		StringName bus[MAX_BUSES_PER_PLAYBACK];
+		// Bus indices, so the audio thread never copies or frees a StringName.
+		int bus[MAX_BUSES_PER_PLAYBACK] = {};
 		AudioFrame volume[MAX_BUSES_PER_PLAYBACK][MAX_CHANNELS_PER_BUS];
 	};
 
@@ -279,29 +311,90 @@ private:
 		};
 		// If zero or positive, a place in the stream to seek to during the next mix.
 		SafeNumeric<float> setseek;
-		SafeNumeric<float> pitch_scale;
-		SafeNumeric<float> highshelf_gain;
-		SafeNumeric<float> attenuation_filter_cutoff_hz; // This isn't used unless highshelf_gain is nonzero.
+		// Parameters below are only accessed on the audio thread, they are changed through commands.
+		float pitch_scale = 1.0f;
+		float highshelf_gain = 0.0f;
+		float attenuation_filter_cutoff_hz = 0.0f; // This isn't used unless highshelf_gain is nonzero.
 		AudioFilterSW::Processor filter_process[8];
 		// Updating this ref after the list node is created breaks consistency guarantees, don't do it!
 		Ref<AudioStreamPlayback> stream_playback;
 		// Playback state determines the fate of a particular AudioStreamListNode during the mix step. Must be atomically replaced.
 		std::atomic<PlaybackState> state = AWAITING_DELETION;
-		// This data should only ever be modified by an atomic replacement of the pointer.
-		std::atomic<AudioStreamPlaybackBusDetails *> bus_details = nullptr;
+		AudioStreamPlaybackBusDetails bus_details;
+		// The buses last requested by name, bus_details is updated to match through a command and
+		// resolved again from these when the buses change. Guarded by bus_details_mutex.
+		StringName requested_buses[MAX_BUSES_PER_PLAYBACK];
+		int requested_bus_count = 0;
 		// Previous bus details should only be accessed on the audio thread.
 		AudioStreamPlaybackBusDetails *prev_bus_details = nullptr;
 		// The next few samples are stored here so we have some time to fade audio out if it ends abruptly at the beginning of the next mix.
 		AudioFrame lookahead[LOOKAHEAD_BUFFER_SIZE];
+		// Whether the playback was fading out when it was last mixed. Only accessed on the audio thread.
+		bool fading_out = false;
+		// Extension playbacks can call into code that isn't thread-safe, so they are always mixed on the audio thread.
+		bool mix_serially = false;
+		// Voices with a priority can be virtualized, see _update_voices().
+		bool voice_managed = false;
+		int voice_priority = 0;
+		bool voice_audible = true;
+		// Fading out for one mix step before becoming virtual.
+		bool virtualizing = false;
+		// Set on the audio thread, can be read anywhere.
+		SafeFlag is_virtual;
+		// Stream time elapsed while virtual that has not been skipped yet.
+		double virtual_time = 0.0;
+	};
+
+	// Playbacks removed from the list. They are deleted once the commands that may still point to them
+	// (the ones pushed before they were removed) have been applied. Only accessed on the main thread.
+	struct RetiredPlayback {
+		AudioStreamPlaybackListNode *playback = nullptr;
+		uint32_t command_position = 0;
 	};
+	LocalVector<RetiredPlayback> retired_playbacks;
 
 	SafeList<AudioStreamPlaybackListNode *> playback_list;
-	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard;
 
-	// TODO document if this is necessary.
-	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
+	// Guards the requested buses of the playbacks and the bus names they're resolved with, so they
+	// can be set from any thread without locking the driver. Always taken before the driver lock.
+	BinaryMutex bus_details_mutex;
+
+	// Parameter changes from the game threads, applied by the audio thread at the start of each mix step.
+	struct Command {
+		enum Type {
+			BUS_SET_VOLUME_DB,
+			BUS_SET_SOLO,
+			BUS_SET_MUTE,
+			BUS_SET_BYPASS,
+			BUS_SET_EFFECT_ENABLED,
+			PLAYBACK_SET_BUS_DETAILS,
+			PLAYBACK_SET_PITCH_SCALE,
+			PLAYBACK_SET_HIGHSHELF_PARAMS,
+			PLAYBACK_SET_VOICE_PRIORITY,
+		};
+
+		Type type = BUS_SET_VOLUME_DB;
+		Bus *bus = nullptr;
+		AudioStreamPlaybackListNode *playback = nullptr;
+		int index = 0;
+		float value = 0.0f;
+		float value2 = 0.0f;
+		bool enabled = false;
+		AudioStreamPlaybackBusDetails bus_details;
+	};
+
+	AudioCommandRing<Command> command_ring;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
+	void _push_command(const Command &p_command);
+	void _apply_commands();
+	void _apply_command(const Command &p_command);
+	void _sync_bus_mix_state(Bus *p_bus);
+	int _find_bus_index_or_master(const StringName &p_name) const;
+	LocalVector<StringName> _get_bus_names() const;
+	void _update_playback_bus_indices(const LocalVector<StringName> &p_old_bus_names);
+	void _retire_playbacks();
+
+	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each channel of every bus processed at the same time
 	Vector<AudioFrame> mix_buffer;
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
@@ -312,7 +405,70 @@ private:
 
 	void init_channels_and_buffers();
 
+	AudioMixThreadPool mix_thread_pool;
+	AudioDecodeAhead decode_ahead;
+
+	// Playbacks mixed this step, and their buffers when they are mixed in parallel.
+	LocalVector<AudioStreamPlaybackListNode *> mix_playbacks;
+	LocalVector<AudioFrame> playback_mix_buffers;
+
+	struct VoiceCandidate {
+		AudioStreamPlaybackListNode *playback = nullptr;
+		int priority = 0;
+		float audibility = 0.0f;
+		uint32_t order = 0;
+
+		bool operator<(const VoiceCandidate &p_other) const {
+			if (priority != p_other.priority) {
+				return priority > p_other.priority;
+			}
+			if (audibility != p_other.audibility) {
+				return audibility > p_other.audibility;
+			}
+			return order < p_other.order;
+		}
+	};
+
+	// Linear gain from each bus to the output, used to estimate how audible voices are.
+	LocalVector<float> bus_audibility;
+	LocalVector<VoiceCandidate> voice_candidates;
+
+	// Bus graph, rebuilt when the bus layout changes. Only touched with the driver locked.
+	bool bus_graph_dirty = true;
+	LocalVector<uint8_t> bus_isolated;
+	LocalVector<int> bus_send_index;
+	LocalVector<uint32_t> bus_level;
+	LocalVector<uint32_t> bus_child_offsets;
+	LocalVector<uint32_t> bus_child_fill;
+	LocalVector<int> bus_children;
+	LocalVector<int> bus_schedule;
+	LocalVector<uint32_t> bus_level_offsets;
+
+	struct BusProcessJob {
+		AudioServer *server = nullptr;
+		const int *buses = nullptr;
+		Vector<AudioFrame> *temp_buffers = nullptr;
+		bool solo_mode = false;
+	};
+
 	void _mix_step();
+	void _update_bus_audibility(bool p_solo_mode);
+	float _get_voice_audibility(const AudioStreamPlaybackListNode *p_playback);
+	void _update_voices(bool p_solo_mode);
+	void _erase_playback_list_node(AudioStreamPlaybackListNode *p_playback);
+	void _mix_playback(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf);
+	void _mix_playback_to_buses(AudioStreamPlaybackListNode *p_playback, AudioFrame *p_buf);
+	static void _mix_playback_job(void *p_userdata, uint32_t p_index);
+	bool _is_playback_mixed_serially(const AudioStreamPlaybackListNode *p_playback) const;
+	bool _is_bus_reading_other_buses(const Bus *p_bus) const;
+	bool _is_bus_sharing_effects(int p_bus) const;
+	void _update_bus_graph();
+	void _process_bus(int p_bus, Vector<AudioFrame> *p_temp_buffers, bool p_solo_mode);
+	static void _process_bus_job(void *p_userdata, uint32_t p_index);
+	AudioFrame *_get_bus_channel_mix_buffer(Bus *p_bus, int p_channel);
+	void _mix_volume_ramp(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, unsigned int p_from, unsigned int p_count) const;
+	void _mix_volume_ramp_accumulate(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, unsigned int p_count) const;
+	static void _mix_accumulate(AudioFrame *p_out_buf, const AudioFrame *p_source_buf, unsigned int p_count);
 	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
 	// Should only be called on the main thread.
@@ -417,10 +573,20 @@ public:
 	void set_playback_pitch_scale(Ref<AudioStreamPlayback> p_playback, float p_pitch_scale);
 	void set_playback_paused(Ref<AudioStreamPlayback> p_playback, bool p_paused);
 	void set_playback_highshelf_params(Ref<AudioStreamPlayback> p_playback, float p_gain, float p_attenuation_cutoff_hz);
+	void set_playback_voice_priority(Ref<AudioStreamPlayback> p_playback, int p_priority);
 
 	bool is_playback_active(Ref<AudioStreamPlayback> p_playback);
 	float get_playback_position(Ref<AudioStreamPlayback> p_playback);
 	bool is_playback_paused(Ref<AudioStreamPlayback> p_playback);
+	bool is_playback_virtual(Ref<AudioStreamPlayback> p_playback);
+
+	void set_voice_budget(int p_budget);
+	int get_voice_budget() const;
+
+	void set_virtual_voice_threshold_db(float p_threshold_db);
+	float get_virtual_voice_threshold_db() const;
+
+	int get_virtual_voice_count() const;
 
 	uint64_t get_mix_count() const;
 	uint64_t get_mixed_frames() const;
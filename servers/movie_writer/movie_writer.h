@@ -59,6 +59,9 @@ protected:
 	virtual uint32_t get_audio_mix_rate() const;
 	virtual AudioServer::SpeakerMode get_audio_speaker_mode() const;
 
+	// Number of interleaved samples in each audio block passed to write_frame().
+	uint32_t get_audio_block_sample_count() const { return audio_mix_buffer.size(); }
+
 	virtual Error write_begin(const Size2i &p_movie_size, uint32_t p_fps, const String &p_base_path);
 	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data);
 	virtual void write_end();
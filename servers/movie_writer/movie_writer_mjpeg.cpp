@@ -190,16 +190,20 @@ Error MovieWriterMJPEG::write_begin(const Size2i &p_movie_size, uint32_t p_fps,
 	return OK;
 }
 
-Error MovieWriterMJPEG::write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) {
+Error MovieWriterMJPEG::encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const {
+	r_data = p_image->save_jpg_to_buffer(quality);
+	return r_data.is_empty() ? ERR_CANT_CREATE : OK;
+}
+
+Error MovieWriterMJPEG::write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) {
 	ERR_FAIL_COND_V(!f.is_valid(), ERR_UNCONFIGURED);
 
-	Vector<uint8_t> jpg_buffer = p_image->save_jpg_to_buffer(quality);
-	uint32_t s = jpg_buffer.size();
+	uint32_t s = p_data.size();
 
 	f->store_buffer((const uint8_t *)"00db", 4); // Stream 0, Video
-	f->store_32(jpg_buffer.size()); // sizes
-	f->store_buffer(jpg_buffer.ptr(), jpg_buffer.size());
-	if (jpg_buffer.size() & 1) {
+	f->store_32(p_data.size()); // sizes
+	f->store_buffer(p_data.ptr(), p_data.size());
+	if (p_data.size() & 1) {
 		f->store_8(0);
 		s++;
 	}
@@ -214,7 +218,7 @@ Error MovieWriterMJPEG::write_frame(const Ref<Image> &p_image, const int32_t *p_
 	return OK;
 }
 
-void MovieWriterMJPEG::write_end() {
+void MovieWriterMJPEG::write_encoded_end() {
 	if (f.is_valid()) {
 		// Finalize the file (frame indices)
 		f->store_buffer((const uint8_t *)"idx1", 4);
@@ -261,3 +265,7 @@ MovieWriterMJPEG::MovieWriterMJPEG() {
 	speaker_mode = AudioServer::SpeakerMode(int(GLOBAL_GET("editor/movie_writer/speaker_mode")));
 	quality = GLOBAL_GET("editor/movie_writer/mjpeg_quality");
 }
+
+MovieWriterMJPEG::~MovieWriterMJPEG() {
+	finish_encoding();
+}
@@ -31,10 +31,10 @@
 #ifndef MOVIE_WRITER_MJPEG_H
 #define MOVIE_WRITER_MJPEG_H
 
-#include "servers/movie_writer/movie_writer.h"
+#include "servers/movie_writer/movie_writer_pipelined.h"
 
-class MovieWriterMJPEG : public MovieWriter {
-	GDCLASS(MovieWriterMJPEG, MovieWriter)
+class MovieWriterMJPEG : public MovieWriterPipelined {
+	GDCLASS(MovieWriterMJPEG, MovieWriterPipelined)
 
 	uint32_t mix_rate = 48000;
 	AudioServer::SpeakerMode speaker_mode = AudioServer::SPEAKER_MODE_STEREO;
@@ -61,13 +61,15 @@ protected:
 	virtual void get_supported_extensions(List<String> *r_extensions) const override;
 
 	virtual Error write_begin(const Size2i &p_movie_size, uint32_t p_fps, const String &p_base_path) override;
-	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) override;
-	virtual void write_end() override;
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const override;
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) override;
+	virtual void write_encoded_end() override;
 
 	virtual bool handles_file(const String &p_path) const override;
 
 public:
 	MovieWriterMJPEG();
+	~MovieWriterMJPEG();
 };
 
 #endif // MOVIE_WRITER_MJPEG_H
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  movie_writer_pipelined.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "movie_writer_pipelined.h"
+#include "core/config/project_settings.h"
+
+void MovieWriterPipelined::_encode_frame_task(Frame *p_frame) {
+	p_frame->error = encode_frame(p_frame->image, p_frame->data);
+	p_frame->image.unref(); // Release the raw frame as soon as possible.
+}
+
+Error MovieWriterPipelined::_write_oldest_frame() {
+	Frame *frame = queued_frames[0];
+	queued_frames.remove_at(0);
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(frame->task);
+
+	Error err = frame->error;
+	if (err == OK) {
+		err = write_encoded_frame(frame->data, frame->audio.ptr());
+	}
+	memdelete(frame);
+
+	return err;
+}
+
+Error MovieWriterPipelined::write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) {
+	while (queued_frames.size() >= max_queued_frames) {
+		Error err = _write_oldest_frame();
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Failed to write an encoded movie frame.");
+	}
+
+	Frame *frame = memnew(Frame);
+	frame->image = p_image;
+	// The audio mix buffer is reused for the next frame, keep a copy.
+	uint32_t audio_samples = get_audio_block_sample_count();
+	if (p_audio_data && audio_samples > 0) {
+		frame->audio.resize(audio_samples);
+		memcpy(frame->audio.ptr(), p_audio_data, audio_samples * sizeof(int32_t));
+	}
+	frame->task = WorkerThreadPool::get_singleton()->add_template_task(this, &MovieWriterPipelined::_encode_frame_task, frame, false, SNAME("MovieWriterEncodeFrame"));
+	queued_frames.push_back(frame);
+
+	return OK;
+}
+
+void MovieWriterPipelined::write_end() {
+	while (!queued_frames.is_empty()) {
+		Error err = _write_oldest_frame();
+		if (err != OK) {
+			ERR_PRINT("Failed to write an encoded movie frame.");
+		}
+	}
+
+	write_encoded_end();
+}
+
+void MovieWriterPipelined::set_max_queued_frames(uint32_t p_frames) {
+	ERR_FAIL_COND(p_frames == 0);
+	max_queued_frames = p_frames;
+}
+
+uint32_t MovieWriterPipelined::get_max_queued_frames() const {
+	return max_queued_frames;
+}
+
+void MovieWriterPipelined::finish_encoding() {
+	for (Frame *frame : queued_frames) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(frame->task);
+		memdelete(frame);
+	}
+	queued_frames.clear();
+}
+
+MovieWriterPipelined::MovieWriterPipelined() {
+	max_queued_frames = MAX(1, int(GLOBAL_GET("editor/movie_writer/max_queued_frames")));
+}
+
+MovieWriterPipelined::~MovieWriterPipelined() {
+	// Too late to wait for the tasks here, encode_frame() is no longer overridden.
+	DEV_ASSERT(queued_frames.is_empty());
+}
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  movie_writer_pipelined.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef MOVIE_WRITER_PIPELINED_H
+#define MOVIE_WRITER_PIPELINED_H
+
+#include "core/object/worker_thread_pool.h"
+#include "servers/movie_writer/movie_writer.h"
+
+// Base for writers whose per-frame cost is dominated by image encoding.
+// Frames are encoded on the WorkerThreadPool while the engine keeps rendering,
+// and handed back to the writer in capture order. The number of frames in
+// flight is bounded, so memory use stays predictable at high resolutions.
+class MovieWriterPipelined : public MovieWriter {
+	GDCLASS(MovieWriterPipelined, MovieWriter)
+
+	struct Frame {
+		Ref<Image> image;
+		LocalVector<int32_t> audio;
+		Vector<uint8_t> data;
+		Error error = OK;
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	uint32_t max_queued_frames = 8;
+	LocalVector<Frame *> queued_frames; // Oldest first.
+
+	void _encode_frame_task(Frame *p_frame);
+	Error _write_oldest_frame();
+
+protected:
+	// Called from worker threads, possibly for several frames at once.
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const = 0;
+	// Called on the main thread, in capture order.
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) = 0;
+	// Called once every queued frame has been written.
+	virtual void write_encoded_end() = 0;
+
+	// Waits for the frames still being encoded and drops them. Must be called from the destructor
+	// of every class that overrides encode_frame(), as the tasks still call it.
+	void finish_encoding();
+
+	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) override final;
+	virtual void write_end() override final;
+
+public:
+	void set_max_queued_frames(uint32_t p_frames);
+	uint32_t get_max_queued_frames() const;
+
+	MovieWriterPipelined();
+	~MovieWriterPipelined();
+};
+
+#endif // MOVIE_WRITER_PIPELINED_H
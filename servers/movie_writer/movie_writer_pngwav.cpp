@@ -40,11 +40,11 @@ AudioServer::SpeakerMode MovieWriterPNGWAV::get_audio_speaker_mode() const {
 }
 
 void MovieWriterPNGWAV::get_supported_extensions(List<String> *r_extensions) const {
-	r_extensions->push_back("png");
+	r_extensions->push_back(get_image_extension());
 }
 
 bool MovieWriterPNGWAV::handles_file(const String &p_path) const {
-	return p_path.get_extension().to_lower() == "png";
+	return p_path.get_extension().to_lower() == get_image_extension();
 }
 
 String MovieWriterPNGWAV::zeros_str(uint32_t p_index) {
@@ -74,7 +74,7 @@ Error MovieWriterPNGWAV::write_begin(const Size2i &p_movie_size, uint32_t p_fps,
 
 		String file = base_path.get_file();
 		while (true) {
-			String path = file + zeros_str(idx) + ".png";
+			String path = file + zeros_str(idx) + "." + get_image_extension();
 			if (d->remove(path) != OK) {
 				break;
 			}
@@ -139,13 +139,17 @@ Error MovieWriterPNGWAV::write_begin(const Size2i &p_movie_size, uint32_t p_fps,
 	return OK;
 }
 
-Error MovieWriterPNGWAV::write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) {
-	ERR_FAIL_COND_V(!f_wav.is_valid(), ERR_UNCONFIGURED);
+Error MovieWriterPNGWAV::encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const {
+	r_data = p_image->save_png_to_buffer();
+	return r_data.is_empty() ? ERR_CANT_CREATE : OK;
+}
 
-	Vector<uint8_t> png_buffer = p_image->save_png_to_buffer();
+Error MovieWriterPNGWAV::write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) {
+	ERR_FAIL_COND_V(!f_wav.is_valid(), ERR_UNCONFIGURED);
 
-	Ref<FileAccess> fi = FileAccess::open(base_path + zeros_str(frame_count) + ".png", FileAccess::WRITE);
-	fi->store_buffer(png_buffer.ptr(), png_buffer.size());
+	Ref<FileAccess> fi = FileAccess::open(base_path + zeros_str(frame_count) + "." + get_image_extension(), FileAccess::WRITE);
+	ERR_FAIL_COND_V(fi.is_null(), ERR_CANT_OPEN);
+	fi->store_buffer(p_data.ptr(), p_data.size());
 	f_wav->store_buffer((const uint8_t *)p_audio_data, audio_block_size);
 
 	frame_count++;
@@ -153,7 +157,7 @@ Error MovieWriterPNGWAV::write_frame(const Ref<Image> &p_image, const int32_t *p
 	return OK;
 }
 
-void MovieWriterPNGWAV::write_end() {
+void MovieWriterPNGWAV::write_encoded_end() {
 	if (f_wav.is_valid()) {
 		uint32_t total_size = 4 /* WAVE */ + 8 /* fmt+size */ + 16 /* format */ + 8 /* data+size */;
 		uint32_t datasize = f_wav->get_position() - wav_data_size_pos;
@@ -168,3 +172,7 @@ MovieWriterPNGWAV::MovieWriterPNGWAV() {
 	mix_rate = GLOBAL_GET("editor/movie_writer/mix_rate");
 	speaker_mode = AudioServer::SpeakerMode(int(GLOBAL_GET("editor/movie_writer/speaker_mode")));
 }
+
+MovieWriterPNGWAV::~MovieWriterPNGWAV() {
+	finish_encoding();
+}
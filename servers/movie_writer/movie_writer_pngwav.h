@@ -31,10 +31,10 @@
 #ifndef MOVIE_WRITER_PNGWAV_H
 #define MOVIE_WRITER_PNGWAV_H
 
-#include "servers/movie_writer/movie_writer.h"
+#include "servers/movie_writer/movie_writer_pipelined.h"
 
-class MovieWriterPNGWAV : public MovieWriter {
-	GDCLASS(MovieWriterPNGWAV, MovieWriter)
+class MovieWriterPNGWAV : public MovieWriterPipelined {
+	GDCLASS(MovieWriterPNGWAV, MovieWriterPipelined)
 
 	enum {
 		MAX_TRAILING_ZEROS = 8 // more than 10 days at 60fps, no hard drive can put up with this anyway :)
@@ -54,18 +54,23 @@ class MovieWriterPNGWAV : public MovieWriter {
 	String zeros_str(uint32_t p_index);
 
 protected:
+	// Extension of the image files in the sequence.
+	virtual String get_image_extension() const { return "png"; }
+
 	virtual uint32_t get_audio_mix_rate() const override;
 	virtual AudioServer::SpeakerMode get_audio_speaker_mode() const override;
 	virtual void get_supported_extensions(List<String> *r_extensions) const override;
 
 	virtual Error write_begin(const Size2i &p_movie_size, uint32_t p_fps, const String &p_base_path) override;
-	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) override;
-	virtual void write_end() override;
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const override;
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) override;
+	virtual void write_encoded_end() override;
 
 	virtual bool handles_file(const String &p_path) const override;
 
 public:
 	MovieWriterPNGWAV();
+	~MovieWriterPNGWAV();
 };
 
 #endif // MOVIE_WRITER_PNGWAV_H
@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  movie_writer_qoiwav.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "movie_writer_qoiwav.h"
+
+enum {
+	QOI_OP_INDEX = 0x00,
+	QOI_OP_DIFF = 0x40,
+	QOI_OP_LUMA = 0x80,
+	QOI_OP_RUN = 0xc0,
+	QOI_OP_RGB = 0xfe,
+	QOI_OP_RGBA = 0xff,
+	QOI_MAX_RUN = 62,
+	QOI_HEADER_SIZE = 14,
+	QOI_END_MARKER_SIZE = 8,
+};
+
+static _FORCE_INLINE_ uint32_t _qoi_hash(const uint8_t *p_px) {
+	return (p_px[0] * 3 + p_px[1] * 5 + p_px[2] * 7 + p_px[3] * 11) % 64;
+}
+
+static _FORCE_INLINE_ void _qoi_store_32_be(uint8_t *p_dst, uint32_t p_value) {
+	p_dst[0] = (p_value >> 24) & 0xff;
+	p_dst[1] = (p_value >> 16) & 0xff;
+	p_dst[2] = (p_value >> 8) & 0xff;
+	p_dst[3] = p_value & 0xff;
+}
+
+Vector<uint8_t> MovieWriterQOIWAV::encode_qoi(const Ref<Image> &p_image) {
+	ERR_FAIL_COND_V(p_image.is_null() || p_image->is_empty(), Vector<uint8_t>());
+
+	Ref<Image> image = p_image;
+	if (image->get_format() != Image::FORMAT_RGB8 && image->get_format() != Image::FORMAT_RGBA8) {
+		image = p_image->duplicate();
+		image->convert(Image::FORMAT_RGBA8);
+	}
+
+	const uint32_t channels = image->get_format() == Image::FORMAT_RGBA8 ? 4 : 3;
+	const uint32_t width = image->get_width();
+	const uint32_t height = image->get_height();
+	const uint64_t pixel_count = uint64_t(width) * height;
+	const uint8_t *src = image->ptr();
+
+	// Worst case is one QOI_OP_RGBA (or QOI_OP_RGB) per pixel.
+	Vector<uint8_t> data;
+	data.resize(QOI_HEADER_SIZE + pixel_count * (channels + 1) + QOI_END_MARKER_SIZE);
+	uint8_t *dst = data.ptrw();
+	uint64_t ofs = 0;
+
+	dst[ofs++] = 'q';
+	dst[ofs++] = 'o';
+	dst[ofs++] = 'i';
+	dst[ofs++] = 'f';
+	_qoi_store_32_be(&dst[ofs], width);
+	ofs += 4;
+	_qoi_store_32_be(&dst[ofs], height);
+	ofs += 4;
+	dst[ofs++] = channels;
+	dst[ofs++] = 0; // sRGB with linear alpha.
+
+	uint8_t index[64][4];
+	memset(index, 0, sizeof(index));
+	uint8_t prev[4] = { 0, 0, 0, 255 };
+	uint8_t px[4] = { 0, 0, 0, 255 };
+	uint32_t run = 0;
+
+	for (uint64_t i = 0; i < pixel_count; i++) {
+		const uint8_t *s = &src[i * channels];
+		px[0] = s[0];
+		px[1] = s[1];
+		px[2] = s[2];
+		if (channels == 4) {
+			px[3] = s[3];
+		}
+
+		if (memcmp(px, prev, 4) == 0) {
+			run++;
+			if (run == QOI_MAX_RUN || i == pixel_count - 1) {
+				dst[ofs++] = QOI_OP_RUN | (run - 1);
+				run = 0;
+			}
+			continue;
+		}
+
+		if (run > 0) {
+			dst[ofs++] = QOI_OP_RUN | (run - 1);
+			run = 0;
+		}
+
+		const uint32_t hash = _qoi_hash(px);
+		if (memcmp(index[hash], px, 4) == 0) {
+			dst[ofs++] = QOI_OP_INDEX | hash;
+		} else {
+			memcpy(index[hash], px, 4);
+
+			if (px[3] == prev[3]) {
+				const int8_t vr = int8_t(px[0] - prev[0]);
+				const int8_t vg = int8_t(px[1] - prev[1]);
+				const int8_t vb = int8_t(px[2] - prev[2]);
+				const int8_t vg_r = vr - vg;
+				const int8_t vg_b = vb - vg;
+
+				if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+					dst[ofs++] = QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+				} else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+					dst[ofs++] = QOI_OP_LUMA | (vg + 32);
+					dst[ofs++] = ((vg_r + 8) << 4) | (vg_b + 8);
+				} else {
+					dst[ofs++] = QOI_OP_RGB;
+					dst[ofs++] = px[0];
+					dst[ofs++] = px[1];
+					dst[ofs++] = px[2];
+				}
+			} else {
+				dst[ofs++] = QOI_OP_RGBA;
+				dst[ofs++] = px[0];
+				dst[ofs++] = px[1];
+				dst[ofs++] = px[2];
+				dst[ofs++] = px[3];
+			}
+		}
+
+		memcpy(prev, px, 4);
+	}
+
+	// End marker: seven zero bytes followed by 0x01.
+	for (int i = 0; i < QOI_END_MARKER_SIZE - 1; i++) {
+		dst[ofs++] = 0;
+	}
+	dst[ofs++] = 1;
+
+	data.resize(ofs);
+	return data;
+}
+
+Error MovieWriterQOIWAV::encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const {
+	r_data = encode_qoi(p_image);
+	return r_data.is_empty() ? ERR_CANT_CREATE : OK;
+}
+
+MovieWriterQOIWAV::~MovieWriterQOIWAV() {
+	finish_encoding();
+}
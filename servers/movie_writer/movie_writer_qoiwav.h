@@ -0,0 +1,53 @@
+/**************************************************************************/
+/*  movie_writer_qoiwav.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef MOVIE_WRITER_QOIWAV_H
+#define MOVIE_WRITER_QOIWAV_H
+
+#include "servers/movie_writer/movie_writer_pngwav.h"
+
+// Same image sequence and WAV layout as MovieWriterPNGWAV, but frames are
+// stored as QOI (https://qoiformat.org), which is lossless and encodes many
+// times faster than PNG's deflate at the cost of larger files.
+class MovieWriterQOIWAV : public MovieWriterPNGWAV {
+	GDCLASS(MovieWriterQOIWAV, MovieWriterPNGWAV)
+
+protected:
+	virtual String get_image_extension() const override { return "qoi"; }
+
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const override;
+
+public:
+	static Vector<uint8_t> encode_qoi(const Ref<Image> &p_image);
+
+	~MovieWriterQOIWAV();
+};
+
+#endif // MOVIE_WRITER_QOIWAV_H
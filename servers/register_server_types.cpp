@@ -39,6 +39,7 @@
 #include "audio/effects/audio_effect_capture.h"
 #include "audio/effects/audio_effect_chorus.h"
 #include "audio/effects/audio_effect_compressor.h"
+#include "audio/effects/audio_effect_convolution_reverb.h"
 #include "audio/effects/audio_effect_delay.h"
 #include "audio/effects/audio_effect_distortion.h"
 #include "audio/effects/audio_effect_eq.h"
@@ -62,6 +63,7 @@
 #include "movie_writer/movie_writer.h"
 #include "movie_writer/movie_writer_mjpeg.h"
 #include "movie_writer/movie_writer_pngwav.h"
+#include "movie_writer/movie_writer_qoiwav.h"
 #include "rendering/renderer_compositor.h"
 #include "rendering/renderer_rd/framebuffer_cache_rd.h"
 #include "rendering/renderer_rd/storage_rd/render_data_rd.h"
@@ -143,6 +145,7 @@ static bool has_server_feature_callback(const String &p_feature) {
 
 static MovieWriterMJPEG *writer_mjpeg = nullptr;
 static MovieWriterPNGWAV *writer_pngwav = nullptr;
+static MovieWriterQOIWAV *writer_qoiwav = nullptr;
 
 void register_server_types() {
 	OS::get_singleton()->benchmark_begin_measure("Servers", "Register Extensions");
@@ -192,6 +195,7 @@ void register_server_types() {
 		GDREGISTER_CLASS(AudioEffectAmplify);
 
 		GDREGISTER_CLASS(AudioEffectReverb);
+		GDREGISTER_CLASS(AudioEffectConvolutionReverb);
 
 		GDREGISTER_CLASS(AudioEffectLowPassFilter);
 		GDREGISTER_CLASS(AudioEffectHighPassFilter);
@@ -349,6 +353,9 @@ void register_server_types() {
 	writer_pngwav = memnew(MovieWriterPNGWAV);
 	MovieWriter::add_writer(writer_pngwav);
 
+	writer_qoiwav = memnew(MovieWriterQOIWAV);
+	MovieWriter::add_writer(writer_qoiwav);
+
 	OS::get_singleton()->benchmark_end_measure("Servers", "Register Extensions");
 }
 
@@ -359,6 +366,7 @@ void unregister_server_types() {
 	memdelete(shader_types);
 	memdelete(writer_mjpeg);
 	memdelete(writer_pngwav);
+	memdelete(writer_qoiwav);
 
 	OS::get_singleton()->benchmark_end_measure("Servers", "Unregister Extensions");
 }
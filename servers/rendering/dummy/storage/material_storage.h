@@ -94,6 +94,9 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override { return RS::ShaderNativeSourceCode(); };
 
+	virtual void shader_compile_batch_begin() override {}
+	virtual void shader_compile_batch_end() override {}
+
 	/* MATERIAL API */
 	virtual RID material_allocate() override { return RID(); }
 	virtual void material_initialize(RID p_rid) override {}
@@ -54,14 +54,190 @@ void MeshStorage::mesh_free(RID p_rid) {
 	DummyMesh *mesh = mesh_owner.get_or_null(p_rid);
 	ERR_FAIL_NULL(mesh);
 
+	mesh->dependency.deleted_notify(p_rid);
 	mesh_owner.free(p_rid);
 }
 
+void MeshStorage::_mesh_invalidate_vertex_data(DummyMesh *p_mesh) {
+	p_mesh->skeleton_aabb_rid = RID();
+	p_mesh->skeleton_aabb_version = 0;
+}
+
+void MeshStorage::mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_COND(p_blend_shape_count < 0);
+
+	m->blend_shape_count = p_blend_shape_count;
+}
+
+bool MeshStorage::mesh_needs_instance(RID p_mesh, bool p_has_skeleton) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, false);
+
+	return m->blend_shape_count > 0 || (m->has_bone_weights && p_has_skeleton);
+}
+
+static bool _update_buffer_region(Vector<uint8_t> &r_buffer, int p_offset, const Vector<uint8_t> &p_data) {
+	ERR_FAIL_COND_V(p_offset < 0 || p_offset + p_data.size() > r_buffer.size(), false);
+	memcpy(r_buffer.ptrw() + p_offset, p_data.ptr(), p_data.size());
+	return true;
+}
+
+void MeshStorage::mesh_surface_update_vertex_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_INDEX(p_surface, m->surfaces.size());
+
+	if (_update_buffer_region(m->surfaces.write[p_surface].vertex_data, p_offset, p_data)) {
+		_mesh_invalidate_vertex_data(m);
+	}
+}
+
+void MeshStorage::mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_INDEX(p_surface, m->surfaces.size());
+
+	_update_buffer_region(m->surfaces.write[p_surface].attribute_data, p_offset, p_data);
+}
+
+void MeshStorage::mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_INDEX(p_surface, m->surfaces.size());
+
+	if (_update_buffer_region(m->surfaces.write[p_surface].skin_data, p_offset, p_data)) {
+		_mesh_invalidate_vertex_data(m);
+	}
+}
+
+AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
+	DummyMesh *mesh = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(mesh, AABB());
+
+	if (mesh->custom_aabb != AABB()) {
+		return mesh->custom_aabb;
+	}
+
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	if (!skeleton || skeleton->size == 0) {
+		return mesh->aabb;
+	}
+
+	// A mesh can be shared by multiple skeletons and we need to avoid using the AABB from a different skeleton.
+	if (mesh->skeleton_aabb_version == skeleton->version && mesh->skeleton_aabb_rid == p_skeleton) {
+		return mesh->skeleton_aabb;
+	}
+
+	// Same estimate as the other renderers: move the per-bone bounds with their bones,
+	// which doesn't need the vertices.
+	AABB aabb;
+	for (int i = 0; i < mesh->surfaces.size(); i++) {
+		const RS::SurfaceData &surface = mesh->surfaces[i];
+		AABB laabb;
+
+		if ((surface.format & RS::ARRAY_FORMAT_BONES) && surface.bone_aabbs.size()) {
+			const int bone_count = surface.bone_aabbs.size();
+			ERR_CONTINUE(bone_count > skeleton->size);
+
+			bool found_bone_aabb = false;
+			for (int j = 0; j < bone_count; j++) {
+				const AABB &bone_aabb = surface.bone_aabbs[j];
+				if (bone_aabb.size == Vector3(-1, -1, -1)) {
+					continue; // Bone is unused.
+				}
+
+				// Transform bounds to skeleton's space before applying animation data.
+				const Transform3D bone_transform = CPUSkinning::load_bone_transform(skeleton->data.ptr() + j * CPUSkinning::BONE_STRIDE);
+				const AABB baabb = bone_transform.xform(surface.mesh_to_skeleton_xform.xform(bone_aabb));
+
+				if (!found_bone_aabb) {
+					laabb = baabb;
+					found_bone_aabb = true;
+				} else {
+					laabb.merge_with(baabb);
+				}
+			}
+
+			if (found_bone_aabb) {
+				// Transform skeleton bounds back to mesh's space if any animated AABB applied.
+				laabb = surface.mesh_to_skeleton_xform.affine_inverse().xform(laabb);
+			}
+
+			if (laabb.size == Vector3()) {
+				laabb = surface.aabb;
+			}
+		} else {
+			laabb = surface.aabb;
+		}
+
+		if (i == 0) {
+			aabb = laabb;
+		} else {
+			aabb.merge_with(laabb);
+		}
+	}
+
+	mesh->skeleton_aabb = aabb;
+	mesh->skeleton_aabb_version = skeleton->version;
+	mesh->skeleton_aabb_rid = p_skeleton;
+	return aabb;
+}
+
 void MeshStorage::mesh_clear(RID p_mesh) {
 	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_NULL(m);
 
 	m->surfaces.clear();
+	m->aabb = AABB();
+	m->has_bone_weights = false;
+	_mesh_invalidate_vertex_data(m);
+	m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
+}
+
+Dependency *MeshStorage::mesh_get_dependency(RID p_mesh) const {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, nullptr);
+
+	return &m->dependency;
+}
+
+/* MESH INSTANCE */
+
+RID MeshStorage::mesh_instance_create(RID p_base) {
+	DummyMesh *mesh = mesh_owner.get_or_null(p_base);
+	ERR_FAIL_NULL_V(mesh, RID());
+
+	DummyMeshInstance mi;
+	mi.mesh = p_base;
+	mi.blend_weights.resize(mesh->blend_shape_count);
+	for (float &weight : mi.blend_weights) {
+		weight = 0;
+	}
+
+	return mesh_instance_owner.make_rid(mi);
+}
+
+void MeshStorage::mesh_instance_free(RID p_rid) {
+	ERR_FAIL_COND(!mesh_instance_owner.owns(p_rid));
+	mesh_instance_owner.free(p_rid);
+}
+
+void MeshStorage::mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL(mi);
+	if (mi->skeleton == p_skeleton) {
+		return;
+	}
+	mi->skeleton = p_skeleton;
+}
+
+void MeshStorage::mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL(mi);
+	ERR_FAIL_INDEX(p_shape, (int)mi->blend_weights.size());
+	mi->blend_weights[p_shape] = p_weight;
 }
 
 RID MeshStorage::_multimesh_allocate() {
@@ -93,3 +269,145 @@ Vector<float> MeshStorage::_multimesh_get_buffer(RID p_multimesh) const {
 
 	return multimesh->buffer;
 }
+
+/* SKELETON API */
+
+RID MeshStorage::skeleton_allocate() {
+	return skeleton_owner.allocate_rid();
+}
+
+void MeshStorage::skeleton_initialize(RID p_rid) {
+	skeleton_owner.initialize_rid(p_rid, DummySkeleton());
+}
+
+void MeshStorage::skeleton_free(RID p_rid) {
+	update_dirty_skeletons();
+	skeleton_allocate_data(p_rid, 0);
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL(skeleton);
+	skeleton->dependency.deleted_notify(p_rid);
+	skeleton_owner.free(p_rid);
+}
+
+void MeshStorage::_skeleton_make_dirty(DummySkeleton *p_skeleton) {
+	// Bumped right away rather than when the dependencies are notified, as
+	// the CPU evaluation reads the bone data directly.
+	p_skeleton->version++;
+
+	if (!p_skeleton->dirty) {
+		p_skeleton->dirty = true;
+		p_skeleton->dirty_list = skeleton_dirty_list;
+		skeleton_dirty_list = p_skeleton;
+	}
+}
+
+void MeshStorage::skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_COND(p_bones < 0);
+
+	if (skeleton->size == p_bones && skeleton->use_2d == p_2d_skeleton) {
+		return;
+	}
+
+	skeleton->size = p_bones;
+	skeleton->use_2d = p_2d_skeleton;
+	skeleton->data.resize(p_bones * CPUSkinning::BONE_STRIDE);
+	if (p_bones) {
+		memset(skeleton->data.ptr(), 0, skeleton->data.size() * sizeof(float));
+		_skeleton_make_dirty(skeleton);
+	}
+
+	skeleton->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_SKELETON_DATA);
+}
+
+void MeshStorage::skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_COND(!skeleton->use_2d);
+
+	skeleton->base_transform_2d = p_base_transform;
+}
+
+int MeshStorage::skeleton_get_bone_count(RID p_skeleton) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, 0);
+
+	return skeleton->size;
+}
+
+void MeshStorage::skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_INDEX(p_bone, skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	CPUSkinning::store_bone_transform(p_transform, skeleton->data.ptr() + p_bone * CPUSkinning::BONE_STRIDE);
+	_skeleton_make_dirty(skeleton);
+}
+
+Transform3D MeshStorage::skeleton_bone_get_transform(RID p_skeleton, int p_bone) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, Transform3D());
+	ERR_FAIL_INDEX_V(p_bone, skeleton->size, Transform3D());
+	ERR_FAIL_COND_V(skeleton->use_2d, Transform3D());
+
+	return CPUSkinning::load_bone_transform(skeleton->data.ptr() + p_bone * CPUSkinning::BONE_STRIDE);
+}
+
+void MeshStorage::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_INDEX(p_bone, skeleton->size);
+	ERR_FAIL_COND(!skeleton->use_2d);
+
+	// Stored as a 3D transform in the XY plane, so 2D and 3D share the evaluator.
+	Transform3D transform;
+	transform.basis.rows[0][0] = p_transform.columns[0][0];
+	transform.basis.rows[0][1] = p_transform.columns[1][0];
+	transform.origin.x = p_transform.columns[2][0];
+	transform.basis.rows[1][0] = p_transform.columns[0][1];
+	transform.basis.rows[1][1] = p_transform.columns[1][1];
+	transform.origin.y = p_transform.columns[2][1];
+
+	CPUSkinning::store_bone_transform(transform, skeleton->data.ptr() + p_bone * CPUSkinning::BONE_STRIDE);
+	_skeleton_make_dirty(skeleton);
+}
+
+Transform2D MeshStorage::skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, Transform2D());
+	ERR_FAIL_INDEX_V(p_bone, skeleton->size, Transform2D());
+	ERR_FAIL_COND_V(!skeleton->use_2d, Transform2D());
+
+	const Transform3D transform = CPUSkinning::load_bone_transform(skeleton->data.ptr() + p_bone * CPUSkinning::BONE_STRIDE);
+
+	Transform2D t;
+	t.columns[0][0] = transform.basis.rows[0][0];
+	t.columns[1][0] = transform.basis.rows[0][1];
+	t.columns[2][0] = transform.origin.x;
+	t.columns[0][1] = transform.basis.rows[1][0];
+	t.columns[1][1] = transform.basis.rows[1][1];
+	t.columns[2][1] = transform.origin.y;
+
+	return t;
+}
+
+void MeshStorage::skeleton_update_dependency(RID p_skeleton, DependencyTracker *p_instance) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+
+	p_instance->update_dependency(&skeleton->dependency);
+}
+
+void MeshStorage::update_dirty_skeletons() {
+	while (skeleton_dirty_list) {
+		DummySkeleton *skeleton = skeleton_dirty_list;
+		skeleton_dirty_list = skeleton->dirty_list;
+
+		skeleton->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_SKELETON_BONES);
+
+		skeleton->dirty = false;
+		skeleton->dirty_list = nullptr;
+	}
+}
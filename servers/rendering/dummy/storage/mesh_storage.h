@@ -33,7 +33,9 @@
 
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
+#include "servers/rendering/storage/cpu_skinning.h"
 #include "servers/rendering/storage/mesh_storage.h"
+#include "servers/rendering/storage/utilities.h"
 
 namespace RendererDummy {
 
@@ -43,13 +45,56 @@ private:
 
 	struct DummyMesh {
 		Vector<RS::SurfaceData> surfaces;
-		int blend_shape_count;
-		RS::BlendShapeMode blend_shape_mode;
+		int blend_shape_count = 0;
+		RS::BlendShapeMode blend_shape_mode = RS::BLEND_SHAPE_MODE_NORMALIZED;
 		PackedFloat32Array blend_shape_values;
+		AABB aabb;
+		AABB custom_aabb;
+		bool has_bone_weights = false;
+
+		AABB skeleton_aabb;
+		RID skeleton_aabb_rid;
+		uint64_t skeleton_aabb_version = 0;
+
+		Dependency dependency;
 	};
 
 	mutable RID_Owner<DummyMesh> mesh_owner;
 
+	void _mesh_invalidate_vertex_data(DummyMesh *p_mesh);
+
+	/* MESH INSTANCE */
+
+	// Nothing is rendered here, so the deformed vertices are never evaluated.
+	struct DummyMeshInstance {
+		RID mesh;
+		RID skeleton;
+		LocalVector<float> blend_weights;
+	};
+
+	mutable RID_Owner<DummyMeshInstance> mesh_instance_owner;
+
+	/* SKELETON */
+
+	struct DummySkeleton {
+		// CPUSkinning::BONE_STRIDE floats per bone, also for 2D skeletons.
+		LocalVector<float> data;
+		int size = 0;
+		bool use_2d = false;
+		Transform2D base_transform_2d;
+
+		uint64_t version = 1;
+		bool dirty = false;
+		DummySkeleton *dirty_list = nullptr;
+
+		Dependency dependency;
+	};
+
+	mutable RID_Owner<DummySkeleton> skeleton_owner;
+	DummySkeleton *skeleton_dirty_list = nullptr;
+
+	void _skeleton_make_dirty(DummySkeleton *p_skeleton);
+
 	struct DummyMultiMesh {
 		PackedFloat32Array buffer;
 	};
@@ -70,8 +115,8 @@ public:
 	virtual void mesh_initialize(RID p_rid) override;
 	virtual void mesh_free(RID p_rid) override;
 
-	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) override {}
-	virtual bool mesh_needs_instance(RID p_mesh, bool p_has_skeleton) override { return false; }
+	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) override;
+	virtual bool mesh_needs_instance(RID p_mesh, bool p_has_skeleton) override;
 
 	virtual void mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface) override {
 		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
@@ -93,16 +138,40 @@ public:
 		s->blend_shape_data = p_surface.blend_shape_data;
 		s->uv_scale = p_surface.uv_scale;
 		s->material = p_surface.material;
+
+		if (m->surfaces.size() == 1) {
+			m->aabb = p_surface.aabb;
+		} else {
+			m->aabb.merge_with(p_surface.aabb);
+		}
+		if (p_surface.format & RS::ARRAY_FORMAT_BONES) {
+			m->has_bone_weights = true;
+		}
+		_mesh_invalidate_vertex_data(m);
+		m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
 	}
 
-	virtual int mesh_get_blend_shape_count(RID p_mesh) const override { return 0; }
+	virtual int mesh_get_blend_shape_count(RID p_mesh) const override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL_V(m, 0);
+		return m->blend_shape_count;
+	}
 
-	virtual void mesh_set_blend_shape_mode(RID p_mesh, RS::BlendShapeMode p_mode) override {}
-	virtual RS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const override { return RS::BLEND_SHAPE_MODE_NORMALIZED; }
+	virtual void mesh_set_blend_shape_mode(RID p_mesh, RS::BlendShapeMode p_mode) override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL(m);
+		ERR_FAIL_INDEX((int)p_mode, 2);
+		m->blend_shape_mode = p_mode;
+	}
+	virtual RS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL_V(m, RS::BLEND_SHAPE_MODE_NORMALIZED);
+		return m->blend_shape_mode;
+	}
 
-	virtual void mesh_surface_update_vertex_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
-	virtual void mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
-	virtual void mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
+	virtual void mesh_surface_update_vertex_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override;
+	virtual void mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override;
+	virtual void mesh_surface_update_skin_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override;
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) override {}
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const override { return RID(); }
@@ -121,9 +190,18 @@ public:
 		return m->surfaces.size();
 	}
 
-	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {}
-	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override { return AABB(); }
-	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override { return AABB(); }
+	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL(m);
+		m->custom_aabb = p_aabb;
+		m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
+	}
+	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL_V(m, AABB());
+		return m->custom_aabb;
+	}
+	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override;
 
 	virtual void mesh_set_path(RID p_mesh, const String &p_path) override {}
 	virtual String mesh_get_path(RID p_mesh) const override { return String(); }
@@ -131,13 +209,17 @@ public:
 	virtual void mesh_set_shadow_mesh(RID p_mesh, RID p_shadow_mesh) override {}
 	virtual void mesh_clear(RID p_mesh) override;
 
+	Dependency *mesh_get_dependency(RID p_mesh) const;
+
 	/* MESH INSTANCE */
 
-	virtual RID mesh_instance_create(RID p_base) override { return RID(); }
-	virtual void mesh_instance_free(RID p_rid) override {}
+	bool owns_mesh_instance(RID p_rid) const { return mesh_instance_owner.owns(p_rid); }
 
-	virtual void mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) override {}
-	virtual void mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) override {}
+	virtual RID mesh_instance_create(RID p_base) override;
+	virtual void mesh_instance_free(RID p_rid) override;
+
+	virtual void mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) override;
+	virtual void mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) override;
 	virtual void mesh_instance_check_for_update(RID p_mesh_instance) override {}
 	virtual void mesh_instance_set_canvas_item_transform(RID p_mesh_instance, const Transform2D &p_transform) override {}
 	virtual void update_mesh_instances() override {}
@@ -179,18 +261,22 @@ public:
 
 	/* SKELETON API */
 
-	virtual RID skeleton_allocate() override { return RID(); }
-	virtual void skeleton_initialize(RID p_rid) override {}
-	virtual void skeleton_free(RID p_rid) override {}
-	virtual void skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) override {}
-	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) override {}
-	virtual int skeleton_get_bone_count(RID p_skeleton) const override { return 0; }
-	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) override {}
-	virtual Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const override { return Transform3D(); }
-	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) override {}
-	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const override { return Transform2D(); }
-
-	virtual void skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) override {}
+	bool owns_skeleton(RID p_rid) const { return skeleton_owner.owns(p_rid); }
+
+	virtual RID skeleton_allocate() override;
+	virtual void skeleton_initialize(RID p_rid) override;
+	virtual void skeleton_free(RID p_rid) override;
+	virtual void skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) override;
+	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) override;
+	virtual int skeleton_get_bone_count(RID p_skeleton) const override;
+	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) override;
+	virtual Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const override;
+	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) override;
+	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const override;
+
+	virtual void skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) override;
+
+	void update_dirty_skeletons();
 
 	/* OCCLUDER */
 
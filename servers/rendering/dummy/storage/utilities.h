@@ -74,6 +74,9 @@ public:
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
 			RendererDummy::MeshStorage::get_singleton()->multimesh_free(p_rid);
 			return true;
+		} else if (RendererDummy::MeshStorage::get_singleton()->owns_skeleton(p_rid)) {
+			RendererDummy::MeshStorage::get_singleton()->skeleton_free(p_rid);
+			return true;
 		} else if (RendererDummy::MaterialStorage::get_singleton()->owns_shader(p_rid)) {
 			RendererDummy::MaterialStorage::get_singleton()->shader_free(p_rid);
 			return true;
@@ -83,7 +86,11 @@ public:
 
 	/* DEPENDENCIES */
 
-	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {}
+	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {
+		if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_base)) {
+			p_instance->update_dependency(RendererDummy::MeshStorage::get_singleton()->mesh_get_dependency(p_base));
+		}
+	}
 
 	/* VISIBILITY NOTIFIER */
 
@@ -109,7 +116,7 @@ public:
 
 	/* MISC */
 
-	virtual void update_dirty_resources() override {}
+	virtual void update_dirty_resources() override { RendererDummy::MeshStorage::get_singleton()->update_dirty_skeletons(); }
 	virtual void set_debug_generate_wireframes(bool p_generate) override {}
 
 	virtual bool has_os_feature(const String &p_feature) const override {
@@ -0,0 +1,379 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const LocalVector<Triangle> &p_triangles, float p_z_far, bool p_orthogonal) {
+	const Size2i &size = sizes[0];
+	int tile_columns = (size.x + TILE_SIZE - 1) / TILE_SIZE;
+	int tile_rows = (size.y + TILE_SIZE - 1) / TILE_SIZE;
+	uint32_t tile_count = tile_columns * tile_rows;
+
+	bins.resize(tile_count);
+	for (LocalVector<uint32_t> &bin : bins) {
+		bin.clear();
+	}
+
+	for (uint32_t i = 0; i < p_triangles.size(); i++) {
+		const Triangle &tri = p_triangles[i];
+		int from_x = tri.min_x / TILE_SIZE;
+		int to_x = tri.max_x / TILE_SIZE;
+		int from_y = tri.min_y / TILE_SIZE;
+		int to_y = tri.max_y / TILE_SIZE;
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				bins[y * tile_columns + x].push_back(i);
+			}
+		}
+	}
+
+	RasterThreadData td;
+	td.triangles = p_triangles.ptr();
+	td.tile_columns = tile_columns;
+	td.clear_depth = p_z_far * 1.05f;
+	td.orthogonal = p_orthogonal;
+
+	debug_tex_range = td.clear_depth;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, &td, tile_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data) {
+	const Size2i &size = sizes[0];
+	int tile_x = (p_tile % p_data->tile_columns) * TILE_SIZE;
+	int tile_y = (p_tile / p_data->tile_columns) * TILE_SIZE;
+	int tile_w = MIN(TILE_SIZE, size.x - tile_x);
+	int tile_h = MIN(TILE_SIZE, size.y - tile_y);
+
+	float *depth = mips[0];
+
+	for (int y = tile_y; y < tile_y + tile_h; y++) {
+		float *row = &depth[y * size.x];
+		for (int x = tile_x; x < tile_x + tile_w; x++) {
+			row[x] = p_data->clear_depth;
+		}
+	}
+
+	const LocalVector<uint32_t> &bin = bins[p_tile];
+	for (uint32_t i = 0; i < bin.size(); i++) {
+		const Triangle &tri = p_data->triangles[bin[i]];
+
+		int from_x = MAX(tri.min_x, tile_x);
+		int to_x = MIN(tri.max_x, tile_x + tile_w - 1);
+		int from_y = MAX(tri.min_y, tile_y);
+		int to_y = MIN(tri.max_y, tile_y + tile_h - 1);
+
+		for (int y = from_y; y <= to_y; y++) {
+			float *row = &depth[y * size.x];
+			float py = y + 0.5f;
+
+			float e0 = tri.edges[0][1] * py + tri.edges[0][2];
+			float e1 = tri.edges[1][1] * py + tri.edges[1][2];
+			float e2 = tri.edges[2][1] * py + tri.edges[2][2];
+			float d = tri.depth[1] * py + tri.depth[2];
+
+			// Kept free of branches so it can be vectorized by the compiler.
+			if (p_data->orthogonal) {
+				for (int x = from_x; x <= to_x; x++) {
+					float px = x + 0.5f;
+					bool inside = (tri.edges[0][0] * px + e0 >= 0.0f) & (tri.edges[1][0] * px + e1 >= 0.0f) & (tri.edges[2][0] * px + e2 >= 0.0f);
+					float z = inside ? tri.depth[0] * px + d : FLT_MAX;
+					row[x] = MIN(row[x], z);
+				}
+			} else {
+				for (int x = from_x; x <= to_x; x++) {
+					float px = x + 0.5f;
+					bool inside = (tri.edges[0][0] * px + e0 >= 0.0f) & (tri.edges[1][0] * px + e1 >= 0.0f) & (tri.edges[2][0] * px + e2 >= 0.0f);
+					float inv_z = tri.depth[0] * px + d;
+					float z = inside ? 1.0f / inv_z : FLT_MAX;
+					row[x] = MIN(row[x], z);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	ERR_FAIL_COND(p_indices.size() % 3 != 0);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	occluder->aabb = AABB();
+	if (!p_vertices.is_empty()) {
+		occluder->aabb.position = p_vertices[0];
+		for (int i = 1; i < p_vertices.size(); i++) {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	ERR_FAIL_COND(p_occluder.is_valid() && !occluder_owner.owns(p_occluder));
+
+	OccluderInstance &instance = scenarios[p_scenario].instances[p_instance];
+	instance.occluder = p_occluder;
+	instance.xform = p_xform;
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios[p_scenario].instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_add_triangle(const Vector3 *p_view, const Projection &p_cam_projection, const Size2i &p_buffer_size, bool p_cam_orthogonal) {
+	real_t z_near = p_cam_projection.get_z_near();
+
+	// Clip against the near plane, which can turn the triangle into a quad.
+	Vector3 clipped[4];
+	int clipped_count = 0;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view[i];
+		const Vector3 &b = p_view[(i + 1) % 3];
+		bool a_inside = a.z <= -z_near;
+		bool b_inside = b.z <= -z_near;
+		if (a_inside) {
+			clipped[clipped_count++] = a;
+		}
+		if (a_inside != b_inside) {
+			real_t t = (-z_near - a.z) / (b.z - a.z);
+			clipped[clipped_count++] = a.lerp(b, t);
+		}
+	}
+
+	if (clipped_count < 3) {
+		return;
+	}
+
+	Vector2 screen[4];
+	float depth[4];
+	for (int i = 0; i < clipped_count; i++) {
+		Plane projected = p_cam_projection.xform4(Plane(clipped[i], 1.0));
+		float w = projected.d;
+		screen[i] = Vector2((projected.normal.x / w * 0.5f + 0.5f) * p_buffer_size.x, (projected.normal.y / w * 0.5f + 0.5f) * p_buffer_size.y);
+		depth[i] = p_cam_orthogonal ? -clipped[i].z : -1.0f / clipped[i].z;
+	}
+
+	for (int i = 2; i < clipped_count; i++) {
+		int idx[3] = { 0, i - 1, i };
+
+		float area = (screen[idx[1]] - screen[idx[0]]).cross(screen[idx[2]] - screen[idx[0]]);
+		if (Math::is_zero_approx(area)) {
+			continue;
+		}
+		if (area < 0.0f) {
+			// Occluders are rendered double-sided, so flip the winding instead of culling.
+			SWAP(idx[1], idx[2]);
+			area = -area;
+		}
+
+		Rect2 bounds(screen[idx[0]], Vector2());
+		bounds.expand_to(screen[idx[1]]);
+		bounds.expand_to(screen[idx[2]]);
+
+		Triangle tri;
+		tri.min_x = MAX(0, (int)Math::floor(bounds.position.x));
+		tri.min_y = MAX(0, (int)Math::floor(bounds.position.y));
+		tri.max_x = MIN(p_buffer_size.x - 1, (int)Math::ceil(bounds.position.x + bounds.size.x));
+		tri.max_y = MIN(p_buffer_size.y - 1, (int)Math::ceil(bounds.position.y + bounds.size.y));
+		if (tri.min_x > tri.max_x || tri.min_y > tri.max_y) {
+			continue;
+		}
+
+		// Edge j is opposite to vertex j, so its normalized value is the barycentric weight of that vertex.
+		float inv_area = 1.0f / area;
+		for (int j = 0; j < 3; j++) {
+			const Vector2 &a = screen[idx[(j + 1) % 3]];
+			const Vector2 &b = screen[idx[(j + 2) % 3]];
+			tri.edges[j][0] = (a.y - b.y) * inv_area;
+			tri.edges[j][1] = (b.x - a.x) * inv_area;
+			tri.edges[j][2] = (a.x * b.y - a.y * b.x) * inv_area;
+		}
+
+		for (int j = 0; j < 3; j++) {
+			tri.depth[j] = tri.edges[0][j] * depth[idx[0]] + tri.edges[1][j] * depth[idx[1]] + tri.edges[2][j] * depth[idx[2]];
+		}
+
+		triangles.push_back(tri);
+	}
+}
+
+void RasterOcclusionCull::_setup_triangles(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, const Size2i &p_buffer_size, bool p_cam_orthogonal) {
+	triangles.clear();
+
+	Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+
+	for (const KeyValue<RID, OccluderInstance> &E : p_scenario.instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder || occluder->indices.is_empty()) {
+			continue;
+		}
+
+		AABB aabb = instance.xform.xform(occluder->aabb);
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			if (plane.is_point_over(aabb.get_support(-plane.normal))) {
+				outside = true;
+				break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		Transform3D view_xform = cam_inv_transform * instance.xform;
+		int vertex_count = occluder->vertices.size();
+		view_vertices.resize(vertex_count);
+		const Vector3 *read = occluder->vertices.ptr();
+		for (int i = 0; i < vertex_count; i++) {
+			view_vertices[i] = view_xform.xform(read[i]);
+		}
+
+		const int32_t *indices = occluder->indices.ptr();
+		int index_count = occluder->indices.size();
+		for (int i = 0; i < index_count; i += 3) {
+			ERR_CONTINUE(indices[i] >= vertex_count || indices[i + 1] >= vertex_count || indices[i + 2] >= vertex_count);
+			Vector3 tri[3] = { view_vertices[indices[i]], view_vertices[indices[i + 1]], view_vertices[indices[i + 2]] };
+			_add_triangle(tri, p_cam_projection, p_buffer_size, p_cam_orthogonal);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Projection jittered_proj = _jitter_projection(p_cam_projection, buffer.get_occlusion_buffer_size());
+	Size2i size = buffer.get_occlusion_buffer_size();
+
+	_setup_triangles(scenarios[buffer.scenario_rid], p_cam_transform, jittered_proj, size, p_cam_orthogonal);
+
+	buffer.rasterize(triangles, p_cam_projection.get_z_far(), p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	List<RID> owned;
+	occluder_owner.get_owned_list(&owned);
+	for (const RID &rid : owned) {
+		free_occluder(rid);
+	}
+}
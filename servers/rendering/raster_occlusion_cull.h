@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Built-in occlusion culling, used unless a module provides its own implementation.
+// Occluders are rasterized on the CPU straight into the depth buffer, which is
+// split into tiles that are filled in parallel.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	struct Triangle {
+		// Edge functions and interpolated depth as planes over screen space (a * x + b * y + c),
+		// set up so that pixels inside the triangle have all edge functions >= 0.
+		float edges[3][3];
+		float depth[3]; // Inverse view depth with perspective projections, view depth otherwise.
+		int min_x, min_y, max_x, max_y;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		static const int TILE_SIZE = 16;
+
+	private:
+		struct RasterThreadData {
+			const Triangle *triangles = nullptr;
+			int tile_columns = 0;
+			float clear_depth = 0.0f;
+			bool orthogonal = false;
+		};
+
+		LocalVector<LocalVector<uint32_t>> bins; // Triangles overlapping each tile.
+
+		void _rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+
+		void rasterize(const LocalVector<Triangle> &p_triangles, float p_z_far, bool p_orthogonal);
+	};
+
+private:
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		AABB aabb;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	// Reused between updates to avoid reallocating.
+	LocalVector<Vector3> view_vertices;
+	LocalVector<Triangle> triangles;
+
+	void _setup_triangles(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, const Size2i &p_buffer_size, bool p_cam_orthogonal);
+	void _add_triangle(const Vector3 *p_view, const Projection &p_cam_projection, const Size2i &p_buffer_size, bool p_cam_orthogonal);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -50,8 +51,24 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, Point2(), 1, nullptr);
+	if (p_child_item_count >= (int)thread_cull_threshold && !threaded_cull_running) {
+		top_level_items.clear();
+		for (int i = 0; i < p_child_item_count; i++) {
+			top_level_items.push_back(p_child_items[i].item);
+		}
+
+		ChildCullData child_cull_data;
+		child_cull_data.child_items = top_level_items.ptr();
+		child_cull_data.child_item_count = p_child_item_count;
+		child_cull_data.xform = p_transform;
+		child_cull_data.clip_rect = p_clip_rect;
+		child_cull_data.modulate = Color(1, 1, 1, 1);
+		child_cull_data.canvas_cull_mask = p_canvas_cull_mask;
+		_cull_children_threaded(child_cull_data, z_list, z_last_list);
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -124,6 +141,103 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<Renderer
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void RendererCanvasCull::_mark_subtree_rect_dirty(Item *p_item) {
+	// A clean item never has a dirty descendant, so stop at the first dirty ancestor.
+	while (p_item && !p_item->subtree_rect_dirty) {
+		p_item->subtree_rect_dirty = true;
+		p_item = canvas_item_owner.owns(p_item->parent) ? canvas_item_owner.get_or_null(p_item->parent) : nullptr;
+	}
+}
+
+void RendererCanvasCull::_update_subtree_rect(Item *p_item) {
+	// Hidden children are included too, so that toggling visibility doesn't need to dirty the parents.
+	bool empty = p_item->commands == nullptr && p_item->visibility_notifier == nullptr;
+	Rect2 rect;
+	if (!empty) {
+		rect = p_item->get_rect();
+		if (p_item->visibility_notifier && p_item->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(p_item->visibility_notifier->area);
+		}
+	}
+
+	// These draw outside of their own rect (or regardless of it).
+	bool unbounded = p_item->repeat_source || p_item->copy_back_buffer || p_item->vp_render || p_item->canvas_group;
+	// Skinned and update_when_visible items recompute their rect on every draw, so it can't be cached.
+	unbounded = unbounded || (!p_item->custom_rect && (p_item->update_when_visible || p_item->skeleton.is_valid()));
+
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		if (child->subtree_rect_dirty) {
+			_update_subtree_rect(child);
+		}
+		if (child->subtree_unbounded) {
+			unbounded = true;
+		} else if (!child->subtree_empty) {
+			Rect2 child_rect = child->xform_curr.xform(child->subtree_rect);
+			rect = empty ? child_rect : rect.merge(child_rect);
+			empty = false;
+		}
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_empty = empty;
+	p_item->subtree_unbounded = unbounded;
+	p_item->subtree_rect_dirty = false;
+}
+
+void RendererCanvasCull::_cull_child_chunk(uint32_t p_chunk, ChildCullData *p_data) {
+	int from = p_chunk * p_data->child_item_count / p_data->chunk_count;
+	int to = (p_chunk + 1) * p_data->child_item_count / p_data->chunk_count;
+
+	RendererCanvasRender::Item **chunk_z_list = chunk_z_lists.ptr() + p_chunk * z_range * 2;
+	RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+	memset(chunk_z_list, 0, z_range * 2 * sizeof(RendererCanvasRender::Item *));
+
+	for (int i = from; i < to; i++) {
+		Item *child = p_data->child_items[i];
+		if (p_data->y_sorted) {
+			_cull_canvas_item(child, p_data->xform * child->ysort_xform, p_data->clip_rect, p_data->modulate * child->ysort_modulate, child->ysort_parent_abs_z_index, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, (Item *)child->material_owner, false, p_data->canvas_cull_mask, child->repeat_size, child->repeat_times, child->repeat_source_item);
+		} else {
+			if (p_data->skip_behind && child->behind) {
+				continue;
+			}
+			_cull_canvas_item(child, p_data->xform, p_data->clip_rect, p_data->modulate, p_data->z, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, p_data->material_owner, true, p_data->canvas_cull_mask, p_data->repeat_size, p_data->repeat_times, p_data->repeat_source_item);
+		}
+	}
+}
+
+void RendererCanvasCull::_cull_children_threaded(ChildCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	p_data.chunk_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), (uint32_t)p_data.child_item_count);
+	if (chunk_z_lists.size() < p_data.chunk_count * z_range * 2) {
+		chunk_z_lists.resize(p_data.chunk_count * z_range * 2);
+	}
+
+	// Subtrees found while culling on the worker threads are culled serially.
+	threaded_cull_running = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_child_chunk, &p_data, p_data.chunk_count, -1, true, SNAME("CanvasCullItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	threaded_cull_running = false;
+
+	// Append each chunk's lists in order, so items end up in the same order as when culled serially.
+	for (uint32_t i = 0; i < p_data.chunk_count; i++) {
+		RendererCanvasRender::Item **chunk_z_list = chunk_z_lists.ptr() + i * z_range * 2;
+		RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+		for (int j = 0; j < z_range; j++) {
+			if (!chunk_z_list[j]) {
+				continue;
+			}
+			if (r_z_last_list[j]) {
+				r_z_last_list[j]->next = chunk_z_list[j];
+			} else {
+				r_z_list[j] = chunk_z_list[j];
+			}
+			r_z_last_list[j] = chunk_z_last_list[j];
+		}
+	}
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -196,7 +310,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			cull_lock.lock();
 			RenderingServerDefault::redraw_request();
+			cull_lock.unlock();
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -224,7 +340,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				cull_lock.lock();
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				cull_lock.unlock();
 				ci->visibility_notifier->just_visible = true;
 			}
 
@@ -313,6 +431,25 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 	global_rect.position += p_clip_rect.position;
 
+	// Reject the whole subtree when its bounds are offscreen. Y-sorted descendants are culled
+	// from their sorting parent's list instead, and interpolation, snapping and repeating move
+	// items away from their cached bounds.
+	if (p_allow_y_sort && !repeat_source_item && !snapping_2d_transforms_to_pixel && !_interpolation_data.interpolation_enabled) {
+		if (ci->subtree_rect_dirty) {
+			_update_subtree_rect(ci);
+		}
+		if (!ci->subtree_unbounded) {
+			if (ci->subtree_empty) {
+				return;
+			}
+			Rect2 subtree_global_rect = final_xform.xform(ci->subtree_rect);
+			subtree_global_rect.position += p_clip_rect.position;
+			if (!p_clip_rect.intersects(subtree_global_rect, true)) {
+				return;
+			}
+		}
+	}
+
 	if (ci->use_parent_material && p_material_owner) {
 		ci->material_owner = p_material_owner;
 	} else {
@@ -376,8 +513,21 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			SortArray<Item *, ItemPtrSort> sorter;
 			sorter.sort(child_items, child_item_count);
 
-			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+			if (child_item_count >= (int)thread_cull_threshold && !threaded_cull_running) {
+				ChildCullData child_cull_data;
+				child_cull_data.child_items = child_items;
+				child_cull_data.child_item_count = child_item_count;
+				child_cull_data.y_sorted = true;
+				child_cull_data.xform = final_xform;
+				child_cull_data.clip_rect = p_clip_rect;
+				child_cull_data.modulate = modulate;
+				child_cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+				child_cull_data.canvas_cull_mask = p_canvas_cull_mask;
+				_cull_children_threaded(child_cull_data, r_z_list, r_z_last_list);
+			} else {
+				for (i = 0; i < child_item_count; i++) {
+					_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				}
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -404,11 +554,29 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
-		for (int i = 0; i < child_item_count; i++) {
-			if (child_items[i]->behind || use_canvas_group) {
-				continue;
+		if (!use_canvas_group && child_item_count >= (int)thread_cull_threshold && !threaded_cull_running) {
+			ChildCullData child_cull_data;
+			child_cull_data.child_items = child_items;
+			child_cull_data.child_item_count = child_item_count;
+			child_cull_data.skip_behind = true;
+			child_cull_data.xform = final_xform;
+			child_cull_data.clip_rect = p_clip_rect;
+			child_cull_data.modulate = modulate;
+			child_cull_data.z = p_z;
+			child_cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+			child_cull_data.material_owner = p_material_owner;
+			child_cull_data.canvas_cull_mask = p_canvas_cull_mask;
+			child_cull_data.repeat_size = repeat_size;
+			child_cull_data.repeat_times = repeat_times;
+			child_cull_data.repeat_source_item = repeat_source_item;
+			_cull_children_threaded(child_cull_data, r_z_list, r_z_last_list);
+		} else {
+			for (int i = 0; i < child_item_count; i++) {
+				if (child_items[i]->behind || use_canvas_group) {
+					continue;
+				}
+				_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 	}
 }
@@ -448,6 +616,7 @@ void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, con
 	ERR_FAIL_NULL(canvas);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	int idx = canvas->find_item(canvas_item);
 	ERR_FAIL_COND(idx == -1);
@@ -463,6 +632,7 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	ERR_FAIL_COND(p_repeat_times < 0);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	bool is_repeat_source = (p_repeat_size.x || p_repeat_size.y) && p_repeat_times;
 	canvas_item->repeat_source = is_repeat_source;
@@ -507,6 +677,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_mark_subtree_rect_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -527,6 +698,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			_mark_subtree_rect_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -559,6 +731,7 @@ void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
 void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (_interpolation_data.interpolation_enabled && canvas_item->interpolated) {
 		if (!canvas_item->on_interpolate_transform_list) {
@@ -603,6 +776,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -634,11 +808,13 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_subtree_rect_dirty(canvas_item);
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(line);
@@ -868,6 +1044,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -1138,6 +1315,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 		}
 		Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 		ERR_FAIL_NULL(canvas_item);
+		_mark_subtree_rect_dirty(canvas_item);
 
 		Vector<Color> colors;
 		if (p_colors.size() == 1) {
@@ -1180,6 +1358,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1344,6 +1523,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	static const int circle_segments = 64;
 
@@ -1435,6 +1615,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1466,6 +1647,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range, float p_scale) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1500,6 +1682,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1532,6 +1715,7 @@ void RendererCanvasCull::canvas_item_add_lcd_texture_rect_region(RID p_item, con
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_NULL(rect);
@@ -1573,6 +1757,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_NULL(style);
@@ -1597,6 +1782,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_NULL(prim);
@@ -1623,6 +1809,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1644,6 +1831,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -1665,6 +1853,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_NULL(tr);
@@ -1674,6 +1863,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1693,6 +1883,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
@@ -1707,6 +1898,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
@@ -1718,6 +1910,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_NULL(ci);
@@ -1727,6 +1920,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_NULL(as);
@@ -1764,6 +1958,7 @@ void RendererCanvasCull::canvas_item_set_z_as_relative_to_parent(RID p_item, boo
 void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (canvas_item->skeleton == p_skeleton) {
 		return;
 	}
@@ -1793,6 +1988,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1810,6 +2006,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->clear();
 #ifdef DEBUG_ENABLED
@@ -1855,6 +2052,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1890,6 +2088,7 @@ void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpo
 void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	canvas_item->xform_prev = canvas_item->xform_curr;
 }
 
@@ -1897,6 +2096,7 @@ void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
 void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
 }
@@ -1904,6 +2104,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -2421,6 +2622,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_mark_subtree_rect_dirty(item_owner);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2609,6 +2811,8 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	thread_cull_threshold = GLOBAL_GET("rendering/2d/culling/threaded_cull_minimum_children");
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
@@ -36,6 +36,8 @@
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
+	friend class TestRendererCanvasCullInternalsAccessor;
+
 public:
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
@@ -56,6 +58,13 @@ public:
 		int ysort_parent_abs_z_index; // Absolute Z index of parent. Only populated and used when y-sorting.
 		uint32_t visibility_layer = 0xffffffff;
 
+		// Bounds of this item and all of its descendants in local coordinates,
+		// used to reject whole offscreen subtrees. Unbounded subtrees are never rejected.
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty = true;
+		bool subtree_empty = false;
+		bool subtree_unbounded = false;
+
 		Vector<Item *> child_items;
 
 		struct VisibilityNotifierData {
@@ -183,6 +192,9 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
+	void _mark_subtree_rect_dirty(Item *p_item);
+	void _update_subtree_rect(Item *p_item);
+
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
@@ -194,6 +206,36 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Sibling subtrees are culled on worker threads, each chunk of siblings
+	// into its own z lists, which are then appended in sibling order.
+	struct ChildCullData {
+		Item **child_items = nullptr;
+		int child_item_count = 0;
+		uint32_t chunk_count = 0;
+		bool y_sorted = false;
+		bool skip_behind = false;
+
+		Transform2D xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+		Point2 repeat_size;
+		int repeat_times = 1;
+		RendererCanvasRender::Item *repeat_source_item = nullptr;
+	};
+
+	uint32_t thread_cull_threshold = 1000;
+	bool threaded_cull_running = false;
+	LocalVector<RendererCanvasRender::Item *> chunk_z_lists;
+	LocalVector<Item *> top_level_items;
+	SpinLock cull_lock;
+
+	void _cull_child_chunk(uint32_t p_chunk, ChildCullData *p_data);
+	void _cull_children_threaded(ChildCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
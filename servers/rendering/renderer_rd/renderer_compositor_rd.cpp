@@ -294,6 +294,7 @@ RendererCompositorRD::RendererCompositorRD() {
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
+					ShaderCompiler::set_cache_dir(shader_cache_dir);
 				}
 			}
 		}
@@ -335,4 +336,5 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderCompiler::set_cache_dir(String());
 }
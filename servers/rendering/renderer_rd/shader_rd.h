@@ -92,7 +92,7 @@ private:
 	void _compile_version(Version *p_version, int p_group);
 	void _allocate_placeholders(Version *p_version, int p_group);
 
-	RID_Owner<Version> version_owner;
+	RID_Owner<Version, true> version_owner;
 
 	struct StageTemplate {
 		struct Chunk {
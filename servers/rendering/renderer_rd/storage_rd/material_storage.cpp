@@ -32,6 +32,7 @@
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering/storage/variant_converters.h"
 #include "texture_storage.h"
 
@@ -1908,18 +1909,84 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		}
 	}
 
+	if (shader->data && shader_compile_batch_depth > 0) {
+		// Compiled together with the rest of the batch in shader_compile_batch_end().
+		shader->data->set_path_hint(shader->path_hint);
+		if (!shader->compile_pending) {
+			shader->compile_pending = true;
+			shader_compile_batch.push_back(p_shader);
+		}
+		return;
+	}
+
+	shader->compile_pending = false;
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
 		shader->data->set_code(p_code);
 	}
 
-	for (Material *E : shader->owners) {
+	_shader_notify_owners(shader);
+}
+
+void MaterialStorage::_shader_notify_owners(Shader *p_shader) {
+	for (Material *E : p_shader->owners) {
 		Material *material = E;
 		material->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MATERIAL);
 		_material_queue_update(material, true, true);
 	}
 }
 
+void MaterialStorage::_shader_compile_pending(Shader *p_shader) {
+	if (!p_shader->compile_pending) {
+		return;
+	}
+
+	// Something needs the compiled shader before the batch ended, compile it right away.
+	p_shader->compile_pending = false;
+	if (p_shader->data) {
+		p_shader->data->set_code(p_shader->code);
+	}
+	_shader_notify_owners(p_shader);
+}
+
+void MaterialStorage::_shader_compile_batch_task(uint32_t p_index, Shader **p_shaders) {
+	p_shaders[p_index]->data->set_code(p_shaders[p_index]->code);
+}
+
+void MaterialStorage::shader_compile_batch_begin() {
+	shader_compile_batch_depth++;
+}
+
+void MaterialStorage::shader_compile_batch_end() {
+	ERR_FAIL_COND_MSG(shader_compile_batch_depth == 0, "Shader compile batch ended without being started.");
+
+	shader_compile_batch_depth--;
+	if (shader_compile_batch_depth > 0) {
+		return;
+	}
+
+	LocalVector<Shader *> shaders;
+	for (const RID &E : shader_compile_batch) {
+		Shader *shader = shader_owner.get_or_null(E);
+		if (shader && shader->compile_pending && shader->data) {
+			shaders.push_back(shader);
+		}
+	}
+	shader_compile_batch.clear();
+
+	if (!shaders.is_empty()) {
+		// Low priority, so compiling a shader can still run the high priority
+		// tasks it spawns for its own variants and wait for them.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MaterialStorage::_shader_compile_batch_task, shaders.ptr(), shaders.size(), -1, false, SNAME("ShaderBatchCompilation"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (Shader *shader : shaders) {
+		shader->compile_pending = false;
+		_shader_notify_owners(shader);
+	}
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
@@ -1939,6 +2006,7 @@ String MaterialStorage::shader_get_code(RID p_shader) const {
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
+	const_cast<MaterialStorage *>(this)->_shader_compile_pending(shader);
 	if (shader->data) {
 		return shader->data->get_shader_uniform_list(p_param_list);
 	}
@@ -1984,6 +2052,7 @@ RID MaterialStorage::shader_get_default_texture_parameter(RID p_shader, const St
 Variant MaterialStorage::shader_get_parameter_default(RID p_shader, const StringName &p_param) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, Variant());
+	const_cast<MaterialStorage *>(this)->_shader_compile_pending(shader);
 	if (shader->data) {
 		return shader->data->get_default_parameter(p_param);
 	}
@@ -1998,6 +2067,7 @@ void MaterialStorage::shader_set_data_request_function(ShaderType p_shader_type,
 RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_shader) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, RS::ShaderNativeSourceCode());
+	const_cast<MaterialStorage *>(this)->_shader_compile_pending(shader);
 	if (shader->data) {
 		return shader->data->get_native_source_code();
 	}
@@ -207,6 +207,7 @@ private:
 		ShaderType type;
 		HashMap<StringName, HashMap<int, RID>> default_texture_parameter;
 		HashSet<Material *> owners;
+		bool compile_pending = false;
 	};
 
 	typedef ShaderData *(*ShaderDataRequestFunction)();
@@ -215,6 +216,15 @@ private:
 	mutable RID_Owner<Shader, true> shader_owner;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
 
+	// Shaders whose code was set inside a compile batch, compiled in parallel
+	// once the outermost batch ends.
+	uint32_t shader_compile_batch_depth = 0;
+	LocalVector<RID> shader_compile_batch;
+
+	void _shader_notify_owners(Shader *p_shader);
+	void _shader_compile_pending(Shader *p_shader);
+	void _shader_compile_batch_task(uint32_t p_index, Shader **p_shaders);
+
 	/* MATERIAL API */
 
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
@@ -407,6 +417,9 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	virtual void shader_compile_batch_begin() override;
+	virtual void shader_compile_batch_end() override;
+
 	/* MATERIAL API */
 
 	bool owns_material(RID p_rid) { return material_owner.owns(p_rid); };
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_constants.h"
 #include "rendering_server_default.h"
@@ -173,6 +174,8 @@ void RendererSceneCull::_instance_pair(Instance *p_A, Instance *p_B) {
 	Instance *A = p_A;
 	Instance *B = p_B;
 
+	_instance_cull_changed(A);
+
 	//instance indices are designed so greater always contains lesser
 	if (A->base_type > B->base_type) {
 		SWAP(A, B); //lesser always first
@@ -280,6 +283,8 @@ void RendererSceneCull::_instance_unpair(Instance *p_A, Instance *p_B) {
 	Instance *A = p_A;
 	Instance *B = p_B;
 
+	_instance_cull_changed(A);
+
 	//instance indices are designed so greater always contains lesser
 	if (A->base_type > B->base_type) {
 		SWAP(A, B); //lesser always first
@@ -457,6 +462,13 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 }
 
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
+	// Called whenever a viewport leaves its scenario, so its cull cache goes too,
+	// even if the scenario has no visibility ranges and no mask was ever assigned.
+	if (cull_caches.has(p_viewport)) {
+		memdelete(cull_caches[p_viewport]);
+		cull_caches.erase(p_viewport);
+	}
+
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_NULL(scenario);
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
@@ -466,6 +478,7 @@ void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario,
 	uint64_t mask = scenario->viewport_visibility_masks[p_viewport];
 	scenario->used_viewport_visibility_bits &= ~mask;
 	scenario->viewport_visibility_masks.erase(p_viewport);
+	scenario->cull_version++;
 }
 
 void RendererSceneCull::scenario_add_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
@@ -485,6 +498,7 @@ void RendererSceneCull::scenario_add_viewport_visibility_mask(RID p_scenario, RI
 
 	scenario->viewport_visibility_masks[p_viewport] = new_mask;
 	scenario->used_viewport_visibility_bits |= new_mask;
+	scenario->cull_version++;
 }
 
 /* INSTANCING API */
@@ -514,6 +528,8 @@ void RendererSceneCull::instance_initialize(RID p_rid) {
 }
 
 void RendererSceneCull::_instance_update_mesh_instance(Instance *p_instance) {
+	_instance_cull_changed(p_instance);
+
 	bool needs_instance = RSG::mesh_storage->mesh_needs_instance(p_instance->base, p_instance->skeleton.is_valid());
 	if (needs_instance != p_instance->mesh_instance.is_valid()) {
 		if (needs_instance) {
@@ -547,6 +563,7 @@ void RendererSceneCull::instance_set_base(RID p_instance, RID p_base) {
 	ERR_FAIL_NULL(instance);
 
 	Scenario *scenario = instance->scenario;
+	_instance_cull_changed(instance);
 
 	if (instance->base_type != RS::INSTANCE_NONE) {
 		//free anything related to that base
@@ -893,6 +910,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	}
 
 	instance->layer_mask = p_mask;
+	_instance_cull_changed(instance);
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
 	}
@@ -1226,6 +1244,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
 	instance->ignore_all_culling = p_enabled;
+	_instance_cull_changed(instance);
 
 	if (instance->scenario && instance->array_index >= 0) {
 		InstanceData &idata = instance->scenario->instance_data[instance->array_index];
@@ -1315,6 +1334,8 @@ void RendererSceneCull::instance_geometry_set_flag(RID p_instance, RS::InstanceF
 
 	//ERR_FAIL_COND(((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK));
 
+	_instance_cull_changed(instance);
+
 	switch (p_flags) {
 		case RS::INSTANCE_FLAG_USE_BAKED_LIGHT: {
 			instance->baked_light = p_enabled;
@@ -1391,6 +1412,7 @@ void RendererSceneCull::instance_geometry_set_cast_shadows_setting(RID p_instanc
 	ERR_FAIL_NULL(instance);
 
 	instance->cast_shadows = p_shadow_casting_setting;
+	_instance_cull_changed(instance);
 
 	if (instance->scenario && instance->array_index >= 0) {
 		InstanceData &idata = instance->scenario->instance_data[instance->array_index];
@@ -1475,6 +1497,7 @@ void RendererSceneCull::instance_set_visibility_parent(RID p_instance, RID p_par
 	Instance *old_parent = instance->visibility_parent;
 	if (old_parent) {
 		old_parent->visibility_dependencies.erase(instance);
+		old_parent->visibility_dependencies_aabb_dirty = true;
 		instance->visibility_parent = nullptr;
 		_update_instance_visibility_depth(old_parent);
 	}
@@ -1484,6 +1507,7 @@ void RendererSceneCull::instance_set_visibility_parent(RID p_instance, RID p_par
 
 	if (parent) {
 		parent->visibility_dependencies.insert(instance);
+		parent->visibility_dependencies_aabb_dirty = true;
 		instance->visibility_parent = parent;
 
 		bool cycle_detected = _update_instance_visibility_depth(parent);
@@ -1497,6 +1521,26 @@ void RendererSceneCull::instance_set_visibility_parent(RID p_instance, RID p_par
 	_update_instance_visibility_dependencies(instance);
 }
 
+void RendererSceneCull::_update_visibility_dependencies_aabb(Instance *p_instance) {
+	AABB aabb;
+	bool first = true;
+	for (const Instance *E : p_instance->visibility_dependencies) {
+		// Hidden dependencies are included too, so the bounds don't need updating when they are shown.
+		if (E->scenario != p_instance->scenario) {
+			continue;
+		}
+		if (first) {
+			aabb = E->transformed_aabb;
+			first = false;
+		} else {
+			aabb.merge_with(E->transformed_aabb);
+		}
+	}
+
+	p_instance->visibility_dependencies_aabb = aabb;
+	p_instance->visibility_dependencies_aabb_dirty = false;
+}
+
 bool RendererSceneCull::_update_instance_visibility_depth(Instance *p_instance) {
 	bool cycle_detected = false;
 	HashSet<Instance *> traversed_nodes;
@@ -1532,6 +1576,8 @@ bool RendererSceneCull::_update_instance_visibility_depth(Instance *p_instance)
 }
 
 void RendererSceneCull::_update_instance_visibility_dependencies(Instance *p_instance) {
+	_instance_cull_changed(p_instance);
+
 	bool is_geometry_instance = ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) && p_instance->base_data;
 	bool has_visibility_range = p_instance->visibility_range_begin > 0.0 || p_instance->visibility_range_end > 0.0;
 	bool needs_visibility_cull = has_visibility_range && is_geometry_instance && p_instance->array_index != -1;
@@ -1709,6 +1755,7 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 
 void RendererSceneCull::_update_instance(Instance *p_instance) {
 	p_instance->version++;
+	_instance_cull_changed(p_instance);
 
 	// When not using interpolation the transform is used straight.
 	const Transform3D *instance_xform = &p_instance->transform;
@@ -1956,6 +2003,10 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_visibility[p_instance->visibility_index].position = p_instance->transformed_aabb.get_center();
 	}
 
+	if (p_instance->visibility_parent) {
+		p_instance->visibility_parent->visibility_dependencies_aabb_dirty = true;
+	}
+
 	//move instance and repair
 	pair_pass++;
 
@@ -2015,6 +2066,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		return; //nothing to do
 	}
 
+	_instance_cull_changed(p_instance);
+
 	while (p_instance->pairs.first()) {
 		InstancePair *pair = p_instance->pairs.first()->self();
 		Instance *other_instance = p_instance == pair->a ? pair->b : pair->a;
@@ -2456,30 +2509,21 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
-	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
-
+uint32_t RendererSceneCull::_light_instance_setup_shadow_passes(Instance *p_instance, uint32_t p_light) {
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
+	uint32_t first_pass = shadow_passes.size();
 
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
 		case RS::LIGHT_OMNI: {
 			RS::LightOmniShadowMode shadow_mode = RSG::light_storage->light_omni_get_shadow_mode(p_instance->base);
+			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 			if (shadow_mode == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !RSG::light_storage->light_instances_can_render_shadow_cube()) {
-				if (max_shadows_used + 2 > MAX_UPDATE_SHADOWS) {
-					return true;
-				}
 				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
-					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-
 					real_t z = i == 0 ? -1 : 1;
 					Vector<Plane> planes;
 					planes.resize(6);
@@ -2490,205 +2534,339 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
+					shadow_passes.push_back(ShadowPass());
+					ShadowPass &pass = shadow_passes[shadow_passes.size() - 1];
+					pass.planes = planes;
+					pass.transform = light_transform;
+					pass.range = radius;
+					pass.pass = i;
+				}
+			} else { //shadow cube
+				Projection cm;
+				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+				static const Vector3 view_normals[6] = {
+					Vector3(+1, 0, 0),
+					Vector3(-1, 0, 0),
+					Vector3(0, -1, 0),
+					Vector3(0, +1, 0),
+					Vector3(0, 0, +1),
+					Vector3(0, 0, -1)
+				};
+				static const Vector3 view_up[6] = {
+					Vector3(0, -1, 0),
+					Vector3(0, -1, 0),
+					Vector3(0, 0, -1),
+					Vector3(0, 0, +1),
+					Vector3(0, -1, 0),
+					Vector3(0, -1, 0)
+				};
 
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
+				for (int i = 0; i < 6; i++) {
+					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
+					shadow_passes.push_back(ShadowPass());
+					ShadowPass &pass = shadow_passes[shadow_passes.size() - 1];
+					pass.planes = cm.get_projection_planes(xform);
+					pass.projection = cm;
+					pass.transform = xform;
+					pass.range = radius;
+					pass.pass = i;
+				}
+			}
 
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+		} break;
+		case RS::LIGHT_SPOT: {
+			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
+			real_t angle = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
 
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+			Projection cm;
+			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
+			shadow_passes.push_back(ShadowPass());
+			ShadowPass &pass = shadow_passes[shadow_passes.size() - 1];
+			pass.planes = cm.get_projection_planes(light_transform);
+			pass.projection = cm;
+			pass.transform = light_transform;
+			pass.range = radius;
+			pass.pass = 0;
 
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
+		} break;
+	}
 
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
+	for (uint32_t i = first_pass; i < shadow_passes.size(); i++) {
+		ShadowPass &pass = shadow_passes[i];
+		pass.points = Geometry3D::compute_convex_mesh_points(&pass.planes[0], pass.planes.size());
+		pass.light = p_light;
 
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
+		if (pass.points.size()) {
+			pass.bounds = AABB(pass.points[0], Vector3());
+			for (int j = 1; j < pass.points.size(); j++) {
+				pass.bounds.expand_to(pass.points[j]);
+			}
+		}
+	}
 
-					RSG::mesh_storage->update_mesh_instances();
+	return shadow_passes.size() - first_pass;
+}
 
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
-				}
-			} else { //shadow cube
+bool RendererSceneCull::_light_instance_finish_shadow_pass(Instance *p_instance, const ShadowPass &p_pass, uint32_t p_shadow_index, uint32_t p_visible_layers) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
-				if (max_shadows_used + 6 > MAX_UPDATE_SHADOWS) {
-					return true;
-				}
+	bool animated_material_found = false;
 
-				real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-				Projection cm;
-				cm.set_perspective(90, 1, radius * 0.005f, radius);
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[p_shadow_index];
 
-				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
-					static const Vector3 view_normals[6] = {
-						Vector3(+1, 0, 0),
-						Vector3(-1, 0, 0),
-						Vector3(0, -1, 0),
-						Vector3(0, +1, 0),
-						Vector3(0, 0, +1),
-						Vector3(0, 0, -1)
-					};
-					static const Vector3 view_up[6] = {
-						Vector3(0, -1, 0),
-						Vector3(0, -1, 0),
-						Vector3(0, 0, -1),
-						Vector3(0, 0, +1),
-						Vector3(0, -1, 0),
-						Vector3(0, -1, 0)
-					};
+	for (Instance *instance : p_pass.casters) {
+		if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
+			continue;
+		} else {
+			if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+				animated_material_found = true;
+			}
 
-					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
+			if (instance->mesh_instance.is_valid()) {
+				RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
+			}
+		}
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
+		shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+	}
 
-					instance_shadow_cull_result.clear();
+	RSG::mesh_storage->update_mesh_instances();
 
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+	RSG::light_storage->light_instance_set_shadow_transform(light->instance, p_pass.projection, p_pass.transform, p_pass.range, 0, p_pass.pass, 0);
+	shadow_data.light = light->instance;
+	shadow_data.pass = p_pass.pass;
 
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
+	return animated_material_found;
+}
 
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
+bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, int32_t p_light_cull_id, Scenario *p_scenario, uint32_t p_visible_layers) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	shadow_passes.clear();
+	uint32_t pass_count = _light_instance_setup_shadow_passes(p_instance, 0);
 
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	if (max_shadows_used + pass_count > MAX_UPDATE_SHADOWS) {
+		return true;
+	}
 
-					if (!light->is_shadow_update_full()) {
-						light_culler->cull_regular_light(instance_shadow_cull_result);
-					}
+	bool animated_material_found = false;
 
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
+	for (ShadowPass &pass : shadow_passes) {
+		RENDER_TIMESTAMP("Cull Light3D Shadow, Pass " + itos(pass.pass));
 
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
+		struct CullConvex {
+			LocalVector<Instance *> *result;
+			_FORCE_INLINE_ bool operator()(void *p_data) {
+				Instance *p_instance = (Instance *)p_data;
+				result->push_back(p_instance);
+				return false;
+			}
+		};
 
-					RSG::mesh_storage->update_mesh_instances();
-					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
+		CullConvex cull_convex;
+		cull_convex.result = &pass.casters;
 
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
-				}
+		p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(pass.planes.ptr(), pass.planes.size(), pass.points.ptr(), pass.points.size(), cull_convex);
 
-				//restore the regular DP matrix
-				//RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, 0, 0);
+		if (!light->is_shadow_update_full()) {
+			for (uint32_t j = 0; j < pass.casters.size(); j++) {
+				if (!light_culler->cull_regular_light(pass.casters[j]->transformed_aabb, p_light_cull_id)) {
+					pass.casters.remove_at_unordered(j);
+					j--;
+				}
 			}
+		}
 
-		} break;
-		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
+		if (_light_instance_finish_shadow_pass(p_instance, pass, max_shadows_used++, p_visible_layers)) {
+			animated_material_found = true;
+		}
+	}
 
-			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
-				return true;
-			}
+	return animated_material_found;
+}
 
-			real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
-			real_t angle = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
+bool RendererSceneCull::_light_instance_queue_shadow_update(Instance *p_instance, int32_t p_light_cull_id) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
-			Projection cm;
-			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
+	uint32_t first_pass = shadow_passes.size();
+	uint32_t pass_count = _light_instance_setup_shadow_passes(p_instance, shadow_lights.size());
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+	if (pass_count == 0 || max_shadows_used + pass_count > MAX_UPDATE_SHADOWS) {
+		shadow_passes.resize(first_pass);
+		return pass_count != 0;
+	}
 
-			instance_shadow_cull_result.clear();
+	ShadowLight shadow_light;
+	shadow_light.instance = p_instance;
+	shadow_light.light_cull_id = light->is_shadow_update_full() ? -1 : p_light_cull_id;
+	shadow_light.first_shadow = max_shadows_used;
+	shadow_light.first_pass = first_pass;
+	shadow_light.pass_count = pass_count;
+	shadow_light.bounds = shadow_passes[first_pass].bounds;
+	for (uint32_t i = first_pass + 1; i < shadow_passes.size(); i++) {
+		shadow_light.bounds.merge_with(shadow_passes[i].bounds);
+	}
+	shadow_lights.push_back(shadow_light);
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+	// Reserve the shadow slots now, so the light budget is the same as when updating lights one by one.
+	max_shadows_used += pass_count;
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+	return false;
+}
+
+void RendererSceneCull::_shadow_pass_cull_threaded(uint32_t p_pass, ShadowLight *p_lights) {
+	ShadowPass &pass = shadow_passes[p_pass];
+	const ShadowLight &light = p_lights[pass.light];
+
+	for (Instance *instance : light.candidates) {
+		const AABB &aabb = instance->transformed_aabb;
+		if (!aabb.intersects(pass.bounds) || !aabb.intersects_convex_shape(pass.planes.ptr(), pass.planes.size(), pass.points.ptr(), pass.points.size())) {
+			continue;
+		}
+		if (light.light_cull_id >= 0 && !light_culler->cull_regular_light(aabb, light.light_cull_id)) {
+			continue;
+		}
+		pass.casters.push_back(instance);
+	}
+}
+
+void RendererSceneCull::_update_queued_shadows(Scenario *p_scenario, uint32_t p_visible_layers) {
+	if (shadow_lights.is_empty()) {
+		return;
+	}
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+	RENDER_TIMESTAMP("Cull Positional Shadows");
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	// Hash the lights into a uniform grid sized after the average light, so one query
+	// of the geometry BVH can hand every light its candidate casters.
+	AABB query_bounds = shadow_lights[0].bounds;
+	real_t cell_size = 0.0;
+	for (const ShadowLight &light : shadow_lights) {
+		query_bounds.merge_with(light.bounds);
+		cell_size += light.bounds.get_longest_axis_size();
+	}
+	cell_size = MAX(cell_size / shadow_lights.size(), (real_t)0.001);
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+	struct CellRange {
+		Vector3i from;
+		Vector3i to;
+		_FORCE_INLINE_ int64_t get_cell_count() const {
+			return int64_t(to.x - from.x + 1) * int64_t(to.y - from.y + 1) * int64_t(to.z - from.z + 1);
+		}
+	};
 
-			if (!light->is_shadow_update_full()) {
-				light_culler->cull_regular_light(instance_shadow_cull_result);
+	auto cell_range = [cell_size](const AABB &p_aabb) {
+		CellRange range;
+		Vector3 from = p_aabb.position / cell_size;
+		Vector3 to = (p_aabb.position + p_aabb.size) / cell_size;
+		range.from = Vector3i(Math::floor(from.x), Math::floor(from.y), Math::floor(from.z));
+		range.to = Vector3i(Math::floor(to.x), Math::floor(to.y), Math::floor(to.z));
+		return range;
+	};
+
+	shadow_light_hash.clear();
+	LocalVector<uint32_t> oversized_lights;
+
+	for (uint32_t i = 0; i < shadow_lights.size(); i++) {
+		CellRange range = cell_range(shadow_lights[i].bounds);
+		if (range.get_cell_count() > SHADOW_LIGHT_HASH_MAX_CELLS) {
+			oversized_lights.push_back(i);
+			continue;
+		}
+		for (int x = range.from.x; x <= range.to.x; x++) {
+			for (int y = range.from.y; y <= range.to.y; y++) {
+				for (int z = range.from.z; z <= range.to.z; z++) {
+					shadow_light_hash[Vector3i(x, y, z)].push_back(i);
+				}
 			}
+		}
+	}
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+	struct CullAABB {
+		PagedArray<Instance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			result->push_back(p_instance);
+			return false;
+		}
+	};
 
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
+	instance_shadow_cull_result.clear();
+	CullAABB cull_aabb;
+	cull_aabb.result = &instance_shadow_cull_result;
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].aabb_query(query_bounds, cull_aabb);
+
+	// An instance can share several cells with a light, only add it once.
+	LocalVector<uint32_t> light_stamps;
+	light_stamps.resize(shadow_lights.size());
+	for (uint32_t &stamp : light_stamps) {
+		stamp = 0;
+	}
+
+	for (uint32_t i = 0; i < instance_shadow_cull_result.size(); i++) {
+		Instance *instance = instance_shadow_cull_result[i];
+		const AABB &aabb = instance->transformed_aabb;
+		const uint32_t stamp = i + 1;
+
+		CellRange range = cell_range(aabb);
+		if (range.get_cell_count() > SHADOW_LIGHT_HASH_MAX_CELLS) {
+			for (ShadowLight &light : shadow_lights) {
+				if (aabb.intersects(light.bounds)) {
+					light.candidates.push_back(instance);
+				}
+			}
+			continue;
+		}
+
+		for (int x = range.from.x; x <= range.to.x; x++) {
+			for (int y = range.from.y; y <= range.to.y; y++) {
+				for (int z = range.from.z; z <= range.to.z; z++) {
+					const LocalVector<uint32_t> *cell = shadow_light_hash.getptr(Vector3i(x, y, z));
+					if (!cell) {
+						continue;
+					}
+					for (uint32_t light_index : *cell) {
+						if (light_stamps[light_index] == stamp) {
+							continue;
+						}
+						light_stamps[light_index] = stamp;
+						if (aabb.intersects(shadow_lights[light_index].bounds)) {
+							shadow_lights[light_index].candidates.push_back(instance);
+						}
 					}
 				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
 			}
+		}
 
-			RSG::mesh_storage->update_mesh_instances();
+		for (uint32_t light_index : oversized_lights) {
+			if (aabb.intersects(shadow_lights[light_index].bounds)) {
+				shadow_lights[light_index].candidates.push_back(instance);
+			}
+		}
+	}
 
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+	// Every pass only reads its light's candidates and writes its own caster list.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_shadow_pass_cull_threaded, shadow_lights.ptr(), shadow_passes.size(), -1, true, SNAME("CullShadowPasses"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-		} break;
+	// Storage is not thread safe, so the shadow data is filled in light order afterwards.
+	for (const ShadowLight &light : shadow_lights) {
+		bool animated_material_found = false;
+		for (uint32_t i = 0; i < light.pass_count; i++) {
+			if (_light_instance_finish_shadow_pass(light.instance, shadow_passes[light.first_pass + i], light.first_shadow + i, p_visible_layers)) {
+				animated_material_found = true;
+			}
+		}
+		if (animated_material_found) {
+			static_cast<InstanceLightData *>(light.instance->base_data)->make_shadow_dirty();
+		}
 	}
 
-	return animated_material_found;
+	shadow_lights.clear();
+	shadow_passes.clear();
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2815,12 +2993,27 @@ void RendererSceneCull::_visibility_cull(const VisibilityCullData &cull_data, ui
 				idata.flags |= InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN;
 				idata.flags &= ~InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE;
 				idata.flags &= ~InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN;
+				idata.flags &= ~(InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OUTSIDE_FRUSTUM | InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OCCLUDED);
 				continue;
 			}
 		}
 
 		int range_check = _visibility_range_check<true>(vd, cull_data.camera_position, cull_data.viewport_mask);
 
+		// When the dependencies are shown (e.g. HLOD children closer than their proxy's range),
+		// test their combined bounds once, so that a whole off-screen or occluded cluster
+		// is rejected without testing each dependency on its own.
+		idata.flags &= ~(InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OUTSIDE_FRUSTUM | InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OCCLUDED);
+		if ((range_check == 1 || range_check == 2) && !vd.instance->visibility_dependencies.is_empty()) {
+			Instance *instance = vd.instance;
+			InstanceBounds bounds(instance->visibility_dependencies_aabb);
+			if (!bounds.in_frustum(*cull_data.frustum)) {
+				idata.flags |= InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OUTSIDE_FRUSTUM;
+			} else if (cull_data.occlusion_buffer && cull_data.occlusion_buffer->is_occluded(bounds.bounds, cull_data.camera_position, cull_data.cam_inv_transform, *cull_data.camera_matrix, cull_data.camera_matrix->get_z_near(), instance->visibility_dependencies_occlusion_timeout)) {
+				idata.flags |= InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OCCLUDED;
+			}
+		}
+
 		if (range_check == -1) {
 			idata.flags |= InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN;
 			idata.flags &= ~InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE;
@@ -2899,6 +3092,26 @@ void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_d
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
 
+void RendererSceneCull::CullBatch::cull_frustum(const Frustum &p_frustum) {
+	// Same test as InstanceBounds::in_frustum(), one plane at a time for the whole batch.
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+		const real_t *x = bounds[signs[0]];
+		const real_t *y = bounds[signs[1]];
+		const real_t *z = bounds[signs[2]];
+		const real_t nx = plane.normal.x;
+		const real_t ny = plane.normal.y;
+		const real_t nz = plane.normal.z;
+		const real_t d = plane.d;
+
+		for (uint32_t j = 0; j < count; j++) {
+			const real_t distance = nx * x[j] + ny * y[j] + nz * z[j] - d;
+			visible[j] &= uint32_t(!(distance >= 0.0));
+		}
+	}
+}
+
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::light_storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
@@ -2911,7 +3124,35 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Layer and camera frustum checks are done ahead of time for batches of instances.
+	// When nothing else can make an instance visible, the ones failing them are skipped right away.
+	CullBatch batch;
+	uint64_t batch_from = p_from;
+	uint64_t batch_to = p_from;
+	const bool skip_batch_culled = cull_data.cull->shadow_count == 0 && cull_data.cull->sdfgi.region_count == 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (i == batch_to) {
+			batch_from = i;
+			batch_to = MIN(i + CullBatch::SIZE, p_to);
+			batch.count = 0;
+			for (uint64_t j = batch_from; j < batch_to; j++) {
+				batch.add(cull_data.scenario->instance_aabbs[j], cull_data.visible_layers & cull_data.scenario->instance_data[j].layer_mask);
+			}
+			batch.cull_frustum(cull_data.cull->frustum);
+		}
+
+		bool batch_visible = batch.visible[i - batch_from];
+		if (batch_visible && cull_data.scenario->instance_data[i].parent_array_index != -1) {
+			const InstanceData &cluster_data = cull_data.scenario->instance_data[cull_data.scenario->instance_data[i].parent_array_index];
+			if ((cluster_data.flags & InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OUTSIDE_FRUSTUM) || ((cluster_data.flags & InstanceData::FLAG_VISIBILITY_DEPENDENCIES_OCCLUDED) && !(cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING))) {
+				batch_visible = false;
+			}
+		}
+		if (!batch_visible && skip_batch_culled && !(cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			continue;
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2927,7 +3168,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((batch_visible && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2940,6 +3181,8 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 					if (cull_data.render_reflection_probe != idata.instance) {
 						//avoid entering The Matrix
 
+						cull_result.has_per_frame_work = true;
+
 						if ((idata.flags & InstanceData::FLAG_REFLECTION_PROBE_DIRTY) || RSG::light_storage->reflection_probe_instance_needs_redraw(RID::from_uint64(idata.instance_data_rid))) {
 							InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(idata.instance->base_data);
 							cull_data.cull->lock.lock();
@@ -2961,6 +3204,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 				} else if (base_type == RS::INSTANCE_VOXEL_GI) {
 					InstanceVoxelGIData *voxel_gi = static_cast<InstanceVoxelGIData *>(idata.instance->base_data);
+					cull_result.has_per_frame_work = true;
 					cull_data.cull->lock.lock();
 					if (!voxel_gi->update_element.in_list()) {
 						voxel_gi_update_list.add(&voxel_gi->update_element);
@@ -2974,6 +3218,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 					cull_result.fog_volumes.push_back(RID::from_uint64(idata.instance_data_rid));
 				} else if (base_type == RS::INSTANCE_VISIBLITY_NOTIFIER) {
 					InstanceVisibilityNotifierData *vnd = idata.visibility_notifier;
+					cull_result.has_per_frame_work = true;
 					if (!vnd->list_element.in_list()) {
 						visible_notifier_list_lock.lock();
 						visible_notifier_list.add(&vnd->list_element);
@@ -2986,11 +3231,13 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (idata.flags & InstanceData::FLAG_REDRAW_IF_VISIBLE) {
 						RenderingServerDefault::redraw_request();
+						cull_result.has_per_frame_work = true;
 					}
 
 					if (base_type == RS::INSTANCE_MESH) {
 						mesh_visible = true;
 					} else if (base_type == RS::INSTANCE_PARTICLES) {
+						cull_result.has_per_frame_work = true;
 						//particles visible? process them
 						if (RSG::particles_storage->particles_is_inactive(idata.base_rid)) {
 							//but if nothing is going on, don't do it.
@@ -3011,6 +3258,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 						if (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN) {
 							const int32_t &parent_idx = cull_data.scenario->instance_data[idata.parent_array_index].visibility_index;
 							fade = cull_data.scenario->instance_visibility[parent_idx].children_fade_alpha;
+							cull_result.has_per_frame_work = true;
 						}
 						idata.instance_geometry->set_parent_fade_alpha(fade);
 					}
@@ -3097,6 +3345,11 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 						idata.flags &= ~uint32_t(InstanceData::FLAG_GEOM_VOXEL_GI_DIRTY);
 					}
 
+					if (idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) {
+						// Captured probe lighting is blended in over several frames.
+						cull_result.has_per_frame_work = true;
+					}
+
 					if ((idata.flags & InstanceData::FLAG_LIGHTMAP_CAPTURE) && idata.instance->last_frame_pass != frame_number && !idata.instance->lightmap_target_sh.is_empty() && !idata.instance->lightmap_sh.is_empty()) {
 						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
 						Color *sh = idata.instance->lightmap_sh.ptrw();
@@ -3170,6 +3423,31 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	}
 }
 
+RendererSceneCull::CullCacheKey RendererSceneCull::_get_cull_cache_key(const RendererSceneRender::CameraData *p_camera_data, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas) const {
+	CullCacheKey key;
+	key.scenario = p_scenario;
+	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
+	if (scenario) {
+		key.scenario_version = scenario->cull_version;
+	}
+	key.cam_transform = p_camera_data->main_transform;
+	key.cam_projection = p_camera_data->main_projection;
+	key.visible_layers = p_visible_layers;
+	key.shadow_atlas = p_shadow_atlas;
+
+	for (uint32_t i = 0; i < cull.shadow_count; i++) {
+		key.shadow_lights.push_back(cull.shadows[i].light_instance);
+		for (uint32_t j = 0; j < cull.shadows[i].cascade_count; j++) {
+			const Frustum &frustum = cull.shadows[i].cascades[j].frustum;
+			for (uint32_t k = 0; k < frustum.plane_count; k++) {
+				key.shadow_planes.push_back(frustum.planes_ptr[k]);
+			}
+		}
+	}
+
+	return key;
+}
+
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows, RenderingMethod::RenderInfo *r_render_info) {
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
@@ -3190,6 +3468,11 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		scene_render->sdfgi_update(p_render_buffers, p_environment, camera_position); //update conditions for SDFGI (whether its used or not)
 	}
 
+	Vector<Plane> planes = p_camera_data->main_projection.get_projection_planes(p_camera_data->main_transform);
+	cull.frustum = Frustum(planes);
+
+	const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
+
 	RENDER_TIMESTAMP("Update Visibility Dependencies");
 
 	if (scenario->instance_visibility.get_bin_count() > 0) {
@@ -3197,10 +3480,26 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			scenario_add_viewport_visibility_mask(scenario->self, p_viewport);
 		}
 
+		// Only visibility parents (bins above 0) cull their dependencies as a cluster.
+		for (int i = 1; i < scenario->instance_visibility.get_bin_count(); i++) {
+			uint32_t from = scenario->instance_visibility.get_bin_start(i);
+			uint32_t to = from + scenario->instance_visibility.get_bin_size(i);
+			for (uint32_t j = from; j < to; j++) {
+				Instance *instance = scenario->instance_visibility[j].instance;
+				if (instance->visibility_dependencies_aabb_dirty) {
+					_update_visibility_dependencies_aabb(instance);
+				}
+			}
+		}
+
 		VisibilityCullData visibility_cull_data;
 		visibility_cull_data.scenario = scenario;
 		visibility_cull_data.viewport_mask = scenario->viewport_visibility_masks[p_viewport];
 		visibility_cull_data.camera_position = camera_position;
+		visibility_cull_data.frustum = &cull.frustum;
+		visibility_cull_data.occlusion_buffer = occlusion_buffer;
+		visibility_cull_data.cam_inv_transform = p_camera_data->main_transform.affine_inverse();
+		visibility_cull_data.camera_matrix = &p_camera_data->main_projection;
 
 		for (int i = scenario->instance_visibility.get_bin_count() - 1; i > 0; i--) { // We skip bin 0
 			visibility_cull_data.cull_offset = scenario->instance_visibility.get_bin_start(i);
@@ -3225,9 +3524,6 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 	/* STEP 2 - CULL */
 
-	Vector<Plane> planes = p_camera_data->main_projection.get_projection_planes(p_camera_data->main_transform);
-	cull.frustum = Frustum(planes);
-
 	Vector<RID> directional_lights;
 	// directional lights
 	{
@@ -3291,9 +3587,44 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 	scene_cull_result.clear();
 
+	// Nothing moved since this viewport was last culled, reuse the previous result.
+	// Not done for probes, SDFGI updates and occlusion culling, as those change from frame to frame.
+	CullCache *cull_cache = nullptr;
+	bool cull_cache_hit = false;
+	if (reuse_cull_results && p_viewport.is_valid() && !render_reflection_probe && cull.sdfgi.region_count == 0 && !occlusion_buffer) {
+		if (!cull_caches.has(p_viewport)) {
+			CullCache *new_cache = memnew(CullCache);
+			new_cache->result.init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
+			cull_caches.insert(p_viewport, new_cache);
+		}
+		cull_cache = cull_caches[p_viewport];
+
+		CullCacheKey key = _get_cull_cache_key(p_camera_data, p_visible_layers, p_scenario, p_shadow_atlas);
+		cull_cache_hit = cull_cache->valid && cull_cache->key == key;
+
+		if (!cull_cache_hit) {
+			cull_cache->valid = false;
+			cull_cache->key = key;
+		}
+	}
+
+	if (cull_cache_hit) {
+		scene_cull_result.copy_from(cull_cache->result);
+
+		if (p_shadow_atlas.is_valid()) {
+			for (uint64_t i = 0; i < scene_cull_result.lights.size(); i++) {
+				const Instance *ins = scene_cull_result.lights[i];
+				if (RSG::light_storage->light_has_shadow(ins->base)) {
+					InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+					RSG::light_storage->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
+				}
+			}
+		}
+	}
+
 	{
 		uint64_t cull_from = 0;
-		uint64_t cull_to = scenario->instance_data.size();
+		uint64_t cull_to = cull_cache_hit ? 0 : scenario->instance_data.size();
 
 		CullData cull_data;
 
@@ -3304,7 +3635,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.cam_transform = p_camera_data->main_transform;
 		cull_data.visible_layers = p_visible_layers;
 		cull_data.render_reflection_probe = render_reflection_probe;
-		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
+		cull_data.occlusion_buffer = occlusion_buffer;
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
 //#define DEBUG_CULL_TIME
@@ -3325,11 +3656,16 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				scene_cull_result.append_from(thread);
 			}
 
-		} else {
+		} else if (!cull_cache_hit) {
 			//single threaded
 			_scene_cull(cull_data, scene_cull_result, cull_from, cull_to);
 		}
 
+		if (cull_cache && !cull_cache_hit && !scene_cull_result.has_per_frame_work) {
+			cull_cache->result.copy_from(scene_cull_result);
+			cull_cache->valid = true;
+		}
+
 #ifdef DEBUG_CULL_TIME
 		static float time_avg = 0;
 		static uint32_t time_count = 0;
@@ -3370,6 +3706,11 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 
 		// Positional Shadows
+
+		// With many lights, the casters of all lights to redraw are gathered together after this loop,
+		// instead of querying the geometry BVH once per shadow pass.
+		const bool batch_shadow_updates = p_shadow_atlas.is_valid() && scene_cull_result.lights.size() >= SHADOW_LIGHT_BATCH_THRESHOLD;
+
 		for (uint32_t i = 0; i < (uint32_t)scene_cull_result.lights.size(); i++) {
 			Instance *ins = scene_cull_result.lights[i];
 
@@ -3457,12 +3798,16 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			// so that we can turn off tighter caster culling.
 			light->detect_light_intersects_multiple_cameras(Engine::get_singleton()->get_frames_drawn());
 
+			// Lights that are not prepared below keep all their casters.
+			int32_t light_cull_id = -1;
+
 			if (light->is_shadow_dirty()) {
 				// Dirty shadows have no need to be drawn if
 				// the light volume doesn't intersect the camera frustum.
 
 				// Returns false if the entire light can be culled.
-				bool allow_redraw = light_culler->prepare_regular_light(*ins);
+				bool allow_redraw = light_culler->prepare_regular_light(*ins, i);
+				light_cull_id = i;
 
 				// Directional lights aren't handled here, _light_instance_update_shadow is called from elsewhere.
 				// Checking for this in case this changes, as this is assumed.
@@ -3484,17 +3829,25 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
 				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
-				if (_light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers)) {
-					light->make_shadow_dirty();
+				if (batch_shadow_updates) {
+					if (_light_instance_queue_shadow_update(ins, light_cull_id)) {
+						light->make_shadow_dirty();
+					}
+				} else {
+					RENDER_TIMESTAMP("> Render Light3D " + itos(i));
+					if (_light_instance_update_shadow(ins, light_cull_id, scenario, p_visible_layers)) {
+						light->make_shadow_dirty();
+					}
+					RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 				}
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
 			} else {
 				if (redraw) {
 					light->make_shadow_dirty();
 				}
 			}
 		}
+
+		_update_queued_shadows(scenario, p_visible_layers);
 	}
 
 	//render SDFGI
@@ -4330,6 +4683,10 @@ bool RendererSceneCull::free(RID p_rid) {
 		_interpolation_data.notify_free_instance(p_rid, *instance);
 
 		instance_geometry_set_lightmap(p_rid, RID(), Rect2(), 0);
+		if (instance->visibility_parent) {
+			// Don't leave a dangling dependency in the parent's cluster.
+			instance_set_visibility_parent(p_rid, RID());
+		}
 		instance_set_scenario(p_rid, RID());
 		instance_set_base(p_rid, RID());
 		instance_geometry_set_material_override(p_rid, RID());
@@ -4514,9 +4871,10 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	reuse_cull_results = GLOBAL_GET("rendering/limits/spatial_indexer/reuse_unchanged_cull_results");
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	default_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4542,8 +4900,14 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	for (KeyValue<RID, CullCache *> &E : cull_caches) {
+		E.value->result.reset();
+		memdelete(E.value);
+	}
+	cull_caches.clear();
+
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
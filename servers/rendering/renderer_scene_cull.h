@@ -60,7 +60,11 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		// Below this many visible positional lights, shadow casters are gathered light by light.
+		SHADOW_LIGHT_BATCH_THRESHOLD = 8,
+		// Lights and instances spanning more spatial hash cells than this are tested against everything instead.
+		SHADOW_LIGHT_HASH_MAX_CELLS = 64,
 	};
 
 	uint64_t render_pass;
@@ -129,7 +133,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -254,6 +258,27 @@ public:
 		}
 	};
 
+	struct CullBatch {
+		// Bounds of consecutive instances laid out per component, so the
+		// plane tests below run over whole batches in vectorized loops.
+
+		static constexpr uint32_t SIZE = 64;
+
+		real_t bounds[6][SIZE]; // Same component order as InstanceBounds.
+		uint32_t visible[SIZE]; // Same width as the bounds, which helps vectorization.
+		uint32_t count = 0;
+
+		_ALWAYS_INLINE_ void add(const InstanceBounds &p_bounds, bool p_visible) {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i][count] = p_bounds.bounds[i];
+			}
+			visible[count] = p_visible;
+			count++;
+		}
+
+		void cull_frustum(const Frustum &p_frustum);
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -279,6 +304,9 @@ public:
 			FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN = (1 << 22),
 			FLAG_GEOM_PROJECTOR_SOFTSHADOW_DIRTY = (1 << 23),
 			FLAG_IGNORE_ALL_CULLING = (1 << 24),
+			// Set on visibility parents whose dependencies are shown, when all of them can be culled at once.
+			FLAG_VISIBILITY_DEPENDENCIES_OUTSIDE_FRUSTUM = (1 << 25),
+			FLAG_VISIBILITY_DEPENDENCIES_OCCLUDED = (1 << 26),
 		};
 
 		uint32_t flags = 0;
@@ -356,6 +384,9 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Increased by any change that can affect culling, which invalidates cached cull results.
+		uint64_t cull_version = 0;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -486,6 +517,10 @@ public:
 		Instance *visibility_parent = nullptr;
 		HashSet<Instance *> visibility_dependencies;
 		uint32_t visibility_dependencies_depth = 0;
+		// Bounds of all dependencies, so they can be culled as a cluster (e.g. HLOD children of a proxy mesh).
+		AABB visibility_dependencies_aabb;
+		bool visibility_dependencies_aabb_dirty = false;
+		uint64_t visibility_dependencies_occlusion_timeout = 0;
 		float transparency = 0.0f;
 		Scenario *scenario = nullptr;
 		SelfList<Instance> scenario_item;
@@ -654,6 +689,12 @@ public:
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
+	static _FORCE_INLINE_ void _instance_cull_changed(Instance *p_instance) {
+		if (p_instance->scenario) {
+			p_instance->scenario->cull_version++;
+		}
+	}
+
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
 		HashSet<Instance *> lights;
@@ -931,7 +972,19 @@ public:
 		PagedArray<RenderGeometryInstance *> sdfgi_region_geometry_instances[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 		PagedArray<RID> sdfgi_cascade_lights[SDFGI_MAX_CASCADES];
 
+		// Set when culling did work that must be repeated every frame (particles, notifiers, probe updates...),
+		// so this result can't be reused for later frames.
+		bool has_per_frame_work = false;
+
+		template <typename T>
+		static void _copy_array(PagedArray<T> &r_to, const PagedArray<T> &p_from) {
+			for (uint64_t i = 0; i < p_from.size(); i++) {
+				r_to.push_back(p_from[i]);
+			}
+		}
+
 		void clear() {
+			has_per_frame_work = false;
 			geometry_instances.clear();
 			lights.clear();
 			light_instances.clear();
@@ -957,6 +1010,7 @@ public:
 		}
 
 		void reset() {
+			has_per_frame_work = false;
 			geometry_instances.reset();
 			lights.reset();
 			light_instances.reset();
@@ -981,7 +1035,36 @@ public:
 			}
 		}
 
+		void copy_from(const InstanceCullResult &p_cull_result) {
+			clear();
+			has_per_frame_work = p_cull_result.has_per_frame_work;
+			_copy_array(geometry_instances, p_cull_result.geometry_instances);
+			_copy_array(lights, p_cull_result.lights);
+			_copy_array(light_instances, p_cull_result.light_instances);
+			_copy_array(lightmaps, p_cull_result.lightmaps);
+			_copy_array(reflections, p_cull_result.reflections);
+			_copy_array(decals, p_cull_result.decals);
+			_copy_array(voxel_gi_instances, p_cull_result.voxel_gi_instances);
+			_copy_array(mesh_instances, p_cull_result.mesh_instances);
+			_copy_array(fog_volumes, p_cull_result.fog_volumes);
+
+			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
+				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
+					_copy_array(directional_shadows[i].cascade_geometry_instances[j], p_cull_result.directional_shadows[i].cascade_geometry_instances[j]);
+				}
+			}
+
+			for (int i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
+				_copy_array(sdfgi_region_geometry_instances[i], p_cull_result.sdfgi_region_geometry_instances[i]);
+			}
+
+			for (int i = 0; i < SDFGI_MAX_CASCADES; i++) {
+				_copy_array(sdfgi_cascade_lights[i], p_cull_result.sdfgi_cascade_lights[i]);
+			}
+		}
+
 		void append_from(InstanceCullResult &p_cull_result) {
+			has_per_frame_work = has_per_frame_work || p_cull_result.has_per_frame_work;
 			geometry_instances.merge_unordered(p_cull_result.geometry_instances);
 			lights.merge_unordered(p_cull_result.lights);
 			light_instances.merge_unordered(p_cull_result.light_instances);
@@ -1036,6 +1119,36 @@ public:
 	InstanceCullResult scene_cull_result;
 	LocalVector<InstanceCullResult> scene_cull_result_threads;
 
+	// Cull results of a viewport, reused as long as neither its camera, its
+	// directional shadow cascades nor anything in its scenario changed.
+	struct CullCacheKey {
+		RID scenario;
+		uint64_t scenario_version = 0;
+		Transform3D cam_transform;
+		Projection cam_projection;
+		uint32_t visible_layers = 0;
+		RID shadow_atlas;
+		Vector<RID> shadow_lights;
+		Vector<Plane> shadow_planes;
+
+		bool operator==(const CullCacheKey &p_key) const {
+			return scenario == p_key.scenario && scenario_version == p_key.scenario_version && visible_layers == p_key.visible_layers && shadow_atlas == p_key.shadow_atlas && cam_transform == p_key.cam_transform && cam_projection == p_key.cam_projection && shadow_lights == p_key.shadow_lights && shadow_planes == p_key.shadow_planes;
+		}
+		bool operator!=(const CullCacheKey &p_key) const { return !(*this == p_key); }
+	};
+
+	struct CullCache {
+		CullCacheKey key;
+		InstanceCullResult result;
+		bool valid = false;
+	};
+
+	// Uses the directional shadow cascades currently set up in `cull`.
+	CullCacheKey _get_cull_cache_key(const RendererSceneRender::CameraData *p_camera_data, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas) const;
+
+	bool reuse_cull_results = false;
+	HashMap<RID, CullCache *> cull_caches;
+
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
@@ -1110,7 +1223,38 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	struct ShadowPass {
+		Vector<Plane> planes;
+		Vector<Vector3> points;
+		AABB bounds;
+		Projection projection;
+		Transform3D transform;
+		real_t range = 0.0;
+		int pass = 0;
+		uint32_t light = 0;
+		LocalVector<Instance *> casters;
+	};
+
+	struct ShadowLight {
+		Instance *instance = nullptr;
+		int32_t light_cull_id = -1;
+		uint32_t first_shadow = 0;
+		uint32_t first_pass = 0;
+		uint32_t pass_count = 0;
+		AABB bounds;
+		LocalVector<Instance *> candidates;
+	};
+
+	LocalVector<ShadowPass> shadow_passes;
+	LocalVector<ShadowLight> shadow_lights;
+	HashMap<Vector3i, LocalVector<uint32_t>> shadow_light_hash;
+
+	uint32_t _light_instance_setup_shadow_passes(Instance *p_instance, uint32_t p_light);
+	bool _light_instance_finish_shadow_pass(Instance *p_instance, const ShadowPass &p_pass, uint32_t p_shadow_index, uint32_t p_visible_layers);
+	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, int32_t p_light_cull_id, Scenario *p_scenario, uint32_t p_visible_layers = 0xFFFFFF);
+	bool _light_instance_queue_shadow_update(Instance *p_instance, int32_t p_light_cull_id);
+	void _shadow_pass_cull_threaded(uint32_t p_pass, ShadowLight *p_lights);
+	void _update_queued_shadows(Scenario *p_scenario, uint32_t p_visible_layers);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 	RID _render_get_compositor(RID p_camera, RID p_scenario);
@@ -1159,8 +1303,14 @@ public:
 		Vector3 camera_position;
 		uint32_t cull_offset;
 		uint32_t cull_count;
+		const Frustum *frustum = nullptr;
+		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer = nullptr;
+		Transform3D cam_inv_transform;
+		const Projection *camera_matrix = nullptr;
 	};
 
+	void _update_visibility_dependencies_aabb(Instance *p_instance);
+
 	void _visibility_cull_threaded(uint32_t p_thread, VisibilityCullData *cull_data);
 	void _visibility_cull(const VisibilityCullData &cull_data, uint64_t p_from, uint64_t p_to);
 	template <bool p_fade_check>
@@ -79,10 +79,20 @@ void RenderingLightCuller::prepare_directional_light(const RendererSceneCull::In
 		data.directional_cull_planes.resize(p_directional_light_id + 1);
 	}
 
-	_prepare_light(*p_instance, p_directional_light_id);
+	_prepare_light(*p_instance, data.directional_cull_planes[p_directional_light_id]);
 }
 
-bool RenderingLightCuller::_prepare_light(const RendererSceneCull::Instance &p_instance, int32_t p_directional_light_id) {
+bool RenderingLightCuller::prepare_regular_light(const RendererSceneCull::Instance &p_instance, int32_t p_regular_light_id) {
+	ERR_FAIL_COND_V(p_regular_light_id < 0, true);
+
+	if (p_regular_light_id >= (int32_t)data.regular_cull_planes.size()) {
+		data.regular_cull_planes.resize(p_regular_light_id + 1);
+	}
+
+	return _prepare_light(p_instance, data.regular_cull_planes[p_regular_light_id]);
+}
+
+bool RenderingLightCuller::_prepare_light(const RendererSceneCull::Instance &p_instance, LightCullPlanes &r_cull_planes) {
 	if (!data.is_active()) {
 		return true;
 	}
@@ -109,12 +119,7 @@ bool RenderingLightCuller::_prepare_light(const RendererSceneCull::Instance &p_i
 	lsource.dir = -p_instance.transform.basis.get_column(2);
 	lsource.dir.normalize();
 
-	bool visible;
-	if (p_directional_light_id == -1) {
-		visible = _add_light_camera_planes(data.regular_cull_planes, lsource);
-	} else {
-		visible = _add_light_camera_planes(data.directional_cull_planes[p_directional_light_id], lsource);
-	}
+	bool visible = _add_light_camera_planes(r_cull_planes, lsource);
 
 	if (data.light_culling_active) {
 		return visible;
@@ -150,75 +155,44 @@ bool RenderingLightCuller::cull_directional_light(const RendererSceneCull::Insta
 	return true;
 }
 
-void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result) {
+bool RenderingLightCuller::cull_regular_light(const AABB &p_aabb, int32_t p_regular_light_id) {
 	if (!data.is_active() || !is_caster_culling_active()) {
-		return;
+		return true;
 	}
 
-	// If the light is out of range, no need to check anything, just return 0 casters.
-	// Ideally an out of range light should not even be drawn AT ALL (no shadow map, no PCF etc).
-	if (data.out_of_range) {
-		return;
+	// Lights that were not prepared this frame have no planes, and keep all their casters.
+	if (p_regular_light_id < 0 || p_regular_light_id >= (int32_t)data.regular_cull_planes.size()) {
+		return true;
 	}
 
-	// Shorter local alias.
-	PagedArray<RendererSceneCull::Instance *> &list = r_instance_shadow_cull_result;
+	const LightCullPlanes &cull_planes = data.regular_cull_planes[p_regular_light_id];
 
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-	uint32_t count_before = r_instance_shadow_cull_result.size();
-#endif
+	// If the light is out of range, no need to check anything.
+	// Ideally an out of range light should not even be drawn AT ALL (no shadow map, no PCF etc).
+	if (cull_planes.out_of_range) {
+		return true;
+	}
 
-	// Go through all the casters in the list (the list will hopefully shrink as we go).
-	for (int n = 0; n < (int)list.size(); n++) {
-		// World space aabb.
-		const AABB &bb = list[n]->transformed_aabb;
+	real_t r_min, r_max;
+	for (int p = 0; p < cull_planes.num_cull_planes; p++) {
+		// As we only need r_min, could this be optimized?
+		p_aabb.project_range_in_plane(cull_planes.cull_planes[p], r_min, r_max);
 
 #ifdef LIGHT_CULLER_DEBUG_LOGGING
 		if (is_logging()) {
-			print_line("bb : " + String(bb));
+			print_line("bb : " + String(p_aabb) + "\tplane " + itos(p) + " : " + String(cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
 		}
 #endif
 
-		real_t r_min, r_max;
-		bool show = true;
-
-		for (int p = 0; p < data.regular_cull_planes.num_cull_planes; p++) {
-			// As we only need r_min, could this be optimized?
-			bb.project_range_in_plane(data.regular_cull_planes.cull_planes[p], r_min, r_max);
-
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-			if (is_logging()) {
-				print_line("\tplane " + itos(p) + " : " + String(data.regular_cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
-			}
-#endif
-
-			if (r_min > 0.0f) {
-				show = false;
-				break;
-			}
-		}
-
-		// Remove.
-		if (!show) {
-			list.remove_at_unordered(n);
-
-			// Repeat this element next iteration of the loop as it has been removed and replaced by the last.
-			n--;
-
+		if (r_min > 0.0f) {
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
 			data.regular_rejected_count++;
 #endif
+			return false;
 		}
 	}
 
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-	uint32_t removed = r_instance_shadow_cull_result.size() - count_before;
-	if (removed) {
-		if (((data.debug_count) % 60) == 0) {
-			print_line("[" + itos(data.debug_count) + "] linear cull before " + itos(count_before) + " after " + itos(r_instance_shadow_cull_result.size()));
-		}
-	}
-#endif
+	return true;
 }
 
 void RenderingLightCuller::LightCullPlanes::add_cull_plane(const Plane &p) {
@@ -335,7 +309,7 @@ bool RenderingLightCuller::_add_light_camera_planes(LightCullPlanes &r_cull_plan
 
 	// Start with 0 cull planes.
 	r_cull_planes.num_cull_planes = 0;
-	data.out_of_range = false;
+	r_cull_planes.out_of_range = false;
 	uint32_t lookup = 0;
 
 	// Find which of the camera planes are facing away from the light.
@@ -364,7 +338,7 @@ bool RenderingLightCuller::_add_light_camera_planes(LightCullPlanes &r_cull_plan
 				// be seen.
 				if (dist >= p_light_source.range) {
 					// If the light is out of range, no need to do anything else, everything will be culled.
-					data.out_of_range = true;
+					r_cull_planes.out_of_range = true;
 					return false;
 				}
 			}
@@ -393,7 +367,7 @@ bool RenderingLightCuller::_add_light_camera_planes(LightCullPlanes &r_cull_plan
 
 				// Is the light out of range?
 				if (dist >= p_light_source.range) {
-					data.out_of_range = true;
+					r_cull_planes.out_of_range = true;
 					return false;
 				}
 
@@ -405,7 +379,7 @@ bool RenderingLightCuller::_add_light_camera_planes(LightCullPlanes &r_cull_plan
 				float dist_end = data.frustum_planes[n].distance_to(pos_end);
 
 				if (dist_end >= end_cone_radius) {
-					data.out_of_range = true;
+					r_cull_planes.out_of_range = true;
 					return false;
 				}
 			}
@@ -498,7 +472,7 @@ bool RenderingLightCuller::prepare_camera(const Transform3D &p_cam_transform, co
 	data.frustum_planes = p_cam_matrix.get_projection_planes(p_cam_transform);
 	DEV_CHECK_ONCE(data.frustum_planes.size() == 6);
 
-	data.regular_cull_planes.num_cull_planes = 0;
+	data.regular_cull_planes.resize(0);
 
 #ifdef LIGHT_CULLER_DEBUG_DIRECTIONAL_LIGHT
 	if (is_logging()) {
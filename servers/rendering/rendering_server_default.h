@@ -239,6 +239,9 @@ public:
 
 	FUNC1RC(ShaderNativeSourceCode, shader_get_native_source_code, RID)
 
+	FUNC0(shader_compile_batch_begin)
+	FUNC0(shader_compile_batch_end)
+
 	/* COMMON MATERIAL API */
 
 	FUNCRIDSPLIT(material)
@@ -31,7 +31,12 @@
 #include "shader_compiler.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -446,7 +451,7 @@ static String _get_global_shader_uniform_from_type_and_index(const String &p_buf
 	}
 }
 
-String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
+String ShaderCompiler::_dump_node_code(CompileState &r_state, const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
 	String code;
 
 	switch (p_node->type) {
@@ -454,9 +459,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			SL::ShaderNode *pnode = (SL::ShaderNode *)p_node;
 
 			for (int i = 0; i < pnode->render_modes.size(); i++) {
-				if (p_default_actions.render_mode_defines.has(pnode->render_modes[i]) && !used_rmode_defines.has(pnode->render_modes[i])) {
+				if (p_default_actions.render_mode_defines.has(pnode->render_modes[i]) && !r_state.used_rmode_defines.has(pnode->render_modes[i])) {
 					r_gen_code.defines.push_back(p_default_actions.render_mode_defines[pnode->render_modes[i]]);
-					used_rmode_defines.insert(pnode->render_modes[i]);
+					r_state.used_rmode_defines.insert(pnode->render_modes[i]);
 				}
 
 				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
@@ -674,7 +679,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 				if (varying.stage == SL::ShaderNode::Varying::STAGE_FRAGMENT_TO_LIGHT || varying.stage == SL::ShaderNode::Varying::STAGE_FRAGMENT) {
 					var_frag_to_light.push_back(Pair<StringName, SL::ShaderNode::Varying>(varying_name, varying));
-					fragment_varyings.insert(varying_name);
+					r_state.fragment_varyings.insert(varying_name);
 					continue;
 				}
 				if (varying.type < SL::TYPE_INT) {
@@ -754,7 +759,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					gcode += "]";
 				}
 				gcode += "=";
-				gcode += _dump_node_code(cnode.initializer, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				gcode += _dump_node_code(r_state, cnode.initializer, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				gcode += ";\n";
 				for (int j = 0; j < STAGE_MAX; j++) {
 					r_gen_code.stage_globals[j] += gcode;
@@ -766,10 +771,10 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			//code for functions
 			for (int i = 0; i < pnode->vfunctions.size(); i++) {
 				SL::FunctionNode *fnode = pnode->vfunctions[i].function;
-				function = fnode;
-				current_func_name = fnode->name;
-				function_code[fnode->name] = _dump_node_code(fnode->body, p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
-				function = nullptr;
+				r_state.function = fnode;
+				r_state.current_func_name = fnode->name;
+				function_code[fnode->name] = _dump_node_code(r_state, fnode->body, p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				r_state.function = nullptr;
 			}
 
 			//place functions in actual code
@@ -779,9 +784,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			for (int i = 0; i < pnode->vfunctions.size(); i++) {
 				SL::FunctionNode *fnode = pnode->vfunctions[i].function;
 
-				function = fnode;
+				r_state.function = fnode;
 
-				current_func_name = fnode->name;
+				r_state.current_func_name = fnode->name;
 
 				if (p_actions.entry_point_stages.has(fnode->name)) {
 					Stage stage = p_actions.entry_point_stages[fnode->name];
@@ -789,7 +794,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					r_gen_code.code[fnode->name] = function_code[fnode->name];
 				}
 
-				function = nullptr;
+				r_state.function = nullptr;
 			}
 
 			//code+=dump_node_code(pnode->body,p_level);
@@ -808,7 +813,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			int i = 0;
 			for (List<ShaderLanguage::Node *>::ConstIterator itr = bnode->statements.begin(); itr != bnode->statements.end(); ++itr, ++i) {
-				String scode = _dump_node_code(*itr, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String scode = _dump_node_code(r_state, *itr, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 
 				if ((*itr)->type == SL::Node::NODE_TYPE_CONTROL_FLOW || bnode->single_statement) {
 					code += scode; //use directly
@@ -844,7 +849,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				if (is_array) {
 					declaration += "[";
 					if (vdnode->declarations[i].size_expression != nullptr) {
-						declaration += _dump_node_code(vdnode->declarations[i].size_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						declaration += _dump_node_code(r_state, vdnode->declarations[i].size_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					} else {
 						declaration += itos(vdnode->declarations[i].size);
 					}
@@ -854,7 +859,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				if (!is_array || vdnode->declarations[i].single_expression) {
 					if (!vdnode->declarations[i].initializer.is_empty()) {
 						declaration += "=";
-						declaration += _dump_node_code(vdnode->declarations[i].initializer[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						declaration += _dump_node_code(r_state, vdnode->declarations[i].initializer[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					}
 				} else {
 					int size = vdnode->declarations[i].initializer.size();
@@ -873,7 +878,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							if (j > 0) {
 								declaration += ",";
 							}
-							declaration += _dump_node_code(vdnode->declarations[i].initializer[j], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+							declaration += _dump_node_code(r_state, vdnode->declarations[i].initializer[j], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 						}
 						declaration += ")";
 					}
@@ -886,13 +891,13 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			SL::VariableNode *vnode = (SL::VariableNode *)p_node;
 			bool use_fragment_varying = false;
 
-			if (!vnode->is_local && !(p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX)) {
+			if (!vnode->is_local && !(p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_VERTEX)) {
 				if (p_assigning) {
-					if (shader->varyings.has(vnode->name)) {
+					if (r_state.shader->varyings.has(vnode->name)) {
 						use_fragment_varying = true;
 					}
 				} else {
-					if (fragment_varyings.has(vnode->name)) {
+					if (r_state.fragment_varyings.has(vnode->name)) {
 						use_fragment_varying = true;
 					}
 				}
@@ -902,26 +907,26 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				*p_actions.write_flag_pointers[vnode->name] = true;
 			}
 
-			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
+			if (p_default_actions.usage_defines.has(vnode->name) && !r_state.used_name_defines.has(vnode->name)) {
 				String define = p_default_actions.usage_defines[vnode->name];
 				if (define.begins_with("@")) {
 					define = p_default_actions.usage_defines[define.substr(1, define.length())];
 				}
 				r_gen_code.defines.push_back(define);
-				used_name_defines.insert(vnode->name);
+				r_state.used_name_defines.insert(vnode->name);
 			}
 
-			if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
+			if (p_actions.usage_flag_pointers.has(vnode->name) && !r_state.used_flag_pointers.has(vnode->name)) {
 				*p_actions.usage_flag_pointers[vnode->name] = true;
-				used_flag_pointers.insert(vnode->name);
+				r_state.used_flag_pointers.insert(vnode->name);
 			}
 
 			if (p_default_actions.renames.has(vnode->name)) {
 				code = p_default_actions.renames[vnode->name];
 			} else {
-				if (shader->uniforms.has(vnode->name)) {
+				if (r_state.shader->uniforms.has(vnode->name)) {
 					//its a uniform!
-					const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[vnode->name];
+					const ShaderLanguage::ShaderNode::Uniform &u = r_state.shader->uniforms[vnode->name];
 					if (u.is_texture()) {
 						StringName name;
 						if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
@@ -966,10 +971,10 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			}
 
 			if (vnode->name == time_name) {
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
+				if (p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_FRAGMENT) {
+				if (p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_FRAGMENT) {
 					r_gen_code.uses_fragment_time = true;
 				}
 			}
@@ -988,7 +993,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			code += "]";
 			code += "(";
 			for (int i = 0; i < sz; i++) {
-				code += _dump_node_code(acnode->initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(r_state, acnode->initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				if (i != sz - 1) {
 					code += ", ";
 				}
@@ -999,16 +1004,16 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 			SL::ArrayNode *anode = (SL::ArrayNode *)p_node;
 			bool use_fragment_varying = false;
 
-			if (!anode->is_local && !(p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX)) {
-				if (anode->assign_expression != nullptr && shader->varyings.has(anode->name)) {
+			if (!anode->is_local && !(p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_VERTEX)) {
+				if (anode->assign_expression != nullptr && r_state.shader->varyings.has(anode->name)) {
 					use_fragment_varying = true;
 				} else {
 					if (p_assigning) {
-						if (shader->varyings.has(anode->name)) {
+						if (r_state.shader->varyings.has(anode->name)) {
 							use_fragment_varying = true;
 						}
 					} else {
-						if (fragment_varyings.has(anode->name)) {
+						if (r_state.fragment_varyings.has(anode->name)) {
 							use_fragment_varying = true;
 						}
 					}
@@ -1019,26 +1024,26 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				*p_actions.write_flag_pointers[anode->name] = true;
 			}
 
-			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
+			if (p_default_actions.usage_defines.has(anode->name) && !r_state.used_name_defines.has(anode->name)) {
 				String define = p_default_actions.usage_defines[anode->name];
 				if (define.begins_with("@")) {
 					define = p_default_actions.usage_defines[define.substr(1, define.length())];
 				}
 				r_gen_code.defines.push_back(define);
-				used_name_defines.insert(anode->name);
+				r_state.used_name_defines.insert(anode->name);
 			}
 
-			if (p_actions.usage_flag_pointers.has(anode->name) && !used_flag_pointers.has(anode->name)) {
+			if (p_actions.usage_flag_pointers.has(anode->name) && !r_state.used_flag_pointers.has(anode->name)) {
 				*p_actions.usage_flag_pointers[anode->name] = true;
-				used_flag_pointers.insert(anode->name);
+				r_state.used_flag_pointers.insert(anode->name);
 			}
 
 			if (p_default_actions.renames.has(anode->name)) {
 				code = p_default_actions.renames[anode->name];
 			} else {
-				if (shader->uniforms.has(anode->name)) {
+				if (r_state.shader->uniforms.has(anode->name)) {
 					//its a uniform!
-					const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[anode->name];
+					const ShaderLanguage::ShaderNode::Uniform &u = r_state.shader->uniforms[anode->name];
 					if (u.is_texture()) {
 						code = _mkid(anode->name); //texture, use as is
 					} else {
@@ -1066,21 +1071,21 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			if (anode->call_expression != nullptr) {
 				code += ".";
-				code += _dump_node_code(anode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
+				code += _dump_node_code(r_state, anode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
 			} else if (anode->index_expression != nullptr) {
 				code += "[";
-				code += _dump_node_code(anode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(r_state, anode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += "]";
 			} else if (anode->assign_expression != nullptr) {
 				code += "=";
-				code += _dump_node_code(anode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
+				code += _dump_node_code(r_state, anode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
 			}
 
 			if (anode->name == time_name) {
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
+				if (p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
-				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_FRAGMENT) {
+				if (p_actions.entry_point_stages.has(r_state.current_func_name) && p_actions.entry_point_stages[r_state.current_func_name] == STAGE_FRAGMENT) {
 					r_gen_code.uses_fragment_time = true;
 				}
 			}
@@ -1107,7 +1112,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else {
 						code += "";
 					}
-					code += _dump_node_code(cnode->array_declarations[0].initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, cnode->array_declarations[0].initializer[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				}
 				code += ")";
 			}
@@ -1128,18 +1133,18 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				case SL::OP_ASSIGN_BIT_AND:
 				case SL::OP_ASSIGN_BIT_OR:
 				case SL::OP_ASSIGN_BIT_XOR:
-					code = _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, true) + _opstr(onode->op) + _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code = _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, true) + _opstr(onode->op) + _dump_node_code(r_state, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					break;
 				case SL::OP_BIT_INVERT:
 				case SL::OP_NEGATE:
 				case SL::OP_NOT:
 				case SL::OP_DECREMENT:
 				case SL::OP_INCREMENT:
-					code = _opstr(onode->op) + _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code = _opstr(onode->op) + _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					break;
 				case SL::OP_POST_DECREMENT:
 				case SL::OP_POST_INCREMENT:
-					code = _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + _opstr(onode->op);
+					code = _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + _opstr(onode->op);
 					break;
 				case SL::OP_CALL:
 				case SL::OP_STRUCT:
@@ -1150,9 +1155,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					const bool is_internal_func = internal_functions.has(vnode->name);
 
 					if (!is_internal_func) {
-						for (int i = 0; i < shader->vfunctions.size(); i++) {
-							if (shader->vfunctions[i].name == vnode->name) {
-								func = shader->vfunctions[i].function;
+						for (int i = 0; i < r_state.shader->vfunctions.size(); i++) {
+							if (r_state.shader->vfunctions[i].name == vnode->name) {
+								func = r_state.shader->vfunctions[i].function;
 								break;
 							}
 						}
@@ -1168,9 +1173,9 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else if (onode->op == SL::OP_CONSTRUCT) {
 						code += String(vnode->name);
 					} else {
-						if (p_actions.usage_flag_pointers.has(vnode->name) && !used_flag_pointers.has(vnode->name)) {
+						if (p_actions.usage_flag_pointers.has(vnode->name) && !r_state.used_flag_pointers.has(vnode->name)) {
 							*p_actions.usage_flag_pointers[vnode->name] = true;
-							used_flag_pointers.insert(vnode->name);
+							r_state.used_flag_pointers.insert(vnode->name);
 						}
 
 						if (is_internal_func) {
@@ -1235,7 +1240,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							}
 						}
 
-						String node_code = _dump_node_code(onode->arguments[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+						String node_code = _dump_node_code(r_state, onode->arguments[i], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 						if (is_texture_func && i == 1) {
 							// If we're doing a texture lookup we need to check our texture argument
 							StringName texture_uniform;
@@ -1264,8 +1269,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								if (actions.custom_samplers.has(texture_uniform)) {
 									sampler_name = actions.custom_samplers[texture_uniform];
 								} else {
-									if (shader->uniforms.has(texture_uniform)) {
-										const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[texture_uniform];
+									if (r_state.shader->uniforms.has(texture_uniform)) {
+										const ShaderLanguage::ShaderNode::Uniform &u = r_state.shader->uniforms[texture_uniform];
 										if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 											is_screen_texture = true;
 										} else if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
@@ -1277,23 +1282,23 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 									} else {
 										bool found = false;
 
-										for (int j = 0; j < function->arguments.size(); j++) {
-											if (function->arguments[j].name == texture_uniform) {
-												if (function->arguments[j].tex_builtin_check) {
-													ERR_CONTINUE(!actions.custom_samplers.has(function->arguments[j].tex_builtin));
-													sampler_name = actions.custom_samplers[function->arguments[j].tex_builtin];
+										for (int j = 0; j < r_state.function->arguments.size(); j++) {
+											if (r_state.function->arguments[j].name == texture_uniform) {
+												if (r_state.function->arguments[j].tex_builtin_check) {
+													ERR_CONTINUE(!actions.custom_samplers.has(r_state.function->arguments[j].tex_builtin));
+													sampler_name = actions.custom_samplers[r_state.function->arguments[j].tex_builtin];
 													found = true;
 													break;
 												}
-												if (function->arguments[j].tex_argument_check) {
-													if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
+												if (r_state.function->arguments[j].tex_argument_check) {
+													if (r_state.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 														is_screen_texture = true;
-													} else if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
+													} else if (r_state.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
 														is_depth_texture = true;
-													} else if (function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_NORMAL_ROUGHNESS_TEXTURE) {
+													} else if (r_state.function->arguments[j].tex_hint == ShaderLanguage::ShaderNode::Uniform::HINT_NORMAL_ROUGHNESS_TEXTURE) {
 														is_normal_roughness_texture = true;
 													}
-													sampler_name = _get_sampler_name(function->arguments[j].tex_argument_filter, function->arguments[j].tex_argument_repeat);
+													sampler_name = _get_sampler_name(r_state.function->arguments[j].tex_argument_filter, r_state.function->arguments[j].tex_argument_repeat);
 													found = true;
 													break;
 												}
@@ -1319,8 +1324,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								// Texture function on low end hardware (i.e. OpenGL).
 								// We just need to know if the texture supports multiview.
 
-								if (shader->uniforms.has(texture_uniform)) {
-									const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[texture_uniform];
+								if (r_state.shader->uniforms.has(texture_uniform)) {
+									const ShaderLanguage::ShaderNode::Uniform &u = r_state.shader->uniforms[texture_uniform];
 									if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_SCREEN_TEXTURE) {
 										multiview_uv_needed = true;
 									} else if (u.hint == ShaderLanguage::ShaderNode::Uniform::HINT_DEPTH_TEXTURE) {
@@ -1352,19 +1357,19 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					}
 				} break;
 				case SL::OP_INDEX: {
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "[";
-					code += _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "]";
 
 				} break;
 				case SL::OP_SELECT_IF: {
 					code += "(";
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += "?";
-					code += _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += ":";
-					code += _dump_node_code(onode->arguments[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					code += ")";
 
 				} break;
@@ -1376,7 +1381,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					if (p_use_scope) {
 						code += "(";
 					}
-					code += _dump_node_code(onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + " " + _opstr(onode->op) + " " + _dump_node_code(onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, onode->arguments[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + " " + _opstr(onode->op) + " " + _dump_node_code(r_state, onode->arguments[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 					if (p_use_scope) {
 						code += ")";
 					}
@@ -1388,45 +1393,45 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 		case SL::Node::NODE_TYPE_CONTROL_FLOW: {
 			SL::ControlFlowNode *cfnode = (SL::ControlFlowNode *)p_node;
 			if (cfnode->flow_op == SL::FLOW_OP_IF) {
-				code += _mktab(p_level) + "if (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "if (" + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 				if (cfnode->blocks.size() == 2) {
 					code += _mktab(p_level) + "else\n";
-					code += _dump_node_code(cfnode->blocks[1], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+					code += _dump_node_code(r_state, cfnode->blocks[1], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 				}
 			} else if (cfnode->flow_op == SL::FLOW_OP_SWITCH) {
-				code += _mktab(p_level) + "switch (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "switch (" + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_CASE) {
-				code += _mktab(p_level) + "case " + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ":\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "case " + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ":\n";
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_DEFAULT) {
 				code += _mktab(p_level) + "default:\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_DO) {
 				code += _mktab(p_level) + "do";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
-				code += _mktab(p_level) + "while (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ");";
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "while (" + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ");";
 			} else if (cfnode->flow_op == SL::FLOW_OP_WHILE) {
-				code += _mktab(p_level) + "while (" + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
-				code += _dump_node_code(cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _mktab(p_level) + "while (" + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ")\n";
+				code += _dump_node_code(r_state, cfnode->blocks[0], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 			} else if (cfnode->flow_op == SL::FLOW_OP_FOR) {
-				String left = _dump_node_code(cfnode->blocks[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
-				String middle = _dump_node_code(cfnode->blocks[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
-				String right = _dump_node_code(cfnode->blocks[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String left = _dump_node_code(r_state, cfnode->blocks[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String middle = _dump_node_code(r_state, cfnode->blocks[1], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				String right = _dump_node_code(r_state, cfnode->blocks[2], p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += _mktab(p_level) + "for (" + left + ";" + middle + ";" + right + ")\n";
-				code += _dump_node_code(cfnode->blocks[3], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(r_state, cfnode->blocks[3], p_level + 1, r_gen_code, p_actions, p_default_actions, p_assigning);
 
 			} else if (cfnode->flow_op == SL::FLOW_OP_RETURN) {
 				if (cfnode->expressions.size()) {
-					code = "return " + _dump_node_code(cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ";";
+					code = "return " + _dump_node_code(r_state, cfnode->expressions[0], p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + ";";
 				} else {
 					code = "return;";
 				}
 			} else if (cfnode->flow_op == SL::FLOW_OP_DISCARD) {
-				if (p_actions.usage_flag_pointers.has("DISCARD") && !used_flag_pointers.has("DISCARD")) {
+				if (p_actions.usage_flag_pointers.has("DISCARD") && !r_state.used_flag_pointers.has("DISCARD")) {
 					*p_actions.usage_flag_pointers["DISCARD"] = true;
-					used_flag_pointers.insert("DISCARD");
+					r_state.used_flag_pointers.insert("DISCARD");
 				}
 
 				code = "discard;";
@@ -1439,17 +1444,17 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 		} break;
 		case SL::Node::NODE_TYPE_MEMBER: {
 			SL::MemberNode *mnode = (SL::MemberNode *)p_node;
-			code = _dump_node_code(mnode->owner, p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + "." + mnode->name;
+			code = _dump_node_code(r_state, mnode->owner, p_level, r_gen_code, p_actions, p_default_actions, p_assigning) + "." + mnode->name;
 			if (mnode->index_expression != nullptr) {
 				code += "[";
-				code += _dump_node_code(mnode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
+				code += _dump_node_code(r_state, mnode->index_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning);
 				code += "]";
 			} else if (mnode->assign_expression != nullptr) {
 				code += "=";
-				code += _dump_node_code(mnode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
+				code += _dump_node_code(r_state, mnode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
 			} else if (mnode->call_expression != nullptr) {
 				code += ".";
-				code += _dump_node_code(mnode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
+				code += _dump_node_code(r_state, mnode->call_expression, p_level, r_gen_code, p_actions, p_default_actions, p_assigning, false);
 			}
 		} break;
 	}
@@ -1462,13 +1467,332 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+static const char *compiler_cache_file_header = "GDSG";
+static const uint32_t compiler_cache_file_version = 1;
+
+String ShaderCompiler::cache_dir;
+
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const {
+	StringBuilder key;
+	key.append("[version]");
+	key.append(VERSION_FULL_BUILD);
+	key.append(VERSION_HASH);
+	key.append("[mode]");
+	key.append(itos(p_mode));
+	key.append("[default_actions]");
+	key.append(actions_hash);
+
+	key.append("[entry_points]");
+	for (const KeyValue<StringName, Stage> &E : p_actions->entry_point_stages) {
+		key.append(String(E.key) + ":" + itos(E.value) + ";");
+	}
+	key.append("[render_mode_values]");
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		key.append(String(E.key) + ":" + itos(E.value.second) + ";");
+	}
+	key.append("[render_mode_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->render_mode_flags) {
+		key.append(String(E.key) + ";");
+	}
+	key.append("[usage_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		key.append(String(E.key) + ";");
+	}
+	key.append("[write_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		key.append(String(E.key) + ";");
+	}
+
+	key.append("[code]");
+	key.append(p_code);
+
+	return key.as_string().sha256_text();
+}
+
+static void _store_uniform(Ref<FileAccess> p_file, const ShaderLanguage::ShaderNode::Uniform &p_uniform) {
+	p_file->store_32(p_uniform.order);
+	p_file->store_32(p_uniform.prop_order);
+	p_file->store_32(p_uniform.texture_order);
+	p_file->store_32(p_uniform.texture_binding);
+	p_file->store_32(p_uniform.type);
+	p_file->store_32(p_uniform.precision);
+	p_file->store_32(p_uniform.array_size);
+	p_file->store_32(p_uniform.default_value.size());
+	for (int i = 0; i < p_uniform.default_value.size(); i++) {
+		p_file->store_32(p_uniform.default_value[i].uint);
+	}
+	p_file->store_32(p_uniform.scope);
+	p_file->store_32(p_uniform.hint);
+	p_file->store_8(p_uniform.use_color);
+	p_file->store_32(p_uniform.filter);
+	p_file->store_32(p_uniform.repeat);
+	for (int i = 0; i < 3; i++) {
+		p_file->store_float(p_uniform.hint_range[i]);
+	}
+	p_file->store_32(p_uniform.hint_enum_names.size());
+	for (int i = 0; i < p_uniform.hint_enum_names.size(); i++) {
+		p_file->store_pascal_string(p_uniform.hint_enum_names[i]);
+	}
+	p_file->store_32(p_uniform.instance_index);
+	p_file->store_pascal_string(p_uniform.group);
+	p_file->store_pascal_string(p_uniform.subgroup);
+}
+
+static void _get_uniform(Ref<FileAccess> p_file, ShaderLanguage::ShaderNode::Uniform &r_uniform) {
+	r_uniform.order = (int32_t)p_file->get_32();
+	r_uniform.prop_order = (int32_t)p_file->get_32();
+	r_uniform.texture_order = (int32_t)p_file->get_32();
+	r_uniform.texture_binding = (int32_t)p_file->get_32();
+	r_uniform.type = ShaderLanguage::DataType(p_file->get_32());
+	r_uniform.precision = ShaderLanguage::DataPrecision(p_file->get_32());
+	r_uniform.array_size = (int32_t)p_file->get_32();
+	uint32_t value_count = p_file->get_32();
+	if (p_file->eof_reached()) {
+		return;
+	}
+	r_uniform.default_value.resize(value_count);
+	for (uint32_t i = 0; i < value_count; i++) {
+		r_uniform.default_value.write[i].uint = p_file->get_32();
+	}
+	r_uniform.scope = ShaderLanguage::ShaderNode::Uniform::Scope(p_file->get_32());
+	r_uniform.hint = ShaderLanguage::ShaderNode::Uniform::Hint(p_file->get_32());
+	r_uniform.use_color = p_file->get_8();
+	r_uniform.filter = ShaderLanguage::TextureFilter(p_file->get_32());
+	r_uniform.repeat = ShaderLanguage::TextureRepeat(p_file->get_32());
+	for (int i = 0; i < 3; i++) {
+		r_uniform.hint_range[i] = p_file->get_float();
+	}
+	uint32_t enum_name_count = p_file->get_32();
+	for (uint32_t i = 0; i < enum_name_count && !p_file->eof_reached(); i++) {
+		r_uniform.hint_enum_names.push_back(p_file->get_pascal_string());
+	}
+	r_uniform.instance_index = (int32_t)p_file->get_32();
+	r_uniform.group = p_file->get_pascal_string();
+	r_uniform.subgroup = p_file->get_pascal_string();
+}
+
+static void _store_string_names(Ref<FileAccess> p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (int i = 0; i < p_names.size(); i++) {
+		p_file->store_pascal_string(p_names[i]);
+	}
+}
+
+static Vector<StringName> _get_string_names(Ref<FileAccess> p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	Ref<FileAccess> f = FileAccess::open(cache_dir.path_join(p_key) + ".cache", FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	if (String(header) != compiler_cache_file_header || f->get_32() != compiler_cache_file_version) {
+		return false;
+	}
+
+	Vector<StringName> render_modes = _get_string_names(f);
+	Vector<StringName> usage_flags = _get_string_names(f);
+	Vector<StringName> write_flags = _get_string_names(f);
+
+	HashMap<StringName, SL::ShaderNode::Uniform> uniforms;
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		_get_uniform(f, uniform);
+		if (uniform.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && _get_global_shader_uniform_type(name) != uniform.type) {
+			return false; // The global uniform was changed since this was cached, the shader may not even compile anymore.
+		}
+		uniforms.insert(name, uniform);
+	}
+
+	GeneratedCode gen_code;
+	uint32_t define_count = f->get_32();
+	for (uint32_t i = 0; i < define_count && !f->eof_reached(); i++) {
+		gen_code.defines.push_back(f->get_pascal_string());
+	}
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = (int32_t)f->get_32();
+		gen_code.texture_uniforms.push_back(texture);
+	}
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+	uint8_t usage = f->get_8();
+	gen_code.uses_global_textures = usage & (1 << 0);
+	gen_code.uses_fragment_time = usage & (1 << 1);
+	gen_code.uses_vertex_time = usage & (1 << 2);
+	gen_code.uses_screen_texture_mipmaps = usage & (1 << 3);
+	gen_code.uses_screen_texture = usage & (1 << 4);
+	gen_code.uses_depth_texture = usage & (1 << 5);
+	gen_code.uses_normal_roughness_texture = usage & (1 << 6);
+
+	if (f->get_error() != OK || f->eof_reached() || f->get_buffer((uint8_t *)header, 4) != 4 || String(header) != compiler_cache_file_header) {
+		return false; // Truncated or corrupt.
+	}
+
+	// Everything was read, now apply what compiling would have.
+	for (const StringName &E : render_modes) {
+		if (p_actions->render_mode_flags.has(E)) {
+			*p_actions->render_mode_flags[E] = true;
+		}
+		if (p_actions->render_mode_values.has(E)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[E];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &E : usage_flags) {
+		if (p_actions->usage_flag_pointers.has(E)) {
+			*p_actions->usage_flag_pointers[E] = true;
+		}
+	}
+	for (const StringName &E : write_flags) {
+		if (p_actions->write_flag_pointers.has(E)) {
+			*p_actions->write_flag_pointers[E] = true;
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+
+	r_gen_code = gen_code;
+	return true;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const Vector<StringName> &p_render_modes, const Vector<StringName> &p_usage_flags, const Vector<StringName> &p_write_flags, const HashMap<StringName, SL::ShaderNode::Uniform> &p_uniforms, const GeneratedCode &p_gen_code) {
+	// Shaders may be compiled on several threads, write to a unique file first
+	// so another thread never reads a partially written entry.
+	const String path = cache_dir.path_join(p_key) + ".cache";
+	const String temp_path = path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+
+	f->store_buffer((const uint8_t *)compiler_cache_file_header, 4);
+	f->store_32(compiler_cache_file_version);
+
+	_store_string_names(f, p_render_modes);
+	_store_string_names(f, p_usage_flags);
+	_store_string_names(f, p_write_flags);
+
+	f->store_32(p_uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_uniforms) {
+		f->store_pascal_string(E.key);
+		_store_uniform(f, E.value);
+	}
+
+	f->store_32(p_gen_code.defines.size());
+	for (int i = 0; i < p_gen_code.defines.size(); i++) {
+		f->store_pascal_string(p_gen_code.defines[i]);
+	}
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : p_gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (int i = 0; i < p_gen_code.uniform_offsets.size(); i++) {
+		f->store_32(p_gen_code.uniform_offsets[i]);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+	uint8_t usage = 0;
+	usage |= p_gen_code.uses_global_textures ? (1 << 0) : 0;
+	usage |= p_gen_code.uses_fragment_time ? (1 << 1) : 0;
+	usage |= p_gen_code.uses_vertex_time ? (1 << 2) : 0;
+	usage |= p_gen_code.uses_screen_texture_mipmaps ? (1 << 3) : 0;
+	usage |= p_gen_code.uses_screen_texture ? (1 << 4) : 0;
+	usage |= p_gen_code.uses_depth_texture ? (1 << 5) : 0;
+	usage |= p_gen_code.uses_normal_roughness_texture ? (1 << 6) : 0;
+	f->store_8(usage);
+
+	// Trailing header, so truncated files are detected on load.
+	f->store_buffer((const uint8_t *)compiler_cache_file_header, 4);
+	f->close();
+
+	if (DirAccess::rename_absolute(temp_path, path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+void ShaderCompiler::set_cache_dir(const String &p_dir) {
+	cache_dir = String();
+	if (p_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	ERR_FAIL_COND_MSG(da.is_null(), "Can't open shader compiler cache folder: " + p_dir);
+	if (!da->dir_exists("shader_compiler")) {
+		Error err = da->make_dir("shader_compiler");
+		ERR_FAIL_COND_MSG(err != OK, "Can't create shader compiler cache folder: " + p_dir.path_join("shader_compiler"));
+	}
+	cache_dir = p_dir.path_join("shader_compiler");
+}
+
+String ShaderCompiler::get_cache_dir() {
+	return cache_dir;
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	String cache_key;
+	if (!cache_dir.is_empty()) {
+		cache_key = _get_cache_key(p_mode, p_code, p_actions);
+		if (_load_from_cache(cache_key, p_actions, r_gen_code)) {
+			return OK;
+		}
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
 	info.shader_types = ShaderTypes::get_singleton()->get_types();
 	info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
 
+	CompileState state;
+	ShaderLanguage &parser = state.parser;
 	Error err = parser.compile(p_code, info);
 
 	if (err != OK) {
@@ -1558,14 +1882,56 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	r_gen_code.uses_depth_texture = false;
 	r_gen_code.uses_normal_roughness_texture = false;
 
-	used_name_defines.clear();
-	used_rmode_defines.clear();
-	used_flag_pointers.clear();
-	fragment_varyings.clear();
+	state.shader = parser.get_shader();
+
+	if (cache_key.is_empty()) {
+		_dump_node_code(state, state.shader, 1, r_gen_code, *p_actions, actions, false);
+		return OK;
+	}
+
+	// Generate into local flags and uniforms first, to know which of them this shader sets.
+	IdentifierActions recorded_actions = *p_actions;
+	HashMap<StringName, SL::ShaderNode::Uniform> recorded_uniforms;
+	recorded_actions.uniforms = &recorded_uniforms;
+
+	LocalVector<bool> usage_flags;
+	usage_flags.resize(p_actions->usage_flag_pointers.size());
+	LocalVector<bool> write_flags;
+	write_flags.resize(p_actions->write_flag_pointers.size());
+	int flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		usage_flags[flag_index] = false;
+		recorded_actions.usage_flag_pointers[E.key] = &usage_flags[flag_index++];
+	}
+	flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		write_flags[flag_index] = false;
+		recorded_actions.write_flag_pointers[E.key] = &write_flags[flag_index++];
+	}
 
-	shader = parser.get_shader();
-	function = nullptr;
-	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_dump_node_code(state, state.shader, 1, r_gen_code, recorded_actions, actions, false);
+
+	Vector<StringName> used_usage_flags;
+	flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		if (usage_flags[flag_index++]) {
+			*E.value = true;
+			used_usage_flags.push_back(E.key);
+		}
+	}
+	Vector<StringName> used_write_flags;
+	flag_index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		if (write_flags[flag_index++]) {
+			*E.value = true;
+			used_write_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : recorded_uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+
+	_save_to_cache(cache_key, state.shader->render_modes, used_usage_flags, used_write_flags, recorded_uniforms, r_gen_code);
 
 	return OK;
 }
@@ -1573,6 +1939,27 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	{
+		StringBuilder hash;
+		for (const KeyValue<StringName, String> &E : actions.renames) {
+			hash.append("[rename]" + String(E.key) + "=" + E.value);
+		}
+		for (const KeyValue<StringName, String> &E : actions.render_mode_defines) {
+			hash.append("[render_mode_define]" + String(E.key) + "=" + E.value);
+		}
+		for (const KeyValue<StringName, String> &E : actions.usage_defines) {
+			hash.append("[usage_define]" + String(E.key) + "=" + E.value);
+		}
+		for (const KeyValue<StringName, String> &E : actions.custom_samplers) {
+			hash.append("[custom_sampler]" + String(E.key) + "=" + E.value);
+		}
+		hash.append(vformat("[defaults]%d,%d,%d,%d,%d,%d,%d", actions.default_filter, actions.default_repeat, actions.base_texture_binding_index, actions.texture_layout_set, actions.base_varying_index, int(actions.apply_luminance_multiplier), int(actions.check_multiview_samplers)));
+		hash.append("[base_uniform_string]" + actions.base_uniform_string);
+		hash.append("[global_buffer_array_variable]" + actions.global_buffer_array_variable);
+		hash.append("[instance_uniform_index_variable]" + actions.instance_uniform_index_variable);
+		actions_hash = hash.as_string().sha256_text();
+	}
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -104,32 +104,49 @@ public:
 	};
 
 private:
-	ShaderLanguage parser;
+	// State of a single compilation. Kept out of the compiler itself so that
+	// several shaders can be compiled at once by the same ShaderCompiler.
+	struct CompileState {
+		ShaderLanguage parser;
+		const ShaderLanguage::ShaderNode *shader = nullptr;
+		const ShaderLanguage::FunctionNode *function = nullptr;
+		StringName current_func_name;
+
+		HashSet<StringName> used_name_defines;
+		HashSet<StringName> used_flag_pointers;
+		HashSet<StringName> used_rmode_defines;
+		HashSet<StringName> fragment_varyings;
+	};
 
 	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
 
 	void _dump_function_deps(const ShaderLanguage::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added);
-	String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
+	String _dump_node_code(CompileState &r_state, const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
 
-	const ShaderLanguage::ShaderNode *shader = nullptr;
-	const ShaderLanguage::FunctionNode *function = nullptr;
-	StringName current_func_name;
 	StringName time_name;
 	HashSet<StringName> texture_functions;
-
-	HashSet<StringName> used_name_defines;
-	HashSet<StringName> used_flag_pointers;
-	HashSet<StringName> used_rmode_defines;
 	HashSet<StringName> internal_functions;
-	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
+	String actions_hash;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Generated code is cached on disk, keyed by the (already preprocessed) source
+	// and everything else that affects code generation, so warm starts skip parsing.
+	static String cache_dir;
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const;
+	bool _load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _save_to_cache(const String &p_key, const Vector<StringName> &p_render_modes, const Vector<StringName> &p_usage_flags, const Vector<StringName> &p_write_flags, const HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> &p_uniforms, const GeneratedCode &p_gen_code);
+
 public:
+	// Thread-safe once initialize() has been called.
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	static void set_cache_dir(const String &p_dir);
+	static String get_cache_dir();
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
 };
@@ -40,6 +40,7 @@
 #define HAS_WARNING(flag) (warning_flags & flag)
 
 int ShaderLanguage::instance_counter = 0;
+Mutex ShaderLanguage::instance_counter_mutex;
 
 String ShaderLanguage::get_operator_text(Operator p_op) {
 	static const char *op_names[OP_MAX] = { "==",
@@ -724,9 +725,9 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 					static bool suffix_lut[CASE_MAX][127];
 
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
-
+					// Shaders may be parsed from several threads at once, so rely on
+					// the thread-safe initialization of function-local statics.
+					static const bool suffix_lut_initialized = []() {
 						for (int i = 0; i < 127; i++) {
 							char t = char(i);
 
@@ -736,7 +737,9 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
 							suffix_lut[CASE_NONE][i] = false;
 						}
-					}
+						return true;
+					}();
+					(void)suffix_lut_initialized;
 
 					String str;
 					int i = 0;
@@ -3165,8 +3168,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::frag_only_func_defs[] = {
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
-
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
 
@@ -11007,16 +11008,19 @@ ShaderLanguage::ShaderLanguage() {
 	nodes = nullptr;
 	completion_class = TAG_GLOBAL;
 
-	if (instance_counter == 0) {
-		int idx = 0;
-		while (builtin_func_defs[idx].name) {
-			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
-				global_func_set.insert(builtin_func_defs[idx].name);
+	{
+		MutexLock lock(instance_counter_mutex);
+		if (instance_counter == 0) {
+			int idx = 0;
+			while (builtin_func_defs[idx].name) {
+				if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
+					global_func_set.insert(builtin_func_defs[idx].name);
+				}
+				idx++;
 			}
-			idx++;
 		}
+		instance_counter++;
 	}
-	instance_counter++;
 
 #ifdef DEBUG_ENABLED
 	warnings_check_map.insert(ShaderWarning::UNUSED_CONSTANT, &used_constants);
@@ -11031,6 +11035,8 @@ ShaderLanguage::ShaderLanguage() {
 
 ShaderLanguage::~ShaderLanguage() {
 	clear();
+
+	MutexLock lock(instance_counter_mutex);
 	instance_counter--;
 	if (instance_counter == 0) {
 		global_func_set.clear();
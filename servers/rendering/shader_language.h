@@ -32,6 +32,7 @@
 #define SHADER_LANGUAGE_H
 
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
 #include "core/templates/list.h"
@@ -818,6 +819,7 @@ public:
 	static void get_builtin_funcs(List<String> *r_keywords);
 
 	static int instance_counter;
+	static Mutex instance_counter_mutex;
 
 	struct BuiltInInfo {
 		DataType type = TYPE_VOID;
@@ -1132,8 +1134,6 @@ private:
 	static const BuiltinFuncConstArgs builtin_func_const_args[];
 	static const BuiltinEntry frag_only_func_defs[];
 
-	static bool is_const_suffix_lut_initialized;
-
 	Error _validate_precision(DataType p_type, DataPrecision p_precision);
 	bool _compare_datatypes(DataType p_datatype_a, String p_datatype_name_a, int p_array_size_a, DataType p_datatype_b, String p_datatype_name_b, int p_array_size_b);
 	bool _compare_datatypes_in_nodes(Node *a, Node *b);
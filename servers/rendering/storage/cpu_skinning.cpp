@@ -0,0 +1,471 @@
+/**************************************************************************/
+/*  cpu_skinning.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "cpu_skinning.h"
+
+#include "core/object/worker_thread_pool.h"
+
+static PackedVector3Array _get_vector3_array(const Variant &p_array) {
+	if (p_array.get_type() != Variant::PACKED_VECTOR2_ARRAY) {
+		return p_array;
+	}
+
+	// 2D meshes store their vertices without the Z component.
+	const PackedVector2Array array_2d = p_array;
+	PackedVector3Array array;
+	array.resize(array_2d.size());
+	Vector3 *w = array.ptrw();
+	for (int i = 0; i < array_2d.size(); i++) {
+		w[i] = Vector3(array_2d[i].x, array_2d[i].y, 0.0);
+	}
+	return array;
+}
+
+static void _split_vector3_array(const PackedVector3Array &p_array, float *r_streams) {
+	const uint32_t count = p_array.size();
+	const Vector3 *r = p_array.ptr();
+	for (uint32_t i = 0; i < count; i++) {
+		r_streams[i] = r[i].x;
+		r_streams[count + i] = r[i].y;
+		r_streams[count * 2 + i] = r[i].z;
+	}
+}
+
+static void _split_tangent_array(const PackedFloat32Array &p_array, float *r_streams, float *r_signs) {
+	const uint32_t count = p_array.size() / 4;
+	const float *r = p_array.ptr();
+	for (uint32_t i = 0; i < count; i++) {
+		r_streams[i] = r[i * 4 + 0];
+		r_streams[count + i] = r[i * 4 + 1];
+		r_streams[count * 2 + i] = r[i * 4 + 2];
+		if (r_signs) {
+			r_signs[i] = r[i * 4 + 3];
+		}
+	}
+}
+
+Vector3 CPUSkinning::Result::get_vertex(uint32_t p_index) const {
+	const uint32_t count = vertices.size() / 3;
+	ERR_FAIL_UNSIGNED_INDEX_V(p_index, count, Vector3());
+	return Vector3(vertices[p_index], vertices[count + p_index], vertices[count * 2 + p_index]);
+}
+
+Vector3 CPUSkinning::Result::get_normal(uint32_t p_index) const {
+	const uint32_t count = normals.size() / 3;
+	ERR_FAIL_UNSIGNED_INDEX_V(p_index, count, Vector3());
+	return Vector3(normals[p_index], normals[count + p_index], normals[count * 2 + p_index]);
+}
+
+PackedVector3Array CPUSkinning::Result::get_vertex_array() const {
+	const uint32_t count = vertices.size() / 3;
+	PackedVector3Array array;
+	array.resize(count);
+	Vector3 *w = array.ptrw();
+	for (uint32_t i = 0; i < count; i++) {
+		w[i] = Vector3(vertices[i], vertices[count + i], vertices[count * 2 + i]);
+	}
+	return array;
+}
+
+PackedVector3Array CPUSkinning::Result::get_normal_array() const {
+	const uint32_t count = normals.size() / 3;
+	PackedVector3Array array;
+	array.resize(count);
+	Vector3 *w = array.ptrw();
+	for (uint32_t i = 0; i < count; i++) {
+		w[i] = Vector3(normals[i], normals[count + i], normals[count * 2 + i]);
+	}
+	return array;
+}
+
+PackedFloat32Array CPUSkinning::Result::get_tangent_array(const Surface &p_surface) const {
+	const uint32_t count = tangents.size() / 3;
+	ERR_FAIL_COND_V(p_surface.tangent_signs.size() != count, PackedFloat32Array());
+	PackedFloat32Array array;
+	array.resize(count * 4);
+	float *w = array.ptrw();
+	for (uint32_t i = 0; i < count; i++) {
+		w[i * 4 + 0] = tangents[i];
+		w[i * 4 + 1] = tangents[count + i];
+		w[i * 4 + 2] = tangents[count * 2 + i];
+		w[i * 4 + 3] = p_surface.tangent_signs[i];
+	}
+	return array;
+}
+
+Error CPUSkinning::surface_from_arrays(const Array &p_arrays, const TypedArray<Array> &p_blend_shape_arrays, Surface &r_surface) {
+	ERR_FAIL_COND_V(p_arrays.size() != RS::ARRAY_MAX, ERR_INVALID_PARAMETER);
+
+	r_surface = Surface();
+
+	const PackedVector3Array vertices = _get_vector3_array(p_arrays[RS::ARRAY_VERTEX]);
+	ERR_FAIL_COND_V(vertices.is_empty(), ERR_INVALID_DATA);
+
+	const uint32_t vertex_count = vertices.size();
+	r_surface.vertex_count = vertex_count;
+	r_surface.vertices.resize(vertex_count * 3);
+	_split_vector3_array(vertices, r_surface.vertices.ptr());
+
+	const PackedVector3Array normals = p_arrays[RS::ARRAY_NORMAL];
+	if (normals.size() == (int)vertex_count) {
+		r_surface.has_normals = true;
+		r_surface.normals.resize(vertex_count * 3);
+		_split_vector3_array(normals, r_surface.normals.ptr());
+	}
+
+	const PackedFloat32Array tangents = p_arrays[RS::ARRAY_TANGENT];
+	if (tangents.size() == (int)vertex_count * 4) {
+		r_surface.has_tangents = true;
+		r_surface.tangents.resize(vertex_count * 3);
+		r_surface.tangent_signs.resize(vertex_count);
+		_split_tangent_array(tangents, r_surface.tangents.ptr(), r_surface.tangent_signs.ptr());
+	}
+
+	const PackedInt32Array bones = p_arrays[RS::ARRAY_BONES];
+	const PackedFloat32Array weights = p_arrays[RS::ARRAY_WEIGHTS];
+	if (!bones.is_empty() && bones.size() == weights.size()) {
+		const uint32_t influences = bones.size() / vertex_count;
+		ERR_FAIL_COND_V((influences != 4 && influences != 8) || influences * vertex_count != (uint32_t)bones.size(), ERR_INVALID_DATA);
+
+		r_surface.bone_influences = influences;
+		r_surface.bones.resize(influences * vertex_count);
+		r_surface.weights.resize(influences * vertex_count);
+
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			for (uint32_t j = 0; j < influences; j++) {
+				const int bone = bones[i * influences + j];
+				ERR_FAIL_COND_V(bone < 0, ERR_INVALID_DATA);
+				r_surface.bones[j * vertex_count + i] = bone;
+				r_surface.weights[j * vertex_count + i] = weights[i * influences + j];
+				r_surface.required_bones = MAX(r_surface.required_bones, (uint32_t)bone + 1);
+			}
+		}
+	}
+
+	const uint32_t blend_shape_count = p_blend_shape_arrays.size();
+	r_surface.blend_shape_count = blend_shape_count;
+	r_surface.blend_vertices.resize(blend_shape_count * vertex_count * 3);
+	r_surface.blend_normals.resize(r_surface.has_normals ? blend_shape_count * vertex_count * 3 : 0);
+	r_surface.blend_tangents.resize(r_surface.has_tangents ? blend_shape_count * vertex_count * 3 : 0);
+
+	for (uint32_t i = 0; i < blend_shape_count; i++) {
+		const Array shape = p_blend_shape_arrays[i];
+		ERR_FAIL_COND_V(shape.size() != RS::ARRAY_MAX, ERR_INVALID_DATA);
+
+		const PackedVector3Array shape_vertices = _get_vector3_array(shape[RS::ARRAY_VERTEX]);
+		ERR_FAIL_COND_V(shape_vertices.size() != (int)vertex_count, ERR_INVALID_DATA);
+		_split_vector3_array(shape_vertices, r_surface.blend_vertices.ptr() + i * vertex_count * 3);
+
+		// Shapes without their own normals or tangents blend towards the base ones.
+		if (r_surface.has_normals) {
+			float *dst = r_surface.blend_normals.ptr() + i * vertex_count * 3;
+			const PackedVector3Array shape_normals = shape[RS::ARRAY_NORMAL];
+			if (shape_normals.size() == (int)vertex_count) {
+				_split_vector3_array(shape_normals, dst);
+			} else {
+				memcpy(dst, r_surface.normals.ptr(), vertex_count * 3 * sizeof(float));
+			}
+		}
+
+		if (r_surface.has_tangents) {
+			float *dst = r_surface.blend_tangents.ptr() + i * vertex_count * 3;
+			const PackedFloat32Array shape_tangents = shape[RS::ARRAY_TANGENT];
+			if (shape_tangents.size() == (int)vertex_count * 4) {
+				_split_tangent_array(shape_tangents, dst, nullptr);
+			} else {
+				memcpy(dst, r_surface.tangents.ptr(), vertex_count * 3 * sizeof(float));
+			}
+		}
+	}
+
+	return OK;
+}
+
+Error CPUSkinning::surface_from_data(const RS::SurfaceData &p_data, Surface &r_surface) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	ERR_FAIL_NULL_V(rs, ERR_UNCONFIGURED);
+
+	const Array arrays = rs->mesh_create_arrays_from_surface_data(p_data);
+	ERR_FAIL_COND_V(arrays.is_empty(), ERR_INVALID_DATA);
+
+	TypedArray<Array> blend_shape_arrays;
+	if (!p_data.blend_shape_data.is_empty()) {
+		// Same layout as read by RenderingServer::mesh_surface_get_blend_shape_arrays().
+		const uint64_t blend_shape_format = p_data.format & RS::ARRAY_FORMAT_BLEND_SHAPE_MASK;
+		uint32_t offsets[RS::ARRAY_MAX];
+		uint32_t vertex_element_size;
+		uint32_t normal_element_size;
+		uint32_t attrib_element_size;
+		uint32_t skin_element_size;
+		rs->mesh_surface_make_offsets_from_format(blend_shape_format, p_data.vertex_count, 0, offsets, vertex_element_size, normal_element_size, attrib_element_size, skin_element_size);
+
+		const int shape_size = (vertex_element_size + normal_element_size) * p_data.vertex_count;
+		ERR_FAIL_COND_V(shape_size == 0 || p_data.blend_shape_data.size() % shape_size != 0, ERR_INVALID_DATA);
+
+		for (int from = 0; from < p_data.blend_shape_data.size(); from += shape_size) {
+			RS::SurfaceData shape;
+			shape.format = blend_shape_format;
+			shape.vertex_data = p_data.blend_shape_data.slice(from, from + shape_size);
+			shape.vertex_count = p_data.vertex_count;
+			shape.aabb = p_data.aabb;
+			shape.uv_scale = p_data.uv_scale;
+			blend_shape_arrays.push_back(rs->mesh_create_arrays_from_surface_data(shape));
+		}
+	}
+
+	return surface_from_arrays(arrays, blend_shape_arrays, r_surface);
+}
+
+void CPUSkinning::_blend_streams(const Evaluation &p_evaluation, const float *p_base, const float *p_shapes, float *r_dst, uint32_t p_from, uint32_t p_to) {
+	const uint32_t count = p_evaluation.surface->vertex_count;
+	const float base_scale = p_evaluation.base_scale;
+
+	for (uint32_t c = 0; c < 3; c++) {
+		const float *src = p_base + c * count;
+		float *dst = r_dst + c * count;
+
+		for (uint32_t i = p_from; i < p_to; i++) {
+			dst[i] = src[i] * base_scale;
+		}
+
+		for (uint32_t j = 0; j < p_evaluation.active_shapes.size(); j++) {
+			const float *shape = p_shapes + (p_evaluation.active_shapes[j] * 3 + c) * count;
+			const float weight = p_evaluation.active_weights[j];
+			for (uint32_t i = p_from; i < p_to; i++) {
+				dst[i] += shape[i] * weight;
+			}
+		}
+	}
+}
+
+void CPUSkinning::_normalize_streams(float *r_dst, uint32_t p_stride, uint32_t p_from, uint32_t p_to) {
+	float *x = r_dst;
+	float *y = r_dst + p_stride;
+	float *z = r_dst + p_stride * 2;
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const float length_squared = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+		const float scale = length_squared > 0.0f ? 1.0f / Math::sqrt(length_squared) : 0.0f;
+		x[i] *= scale;
+		y[i] *= scale;
+		z[i] *= scale;
+	}
+}
+
+void CPUSkinning::_evaluate_block(void *p_userdata, uint32_t p_block) {
+	Evaluation &evaluation = *(Evaluation *)p_userdata;
+	const Surface &surface = *evaluation.surface;
+	Result &result = *evaluation.result;
+
+	const uint32_t count = surface.vertex_count;
+	const uint32_t from = p_block * BLOCK_SIZE;
+	const uint32_t to = MIN(from + BLOCK_SIZE, count);
+	const uint32_t block_size = to - from;
+
+	float *vertices = result.vertices.ptr();
+	float *normals = surface.has_normals ? result.normals.ptr() : nullptr;
+	float *tangents = surface.has_tangents ? result.tangents.ptr() : nullptr;
+
+	_blend_streams(evaluation, surface.vertices.ptr(), surface.blend_vertices.ptr(), vertices, from, to);
+	if (normals) {
+		_blend_streams(evaluation, surface.normals.ptr(), surface.blend_normals.ptr(), normals, from, to);
+	}
+	if (tangents) {
+		_blend_streams(evaluation, surface.tangents.ptr(), surface.blend_tangents.ptr(), tangents, from, to);
+	}
+
+	if (evaluation.bones) {
+		// Blend the bone matrices of every vertex in the block first, then
+		// transform all attributes with them.
+		float m[BONE_STRIDE][BLOCK_SIZE];
+		for (uint32_t c = 0; c < BONE_STRIDE; c++) {
+			memset(m[c], 0, block_size * sizeof(float));
+		}
+
+		for (uint32_t j = 0; j < surface.bone_influences; j++) {
+			const uint32_t *bones = surface.bones.ptr() + j * count + from;
+			const float *weights = surface.weights.ptr() + j * count + from;
+			for (uint32_t i = 0; i < block_size; i++) {
+				const float *bone = evaluation.bones + bones[i] * BONE_STRIDE;
+				const float weight = weights[i];
+				for (uint32_t c = 0; c < BONE_STRIDE; c++) {
+					m[c][i] += bone[c] * weight;
+				}
+			}
+		}
+
+		float *x = vertices + from;
+		float *y = vertices + count + from;
+		float *z = vertices + count * 2 + from;
+		for (uint32_t i = 0; i < block_size; i++) {
+			const float vx = x[i];
+			const float vy = y[i];
+			const float vz = z[i];
+			x[i] = m[0][i] * vx + m[1][i] * vy + m[2][i] * vz + m[3][i];
+			y[i] = m[4][i] * vx + m[5][i] * vy + m[6][i] * vz + m[7][i];
+			z[i] = m[8][i] * vx + m[9][i] * vy + m[10][i] * vz + m[11][i];
+		}
+
+		float *directions[2] = { normals, tangents };
+		for (float *direction : directions) {
+			if (!direction) {
+				continue;
+			}
+			x = direction + from;
+			y = direction + count + from;
+			z = direction + count * 2 + from;
+			for (uint32_t i = 0; i < block_size; i++) {
+				const float dx = x[i];
+				const float dy = y[i];
+				const float dz = z[i];
+				x[i] = m[0][i] * dx + m[1][i] * dy + m[2][i] * dz;
+				y[i] = m[4][i] * dx + m[5][i] * dy + m[6][i] * dz;
+				z[i] = m[8][i] * dx + m[9][i] * dy + m[10][i] * dz;
+			}
+		}
+	}
+
+	if (evaluation.deform) {
+		if (normals) {
+			_normalize_streams(normals, count, from, to);
+		}
+		if (tangents) {
+			_normalize_streams(tangents, count, from, to);
+		}
+	}
+
+	float min[3];
+	float max[3];
+	for (uint32_t c = 0; c < 3; c++) {
+		const float *stream = vertices + c * count;
+		float stream_min = stream[from];
+		float stream_max = stream[from];
+		for (uint32_t i = from + 1; i < to; i++) {
+			stream_min = MIN(stream_min, stream[i]);
+			stream_max = MAX(stream_max, stream[i]);
+		}
+		min[c] = stream_min;
+		max[c] = stream_max;
+	}
+
+	evaluation.block_aabbs[p_block] = AABB(Vector3(min[0], min[1], min[2]), Vector3(max[0] - min[0], max[1] - min[1], max[2] - min[2]));
+}
+
+void CPUSkinning::evaluate(const Surface &p_surface, const float *p_blend_weights, RS::BlendShapeMode p_blend_shape_mode, const float *p_bones, uint32_t p_bone_count, Result &r_result) {
+	const bool skin = p_bones && p_surface.bone_influences > 0;
+	ERR_FAIL_COND_MSG(skin && p_surface.required_bones > p_bone_count, vformat("The surface references %d bones, but only %d were given.", p_surface.required_bones, p_bone_count));
+
+	const uint32_t vertex_count = p_surface.vertex_count;
+	r_result.vertices.resize(vertex_count * 3);
+	r_result.normals.resize(p_surface.has_normals ? vertex_count * 3 : 0);
+	r_result.tangents.resize(p_surface.has_tangents ? vertex_count * 3 : 0);
+	r_result.aabb = AABB();
+
+	if (vertex_count == 0) {
+		return;
+	}
+
+	Evaluation evaluation;
+	evaluation.surface = &p_surface;
+	evaluation.result = &r_result;
+
+	if (p_blend_weights) {
+		float total_weight = 0.0;
+		for (uint32_t i = 0; i < p_surface.blend_shape_count; i++) {
+			// Same threshold as the skinning shader.
+			if (Math::abs(p_blend_weights[i]) > 0.0001f) {
+				evaluation.active_shapes.push_back(i);
+				evaluation.active_weights.push_back(p_blend_weights[i]);
+				total_weight += p_blend_weights[i];
+			}
+		}
+
+		if (!evaluation.active_shapes.is_empty()) {
+			evaluation.deform = true;
+			if (p_blend_shape_mode == RS::BLEND_SHAPE_MODE_NORMALIZED) {
+				evaluation.base_scale = 1.0 - total_weight;
+			}
+		}
+	}
+
+	if (skin) {
+		evaluation.bones = p_bones;
+		evaluation.deform = true;
+	}
+
+	const uint32_t block_count = (vertex_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	evaluation.block_aabbs.resize(block_count);
+
+	if (vertex_count >= THREADED_VERTEX_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&CPUSkinning::_evaluate_block, &evaluation, block_count, -1, true, SNAME("CPUSkinning"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < block_count; i++) {
+			_evaluate_block(&evaluation, i);
+		}
+	}
+
+	r_result.aabb = evaluation.block_aabbs[0];
+	for (uint32_t i = 1; i < block_count; i++) {
+		r_result.aabb.merge_with(evaluation.block_aabbs[i]);
+	}
+}
+
+void CPUSkinning::store_bone_transform(const Transform3D &p_transform, float *r_data) {
+	r_data[0] = p_transform.basis.rows[0][0];
+	r_data[1] = p_transform.basis.rows[0][1];
+	r_data[2] = p_transform.basis.rows[0][2];
+	r_data[3] = p_transform.origin.x;
+	r_data[4] = p_transform.basis.rows[1][0];
+	r_data[5] = p_transform.basis.rows[1][1];
+	r_data[6] = p_transform.basis.rows[1][2];
+	r_data[7] = p_transform.origin.y;
+	r_data[8] = p_transform.basis.rows[2][0];
+	r_data[9] = p_transform.basis.rows[2][1];
+	r_data[10] = p_transform.basis.rows[2][2];
+	r_data[11] = p_transform.origin.z;
+}
+
+Transform3D CPUSkinning::load_bone_transform(const float *p_data) {
+	Transform3D transform;
+	transform.basis.rows[0][0] = p_data[0];
+	transform.basis.rows[0][1] = p_data[1];
+	transform.basis.rows[0][2] = p_data[2];
+	transform.origin.x = p_data[3];
+	transform.basis.rows[1][0] = p_data[4];
+	transform.basis.rows[1][1] = p_data[5];
+	transform.basis.rows[1][2] = p_data[6];
+	transform.origin.y = p_data[7];
+	transform.basis.rows[2][0] = p_data[8];
+	transform.basis.rows[2][1] = p_data[9];
+	transform.basis.rows[2][2] = p_data[10];
+	transform.origin.z = p_data[11];
+	return transform;
+}
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  cpu_skinning.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef CPU_SKINNING_H
+#define CPU_SKINNING_H
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+#include "servers/rendering_server.h"
+
+// Evaluates blend shapes and skeleton deformation of mesh surfaces on the CPU,
+// with the same math as the GPU skinning shader. Used where there is no GPU to
+// do it (the dummy renderer) and to bake deformed meshes.
+//
+// Attributes are decoded into one stream per component (structure of arrays)
+// and processed in fixed-size blocks, so every inner loop runs over contiguous
+// floats and can be vectorized by the compiler. Large surfaces spread their
+// blocks over the WorkerThreadPool.
+class CPUSkinning {
+public:
+	enum {
+		BLOCK_SIZE = 256,
+		// Surfaces with fewer vertices are evaluated on the calling thread.
+		THREADED_VERTEX_THRESHOLD = 8192,
+		BONE_STRIDE = 12,
+	};
+
+	struct Surface {
+		uint32_t vertex_count = 0;
+		uint32_t blend_shape_count = 0;
+		uint32_t bone_influences = 0; // 0, 4 or 8.
+		uint32_t required_bones = 0; // Highest referenced bone index plus one.
+		bool has_normals = false;
+		bool has_tangents = false;
+
+		// Three streams (x, y, z) of vertex_count floats each.
+		LocalVector<float> vertices;
+		LocalVector<float> normals;
+		LocalVector<float> tangents;
+		LocalVector<float> tangent_signs;
+
+		// Three streams per blend shape, one blend shape after the other.
+		LocalVector<float> blend_vertices;
+		LocalVector<float> blend_normals;
+		LocalVector<float> blend_tangents;
+
+		// One stream of vertex_count entries per influence.
+		LocalVector<uint32_t> bones;
+		LocalVector<float> weights;
+	};
+
+	struct Result {
+		LocalVector<float> vertices;
+		LocalVector<float> normals;
+		LocalVector<float> tangents;
+		AABB aabb;
+
+		Vector3 get_vertex(uint32_t p_index) const;
+		Vector3 get_normal(uint32_t p_index) const;
+
+		PackedVector3Array get_vertex_array() const;
+		PackedVector3Array get_normal_array() const;
+		PackedFloat32Array get_tangent_array(const Surface &p_surface) const;
+	};
+
+private:
+	struct Evaluation {
+		const Surface *surface = nullptr;
+		const float *bones = nullptr;
+		LocalVector<uint32_t> active_shapes;
+		LocalVector<float> active_weights;
+		float base_scale = 1.0;
+		bool deform = false;
+		Result *result = nullptr;
+		LocalVector<AABB> block_aabbs;
+	};
+
+	static void _blend_streams(const Evaluation &p_evaluation, const float *p_base, const float *p_shapes, float *r_dst, uint32_t p_from, uint32_t p_to);
+	static void _normalize_streams(float *r_dst, uint32_t p_stride, uint32_t p_from, uint32_t p_to);
+	static void _evaluate_block(void *p_userdata, uint32_t p_block);
+
+public:
+	static Error surface_from_arrays(const Array &p_arrays, const TypedArray<Array> &p_blend_shape_arrays, Surface &r_surface);
+	static Error surface_from_data(const RS::SurfaceData &p_data, Surface &r_surface);
+
+	// p_blend_weights holds one weight per blend shape, or is null.
+	// p_bones holds BONE_STRIDE floats per bone (the rows of a 3x4 matrix, as
+	// skeletons store them), or is null to skip skinning.
+	static void evaluate(const Surface &p_surface, const float *p_blend_weights, RS::BlendShapeMode p_blend_shape_mode, const float *p_bones, uint32_t p_bone_count, Result &r_result);
+
+	static void store_bone_transform(const Transform3D &p_transform, float *r_data);
+	static Transform3D load_bone_transform(const float *p_data);
+};
+
+#endif // CPU_SKINNING_H
@@ -71,6 +71,9 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const = 0;
 
+	virtual void shader_compile_batch_begin() = 0;
+	virtual void shader_compile_batch_end() = 0;
+
 	/* MATERIAL API */
 
 	virtual RID material_allocate() = 0;
@@ -224,6 +224,9 @@ public:
 
 	virtual ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const = 0;
 
+	virtual void shader_compile_batch_begin() = 0;
+	virtual void shader_compile_batch_end() = 0;
+
 	/* COMMON MATERIAL API */
 
 	enum {
@@ -199,6 +199,7 @@ void TextServerExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_font_get_supported_glyphs, "font_rid");
 
 	GDVIRTUAL_BIND(_font_render_range, "font_rid", "size", "start", "end");
+	GDVIRTUAL_BIND(_font_render_string, "font_rid", "size", "text");
 	GDVIRTUAL_BIND(_font_render_glyph, "font_rid", "size", "index");
 
 	GDVIRTUAL_BIND(_font_draw_glyph, "font_rid", "canvas", "size", "pos", "index", "color");
@@ -938,6 +939,15 @@ void TextServerExtension::font_render_range(const RID &p_font_rid, const Vector2
 	GDVIRTUAL_CALL(_font_render_range, p_font_rid, p_size, p_start, p_end);
 }
 
+void TextServerExtension::font_render_string(const RID &p_font_rid, const Vector2i &p_size, const String &p_text) {
+	if (GDVIRTUAL_CALL(_font_render_string, p_font_rid, p_size, p_text)) {
+		return;
+	}
+	for (int i = 0; i < p_text.length(); i++) {
+		font_render_range(p_font_rid, p_size, p_text[i], p_text[i]);
+	}
+}
+
 void TextServerExtension::font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) {
 	GDVIRTUAL_CALL(_font_render_glyph, p_font_rid, p_size, p_index);
 }
@@ -329,8 +329,10 @@ public:
 	GDVIRTUAL1RC(PackedInt32Array, _font_get_supported_glyphs, RID);
 
 	virtual void font_render_range(const RID &p_font, const Vector2i &p_size, int64_t p_start, int64_t p_end) override;
+	virtual void font_render_string(const RID &p_font_rid, const Vector2i &p_size, const String &p_text) override;
 	virtual void font_render_glyph(const RID &p_font_rid, const Vector2i &p_size, int64_t p_index) override;
 	GDVIRTUAL4(_font_render_range, RID, const Vector2i &, int64_t, int64_t);
+	GDVIRTUAL3(_font_render_string, RID, const Vector2i &, const String &);
 	GDVIRTUAL3(_font_render_glyph, RID, const Vector2i &, int64_t);
 
 	virtual void font_draw_glyph(const RID &p_font, const RID &p_canvas, int64_t p_size, const Vector2 &p_pos, int64_t p_index, const Color &p_color = Color(1, 1, 1)) const override;
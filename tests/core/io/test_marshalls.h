@@ -386,6 +386,58 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] Packed int32 array encoding") {
+	int r_len;
+	PackedInt32Array array;
+	array.push_back(0x12345678);
+	array.push_back(-2);
+	uint8_t buffer[16];
+
+	CHECK(encode_variant(array, buffer, r_len) == OK);
+	CHECK_MESSAGE(r_len == 16, "Length == 4 bytes for header + 4 bytes for array size + 2 * 4 bytes for elements");
+	CHECK_MESSAGE(buffer[0] == 0x1e, "Variant::PACKED_INT32_ARRAY");
+	// Check array size.
+	CHECK(buffer[4] == 0x02);
+	CHECK(buffer[5] == 0x00);
+	CHECK(buffer[6] == 0x00);
+	CHECK(buffer[7] == 0x00);
+	// Check elements, always little-endian.
+	CHECK(buffer[8] == 0x78);
+	CHECK(buffer[9] == 0x56);
+	CHECK(buffer[10] == 0x34);
+	CHECK(buffer[11] == 0x12);
+	CHECK(buffer[12] == 0xfe);
+	CHECK(buffer[13] == 0xff);
+	CHECK(buffer[14] == 0xff);
+	CHECK(buffer[15] == 0xff);
+}
+
+TEST_CASE("[Marshalls] Packed array round trip") {
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	PackedFloat64Array doubles;
+	for (int i = 0; i < 64; i++) {
+		vectors.push_back(Vector3(i, -i * 0.5, i * 2.25));
+		colors.push_back(Color(i / 64.0, 0.25, 1.0 - i / 64.0, 0.5));
+		doubles.push_back(i * 1.0e10 + 0.125);
+	}
+
+	for (const Variant &original : { Variant(vectors), Variant(colors), Variant(doubles) }) {
+		int len;
+		CHECK(encode_variant(original, nullptr, len) == OK);
+		Vector<uint8_t> buffer;
+		buffer.resize(len);
+		CHECK(encode_variant(original, buffer.ptrw(), len) == OK);
+
+		Variant decoded;
+		int r_len;
+		CHECK(decode_variant(decoded, buffer.ptr(), len, &r_len) == OK);
+		CHECK(r_len == len);
+		CHECK(decoded.get_type() == original.get_type());
+		CHECK(decoded == original);
+	}
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  test_variant_schema.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VARIANT_SCHEMA_H
+#define TEST_VARIANT_SCHEMA_H
+
+#include "core/io/marshalls.h"
+#include "core/io/variant_schema.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVariantSchema {
+
+static Ref<VariantSchema> _make_schema() {
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	schema->add_field("health", Variant::INT);
+	schema->add_field("alive", Variant::BOOL);
+	schema->add_field("name", Variant::STRING);
+	schema->add_field("position", Variant::VECTOR2);
+	schema->add_field("cell", Variant::VECTOR3I);
+	schema->add_field("speed", Variant::FLOAT);
+	schema->add_field("extra", Variant::NIL);
+	return schema;
+}
+
+TEST_CASE("[VariantSchema] Fields") {
+	Ref<VariantSchema> schema = _make_schema();
+	CHECK(schema->get_field_count() == 7);
+	CHECK(schema->get_field_name(2) == StringName("name"));
+	CHECK(schema->get_field_type(3) == Variant::VECTOR2);
+	CHECK(schema->find_field("cell") == 4);
+	CHECK(schema->find_field("missing") == -1);
+
+	Dictionary tmpl;
+	tmpl["a"] = 1;
+	tmpl["b"] = Color();
+	schema->create_from_template(tmpl);
+	CHECK(schema->get_field_count() == 2);
+	CHECK(schema->get_field_type(0) == Variant::INT);
+	CHECK(schema->get_field_type(1) == Variant::COLOR);
+}
+
+TEST_CASE("[VariantSchema] Dictionary round trip") {
+	Ref<VariantSchema> schema = _make_schema();
+	Dictionary value;
+	value["health"] = -1234;
+	value["alive"] = true;
+	value["name"] = String::utf8("Jöhn");
+	value["position"] = Vector2(1.5, -2.25);
+	value["cell"] = Vector3i(-70000, 0, 70000);
+	value["speed"] = 0.1;
+	value["extra"] = Array();
+
+	int len;
+	CHECK(schema->encode(value, nullptr, len) == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(schema->encode(value, buffer.ptrw(), len) == OK);
+
+	Variant decoded;
+	int r_len;
+	CHECK(schema->decode(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+	CHECK(r_len == len);
+	CHECK(decoded.get_type() == Variant::DICTIONARY);
+	CHECK(Dictionary(decoded) == value);
+
+	// Without per-field headers the result is much smaller than `encode_variant`.
+	int full_len;
+	CHECK(encode_variant(value, nullptr, full_len) == OK);
+	CHECK(len < full_len / 3);
+}
+
+TEST_CASE("[VariantSchema] Decoded key types") {
+	Dictionary tmpl;
+	tmpl[StringName("id")] = 0;
+	tmpl["label"] = "";
+
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	schema->create_from_template(tmpl);
+	schema->add_field("manual", Variant::INT);
+
+	Dictionary value;
+	value[StringName("id")] = 7;
+	value["label"] = "seven";
+	value["manual"] = 1;
+
+	int len;
+	CHECK(schema->encode(value, nullptr, len) == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(schema->encode(value, buffer.ptrw(), len) == OK);
+
+	Variant decoded;
+	CHECK(schema->decode(decoded, buffer.ptr(), buffer.size()) == OK);
+	List<Variant> keys;
+	Dictionary(decoded).get_key_list(&keys);
+	REQUIRE(keys.size() == 3);
+	// Template keys keep their type, fields added by name decode as String.
+	CHECK(keys.get(0).get_type() == Variant::STRING_NAME);
+	CHECK(keys.get(1).get_type() == Variant::STRING);
+	CHECK(keys.get(2).get_type() == Variant::STRING);
+}
+
+TEST_CASE("[VariantSchema] Absent fields and conversion") {
+	Ref<VariantSchema> schema = _make_schema();
+	Dictionary value;
+	value["speed"] = 3; // Converted to float.
+	value["unknown"] = "ignored";
+
+	int len;
+	CHECK(schema->encode(value, nullptr, len) == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(schema->encode(value, buffer.ptrw(), len) == OK);
+
+	Variant decoded;
+	CHECK(schema->decode(decoded, buffer.ptr(), buffer.size()) == OK);
+	Dictionary dict = decoded;
+	CHECK(dict.size() == 1);
+	CHECK(dict["speed"].get_type() == Variant::FLOAT);
+	CHECK(double(dict["speed"]) == 3.0);
+
+	Dictionary invalid;
+	invalid["position"] = "not a vector";
+	ERR_PRINT_OFF;
+	CHECK(schema->encode(invalid, nullptr, len) != OK);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[VariantSchema] Truncated data") {
+	Ref<VariantSchema> schema = _make_schema();
+	Array value;
+	value.push_back(1);
+	value.push_back(false);
+	value.push_back("text");
+	value.push_back(Vector2());
+	value.push_back(Vector3i());
+	value.push_back(1.0);
+	value.push_back(Variant());
+
+	int len;
+	CHECK(schema->encode(value, nullptr, len) == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(schema->encode(value, buffer.ptrw(), len) == OK);
+
+	Variant decoded;
+	ERR_PRINT_OFF;
+	CHECK(schema->decode(decoded, buffer.ptr(), len - 1) != OK);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[VariantSchema] Math types keep their precision") {
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	schema->add_field("position", Variant::VECTOR3);
+	schema->add_field("rotation", Variant::QUATERNION);
+	schema->add_field("tint", Variant::COLOR);
+
+	// Not exactly representable in single precision.
+	const real_t component = 1.0 / 3.0 + 1e6;
+	Dictionary value;
+	value["position"] = Vector3(component, -component, 0.1);
+	value["rotation"] = Quaternion(component, 0, 0, 1);
+	value["tint"] = Color(0.1, 0.2, 0.3, 0.4);
+
+	int len;
+	CHECK(schema->encode(value, nullptr, len) == OK);
+	CHECK(len == 1 + 7 * (int)sizeof(real_t) + 4 * (int)sizeof(float));
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(schema->encode(value, buffer.ptrw(), len) == OK);
+
+	Variant decoded;
+	CHECK(schema->decode(decoded, buffer.ptr(), buffer.size()) == OK);
+	CHECK(Dictionary(decoded) == value);
+}
+
+TEST_CASE("[VariantSchema] Hash") {
+	Ref<VariantSchema> schema = _make_schema();
+	CHECK(schema->get_hash() == _make_schema()->get_hash());
+
+	// Same number of fields, but a different name or type.
+	Ref<VariantSchema> renamed;
+	renamed.instantiate();
+	renamed->add_field("health", Variant::INT);
+	renamed->add_field("alive", Variant::BOOL);
+	renamed->add_field("name", Variant::STRING);
+	renamed->add_field("offset", Variant::VECTOR2);
+	renamed->add_field("cell", Variant::VECTOR3I);
+	renamed->add_field("speed", Variant::FLOAT);
+	renamed->add_field("extra", Variant::NIL);
+	CHECK(renamed->get_field_count() == schema->get_field_count());
+	CHECK(renamed->get_hash() != schema->get_hash());
+
+	Ref<VariantSchema> retyped;
+	retyped.instantiate();
+	retyped->add_field("health", Variant::INT);
+	retyped->add_field("alive", Variant::BOOL);
+	retyped->add_field("name", Variant::STRING);
+	retyped->add_field("position", Variant::VECTOR2I);
+	retyped->add_field("cell", Variant::VECTOR3I);
+	retyped->add_field("speed", Variant::FLOAT);
+	retyped->add_field("extra", Variant::NIL);
+	CHECK(retyped->get_hash() != schema->get_hash());
+
+	Ref<VariantSchema> reordered;
+	reordered.instantiate();
+	reordered->add_field("alive", Variant::BOOL);
+	reordered->add_field("health", Variant::INT);
+	Ref<VariantSchema> ordered;
+	ordered.instantiate();
+	ordered->add_field("health", Variant::INT);
+	ordered->add_field("alive", Variant::BOOL);
+	CHECK(reordered->get_hash() != ordered->get_hash());
+}
+
+} // namespace TestVariantSchema
+
+#endif // TEST_VARIANT_SCHEMA_H
@@ -94,6 +94,31 @@ TEST_CASE("[LRU] Resize and clear") {
 	CHECK(!lru.has(3));
 	CHECK(!lru.has(4));
 }
+
+TEST_CASE("[LRU] Erase and evict") {
+	LRUCache<int, int> lru;
+
+	lru.set_capacity(4);
+	lru.insert(1, 10);
+	lru.insert(2, 20);
+	lru.insert(3, 30);
+	lru.get(1); // Makes <2> the least recently used entry.
+
+	CHECK(lru.erase(3));
+	CHECK(!lru.erase(3));
+	CHECK(!lru.has(3));
+	CHECK(lru.get_size() == 2);
+
+	int key = 0;
+	int data = 0;
+	CHECK(lru.evict_lru(&key, &data));
+	CHECK(key == 2);
+	CHECK(data == 20);
+	CHECK(lru.evict_lru());
+	CHECK(!lru.has(1));
+	CHECK(!lru.evict_lru());
+	CHECK(lru.get_size() == 0);
+}
 } // namespace TestLRU
 
 #endif // TEST_LRU_H
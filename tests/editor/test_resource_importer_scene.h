@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_resource_importer_scene.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RESOURCE_IMPORTER_SCENE_H
+#define TEST_RESOURCE_IMPORTER_SCENE_H
+
+#include "tests/test_macros.h"
+
+#ifdef TOOLS_ENABLED
+
+#include "editor/import/3d/resource_importer_scene.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/resources/animation_library.h"
+#include "scene/resources/material.h"
+
+namespace TestResourceImporterScene {
+
+static MeshInstance3D *_create_quad(const Ref<Material> &p_material, Mesh::ArrayType p_extra_array, const Vector3 &p_position) {
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 1, 0), Vector3(0, 1, 0) });
+	arrays[Mesh::ARRAY_INDEX] = PackedInt32Array({ 0, 1, 2, 0, 2, 3 });
+	if (p_extra_array == Mesh::ARRAY_TEX_UV2) {
+		arrays[Mesh::ARRAY_TEX_UV2] = PackedVector2Array({ Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) });
+	} else if (p_extra_array == Mesh::ARRAY_COLOR) {
+		arrays[Mesh::ARRAY_COLOR] = PackedColorArray({ Color(1, 0, 0), Color(0, 1, 0), Color(0, 0, 1), Color(1, 1, 1) });
+	}
+
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+	mesh->surface_set_material(0, p_material);
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(mesh);
+	mesh_instance->set_position(p_position);
+	return mesh_instance;
+}
+
+TEST_CASE("[SceneTree][ResourceImporterScene] HLOD proxy from meshes with different vertex formats") {
+	Ref<StandardMaterial3D> material;
+	material.instantiate();
+
+	Node3D *root = memnew(Node3D);
+	MeshInstance3D *with_uv2 = _create_quad(material, Mesh::ARRAY_TEX_UV2, Vector3());
+	root->add_child(with_uv2);
+	MeshInstance3D *with_color = _create_quad(material, Mesh::ARRAY_COLOR, Vector3(2, 0, 0));
+	root->add_child(with_color);
+
+	ResourceImporterScene::_generate_hlod_proxies(root, 100.0, 50.0, 1.0);
+	REQUIRE(root->get_child_count() == 3);
+	MeshInstance3D *proxy = Object::cast_to<MeshInstance3D>(root->get_child(2));
+	REQUIRE(proxy);
+	CHECK(proxy->get_visibility_range_begin() == doctest::Approx(50.0));
+	CHECK(with_uv2->get_visibility_parent() == with_uv2->get_path_to(proxy));
+	CHECK(with_color->get_visibility_parent() == with_color->get_path_to(proxy));
+
+	// Same material, but the formats differ, so each keeps its own surface and attributes.
+	Ref<Mesh> proxy_mesh = proxy->get_mesh();
+	REQUIRE(proxy_mesh.is_valid());
+	CHECK(proxy_mesh->get_surface_count() == 2);
+	int vertex_count = 0;
+	int uv2_surfaces = 0;
+	int color_surfaces = 0;
+	for (int i = 0; i < proxy_mesh->get_surface_count(); i++) {
+		CHECK(proxy_mesh->surface_get_material(i) == material);
+		Array arrays = proxy_mesh->surface_get_arrays(i);
+		vertex_count += PackedVector3Array(arrays[Mesh::ARRAY_VERTEX]).size();
+		const uint64_t format = proxy_mesh->surface_get_format(i);
+		uv2_surfaces += (format & Mesh::ARRAY_FORMAT_TEX_UV2) ? 1 : 0;
+		color_surfaces += (format & Mesh::ARRAY_FORMAT_COLOR) ? 1 : 0;
+		if (format & Mesh::ARRAY_FORMAT_COLOR) {
+			PackedColorArray colors = arrays[Mesh::ARRAY_COLOR];
+			REQUIRE(colors.size() == 4);
+			CHECK(colors[1].is_equal_approx(Color(0, 1, 0)));
+		}
+	}
+	CHECK(vertex_count == 8);
+	CHECK(uv2_surfaces == 1);
+	CHECK(color_surfaces == 1);
+	CHECK(proxy_mesh->get_aabb().is_equal_approx(AABB(Vector3(0, 0, 0), Vector3(3, 1, 0))));
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][ResourceImporterScene] HLOD proxy leaves out animated nodes") {
+	Ref<StandardMaterial3D> material;
+	material.instantiate();
+
+	Node3D *root = memnew(Node3D);
+	MeshInstance3D *static_a = _create_quad(material, Mesh::ARRAY_MAX, Vector3());
+	static_a->set_name("StaticA");
+	root->add_child(static_a);
+	MeshInstance3D *static_b = _create_quad(material, Mesh::ARRAY_MAX, Vector3(2, 0, 0));
+	root->add_child(static_b);
+
+	// A mesh under an animated node, and an animated mesh.
+	Node3D *door = memnew(Node3D);
+	door->set_name("Door");
+	root->add_child(door);
+	MeshInstance3D *door_mesh = _create_quad(material, Mesh::ARRAY_MAX, Vector3(1, 0, 0));
+	door->add_child(door_mesh);
+	MeshInstance3D *spinner = _create_quad(material, Mesh::ARRAY_MAX, Vector3(3, 0, 0));
+	spinner->set_name("Spinner");
+	root->add_child(spinner);
+
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(0, NodePath("Door"));
+	animation->position_track_insert_key(0, 0.0, Vector3(0, 1, 0));
+	animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(1, NodePath("Spinner:rotation"));
+	animation->track_insert_key(1, 0.0, Vector3(0, 1, 0));
+	// Method tracks don't move their target.
+	animation->add_track(Animation::TYPE_METHOD);
+	animation->track_set_path(2, NodePath("StaticA"));
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("open", animation);
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	root->add_child(player);
+	player->add_animation_library("", library);
+
+	ResourceImporterScene::_generate_hlod_proxies(root, 100.0, 50.0, 1.0);
+	REQUIRE(root->get_child_count() == 6);
+	MeshInstance3D *proxy = Object::cast_to<MeshInstance3D>(root->get_child(5));
+	REQUIRE(proxy);
+	CHECK(static_a->get_visibility_parent() == static_a->get_path_to(proxy));
+	CHECK(static_b->get_visibility_parent() == static_b->get_path_to(proxy));
+	CHECK(door_mesh->get_visibility_parent().is_empty());
+	CHECK(spinner->get_visibility_parent().is_empty());
+
+	// Only the static quads are baked into the proxy.
+	Ref<Mesh> proxy_mesh = proxy->get_mesh();
+	REQUIRE(proxy_mesh.is_valid());
+	int vertex_count = 0;
+	for (int i = 0; i < proxy_mesh->get_surface_count(); i++) {
+		vertex_count += PackedVector3Array(proxy_mesh->surface_get_arrays(i)[Mesh::ARRAY_VERTEX]).size();
+	}
+	CHECK(vertex_count == 8);
+	CHECK(proxy_mesh->get_aabb().is_equal_approx(AABB(Vector3(0, 0, 0), Vector3(3, 1, 0))));
+
+	memdelete(root);
+}
+
+} // namespace TestResourceImporterScene
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_RESOURCE_IMPORTER_SCENE_H
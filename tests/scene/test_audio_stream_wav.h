@@ -34,6 +34,7 @@
 #include "core/math/math_defs.h"
 #include "core/math/math_funcs.h"
 #include "scene/resources/audio_stream_wav.h"
+#include "servers/audio_server.h"
 
 #include "tests/test_macros.h"
 
@@ -240,6 +241,57 @@ TEST_CASE("[AudioStreamWAV] Saving IMA ADPCM is not supported") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[AudioStreamWAV] Skipping moves through loops like mixing") {
+	const float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+
+	for (const AudioStreamWAV::LoopMode loop_mode : { AudioStreamWAV::LOOP_FORWARD, AudioStreamWAV::LOOP_PINGPONG, AudioStreamWAV::LOOP_BACKWARD }) {
+		Ref<AudioStreamWAV> stream = memnew(AudioStreamWAV);
+		// Same rate as the server, so mixing moves exactly one frame at a time.
+		stream->set_mix_rate(mix_rate);
+		stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+		stream->set_data(gen_pcm16_test(mix_rate, 8000, false));
+		stream->set_loop_mode(loop_mode);
+		stream->set_loop_begin(1000);
+		stream->set_loop_end(5000);
+
+		Ref<AudioStreamPlayback> mixed = stream->instantiate_playback();
+		Ref<AudioStreamPlayback> skipped = stream->instantiate_playback();
+		mixed->start();
+		skipped->start();
+
+		AudioFrame buffer[512];
+		AudioFrame expected[512];
+		// Times with an exact number of frames, so both end up at the same offset.
+		for (const double time : { 0.25, 0.5, 1.75 }) {
+			int todo = time * mix_rate;
+			while (todo > 0) {
+				const int frames = MIN(todo, 512);
+				mixed->mix(expected, 1.0, frames);
+				todo -= frames;
+			}
+			CHECK(skipped->skip(time));
+
+			// Either can be right at a loop point it didn't wrap around yet, so compare what comes next.
+			mixed->mix(expected, 1.0, 512);
+			skipped->mix(buffer, 1.0, 512);
+			CHECK_MESSAGE(memcmp(buffer, expected, sizeof(buffer)) == 0, vformat("Skipping %f seconds should end where mixing does, with loop mode %d.", time, loop_mode));
+		}
+	}
+}
+
+TEST_CASE("[AudioStreamWAV] Skipping past the end stops playback") {
+	Ref<AudioStreamWAV> stream = memnew(AudioStreamWAV);
+	stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	stream->set_data(gen_pcm16_test(WAV_RATE, WAV_COUNT, false));
+
+	Ref<AudioStreamPlayback> playback = stream->instantiate_playback();
+	playback->start();
+	CHECK(playback->skip(0.5));
+	CHECK(playback->get_playback_position() == doctest::Approx(0.5).epsilon(0.001));
+	CHECK_FALSE(playback->skip(0.6));
+	CHECK_FALSE(playback->is_playing());
+}
+
 } // namespace TestAudioStreamWAV
 
 #endif // TEST_AUDIO_STREAM_WAV_H
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_font_file.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FONT_FILE_H
+#define TEST_FONT_FILE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "editor/themes/builtin_fonts.gen.h"
+#include "scene/resources/font.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestFontFile {
+
+static Ref<FontFile> _make_font() {
+	Ref<FontFile> font;
+	font.instantiate();
+	font->set_data_ptr(_font_NotoSans_Regular, _font_NotoSans_Regular_size);
+	return font;
+}
+
+static String _save_rendered_glyph_cache(const Ref<FontFile> &p_font, const Vector2i &p_size) {
+	p_font->render_range(0, p_size, 'A', 'z');
+	const String path = TestUtils::get_temp_path("font_file_test.glyphcache");
+	REQUIRE(p_font->save_glyph_cache(path) == OK);
+	return path;
+}
+
+TEST_CASE("[SceneTree][FontFile] Glyph cache restores rendered glyphs and textures") {
+	const Vector2i size = Vector2i(16, 0);
+	Ref<FontFile> rendered = _make_font();
+	const String path = _save_rendered_glyph_cache(rendered, size);
+
+	Ref<FontFile> loaded = _make_font();
+	CHECK(loaded->load_glyph_cache(path) == OK);
+
+	const PackedInt32Array glyphs = rendered->get_glyph_list(0, size);
+	REQUIRE(glyphs.size() > 0);
+	CHECK(loaded->get_glyph_list(0, size) == glyphs);
+
+	bool glyphs_match = true;
+	for (int32_t glyph : glyphs) {
+		glyphs_match = glyphs_match && loaded->get_glyph_uv_rect(0, size, glyph) == rendered->get_glyph_uv_rect(0, size, glyph);
+		glyphs_match = glyphs_match && loaded->get_glyph_texture_idx(0, size, glyph) == rendered->get_glyph_texture_idx(0, size, glyph);
+		glyphs_match = glyphs_match && loaded->get_glyph_size(0, size, glyph) == rendered->get_glyph_size(0, size, glyph);
+		glyphs_match = glyphs_match && loaded->get_glyph_offset(0, size, glyph) == rendered->get_glyph_offset(0, size, glyph);
+		glyphs_match = glyphs_match && loaded->get_glyph_advance(0, size.x, glyph) == rendered->get_glyph_advance(0, size.x, glyph);
+	}
+	CHECK_MESSAGE(glyphs_match, "Loaded glyphs should have the placement and metrics they were rendered with.");
+
+	REQUIRE(loaded->get_texture_count(0, size) == rendered->get_texture_count(0, size));
+	for (int i = 0; i < rendered->get_texture_count(0, size); i++) {
+		Ref<Image> expected = rendered->get_texture_image(0, size, i);
+		Ref<Image> image = loaded->get_texture_image(0, size, i);
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == expected->get_size());
+		CHECK(image->get_format() == expected->get_format());
+		CHECK(image->get_data() == expected->get_data());
+	}
+}
+
+TEST_CASE("[SceneTree][FontFile] Glyph cache for other settings leaves the font unchanged") {
+	const Vector2i size = Vector2i(16, 0);
+	const String path = _save_rendered_glyph_cache(_make_font(), size);
+
+	SUBCASE("Different rendering settings") {
+		Ref<FontFile> font = _make_font();
+		font->set_antialiasing(TextServer::FONT_ANTIALIASING_NONE);
+		CHECK(font->load_glyph_cache(path) == ERR_INVALID_DATA);
+		CHECK(font->get_cache_count() == 0);
+	}
+
+	SUBCASE("Different LCD subpixel layout") {
+		Ref<FontFile> lcd_font = _make_font();
+		lcd_font->set_antialiasing(TextServer::FONT_ANTIALIASING_LCD);
+		const Variant prev_layout = GLOBAL_GET("gui/theme/lcd_subpixel_layout");
+		ProjectSettings::get_singleton()->set_setting("gui/theme/lcd_subpixel_layout", TextServer::FONT_LCD_SUBPIXEL_LAYOUT_HRGB);
+		const String lcd_path = _save_rendered_glyph_cache(lcd_font, size);
+
+		ProjectSettings::get_singleton()->set_setting("gui/theme/lcd_subpixel_layout", TextServer::FONT_LCD_SUBPIXEL_LAYOUT_VBGR);
+		Ref<FontFile> font = _make_font();
+		font->set_antialiasing(TextServer::FONT_ANTIALIASING_LCD);
+		CHECK_MESSAGE(font->load_glyph_cache(lcd_path) == ERR_INVALID_DATA, "Glyphs rendered for another subpixel layout should not be loaded.");
+		CHECK(font->get_cache_count() == 0);
+
+		ProjectSettings::get_singleton()->set_setting("gui/theme/lcd_subpixel_layout", TextServer::FONT_LCD_SUBPIXEL_LAYOUT_HRGB);
+		CHECK(font->load_glyph_cache(lcd_path) == OK);
+		ProjectSettings::get_singleton()->set_setting("gui/theme/lcd_subpixel_layout", prev_layout);
+	}
+
+	SUBCASE("Different variation settings") {
+		Ref<FontFile> font = _make_font();
+		font->set_embolden(0, 0.5);
+		CHECK(font->load_glyph_cache(path) == ERR_INVALID_DATA);
+		CHECK(font->get_glyph_list(0, size).is_empty());
+		CHECK(font->get_embolden(0) == doctest::Approx(0.5));
+	}
+}
+
+TEST_CASE("[SceneTree][FontFile] Damaged glyph cache leaves the font unchanged") {
+	const Vector2i size = Vector2i(16, 0);
+	const String path = _save_rendered_glyph_cache(_make_font(), size);
+
+	// Keep the header, and truncate the data of a cache texture.
+	uint32_t header[3];
+	Dictionary entries;
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		for (uint32_t &E : header) {
+			E = f->get_32();
+		}
+		entries = f->get_var();
+	}
+	const String image_key = vformat("cache/0/%d/%d/textures/0/image", size.x, size.y);
+	REQUIRE(entries.has(image_key));
+	Dictionary image = entries[image_key];
+	PackedByteArray data = image["data"];
+	data.resize(data.size() / 2);
+	image["data"] = data;
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (uint32_t E : header) {
+			f->store_32(E);
+		}
+		f->store_var(entries);
+	}
+
+	Ref<FontFile> font = _make_font();
+	font->render_range(0, size, 'a', 'c');
+	const PackedInt32Array glyphs = font->get_glyph_list(0, size);
+
+	ERR_PRINT_OFF;
+	CHECK(font->load_glyph_cache(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(font->get_glyph_list(0, size) == glyphs);
+}
+
+} // namespace TestFontFile
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_FONT_FILE_H
@@ -33,7 +33,13 @@
 
 #include "scene/resources/packed_scene.h"
 
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestPackedScene {
 
@@ -215,6 +221,257 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_create_plan_test_scene() {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	scene->set_position(Vector2(10, 20));
+
+	Node2D *child1 = memnew(Node2D);
+	child1->set_name("Child1");
+	child1->set_rotation(0.5);
+	child1->set_z_index(3);
+	child1->add_to_group("pickups", true);
+	scene->add_child(child1);
+	child1->set_owner(scene);
+	child1->set_unique_name_in_owner(true);
+
+	Node *child2 = memnew(Node);
+	child2->set_name("Child2");
+	child2->set_meta("value", 42);
+	child1->add_child(child2);
+	child2->set_owner(scene);
+
+	child1->connect("renamed", Callable(child2, "set_name").bind("Renamed"), Object::CONNECT_PERSIST);
+
+	return scene;
+}
+
+static void _check_plan_test_instance(Node *p_instance) {
+	REQUIRE(p_instance != nullptr);
+	CHECK(p_instance->get_name() == "TestScene");
+	CHECK(Object::cast_to<Node2D>(p_instance)->get_position() == Vector2(10, 20));
+
+	Node2D *child1 = Object::cast_to<Node2D>(p_instance->get_node_or_null(NodePath("%Child1")));
+	REQUIRE(child1 != nullptr);
+	CHECK(child1->get_owner() == p_instance);
+	CHECK(child1->get_rotation() == doctest::Approx(0.5));
+	CHECK(child1->get_z_index() == 3);
+	CHECK(child1->is_in_group("pickups"));
+
+	REQUIRE(child1->get_child_count() == 1);
+	Node *child2 = child1->get_child(0);
+	CHECK(child2->get_name() == "Child2");
+	CHECK(child2->get_owner() == p_instance);
+	CHECK(int(child2->get_meta("value")) == 42);
+
+	List<Object::Connection> connections;
+	child1->get_signal_connection_list("renamed", &connections);
+	REQUIRE(connections.size() == 1);
+	CHECK(connections.front()->get().callable.get_object() == child2);
+	CHECK((connections.front()->get().flags & Object::CONNECT_PERSIST) != 0);
+
+	child1->emit_signal("renamed");
+	CHECK(child2->get_name() == "Renamed");
+}
+
+TEST_CASE("[PackedScene] Instantiation plan matches generic instantiation") {
+	Node *scene = _create_plan_test_scene();
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	const bool using_plans = SceneState::is_using_instantiation_plans();
+
+	SUBCASE("Generic") {
+		SceneState::set_use_instantiation_plans(false);
+		Node *instance = packed_scene.instantiate();
+		_check_plan_test_instance(instance);
+		memdelete(instance);
+	}
+
+	SUBCASE("Plan") {
+		SceneState::set_use_instantiation_plans(true);
+		for (int i = 0; i < 2; i++) {
+			// First instantiation compiles the plan, second one reuses it.
+			Node *instance = packed_scene.instantiate();
+			_check_plan_test_instance(instance);
+			memdelete(instance);
+		}
+	}
+
+	SceneState::set_use_instantiation_plans(using_plans);
+}
+
+// Saves a scene whose root references an external resource, and releases both so they are no longer cached.
+static void _save_scene_with_dependency(const String &p_scene_path, const String &p_dependency_path) {
+	Ref<Resource> dependency;
+	dependency.instantiate();
+	dependency->set_name("Dependency");
+	CHECK(ResourceSaver::save(dependency, p_dependency_path) == OK);
+	dependency = ResourceLoader::load(p_dependency_path, "", ResourceFormatLoader::CACHE_MODE_REPLACE);
+	REQUIRE(dependency.is_valid());
+
+	Node *scene = memnew(Node);
+	scene->set_name("Root");
+	scene->set_meta("dependency", dependency);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+	CHECK(ResourceSaver::save(packed_scene, p_scene_path) == OK);
+}
+
+TEST_CASE("[PackedScene] Prefetching a scene warms the resource cache") {
+	const String scene_path = TestUtils::get_temp_path("prefetch_scene.tscn");
+	const String dependency_path = TestUtils::get_temp_path("prefetch_dependency.tres");
+	_save_scene_with_dependency(scene_path, dependency_path);
+	REQUIRE_FALSE(ResourceCache::has(scene_path));
+	REQUIRE_FALSE(ResourceCache::has(dependency_path));
+
+	const uint64_t expected_usage = FileAccess::get_file_as_bytes(scene_path).size() + FileAccess::get_file_as_bytes(dependency_path).size();
+	CHECK(ResourceLoader::prefetch({ scene_path }) == OK);
+
+	// The batch runs on the WorkerThreadPool, both files are accounted for once it is done.
+	const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (ResourceLoader::get_prefetch_memory_usage() < expected_usage && OS::get_singleton()->get_ticks_msec() < timeout) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(ResourceLoader::get_prefetch_memory_usage() == expected_usage);
+	CHECK(ResourceCache::has(scene_path));
+	CHECK(ResourceCache::has(dependency_path));
+
+	// Loading now reuses the cached resources.
+	Ref<PackedScene> loaded = ResourceLoader::load(scene_path);
+	CHECK(loaded == ResourceCache::get_ref(scene_path));
+
+	loaded.unref();
+	ResourceLoader::clear_prefetched();
+	CHECK(ResourceLoader::get_prefetch_memory_usage() == 0);
+	CHECK_FALSE(ResourceCache::has(scene_path));
+	CHECK_FALSE(ResourceCache::has(dependency_path));
+}
+
+TEST_CASE("[PackedScene] Retention cache keeps loaded dependencies within budget") {
+	const String scene_path = TestUtils::get_temp_path("retained_scene.tscn");
+	const String dependency_path = TestUtils::get_temp_path("retained_dependency.tres");
+	_save_scene_with_dependency(scene_path, dependency_path);
+	const uint64_t scene_size = FileAccess::get_file_as_bytes(scene_path).size();
+	const uint64_t dependency_size = FileAccess::get_file_as_bytes(dependency_path).size();
+
+	const uint64_t old_budget = ResourceCache::get_retention_budget();
+	ResourceCache::clear_retained();
+	ResourceCache::set_retention_budget(1 << 20);
+
+	// The dependency is loaded as an external resource of the scene, it is retained too.
+	Ref<PackedScene> scene = ResourceLoader::load(scene_path);
+	REQUIRE(scene.is_valid());
+	CHECK(ResourceCache::get_retained_count() == 2);
+	// Both are in use, so none of them is charged.
+	CHECK(ResourceCache::get_retained_memory_usage() == 0);
+
+	scene.unref();
+	CHECK(ResourceCache::has(scene_path));
+	// The dependency is still referenced by the scene.
+	CHECK(ResourceCache::get_retained_memory_usage() == scene_size);
+
+	// The scene alone fits, nothing is evicted.
+	ResourceCache::set_retention_budget(scene_size);
+	CHECK(ResourceCache::get_retained_count() == 2);
+
+	// Evicting the scene releases its reference to the dependency, which becomes idle.
+	ResourceCache::set_retention_budget(1);
+	CHECK(ResourceCache::get_retained_count() == 1);
+	CHECK_FALSE(ResourceCache::has(scene_path));
+	CHECK(ResourceCache::has(dependency_path));
+	CHECK(ResourceCache::get_retained_memory_usage() == dependency_size);
+
+	ResourceCache::set_retention_budget(1);
+	CHECK(ResourceCache::get_retained_count() == 0);
+	CHECK_FALSE(ResourceCache::has(dependency_path));
+
+	ResourceCache::set_retention_budget(old_budget);
+}
+
+TEST_CASE("[PackedScene] Prefetch and retention caches don't keep each other's resources alive") {
+	const String scene_path = TestUtils::get_temp_path("prefetch_retained_scene.tscn");
+	const String dependency_path = TestUtils::get_temp_path("prefetch_retained_dependency.tres");
+	_save_scene_with_dependency(scene_path, dependency_path);
+	const uint64_t scene_size = FileAccess::get_file_as_bytes(scene_path).size();
+	const uint64_t dependency_size = FileAccess::get_file_as_bytes(dependency_path).size();
+
+	const uint64_t old_retention_budget = ResourceCache::get_retention_budget();
+	const uint64_t old_prefetch_budget = ResourceLoader::get_prefetch_memory_budget();
+	ResourceCache::clear_retained();
+	ResourceCache::set_retention_budget(1 << 20);
+	ResourceLoader::set_prefetch_memory_budget(1 << 20);
+
+	CHECK(ResourceLoader::prefetch({ scene_path }) == OK);
+	const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (ResourceLoader::get_prefetch_memory_usage() < scene_size + dependency_size && OS::get_singleton()->get_ticks_msec() < timeout) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE(ResourceLoader::get_prefetch_memory_usage() == scene_size + dependency_size);
+
+	// Both caches hold the scene, and nothing else does, so it counts as idle.
+	CHECK(ResourceCache::get_retained_count() == 2);
+	CHECK(ResourceCache::get_retained_memory_usage() == scene_size);
+
+	// The prefetch cache releases the scene although it is retained. The dependency is still used by the scene.
+	ResourceLoader::set_prefetch_memory_budget(0);
+	CHECK(ResourceLoader::get_prefetch_memory_usage() == dependency_size);
+	CHECK(ResourceCache::has(scene_path));
+
+	// The retention cache releases the scene too, leaving the dependency to both caches.
+	ResourceCache::set_retention_budget(1);
+	CHECK_FALSE(ResourceCache::has(scene_path));
+	CHECK(ResourceCache::get_retained_count() == 1);
+	CHECK(ResourceCache::get_retained_memory_usage() == dependency_size);
+
+	// Once the prefetch cache lets go, the retention cache evicts it right away, as it is over budget.
+	ResourceLoader::set_prefetch_memory_budget(0);
+	CHECK(ResourceLoader::get_prefetch_memory_usage() == 0);
+	CHECK(ResourceCache::get_retained_count() == 0);
+	CHECK_FALSE(ResourceCache::has(dependency_path));
+
+	ResourceLoader::clear_prefetched();
+	ResourceLoader::set_prefetch_memory_budget(old_prefetch_budget);
+	ResourceCache::set_retention_budget(old_retention_budget);
+}
+
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[PackedScene][Benchmark] Instantiation plan" * doctest::skip()) {
+	Node *scene = _create_plan_test_scene();
+	for (int i = 0; i < 16; i++) {
+		Node2D *node = memnew(Node2D);
+		node->set_name(vformat("Extra%d", i));
+		node->set_position(Vector2(i, i));
+		node->set_scale(Vector2(2, 2));
+		node->set_visible(false);
+		scene->add_child(node);
+		node->set_owner(scene);
+	}
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	const bool using_plans = SceneState::is_using_instantiation_plans();
+	const int iterations = 2000;
+	uint64_t usec[2];
+
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_use_instantiation_plans(pass == 1);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			memdelete(packed_scene.instantiate());
+		}
+		usec[pass] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	SceneState::set_use_instantiation_plans(using_plans);
+
+	MESSAGE(vformat("Generic: %.2f usec per instance, plan: %.2f usec per instance.", double(usec[0]) / iterations, double(usec[1]) / iterations));
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_rich_text_label.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RICH_TEXT_LABEL_H
+#define TEST_RICH_TEXT_LABEL_H
+
+#include "scene/gui/rich_text_label.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRichTextLabel {
+
+static const char *paragraph_text = "The quick brown fox jumps over the lazy dog, then runs back to the forest.";
+
+// Identical paragraphs are laid out with the same height, so they must be evenly spaced.
+static bool _paragraphs_evenly_spaced(RichTextLabel *p_rtl) {
+	const float height = p_rtl->get_paragraph_offset(1);
+	if (height <= 0) {
+		return false;
+	}
+	for (int i = 2; i < p_rtl->get_paragraph_count(); i++) {
+		if (Math::abs(p_rtl->get_paragraph_offset(i) - height * i) > 0.01 * i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static RichTextLabel *_make_label(int p_paragraphs, const Size2 &p_size, bool p_scroll_active) {
+	RichTextLabel *rtl = memnew(RichTextLabel);
+	SceneTree::get_singleton()->get_root()->add_child(rtl);
+	rtl->set_scroll_active(p_scroll_active);
+	rtl->set_size(p_size);
+
+	PackedStringArray paragraphs;
+	for (int i = 0; i < p_paragraphs; i++) {
+		paragraphs.push_back(paragraph_text);
+	}
+	rtl->add_text(String("\n").join(paragraphs));
+	return rtl;
+}
+
+TEST_CASE("[SceneTree][RichTextLabel] Paragraphs shaped in batches are laid out in order") {
+	// Enough paragraphs for the small batches filling the visible area and several full batches after them.
+	const int paragraph_count = 200;
+
+	RichTextLabel *reference = _make_label(1, Size2(300, 200), false);
+	const int lines_per_paragraph = reference->get_line_count();
+	REQUIRE(lines_per_paragraph > 1);
+
+	RichTextLabel *rtl = _make_label(paragraph_count, Size2(300, 200), false);
+	CHECK(rtl->get_paragraph_count() == paragraph_count);
+	CHECK(rtl->get_line_count() == paragraph_count * lines_per_paragraph);
+	CHECK(_paragraphs_evenly_spaced(rtl));
+	CHECK(rtl->get_total_character_count() == paragraph_count * reference->get_total_character_count());
+
+	SUBCASE("Changing the width breaks the paragraphs again") {
+		rtl->set_size(Size2(120, 200));
+		reference->set_size(Size2(120, 200));
+		const int narrow_lines_per_paragraph = reference->get_line_count();
+		REQUIRE(narrow_lines_per_paragraph > lines_per_paragraph);
+
+		CHECK(rtl->get_line_count() == paragraph_count * narrow_lines_per_paragraph);
+		CHECK(_paragraphs_evenly_spaced(rtl));
+		CHECK(rtl->get_content_width() <= 120);
+	}
+
+	SUBCASE("Appending a paragraph keeps the previous layout") {
+		const float last_offset = rtl->get_paragraph_offset(paragraph_count - 1);
+		rtl->add_text(String("\n") + paragraph_text);
+		CHECK(rtl->get_line_count() == (paragraph_count + 1) * lines_per_paragraph);
+		CHECK(rtl->get_paragraph_offset(paragraph_count - 1) == last_offset);
+		CHECK(_paragraphs_evenly_spaced(rtl));
+	}
+
+	memdelete(rtl);
+	memdelete(reference);
+}
+
+TEST_CASE("[SceneTree][RichTextLabel] Paragraphs are laid out again when the scroll bar appears during a batch") {
+	// The scroll bar appears once the text outgrows the height, in the middle of the first batches.
+	RichTextLabel *rtl = _make_label(200, Size2(300, 100), true);
+	CHECK(rtl->get_v_scroll_bar()->is_visible());
+	CHECK(_paragraphs_evenly_spaced(rtl));
+	CHECK(rtl->get_content_width() <= 300 - rtl->get_v_scroll_bar()->get_combined_minimum_size().width);
+
+	memdelete(rtl);
+}
+
+} // namespace TestRichTextLabel
+
+#endif // TEST_RICH_TEXT_LABEL_H
@@ -35,6 +35,38 @@
 
 #include "tests/test_macros.h"
 
+class TestTextEditInternalsAccessor {
+public:
+	static bool is_line_shaped(const TextEdit *p_text_edit, int p_line) {
+		return p_text_edit->text.is_shaped(p_line);
+	}
+	static int get_shaped_line_count(const TextEdit *p_text_edit) {
+		return p_text_edit->text.get_shaped_count();
+	}
+	static void free_shaped_lines(TextEdit *p_text_edit, int p_keep_from, int p_keep_to) {
+		p_text_edit->text.free_shaped_lines(p_keep_from, p_keep_to);
+	}
+	static Vector2i get_prefetch_window(const TextEdit *p_text_edit) {
+		return Vector2i(p_text_edit->prefetch_from, p_text_edit->prefetch_to);
+	}
+	static int get_prefetch_batch_size(const TextEdit *p_text_edit) {
+		return p_text_edit->PREFETCH_LINES_PER_FRAME;
+	}
+	static int get_max_shaped_lines(const TextEdit *p_text_edit) {
+		return p_text_edit->MAX_SHAPED_LINES;
+	}
+	// Runs the prefetch until the queued window is done, as the idle frames would.
+	static void prefetch_lines(TextEdit *p_text_edit) {
+		int frames = 0;
+		while (p_text_edit->is_processing_internal() && frames++ < 1000) {
+			p_text_edit->_prefetch_lines();
+		}
+	}
+	static void prefetch_lines_once(TextEdit *p_text_edit) {
+		p_text_edit->_prefetch_lines();
+	}
+};
+
 namespace TestTextEdit {
 static inline Array build_array() {
 	return Array();
@@ -8065,6 +8097,245 @@ TEST_CASE("[SceneTree][TextEdit] gutters") {
 	memdelete(text_edit);
 }
 
+TEST_CASE("[SceneTree][TextEdit] syntax highlighting") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+
+	Ref<CodeHighlighter> highlighter;
+	highlighter.instantiate();
+	highlighter->add_color_region("/*", "*/", Color(1, 0, 0));
+	text_edit->set_syntax_highlighter(highlighter);
+
+	text_edit->set_text("a\nb\nc");
+	for (int i = 0; i < text_edit->get_line_count(); i++) {
+		CHECK_FALSE(((Dictionary)highlighter->get_line_syntax_highlighting(i).get(0, Dictionary())).get("color", Color()) == Color(1, 0, 0));
+	}
+
+	SUBCASE("[TextEdit] region opened above the highlighted line") {
+		text_edit->set_line(0, "/* a");
+		// Highlight the last line first, the region state of the lines above must be recomputed.
+		Dictionary color_map = highlighter->get_line_syntax_highlighting(2);
+		CHECK(((Dictionary)color_map[0])["color"] == Color(1, 0, 0));
+		color_map = highlighter->get_line_syntax_highlighting(1);
+		CHECK(((Dictionary)color_map[0])["color"] == Color(1, 0, 0));
+	}
+
+	SUBCASE("[TextEdit] region closed above the highlighted line") {
+		text_edit->set_line(0, "/* a");
+		CHECK(((Dictionary)highlighter->get_line_syntax_highlighting(2)[0])["color"] == Color(1, 0, 0));
+
+		text_edit->set_line(1, "b */");
+		Dictionary color_map = highlighter->get_line_syntax_highlighting(2);
+		CHECK_FALSE(((Dictionary)color_map.get(0, Dictionary())).get("color", Color()) == Color(1, 0, 0));
+	}
+
+	SUBCASE("[TextEdit] unwrapped lines") {
+		text_edit->set_text("first line\n\tsecond line\nthird");
+		for (int i = 0; i < text_edit->get_line_count(); i++) {
+			CHECK(text_edit->get_line_wrap_count(i) == 0);
+			CHECK(text_edit->get_line_wrapped_text(i).size() == 1);
+			CHECK(text_edit->get_line_width(i) > 0);
+		}
+		CHECK(text_edit->get_line_width(0) > text_edit->get_line_width(2));
+	}
+
+	memdelete(text_edit);
+}
+
+static inline String build_lines(int p_count) {
+	String text;
+	for (int i = 0; i < p_count; i++) {
+		if (i > 0) {
+			text += "\n";
+		}
+		text += "line " + String("x").repeat(i % 20 + 1);
+	}
+	return text;
+}
+
+class LineRecordingHighlighter : public SyntaxHighlighter {
+public:
+	HashSet<int> highlighted_lines;
+
+	virtual Dictionary _get_line_syntax_highlighting_impl(int p_line) override {
+		highlighted_lines.insert(p_line);
+		return Dictionary();
+	}
+};
+
+TEST_CASE("[SceneTree][TextEdit] lazy line shaping") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+	text_edit->set_size(Size2(200, 200));
+
+	text_edit->set_text(build_lines(1000));
+	MessageQueue::get_singleton()->flush();
+
+	const int visible_rows = text_edit->get_visible_line_count() + 1;
+	Vector2i window = TestTextEditInternalsAccessor::get_prefetch_window(text_edit);
+
+	SUBCASE("[TextEdit] only visible lines are shaped when drawn") {
+		for (int i = 0; i < text_edit->get_visible_line_count(); i++) {
+			CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, i));
+		}
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) <= visible_rows + 1);
+
+		// One screen above and below is queued for the prefetch.
+		CHECK(window.x == 0);
+		CHECK(window.y >= visible_rows);
+		CHECK(window.y < 3 * visible_rows);
+		CHECK(text_edit->is_processing_internal());
+
+		bool shaped_outside = false;
+		for (int i = window.y + 1; i < text_edit->get_line_count(); i++) {
+			shaped_outside = shaped_outside || TestTextEditInternalsAccessor::is_line_shaped(text_edit, i);
+		}
+		CHECK_FALSE(shaped_outside);
+
+		text_edit->set_line_as_first_visible(500);
+		MessageQueue::get_singleton()->flush();
+
+		window = TestTextEditInternalsAccessor::get_prefetch_window(text_edit);
+		CHECK(window.x == 500 - visible_rows);
+		CHECK(window.y < 500 + 3 * visible_rows);
+		CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 500));
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.x));
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y));
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y + 1));
+	}
+
+	SUBCASE("[TextEdit] prefetch shapes the margin a batch at a time") {
+		const int batch_size = TestTextEditInternalsAccessor::get_prefetch_batch_size(text_edit);
+		int shaped = TestTextEditInternalsAccessor::get_shaped_line_count(text_edit);
+
+		TestTextEditInternalsAccessor::prefetch_lines_once(text_edit);
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) > shaped);
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) <= shaped + batch_size);
+
+		TestTextEditInternalsAccessor::prefetch_lines(text_edit);
+		CHECK_FALSE(text_edit->is_processing_internal());
+		for (int i = window.x; i <= window.y; i++) {
+			CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, i));
+		}
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y + 1));
+
+		// An edit in the margin queues the finished window again.
+		text_edit->set_line(window.y, "changed");
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y));
+		MessageQueue::get_singleton()->flush();
+		CHECK(text_edit->is_processing_internal());
+
+		TestTextEditInternalsAccessor::prefetch_lines(text_edit);
+		CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y));
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y + 1));
+	}
+
+	SUBCASE("[TextEdit] prefetch highlights the margin") {
+		Ref<LineRecordingHighlighter> highlighter = memnew(LineRecordingHighlighter);
+		text_edit->set_syntax_highlighter(highlighter);
+		MessageQueue::get_singleton()->flush();
+
+		window = TestTextEditInternalsAccessor::get_prefetch_window(text_edit);
+		TestTextEditInternalsAccessor::prefetch_lines(text_edit);
+		for (int i = window.x; i <= window.y; i++) {
+			CHECK(highlighter->highlighted_lines.has(i));
+		}
+		CHECK_FALSE(highlighter->highlighted_lines.has(window.y + 1));
+	}
+
+	memdelete(text_edit);
+}
+
+TEST_CASE("[SceneTree][TextEdit] released shaped lines") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+	text_edit->set_size(Size2(200, 200));
+
+	text_edit->set_text(build_lines(200));
+	Vector<int> widths;
+	for (int i = 0; i < text_edit->get_line_count(); i++) {
+		widths.push_back(text_edit->get_line_width(i));
+	}
+	CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) == text_edit->get_line_count());
+
+	TestTextEditInternalsAccessor::free_shaped_lines(text_edit, 10, 19);
+	CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) == 10);
+	CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 15));
+	CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 100));
+
+	SUBCASE("[TextEdit] released lines keep their layout") {
+		CHECK(text_edit->get_line_wrap_count(100) == 0);
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 100));
+
+		for (int i = 0; i < text_edit->get_line_count(); i++) {
+			CHECK(text_edit->get_line_width(i) == widths[i]);
+		}
+		CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 100));
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) == text_edit->get_line_count());
+	}
+
+	SUBCASE("[TextEdit] released lines are reshaped from their new text") {
+		text_edit->set_line(100, "a line that is much longer than any of the other lines");
+		text_edit->insert_text("inserted ", 101, 0);
+		text_edit->set_line(102, "");
+
+		TextEdit *expected = memnew(TextEdit);
+		SceneTree::get_singleton()->get_root()->add_child(expected);
+		expected->set_size(Size2(200, 200));
+		expected->set_text(text_edit->get_text());
+
+		CHECK(text_edit->get_line_width(100) > widths[100]);
+		for (int i = 99; i <= 103; i++) {
+			CHECK(text_edit->get_line_width(i) == expected->get_line_width(i));
+			CHECK(text_edit->get_line_wrap_count(i) == expected->get_line_wrap_count(i));
+		}
+
+		// Released lines pick up the wrap settings when shaped again.
+		TestTextEditInternalsAccessor::free_shaped_lines(text_edit, 10, 19);
+		text_edit->set_line_wrapping_mode(TextEdit::LineWrappingMode::LINE_WRAPPING_BOUNDARY);
+		expected->set_line_wrapping_mode(TextEdit::LineWrappingMode::LINE_WRAPPING_BOUNDARY);
+
+		CHECK(text_edit->get_line_wrap_count(100) > 0);
+		for (int i = 99; i <= 103; i++) {
+			CHECK(text_edit->get_line_width(i) == expected->get_line_width(i));
+			CHECK(text_edit->get_line_wrap_count(i) == expected->get_line_wrap_count(i));
+		}
+
+		memdelete(expected);
+	}
+
+	SUBCASE("[TextEdit] undo reshapes a released line") {
+		text_edit->set_line(100, "changed");
+		TestTextEditInternalsAccessor::free_shaped_lines(text_edit, 10, 19);
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, 100));
+
+		text_edit->undo();
+		CHECK(text_edit->get_line(100) == "line " + String("x").repeat(100 % 20 + 1));
+		CHECK(text_edit->get_line_width(100) == widths[100]);
+		CHECK(text_edit->get_line_wrap_count(100) == 0);
+	}
+
+	SUBCASE("[TextEdit] prefetch releases lines outside the window") {
+		const int max_shaped = TestTextEditInternalsAccessor::get_max_shaped_lines(text_edit);
+		text_edit->set_text(build_lines(max_shaped + 100));
+		for (int i = 0; i < text_edit->get_line_count(); i++) {
+			text_edit->get_line_width(i);
+		}
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) > max_shaped);
+
+		MessageQueue::get_singleton()->flush();
+		Vector2i window = TestTextEditInternalsAccessor::get_prefetch_window(text_edit);
+		TestTextEditInternalsAccessor::prefetch_lines(text_edit);
+
+		CHECK(TestTextEditInternalsAccessor::get_shaped_line_count(text_edit) == window.y - window.x + 1);
+		CHECK(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y));
+		CHECK_FALSE(TestTextEditInternalsAccessor::is_line_shaped(text_edit, window.y + 1));
+		CHECK(text_edit->get_line_width(max_shaped) == widths[max_shaped % 200]);
+	}
+
+	memdelete(text_edit);
+}
+
 } // namespace TestTextEdit
 
 #endif // TEST_TEXT_EDIT_H
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_audio_command_ring.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_COMMAND_RING_H
+#define TEST_AUDIO_COMMAND_RING_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "servers/audio/audio_command_ring.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_stream.h"
+#include "servers/audio_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioCommandRing {
+
+struct TestCommand {
+	uint32_t producer = 0;
+	uint32_t sequence = 0;
+};
+
+TEST_CASE("[AudioCommandRing] Commands are popped in the order they were pushed") {
+	AudioCommandRing<TestCommand> ring;
+	ring.init(6);
+
+	TestCommand command;
+	CHECK_FALSE(ring.pop(command));
+
+	// Go around the ring several times.
+	uint32_t next_push = 0;
+	uint32_t next_pop = 0;
+	bool in_order = true;
+	for (int round = 0; round < 20; round++) {
+		while (true) {
+			command.sequence = next_push;
+			if (!ring.push(command)) {
+				break;
+			}
+			next_push++;
+		}
+		CHECK_MESSAGE(next_push - next_pop == 8, "The size should be rounded up to a power of two.");
+
+		const int to_pop = round % 8 + 1;
+		for (int i = 0; i < to_pop; i++) {
+			REQUIRE(ring.pop(command));
+			in_order = in_order && command.sequence == next_pop;
+			next_pop++;
+		}
+	}
+	CHECK(in_order);
+	CHECK(ring.get_push_position() == next_push);
+	CHECK(ring.get_pop_position() == next_pop);
+}
+
+struct ProducerData {
+	AudioCommandRing<TestCommand> *ring = nullptr;
+	uint32_t producer = 0;
+	uint32_t count = 0;
+};
+
+static void _producer(void *p_userdata) {
+	ProducerData *data = static_cast<ProducerData *>(p_userdata);
+	TestCommand command;
+	command.producer = data->producer;
+	for (uint32_t i = 0; i < data->count; i++) {
+		command.sequence = i;
+		while (!data->ring->push(command)) {
+			// Full, let the consumer catch up.
+			OS::get_singleton()->yield();
+		}
+	}
+}
+
+TEST_CASE("[AudioCommandRing] Commands from several threads all arrive in order") {
+	const uint32_t producer_count = 4;
+	const uint32_t count = 50000;
+
+	AudioCommandRing<TestCommand> ring;
+	ring.init(64);
+
+	ProducerData data[producer_count];
+	Thread threads[producer_count];
+	for (uint32_t i = 0; i < producer_count; i++) {
+		data[i].ring = &ring;
+		data[i].producer = i;
+		data[i].count = count;
+		threads[i].start(&_producer, &data[i]);
+	}
+
+	uint32_t next_sequence[producer_count] = {};
+	uint32_t received = 0;
+	bool in_order = true;
+	TestCommand command;
+	while (received < producer_count * count) {
+		if (ring.pop(command)) {
+			in_order = in_order && command.producer < producer_count && command.sequence == next_sequence[command.producer];
+			next_sequence[command.producer]++;
+			received++;
+		} else {
+			OS::get_singleton()->yield();
+		}
+	}
+
+	for (uint32_t i = 0; i < producer_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK_MESSAGE(in_order, "Commands of each producer should be popped in the order they were pushed.");
+	CHECK_FALSE(ring.pop(command));
+}
+
+TEST_CASE("[Audio][AudioServer] Bus parameters can be read back before they are mixed") {
+	AudioServer *server = AudioServer::get_singleton();
+	server->set_bus_volume_db(0, -6.0);
+	server->set_bus_mute(0, true);
+	server->set_bus_bypass_effects(0, true);
+	CHECK(server->get_bus_volume_db(0) == doctest::Approx(-6.0));
+	CHECK(server->is_bus_mute(0));
+	CHECK(server->is_bus_bypassing_effects(0));
+
+	server->set_bus_volume_db(0, 0.0);
+	server->set_bus_mute(0, false);
+	server->set_bus_bypass_effects(0, false);
+}
+
+class ConstantPlayback : public AudioStreamPlayback {
+public:
+	virtual bool is_playing() const override { return true; }
+
+	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override {
+		for (int i = 0; i < p_frames; i++) {
+			p_buffer[i] = AudioFrame(0.5, 0.5);
+		}
+		return p_frames;
+	}
+};
+
+TEST_CASE("[Audio][AudioServer] Playbacks keep mixing to their buses when the buses change") {
+	AudioServer *server = AudioServer::get_singleton();
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	driver->finish();
+	driver->set_use_threads(false);
+	driver->init();
+	driver->start();
+
+	Vector<int32_t> output;
+	output.resize(4410 * driver->get_channels());
+
+	server->set_bus_count(3);
+	server->set_bus_name(1, "A");
+	server->set_bus_name(2, "B");
+
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	volumes.fill(AudioFrame(1, 1));
+	Ref<ConstantPlayback> playback;
+	playback.instantiate();
+	server->start_playback_stream(playback, SNAME("B"), volumes);
+
+	driver->mix_audio(4410, output.ptrw());
+	CHECK(server->get_bus_peak_volume_left_db(2, 0) > -10.0);
+	CHECK(server->get_bus_peak_volume_left_db(1, 0) < -100.0);
+
+	server->move_bus(2, 1);
+	REQUIRE(server->get_bus_name(1) == "B");
+	driver->mix_audio(4410, output.ptrw());
+	CHECK_MESSAGE(server->get_bus_peak_volume_left_db(1, 0) > -10.0, "The playback should follow its bus to its new index.");
+	CHECK_MESSAGE(server->get_bus_peak_volume_left_db(2, 0) < -100.0, "The bus now at the old index should get nothing.");
+
+	// Inserting a bus before it moves it again, volumes set afterwards still go to it.
+	server->add_bus(1);
+	server->set_playback_all_bus_volumes_linear(playback, volumes);
+	driver->mix_audio(4410, output.ptrw());
+	REQUIRE(server->get_bus_name(2) == "B");
+	CHECK(server->get_bus_peak_volume_left_db(2, 0) > -10.0);
+	CHECK(server->get_bus_peak_volume_left_db(1, 0) < -100.0);
+
+	server->stop_playback_stream(playback);
+	driver->mix_audio(4410, output.ptrw());
+	server->set_bus_count(1);
+
+	driver->finish();
+	driver->set_use_threads(true);
+	driver->init();
+	driver->start();
+}
+
+} // namespace TestAudioCommandRing
+
+#endif // TEST_AUDIO_COMMAND_RING_H
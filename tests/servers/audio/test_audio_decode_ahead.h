@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  test_audio_decode_ahead.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_DECODE_AHEAD_H
+#define TEST_AUDIO_DECODE_AHEAD_H
+
+#include "servers/audio/audio_decode_ahead.h"
+#include "servers/audio/audio_stream.h"
+#include "servers/audio_server.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioDecodeAhead {
+
+// Decodes a ramp, so every frame tells where it was decoded from.
+class RampPlayback : public AudioStreamPlaybackResampled {
+public:
+	int length = 20000;
+	int position = 0;
+	bool active = false;
+	SafeNumeric<uint32_t> chunks_decoded_on_thread;
+
+	// Keeps the decode thread busy in the middle of a chunk, with the decoder locked.
+	SafeFlag hold_decode_thread;
+	SafeFlag decode_thread_held;
+
+	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) override {
+		if (!Thread::is_main_thread()) {
+			chunks_decoded_on_thread.increment();
+			while (hold_decode_thread.is_set()) {
+				decode_thread_held.set();
+				OS::get_singleton()->delay_usec(100);
+			}
+		}
+		int mixed = 0;
+		while (active && mixed < p_frames) {
+			if (position >= length) {
+				active = false;
+				break;
+			}
+			p_buffer[mixed++] = AudioFrame(position, -position);
+			position++;
+		}
+		for (int i = mixed; i < p_frames; i++) {
+			p_buffer[i] = AudioFrame(0, 0);
+		}
+		return mixed;
+	}
+
+	virtual float get_stream_sampling_rate() override { return AudioServer::get_singleton()->get_mix_rate(); }
+	virtual double _get_decoder_position() const override { return position / AudioServer::get_singleton()->get_mix_rate(); }
+
+	virtual void _decoder_start(double p_from_pos) override {
+		active = true;
+		position = p_from_pos * AudioServer::get_singleton()->get_mix_rate();
+		begin_resample();
+	}
+
+	virtual void _decoder_stop() override { active = false; }
+	virtual void _decoder_seek(double p_time) override { position = p_time * AudioServer::get_singleton()->get_mix_rate(); }
+
+	virtual void start(double p_from_pos) override { _request_decoder(DECODER_REQUEST_START, p_from_pos); }
+	virtual void stop() override { _request_decoder(DECODER_REQUEST_STOP); }
+	virtual void seek(double p_time) override { _request_decoder(DECODER_REQUEST_SEEK, p_time); }
+
+	virtual bool is_playing() const override { return active || _has_decoded_frames() || _has_decoder_requests(); }
+	virtual double get_playback_position() const override { return _is_decoding_ahead() ? _get_decoded_position() : _get_decoder_position(); }
+
+	void enable_decode_ahead() { _enable_decode_ahead(); }
+	bool is_decoding_ahead() const { return _is_decoding_ahead(); }
+	bool has_decoded_frames() const { return _has_decoded_frames(); }
+	bool has_decoder_requests() const { return _has_decoder_requests(); }
+
+	~RampPlayback() {
+		_disable_decode_ahead();
+	}
+};
+
+// Runs the decode thread for the duration of a test, it is disabled by default.
+struct DecodeAheadEnabled {
+	DecodeAheadEnabled() {
+		AudioDecodeAhead::get_singleton()->finish();
+		AudioDecodeAhead::get_singleton()->init(0.05);
+	}
+
+	~DecodeAheadEnabled() {
+		AudioDecodeAhead::get_singleton()->finish();
+		AudioDecodeAhead::get_singleton()->init(0.0);
+	}
+};
+
+static bool _frames_equal(const Vector<AudioFrame> &p_a, const Vector<AudioFrame> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		if (p_a[i].left != p_b[i].left || p_a[i].right != p_b[i].right) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Mixes in steps small enough to need at most one chunk each, after waiting for the
+// decode thread to get ahead, so no step falls back to decoding in the mix.
+static Vector<AudioFrame> _mix(RampPlayback *p_playback, int p_frames, bool p_wait_for_decode) {
+	const int step = 64;
+	Vector<AudioFrame> output;
+	output.resize(p_frames);
+	for (int offset = 0; offset < p_frames; offset += step) {
+		if (p_wait_for_decode) {
+			const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+			while (p_playback->active && !p_playback->has_decoded_frames() && OS::get_singleton()->get_ticks_msec() < timeout) {
+				OS::get_singleton()->delay_usec(100);
+			}
+		}
+		p_playback->mix(output.ptrw() + offset, 1.0, MIN(step, p_frames - offset));
+	}
+	return output;
+}
+
+TEST_CASE("[Audio][DecodeAhead] Frames decoded ahead match frames decoded while mixing") {
+	DecodeAheadEnabled enabled;
+
+	Ref<RampPlayback> reference;
+	reference.instantiate();
+	reference->start(0.0);
+
+	Ref<RampPlayback> playback;
+	playback.instantiate();
+	playback->enable_decode_ahead();
+	REQUIRE(playback->is_decoding_ahead());
+	playback->start(0.0);
+
+	CHECK(_frames_equal(_mix(playback.ptr(), 5000, true), _mix(reference.ptr(), 5000, false)));
+	CHECK_MESSAGE(playback->chunks_decoded_on_thread.get() > 0, "The decode thread should have decoded chunks.");
+	CHECK(playback->get_playback_position() == reference->get_playback_position());
+
+	// Seeking drops what was decoded ahead.
+	playback->seek(0.1);
+	reference->seek(0.1);
+	CHECK(playback->get_playback_position() == doctest::Approx(0.1));
+	CHECK(_frames_equal(_mix(playback.ptr(), 5000, true), _mix(reference.ptr(), 5000, false)));
+
+	// Playing until the end.
+	const int remaining = reference->length - reference->position + 1000;
+	CHECK(_frames_equal(_mix(playback.ptr(), remaining, true), _mix(reference.ptr(), remaining, false)));
+	CHECK_FALSE(playback->is_playing());
+}
+
+TEST_CASE("[Audio][DecodeAhead] Stopping drops the frames decoded ahead") {
+	DecodeAheadEnabled enabled;
+
+	Ref<RampPlayback> playback;
+	playback.instantiate();
+	playback->enable_decode_ahead();
+	playback->start(0.0);
+	_mix(playback.ptr(), 512, true);
+
+	playback->stop();
+	CHECK_FALSE(playback->has_decoded_frames());
+	CHECK_FALSE(playback->is_playing());
+
+	AudioFrame frames[256];
+	CHECK(playback->mix(frames, 1.0, 256) < 256);
+}
+
+static bool _wait_for(const SafeFlag &p_flag, bool p_value) {
+	const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (p_flag.is_set() != p_value && OS::get_singleton()->get_ticks_msec() < timeout) {
+		OS::get_singleton()->delay_usec(100);
+	}
+	return p_flag.is_set() == p_value;
+}
+
+struct SeekFromThread {
+	RampPlayback *playback = nullptr;
+	SafeFlag done;
+
+	static void seek(void *p_userdata) {
+		SeekFromThread *self = static_cast<SeekFromThread *>(p_userdata);
+		self->playback->seek(0.1);
+		self->done.set();
+	}
+};
+
+TEST_CASE("[Audio][DecodeAhead] Seeking from the audio thread never waits for the decode thread") {
+	DecodeAheadEnabled enabled;
+
+	Ref<RampPlayback> reference;
+	reference.instantiate();
+	reference->start(0.0);
+	_mix(reference.ptr(), 512, false);
+	_mix(reference.ptr(), 512, false);
+	reference->seek(0.1);
+
+	Ref<RampPlayback> playback;
+	playback.instantiate();
+	playback->enable_decode_ahead();
+	playback->start(0.0);
+	_mix(playback.ptr(), 512, true);
+
+	// Mixing makes room in the ring, the decode thread then stops in the middle of the next chunk.
+	playback->hold_decode_thread.set();
+	_mix(playback.ptr(), 512, false);
+	REQUIRE(_wait_for(playback->decode_thread_held, true));
+
+	SeekFromThread seek_from_thread;
+	seek_from_thread.playback = playback.ptr();
+	Thread thread;
+	thread.start(&SeekFromThread::seek, &seek_from_thread);
+	CHECK_MESSAGE(_wait_for(seek_from_thread.done, true), "Seeking should not wait for the decode thread to release the decoder.");
+	CHECK(playback->has_decoder_requests());
+
+	playback->hold_decode_thread.clear();
+	thread.wait_to_finish();
+
+	// The seek is applied by the mix once the decode thread is done with its chunk.
+	AudioFrame frame;
+	const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (playback->has_decoder_requests() && OS::get_singleton()->get_ticks_msec() < timeout) {
+		playback->mix(&frame, 1.0, 0);
+		OS::get_singleton()->delay_usec(100);
+	}
+	REQUIRE_FALSE(playback->has_decoder_requests());
+	CHECK(playback->get_playback_position() == doctest::Approx(0.1));
+	CHECK(_frames_equal(_mix(playback.ptr(), 5000, true), _mix(reference.ptr(), 5000, false)));
+}
+
+TEST_CASE("[Audio][DecodeAhead] Playbacks decode while mixing when decoding ahead is disabled") {
+	Ref<RampPlayback> playback;
+	playback.instantiate();
+	playback->enable_decode_ahead();
+	CHECK_FALSE(playback->is_decoding_ahead());
+}
+
+} // namespace TestAudioDecodeAhead
+
+#endif // TEST_AUDIO_DECODE_AHEAD_H
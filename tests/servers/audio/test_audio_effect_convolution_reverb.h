@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  test_audio_effect_convolution_reverb.h                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_EFFECT_CONVOLUTION_REVERB_H
+#define TEST_AUDIO_EFFECT_CONVOLUTION_REVERB_H
+
+#include "servers/audio/audio_fft.h"
+#include "servers/audio/effects/audio_effect_convolution_reverb.h"
+#include "servers/audio_server.h"
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioEffectConvolutionReverb {
+
+class ImpulsePlayback : public AudioStreamPlayback {
+public:
+	Vector<AudioFrame> frames;
+	int position = 0;
+
+	virtual void start(double p_from_pos) override { position = 0; }
+	virtual bool is_playing() const override { return position < frames.size(); }
+
+	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override {
+		const int mixed = MIN(p_frames, frames.size() - position);
+		for (int i = 0; i < mixed; i++) {
+			p_buffer[i] = frames[position + i];
+		}
+		position += mixed;
+		return mixed;
+	}
+};
+
+class ImpulseStream : public AudioStream {
+public:
+	Vector<AudioFrame> frames;
+
+	virtual Ref<AudioStreamPlayback> instantiate_playback() override {
+		Ref<ImpulsePlayback> playback;
+		playback.instantiate();
+		playback->frames = frames;
+		return playback;
+	}
+
+	virtual double get_length() const override { return frames.size() / AudioServer::get_singleton()->get_mix_rate(); }
+};
+
+static Vector<AudioFrame> _random_frames(int p_count, float p_decay_frames, uint64_t p_seed) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(p_seed);
+
+	Vector<AudioFrame> frames;
+	frames.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const float gain = p_decay_frames > 0 ? Math::exp(-i / p_decay_frames) : 1.0;
+		frames.write[i] = AudioFrame(rng->randf_range(-1, 1) * gain, rng->randf_range(-1, 1) * gain);
+	}
+	return frames;
+}
+
+static Ref<AudioEffectConvolutionReverb> _make_reverb(const Vector<AudioFrame> &p_impulse, AudioEffectConvolutionReverb::PartitionSize p_size) {
+	Ref<ImpulseStream> stream;
+	stream.instantiate();
+	stream->frames = p_impulse;
+
+	Ref<AudioEffectConvolutionReverb> reverb;
+	reverb.instantiate();
+	reverb->set_partition_size(p_size);
+	reverb->set_impulse(stream);
+	reverb->wait_for_impulse();
+	return reverb;
+}
+
+TEST_CASE("[AudioFFT] Forward transform matches a direct DFT and the inverse undoes it") {
+	const int size = 64;
+	const Vector<AudioFrame> signal = _random_frames(size, 0, 1);
+
+	Vector<float> buffer;
+	buffer.resize(size * 2);
+	for (int i = 0; i < size; i++) {
+		buffer.write[i * 2 + 0] = signal[i].left;
+		buffer.write[i * 2 + 1] = signal[i].right;
+	}
+	AudioFFT::transform(buffer.ptrw(), size, AudioFFT::FORWARD);
+
+	float max_error = 0.0;
+	for (int k = 0; k < size; k++) {
+		double real = 0.0;
+		double imag = 0.0;
+		for (int n = 0; n < size; n++) {
+			const double angle = -Math_TAU * k * n / size;
+			real += signal[n].left * Math::cos(angle) - signal[n].right * Math::sin(angle);
+			imag += signal[n].left * Math::sin(angle) + signal[n].right * Math::cos(angle);
+		}
+		max_error = MAX(max_error, Math::abs(buffer[k * 2 + 0] - real) + Math::abs(buffer[k * 2 + 1] - imag));
+	}
+	CHECK_MESSAGE(max_error < 1e-4, "The forward transform should match a direct DFT.");
+
+	AudioFFT::transform(buffer.ptrw(), size, AudioFFT::INVERSE);
+	max_error = 0.0;
+	for (int i = 0; i < size; i++) {
+		max_error = MAX(max_error, Math::abs(buffer[i * 2 + 0] / size - signal[i].left) + Math::abs(buffer[i * 2 + 1] / size - signal[i].right));
+	}
+	CHECK_MESSAGE(max_error < 1e-5, "The inverse transform should restore the signal.");
+}
+
+TEST_CASE("[Audio][AudioEffectConvolutionReverb] Output matches direct convolution delayed by one partition") {
+	const Vector<AudioFrame> impulse = _random_frames(1500, 300, 2);
+	const Vector<AudioFrame> input = _random_frames(6000, 0, 3);
+
+	for (int size = 0; size < AudioEffectConvolutionReverb::PARTITION_SIZE_MAX; size++) {
+		Ref<AudioEffectConvolutionReverb> reverb = _make_reverb(impulse, AudioEffectConvolutionReverb::PartitionSize(size));
+		reverb->set_dry(0.25);
+		reverb->set_wet(1.0);
+		const int partition_size = 256 << size;
+
+		// Odd block sizes so partitions straddle process() calls.
+		Ref<AudioEffectInstance> instance = reverb->instantiate();
+		Vector<AudioFrame> output;
+		output.resize(input.size());
+		for (int offset = 0; offset < input.size(); offset += 333) {
+			instance->process(input.ptr() + offset, output.ptrw() + offset, MIN(333, input.size() - offset));
+		}
+
+		float max_error = 0.0;
+		for (int i = 0; i < input.size(); i++) {
+			AudioFrame expected = input[i] * 0.25;
+			for (int j = 0; j < impulse.size() && j <= i - partition_size; j++) {
+				const AudioFrame &x = input[i - partition_size - j];
+				expected.left += impulse[j].left * x.left;
+				expected.right += impulse[j].right * x.right;
+			}
+			max_error = MAX(max_error, Math::abs(output[i].left - expected.left) + Math::abs(output[i].right - expected.right));
+		}
+		CHECK_MESSAGE(max_error < 1e-3, vformat("Convolution with %d frame partitions should match direct convolution.", partition_size));
+	}
+}
+
+TEST_CASE("[Audio][AudioEffectConvolutionReverb] Existing instances pick up a new impulse response") {
+	Ref<AudioEffectConvolutionReverb> reverb = _make_reverb(_random_frames(300, 60, 5), AudioEffectConvolutionReverb::PARTITION_SIZE_256);
+	Ref<AudioEffectInstance> instance = reverb->instantiate();
+
+	const Vector<AudioFrame> input = _random_frames(4096, 0, 6);
+	Vector<AudioFrame> output;
+	output.resize(input.size());
+	instance->process(input.ptr(), output.ptrw(), input.size());
+
+	// A longer impulse with larger partitions needs new buffers for the instance.
+	Ref<ImpulseStream> stream;
+	stream.instantiate();
+	stream->frames = _random_frames(3000, 600, 7);
+	reverb->set_partition_size(AudioEffectConvolutionReverb::PARTITION_SIZE_1024);
+	reverb->set_impulse(stream);
+	reverb->wait_for_impulse();
+
+	Vector<AudioFrame> expected;
+	expected.resize(input.size());
+	reverb->instantiate()->process(input.ptr(), expected.ptrw(), input.size());
+	instance->process(input.ptr(), output.ptrw(), input.size());
+
+	bool matches = true;
+	for (int i = 0; i < input.size(); i++) {
+		matches = matches && output[i].left == expected[i].left && output[i].right == expected[i].right;
+	}
+	CHECK_MESSAGE(matches, "An existing instance should process like a new one once the new impulse response is ready.");
+}
+
+TEST_CASE("[Audio][AudioEffectConvolutionReverb] Only the dry signal passes without an impulse response") {
+	Ref<AudioEffectConvolutionReverb> reverb;
+	reverb.instantiate();
+	reverb->set_dry(0.5);
+
+	const Vector<AudioFrame> input = _random_frames(512, 0, 4);
+	Vector<AudioFrame> output;
+	output.resize(input.size());
+	reverb->instantiate()->process(input.ptr(), output.ptrw(), input.size());
+
+	bool matches = true;
+	for (int i = 0; i < input.size(); i++) {
+		matches = matches && output[i].left == input[i].left * 0.5f && output[i].right == input[i].right * 0.5f;
+	}
+	CHECK(matches);
+}
+
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[Audio][AudioEffectConvolutionReverb][Benchmark] CPU cost per second of impulse response" * doctest::skip()) {
+	const float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+	const int impulse_seconds = 2;
+	const int audio_seconds = 10;
+	const Vector<AudioFrame> impulse = _random_frames(impulse_seconds * mix_rate, mix_rate / 2, 5);
+	const Vector<AudioFrame> input = _random_frames(512, 0, 6);
+	Vector<AudioFrame> output;
+	output.resize(input.size());
+
+	for (int size = 0; size < AudioEffectConvolutionReverb::PARTITION_SIZE_MAX; size++) {
+		Ref<AudioEffectConvolutionReverb> reverb = _make_reverb(impulse, AudioEffectConvolutionReverb::PartitionSize(size));
+		Ref<AudioEffectInstance> instance = reverb->instantiate();
+
+		const int blocks = audio_seconds * mix_rate / input.size();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < blocks; i++) {
+			instance->process(input.ptr(), output.ptrw(), input.size());
+		}
+		const double elapsed = (OS::get_singleton()->get_ticks_usec() - begin) / 1000000.0;
+
+		MESSAGE(vformat("%d frame partitions: %.2f ms of CPU per second of audio per second of impulse response (%.2f%% of one core).",
+				256 << size, elapsed * 1000.0 / audio_seconds / impulse_seconds, elapsed * 100.0 / audio_seconds / impulse_seconds));
+	}
+}
+
+} // namespace TestAudioEffectConvolutionReverb
+
+#endif // TEST_AUDIO_EFFECT_CONVOLUTION_REVERB_H
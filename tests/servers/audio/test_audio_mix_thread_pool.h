@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  test_audio_mix_thread_pool.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_MIX_THREAD_POOL_H
+#define TEST_AUDIO_MIX_THREAD_POOL_H
+
+#include "servers/audio/audio_mix_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+#include <atomic>
+
+namespace TestAudioMixThreadPool {
+
+struct JobData {
+	std::atomic<uint32_t> calls[1024];
+	float results[1024];
+	uint32_t multiplier = 1;
+};
+
+static void _job(void *p_userdata, uint32_t p_index) {
+	JobData *data = static_cast<JobData *>(p_userdata);
+	data->calls[p_index].fetch_add(1);
+	data->results[p_index] = Math::sin(float(p_index * data->multiplier));
+}
+
+TEST_CASE("[AudioMixThreadPool] Every index is processed exactly once") {
+	for (const int thread_count : { 0, 1, 3 }) {
+		AudioMixThreadPool pool;
+		pool.init(thread_count);
+
+		JobData *data = memnew(JobData);
+
+		for (uint32_t run = 0; run < 64; run++) {
+			// Vary the item count so runs with fewer items than threads are covered too.
+			const uint32_t count = (run * 37) % 1024 + 1;
+			data->multiplier = run + 1;
+			for (uint32_t i = 0; i < count; i++) {
+				data->calls[i].store(0);
+			}
+
+			pool.run(&_job, data, count);
+
+			bool all_once = true;
+			bool all_match = true;
+			for (uint32_t i = 0; i < count; i++) {
+				all_once = all_once && data->calls[i].load() == 1;
+				all_match = all_match && data->results[i] == Math::sin(float(i * (run + 1)));
+			}
+			CHECK_MESSAGE(all_once, vformat("Every item should run once with %d threads.", thread_count));
+			CHECK_MESSAGE(all_match, vformat("Every item should see the userdata of its own run with %d threads.", thread_count));
+		}
+
+		memdelete(data);
+		pool.finish();
+		CHECK(pool.get_thread_count() == 0);
+	}
+}
+
+} // namespace TestAudioMixThreadPool
+
+#endif // TEST_AUDIO_MIX_THREAD_POOL_H
@@ -0,0 +1,424 @@
+/**************************************************************************/
+/*  test_audio_mixing.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_MIXING_H
+#define TEST_AUDIO_MIXING_H
+
+#include "core/config/project_settings.h"
+#include "scene/resources/audio_stream_wav.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/effects/audio_effect_amplify.h"
+#include "servers/audio/effects/audio_effect_capture.h"
+#include "servers/audio/effects/audio_effect_compressor.h"
+#include "servers/audio/effects/audio_effect_filter.h"
+#include "servers/audio/effects/audio_effect_reverb.h"
+#include "servers/audio/audio_stream.h"
+#include "servers/audio_server.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioMixing {
+
+static AudioFrame _test_signal(int p_frame) {
+	return AudioFrame(Math::sin(p_frame * 0.05f) * 0.8f, Math::cos(p_frame * 0.0311f) * 0.6f);
+}
+
+// Generates a fixed length signal, so the end of stream handling is covered too.
+class TestPlaybackResampled : public AudioStreamPlaybackResampled {
+public:
+	int length = 0;
+	int position = 0;
+	float sampling_rate = 22050;
+
+	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) override {
+		int mixed = 0;
+		for (int i = 0; i < p_frames; i++) {
+			if (position < length) {
+				p_buffer[i] = _test_signal(position++);
+				mixed++;
+			} else {
+				p_buffer[i] = AudioFrame(0, 0);
+			}
+		}
+		return mixed;
+	}
+
+	virtual float get_stream_sampling_rate() override { return sampling_rate; }
+	virtual void start(double p_from_pos = 0.0) override { begin_resample(); }
+};
+
+// The cubic resampler as it was written before the interpolation loop was split out, one frame at a time.
+class ReferenceResampler {
+	enum {
+		FP_BITS = 16,
+		FP_LEN = (1 << FP_BITS),
+		FP_MASK = FP_LEN - 1,
+		INTERNAL_BUFFER_LEN = 128,
+		CUBIC_INTERP_HISTORY = 4
+	};
+
+	AudioFrame internal_buffer[INTERNAL_BUFFER_LEN + CUBIC_INTERP_HISTORY];
+	unsigned int internal_buffer_end = -1;
+	uint64_t mix_offset = 0;
+	int length = 0;
+	int position = 0;
+
+	int _mix_internal(AudioFrame *p_buffer, int p_frames) {
+		int mixed = 0;
+		for (int i = 0; i < p_frames; i++) {
+			if (position < length) {
+				p_buffer[i] = _test_signal(position++);
+				mixed++;
+			} else {
+				p_buffer[i] = AudioFrame(0, 0);
+			}
+		}
+		return mixed;
+	}
+
+public:
+	explicit ReferenceResampler(int p_length) {
+		length = p_length;
+		for (int i = 0; i < 4; i++) {
+			internal_buffer[i] = AudioFrame(0.0, 0.0);
+		}
+		_mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+	}
+
+	int mix(AudioFrame *p_buffer, uint64_t p_mix_increment, int p_frames) {
+		int mixed_frames_total = -1;
+
+		int i;
+		for (i = 0; i < p_frames; i++) {
+			uint32_t idx = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
+			float mu = (mix_offset & FP_MASK) / float(FP_LEN);
+			AudioFrame y0 = internal_buffer[idx - 3];
+			AudioFrame y1 = internal_buffer[idx - 2];
+			AudioFrame y2 = internal_buffer[idx - 1];
+			AudioFrame y3 = internal_buffer[idx - 0];
+
+			if (idx >= internal_buffer_end && mixed_frames_total == -1) {
+				mixed_frames_total = i;
+			}
+
+			float mu2 = mu * mu;
+			AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
+			AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
+			AudioFrame a2 = y2 - y0;
+			AudioFrame a3 = 2 * y1;
+
+			p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+
+			mix_offset += p_mix_increment;
+
+			while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
+				internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
+				internal_buffer[1] = internal_buffer[INTERNAL_BUFFER_LEN + 1];
+				internal_buffer[2] = internal_buffer[INTERNAL_BUFFER_LEN + 2];
+				internal_buffer[3] = internal_buffer[INTERNAL_BUFFER_LEN + 3];
+				int mixed_frames = _mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+				if (mixed_frames != INTERNAL_BUFFER_LEN) {
+					internal_buffer_end = mixed_frames;
+				} else {
+					internal_buffer_end = -1;
+				}
+				mix_offset -= (INTERNAL_BUFFER_LEN << FP_BITS);
+			}
+		}
+		if (mixed_frames_total == -1 && i == p_frames) {
+			mixed_frames_total = p_frames;
+		}
+		return mixed_frames_total;
+	}
+};
+
+TEST_CASE("[Audio][Mixing] Resampled playback matches per-frame cubic interpolation") {
+	const float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+
+	for (const float sampling_rate : { 22050.0f, 44100.0f, 48000.0f, 96000.0f, 11025.0f }) {
+		for (const float rate_scale : { 1.0f, 0.37f, 1.9f }) {
+			Ref<TestPlaybackResampled> playback;
+			playback.instantiate();
+			playback->length = 5000;
+			playback->sampling_rate = sampling_rate;
+			playback->start();
+
+			ReferenceResampler reference(5000);
+			const uint64_t increment = uint64_t(((sampling_rate * rate_scale * AudioServer::get_singleton()->get_playback_speed_scale()) / double(mix_rate)) * double(1 << 16));
+
+			AudioFrame buffer[512];
+			AudioFrame expected[512];
+			bool matches = true;
+			bool counts_match = true;
+			for (int block = 0; block < 64; block++) {
+				// Odd sizes, so blocks end at every position relative to the internal buffer.
+				const int frames = 100 + (block * 67) % 412;
+				const int mixed = playback->mix(buffer, rate_scale, frames);
+				const int expected_mixed = reference.mix(expected, increment, frames);
+				counts_match = counts_match && mixed == expected_mixed;
+				matches = matches && memcmp(buffer, expected, sizeof(AudioFrame) * frames) == 0;
+			}
+			CHECK_MESSAGE(counts_match, vformat("Mixed frame counts should match at %f Hz, rate scale %f.", sampling_rate, rate_scale));
+			CHECK_MESSAGE(matches, vformat("Resampled frames should be identical at %f Hz, rate scale %f.", sampling_rate, rate_scale));
+		}
+	}
+}
+
+static Vector<AudioFrame> _volumes(float p_volume) {
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	for (int i = 0; i < volumes.size(); i++) {
+		volumes.write[i] = AudioFrame(p_volume, p_volume);
+	}
+	return volumes;
+}
+
+class TestSignalPlayback : public AudioStreamPlayback {
+public:
+	int position = 0;
+
+	virtual bool is_playing() const override { return true; }
+
+	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override {
+		for (int i = 0; i < p_frames; i++) {
+			p_buffer[i] = _test_signal(position++);
+		}
+		return p_frames;
+	}
+};
+
+// Restarts the server with the given number of mixing threads, builds a bus graph with sends,
+// a sidechain and an effect shared by two buses, and mixes it from the test.
+static void _mix_with_threads(int p_threads, Vector<int32_t> &r_output, PackedVector2Array &r_captured) {
+	AudioServer *server = AudioServer::get_singleton();
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+
+	ProjectSettings::get_singleton()->set_setting("audio/general/mixing_threads", p_threads);
+	server->finish();
+	driver->set_use_threads(false);
+	driver->init();
+	server->init();
+
+	server->set_bus_count(7);
+	for (int i = 1; i < 7; i++) {
+		server->set_bus_name(i, vformat("Bus%d", i));
+	}
+	// Two chains feeding the master, plus a bus only used as a sidechain.
+	server->set_bus_send(1, "Bus3");
+	server->set_bus_send(2, "Bus3");
+	server->set_bus_send(4, "Bus5");
+	server->set_bus_send(6, "Master");
+
+	Ref<AudioEffectAmplify> amplify;
+	amplify.instantiate();
+	amplify->set_volume_db(-3.0);
+	server->add_bus_effect(1, amplify);
+
+	Ref<AudioEffectLowPassFilter> filter;
+	filter.instantiate();
+	filter->set_cutoff(2000.0);
+	server->add_bus_effect(2, filter);
+
+	Ref<AudioEffectReverb> reverb;
+	reverb.instantiate();
+	server->add_bus_effect(3, reverb);
+
+	Ref<AudioEffectCompressor> compressor;
+	compressor.instantiate();
+	compressor->set_threshold(-20.0);
+	compressor->set_sidechain("Bus6");
+	server->add_bus_effect(5, compressor);
+
+	Ref<AudioEffectCapture> capture;
+	capture.instantiate();
+	capture->set_buffer_length(1.0);
+	server->add_bus_effect(2, capture);
+	server->add_bus_effect(4, capture);
+
+	Vector<Ref<TestSignalPlayback>> playbacks;
+	for (int i = 1; i < 7; i++) {
+		Ref<TestSignalPlayback> playback;
+		playback.instantiate();
+		playback->position = i * 1000;
+		server->start_playback_stream(playback, server->get_bus_name(i), _volumes(0.5));
+		playbacks.push_back(playback);
+	}
+
+	const int frames = 0.25 * driver->get_mix_rate();
+	r_output.resize(frames * driver->get_channels());
+	driver->mix_audio(frames, r_output.ptrw());
+	r_captured = capture->get_buffer(capture->get_frames_available());
+
+	for (const Ref<TestSignalPlayback> &playback : playbacks) {
+		server->stop_playback_stream(playback);
+	}
+}
+
+TEST_CASE("[Audio][Mixing] Output does not depend on the number of mixing threads") {
+	AudioServer *server = AudioServer::get_singleton();
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+
+	Vector<int32_t> single_output;
+	PackedVector2Array single_captured;
+	_mix_with_threads(0, single_output, single_captured);
+
+	Vector<int32_t> threaded_output;
+	PackedVector2Array threaded_captured;
+	_mix_with_threads(3, threaded_output, threaded_captured);
+
+	ProjectSettings::get_singleton()->set_setting("audio/general/mixing_threads", 0);
+	server->finish();
+	driver->set_use_threads(true);
+	driver->init();
+	server->init();
+
+	REQUIRE(single_output.size() == threaded_output.size());
+	CHECK_MESSAGE(memcmp(single_output.ptr(), threaded_output.ptr(), sizeof(int32_t) * single_output.size()) == 0, "Mixed output should be bit identical with and without mixing threads.");
+	CHECK_MESSAGE(single_captured.size() > 0, "The shared capture effect should have received frames.");
+	CHECK_MESSAGE(single_captured == threaded_captured, "Frames captured from two buses should arrive in the same order.");
+}
+
+TEST_CASE("[Audio][Mixing] Stereo filter processing matches per-sample processing") {
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::HIGHSHELF);
+	filter.set_sampling_rate(44100);
+	filter.set_cutoff(3000);
+	filter.set_resonance(1);
+	filter.set_stages(1);
+	filter.set_gain(0.5);
+
+	AudioFilterSW::Processor left;
+	AudioFilterSW::Processor right;
+	AudioFilterSW::Processor reference_left;
+	AudioFilterSW::Processor reference_right;
+	for (AudioFilterSW::Processor *processor : { &left, &right, &reference_left, &reference_right }) {
+		processor->set_filter(&filter);
+	}
+
+	AudioFrame frames[300];
+	AudioFrame expected[300];
+	bool matches = true;
+	for (int block = 0; block < 8; block++) {
+		// Move the cutoff every block, so coefficient interpolation is exercised.
+		filter.set_cutoff(1000 + block * 700);
+		for (AudioFilterSW::Processor *processor : { &left, &right, &reference_left, &reference_right }) {
+			processor->update_coeffs(300);
+		}
+
+		for (int i = 0; i < 300; i++) {
+			frames[i] = _test_signal(block * 300 + i);
+			expected[i] = frames[i];
+			reference_left.process_one_interp(expected[i].left);
+			reference_right.process_one_interp(expected[i].right);
+		}
+		AudioFilterSW::Processor::process_stereo(&left, &right, frames, 300, true);
+
+		matches = matches && memcmp(frames, expected, sizeof(frames)) == 0;
+	}
+	CHECK_MESSAGE(matches, "Filtered frames should be identical.");
+}
+
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[Audio][Mixing][Benchmark] Voices per core" * doctest::skip()) {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	REQUIRE(driver);
+
+	// Drive the dummy driver from here instead of its own thread.
+	driver->finish();
+	driver->set_use_threads(false);
+	driver->init();
+	driver->start();
+
+	const int mix_rate = driver->get_mix_rate();
+	const int source_rate = 22050;
+
+	// One second of looping stereo 16-bit noise, at a rate that needs resampling.
+	Vector<uint8_t> data;
+	data.resize(source_rate * 4);
+	uint32_t seed = 1234;
+	for (int i = 0; i < data.size(); i++) {
+		seed = seed * 1664525u + 1013904223u;
+		data.write[i] = seed >> 24;
+	}
+	Ref<AudioStreamWAV> wav;
+	wav.instantiate();
+	wav->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	wav->set_stereo(true);
+	wav->set_mix_rate(source_rate);
+	wav->set_data(data);
+	wav->set_loop_mode(AudioStreamWAV::LOOP_FORWARD);
+	wav->set_loop_end(source_rate);
+
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	for (int i = 0; i < volumes.size(); i++) {
+		volumes.write[i] = AudioFrame(0.01, 0.01);
+	}
+
+	const int voice_count = 256;
+	Vector<Ref<AudioStreamPlayback>> playbacks;
+	for (int i = 0; i < voice_count; i++) {
+		Ref<AudioStreamPlayback> playback = wav->instantiate_playback();
+		HashMap<StringName, Vector<AudioFrame>> bus_volumes;
+		bus_volumes[SNAME("Master")] = volumes;
+		// Half of the voices go through the highshelf filter, like attenuated 3D voices do.
+		AudioServer::get_singleton()->start_playback_stream(playback, bus_volumes, 0, 1.0 + (i % 7) * 0.01, i % 2 ? 0.5 : 0.0, 5000);
+		playbacks.push_back(playback);
+	}
+
+	const int seconds = 10;
+	Vector<int32_t> output;
+	output.resize(mix_rate * driver->get_channels());
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < seconds; i++) {
+		driver->mix_audio(mix_rate, output.ptrw());
+	}
+	const double elapsed = (OS::get_singleton()->get_ticks_usec() - begin) / 1000000.0;
+
+	MESSAGE(vformat("Mixed %d voices for %d s of audio in %.3f s: %.1f voices per core.", voice_count, seconds, elapsed, voice_count * seconds / elapsed));
+
+	for (const Ref<AudioStreamPlayback> &playback : playbacks) {
+		AudioServer::get_singleton()->stop_playback_stream(playback);
+	}
+	driver->mix_audio(mix_rate / 10, output.ptrw());
+
+	driver->finish();
+	driver->set_use_threads(true);
+	driver->init();
+	driver->start();
+}
+
+} // namespace TestAudioMixing
+
+#endif // TEST_AUDIO_MIXING_H
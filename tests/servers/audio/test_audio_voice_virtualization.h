@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_audio_voice_virtualization.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_VOICE_VIRTUALIZATION_H
+#define TEST_AUDIO_VOICE_VIRTUALIZATION_H
+
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_stream.h"
+#include "servers/audio_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioVoiceVirtualization {
+
+class CountingPlayback : public AudioStreamPlayback {
+public:
+	int mixed_frames = 0;
+	double skipped_time = 0.0;
+	double length = 1000.0;
+
+	virtual bool is_playing() const override { return skipped_time < length; }
+
+	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override {
+		for (int i = 0; i < p_frames; i++) {
+			p_buffer[i] = AudioFrame(0.5, 0.5);
+		}
+		mixed_frames += p_frames;
+		return p_frames;
+	}
+
+	virtual bool skip(double p_time) override {
+		skipped_time += p_time;
+		return is_playing();
+	}
+};
+
+static Vector<AudioFrame> _volumes(float p_volume) {
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	for (int i = 0; i < volumes.size(); i++) {
+		volumes.write[i] = AudioFrame(p_volume, p_volume);
+	}
+	return volumes;
+}
+
+// Mixes from the test instead of the dummy driver's thread, so every step is deterministic.
+struct ManualMixing {
+	AudioDriverDummy *driver = AudioDriverDummy::get_dummy_singleton();
+	Vector<int32_t> output;
+
+	ManualMixing() {
+		driver->finish();
+		driver->set_use_threads(false);
+		driver->init();
+		driver->start();
+	}
+
+	void mix(double p_seconds) {
+		const int frames = p_seconds * driver->get_mix_rate();
+		output.resize(frames * driver->get_channels());
+		driver->mix_audio(frames, output.ptrw());
+	}
+
+	~ManualMixing() {
+		AudioServer::get_singleton()->set_voice_budget(0);
+		mix(0.1);
+		driver->finish();
+		driver->set_use_threads(true);
+		driver->init();
+		driver->start();
+	}
+};
+
+TEST_CASE("[Audio][VoiceVirtualization] Inaudible voices are skipped instead of mixed") {
+	ManualMixing mixing;
+	AudioServer *server = AudioServer::get_singleton();
+
+	Ref<CountingPlayback> playback;
+	playback.instantiate();
+	server->start_playback_stream(playback, SNAME("Master"), _volumes(0.0));
+	server->set_playback_voice_priority(playback, 0);
+
+	mixing.mix(0.1);
+	CHECK(server->is_playback_virtual(playback));
+	const int mixed_frames = playback->mixed_frames;
+
+	mixing.mix(1.0);
+	CHECK_MESSAGE(playback->mixed_frames == mixed_frames, "Virtual voices should not be mixed.");
+	CHECK_MESSAGE(playback->skipped_time > 0.5, "Virtual voices should keep advancing.");
+
+	server->set_playback_all_bus_volumes_linear(playback, _volumes(1.0));
+	mixing.mix(0.1);
+	CHECK_FALSE(server->is_playback_virtual(playback));
+	CHECK_MESSAGE(playback->mixed_frames > mixed_frames, "Audible voices should be mixed again.");
+	CHECK_MESSAGE(playback->skipped_time == doctest::Approx(1.1).epsilon(0.05), "The voice should resume where it would be had it been mixed.");
+
+	server->stop_playback_stream(playback);
+}
+
+TEST_CASE("[Audio][VoiceVirtualization] Voices without a priority are always mixed") {
+	ManualMixing mixing;
+	AudioServer *server = AudioServer::get_singleton();
+
+	Ref<CountingPlayback> playback;
+	playback.instantiate();
+	server->start_playback_stream(playback, SNAME("Master"), _volumes(0.0));
+
+	mixing.mix(0.5);
+	CHECK_FALSE(server->is_playback_virtual(playback));
+	CHECK(playback->skipped_time == 0.0);
+
+	server->stop_playback_stream(playback);
+}
+
+TEST_CASE("[Audio][VoiceVirtualization] Voices ending while virtual are removed") {
+	ManualMixing mixing;
+	AudioServer *server = AudioServer::get_singleton();
+
+	Ref<CountingPlayback> playback;
+	playback.instantiate();
+	playback->length = 0.5;
+	server->start_playback_stream(playback, SNAME("Master"), _volumes(0.0));
+	server->set_playback_voice_priority(playback, 0);
+
+	mixing.mix(1.5);
+	CHECK_FALSE(server->is_playback_active(playback));
+}
+
+TEST_CASE("[Audio][VoiceVirtualization] Voice budget keeps the highest priority voices") {
+	ManualMixing mixing;
+	AudioServer *server = AudioServer::get_singleton();
+	server->set_voice_budget(2);
+
+	Ref<CountingPlayback> playbacks[3];
+	for (int i = 0; i < 3; i++) {
+		playbacks[i].instantiate();
+		// The loudest voice has the lowest priority.
+		server->start_playback_stream(playbacks[i], SNAME("Master"), _volumes(0.1 * (3 - i)));
+		server->set_playback_voice_priority(playbacks[i], i);
+	}
+
+	mixing.mix(0.5);
+	CHECK(server->is_playback_virtual(playbacks[0]));
+	CHECK_FALSE(server->is_playback_virtual(playbacks[1]));
+	CHECK_FALSE(server->is_playback_virtual(playbacks[2]));
+	CHECK(server->get_virtual_voice_count() == 1);
+
+	// Same priority, the quietest voice is made virtual.
+	for (int i = 0; i < 3; i++) {
+		server->set_playback_voice_priority(playbacks[i], 0);
+	}
+	mixing.mix(0.5);
+	CHECK_FALSE(server->is_playback_virtual(playbacks[0]));
+	CHECK_FALSE(server->is_playback_virtual(playbacks[1]));
+	CHECK(server->is_playback_virtual(playbacks[2]));
+
+	for (int i = 0; i < 3; i++) {
+		server->stop_playback_stream(playbacks[i]);
+	}
+}
+
+} // namespace TestAudioVoiceVirtualization
+
+#endif // TEST_AUDIO_VOICE_VIRTUALIZATION_H
@@ -0,0 +1,279 @@
+/**************************************************************************/
+/*  test_cpu_skinning.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CPU_SKINNING_H
+#define TEST_CPU_SKINNING_H
+
+#include "servers/rendering/dummy/storage/mesh_storage.h"
+#include "servers/rendering/storage/cpu_skinning.h"
+
+#include "core/math/random_pcg.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/mesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCPUSkinning {
+
+static const int TEST_BONE_COUNT = 8;
+static const int TEST_BLEND_SHAPE_COUNT = 3;
+
+struct TestMesh {
+	Array arrays;
+	TypedArray<Array> blend_shapes;
+	Vector<Transform3D> bones;
+	LocalVector<float> bone_data;
+	LocalVector<float> blend_weights;
+};
+
+static TestMesh _make_test_mesh(int p_vertex_count) {
+	RandomPCG rng(0x5eed);
+	TestMesh mesh;
+
+	PackedVector3Array vertices;
+	PackedVector3Array normals;
+	PackedInt32Array bones;
+	PackedFloat32Array weights;
+	for (int i = 0; i < p_vertex_count; i++) {
+		vertices.push_back(Vector3(rng.random(-1.0, 1.0), rng.random(0.0, 2.0), rng.random(-1.0, 1.0)));
+		normals.push_back(Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(0.1, 1.0)).normalized());
+		float total = 0.0;
+		float vertex_weights[4];
+		for (int j = 0; j < 4; j++) {
+			bones.push_back(rng.rand() % TEST_BONE_COUNT);
+			vertex_weights[j] = rng.randf();
+			total += vertex_weights[j];
+		}
+		for (int j = 0; j < 4; j++) {
+			weights.push_back(vertex_weights[j] / total);
+		}
+	}
+
+	mesh.arrays.resize(Mesh::ARRAY_MAX);
+	mesh.arrays[Mesh::ARRAY_VERTEX] = vertices;
+	mesh.arrays[Mesh::ARRAY_NORMAL] = normals;
+	mesh.arrays[Mesh::ARRAY_BONES] = bones;
+	mesh.arrays[Mesh::ARRAY_WEIGHTS] = weights;
+
+	for (int i = 0; i < TEST_BLEND_SHAPE_COUNT; i++) {
+		PackedVector3Array shape_vertices;
+		PackedVector3Array shape_normals;
+		for (int j = 0; j < p_vertex_count; j++) {
+			shape_vertices.push_back(vertices[j] + Vector3(rng.random(-0.5, 0.5), rng.random(-0.5, 0.5), rng.random(-0.5, 0.5)));
+			shape_normals.push_back((normals[j] + Vector3(rng.random(-0.3, 0.3), 0.0, 0.0)).normalized());
+		}
+		Array shape;
+		shape.resize(Mesh::ARRAY_MAX);
+		shape[Mesh::ARRAY_VERTEX] = shape_vertices;
+		shape[Mesh::ARRAY_NORMAL] = shape_normals;
+		mesh.blend_shapes.push_back(shape);
+		mesh.blend_weights.push_back(rng.random(-0.5, 1.0));
+	}
+	// An inactive shape must not contribute.
+	mesh.blend_weights[1] = 0.0;
+
+	mesh.bone_data.resize(TEST_BONE_COUNT * CPUSkinning::BONE_STRIDE);
+	for (int i = 0; i < TEST_BONE_COUNT; i++) {
+		Transform3D bone;
+		bone.basis = Basis::from_euler(Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(-1.0, 1.0)));
+		bone.basis.scale(Vector3(1.0, rng.random(0.8, 1.2), 1.0));
+		bone.origin = Vector3(rng.random(-2.0, 2.0), rng.random(-2.0, 2.0), rng.random(-2.0, 2.0));
+		mesh.bones.push_back(bone);
+		CPUSkinning::store_bone_transform(bone, mesh.bone_data.ptr() + i * CPUSkinning::BONE_STRIDE);
+	}
+
+	return mesh;
+}
+
+// Straightforward per-vertex version of the skinning shader.
+static void _evaluate_reference(const TestMesh &p_mesh, RS::BlendShapeMode p_mode, int p_index, Vector3 &r_vertex, Vector3 &r_normal) {
+	const PackedVector3Array vertices = p_mesh.arrays[Mesh::ARRAY_VERTEX];
+	const PackedVector3Array normals = p_mesh.arrays[Mesh::ARRAY_NORMAL];
+	const PackedInt32Array bones = p_mesh.arrays[Mesh::ARRAY_BONES];
+	const PackedFloat32Array weights = p_mesh.arrays[Mesh::ARRAY_WEIGHTS];
+
+	Vector3 vertex = vertices[p_index];
+	Vector3 normal = normals[p_index];
+	Vector3 blend_vertex;
+	Vector3 blend_normal;
+	real_t total = 0.0;
+	for (int i = 0; i < TEST_BLEND_SHAPE_COUNT; i++) {
+		const real_t weight = p_mesh.blend_weights[i];
+		if (Math::abs(weight) > 0.0001) {
+			const Array shape = p_mesh.blend_shapes[i];
+			blend_vertex += PackedVector3Array(shape[Mesh::ARRAY_VERTEX])[p_index] * weight;
+			blend_normal += PackedVector3Array(shape[Mesh::ARRAY_NORMAL])[p_index] * weight;
+			total += weight;
+		}
+	}
+	if (p_mode == RS::BLEND_SHAPE_MODE_NORMALIZED) {
+		vertex *= 1.0 - total;
+		normal *= 1.0 - total;
+	}
+	vertex += blend_vertex;
+	normal = (normal + blend_normal).normalized();
+
+	Transform3D skin(Basis(0, 0, 0, 0, 0, 0, 0, 0, 0), Vector3());
+	for (int i = 0; i < 4; i++) {
+		const Transform3D &bone = p_mesh.bones[bones[p_index * 4 + i]];
+		const real_t weight = weights[p_index * 4 + i];
+		skin.basis += bone.basis * weight;
+		skin.origin += bone.origin * weight;
+	}
+	r_vertex = skin.xform(vertex);
+	r_normal = skin.basis.xform(normal).normalized();
+}
+
+static bool _matches_reference(const TestMesh &p_mesh, RS::BlendShapeMode p_mode, const CPUSkinning::Result &p_result, int p_vertex_count) {
+	for (int i = 0; i < p_vertex_count; i++) {
+		Vector3 vertex;
+		Vector3 normal;
+		_evaluate_reference(p_mesh, p_mode, i, vertex, normal);
+		if (p_result.get_vertex(i).distance_to(vertex) > 1e-4 || p_result.get_normal(i).distance_to(normal) > 1e-4) {
+			return false;
+		}
+		if (!p_result.aabb.grow(1e-4).has_point(vertex)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[CPUSkinning] Blend shapes and skinning match a per-vertex evaluation") {
+	// Above the threaded threshold too, so the split into blocks on worker threads is covered.
+	for (const int vertex_count : { 37, CPUSkinning::THREADED_VERTEX_THRESHOLD + 123 }) {
+		const TestMesh mesh = _make_test_mesh(vertex_count);
+
+		CPUSkinning::Surface surface;
+		REQUIRE(CPUSkinning::surface_from_arrays(mesh.arrays, mesh.blend_shapes, surface) == OK);
+		CHECK(surface.vertex_count == (uint32_t)vertex_count);
+		CHECK(surface.bone_influences == 4);
+		CHECK(surface.blend_shape_count == (uint32_t)TEST_BLEND_SHAPE_COUNT);
+		CHECK(surface.required_bones <= (uint32_t)TEST_BONE_COUNT);
+
+		CPUSkinning::Result result;
+		CPUSkinning::evaluate(surface, mesh.blend_weights.ptr(), RS::BLEND_SHAPE_MODE_NORMALIZED, mesh.bone_data.ptr(), TEST_BONE_COUNT, result);
+		CHECK_MESSAGE(_matches_reference(mesh, RS::BLEND_SHAPE_MODE_NORMALIZED, result, vertex_count), "Normalized blend shapes with skinning should match the reference.");
+
+		CPUSkinning::evaluate(surface, mesh.blend_weights.ptr(), RS::BLEND_SHAPE_MODE_RELATIVE, mesh.bone_data.ptr(), TEST_BONE_COUNT, result);
+		CHECK_MESSAGE(_matches_reference(mesh, RS::BLEND_SHAPE_MODE_RELATIVE, result, vertex_count), "Relative blend shapes with skinning should match the reference.");
+
+		CPUSkinning::evaluate(surface, nullptr, RS::BLEND_SHAPE_MODE_NORMALIZED, nullptr, 0, result);
+		const PackedVector3Array vertices = mesh.arrays[Mesh::ARRAY_VERTEX];
+		CHECK_MESSAGE(result.get_vertex_array() == vertices, "Without weights or bones, the surface should be left as is.");
+
+		ERR_PRINT_OFF;
+		CPUSkinning::Result unchanged;
+		CPUSkinning::evaluate(surface, nullptr, RS::BLEND_SHAPE_MODE_NORMALIZED, mesh.bone_data.ptr(), 1, unchanged);
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(unchanged.vertices.is_empty(), "Too few bones for the surface should be rejected.");
+	}
+}
+
+static Array _make_limb_arrays() {
+	// Three vertices along a two bone limb: one on each bone, one at the joint.
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(0, 1, 0), Vector3(0, 2, 0) });
+	arrays[Mesh::ARRAY_BONES] = PackedInt32Array({ 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 });
+	arrays[Mesh::ARRAY_WEIGHTS] = PackedFloat32Array({ 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 });
+	return arrays;
+}
+
+TEST_CASE("[SceneTree][CPUSkinning] Dummy renderer skins mesh bounds") {
+	RendererDummy::MeshStorage *mesh_storage = RendererDummy::MeshStorage::get_singleton();
+	REQUIRE(mesh_storage != nullptr);
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, _make_limb_arrays());
+	CHECK(mesh_storage->mesh_needs_instance(mesh, true));
+	CHECK_FALSE(mesh_storage->mesh_needs_instance(mesh, false));
+
+	RID skeleton = rs->skeleton_create();
+	rs->skeleton_allocate_data(skeleton, 2);
+	CHECK(rs->skeleton_get_bone_count(skeleton) == 2);
+	rs->skeleton_bone_set_transform(skeleton, 0, Transform3D());
+	const Transform3D moved(Basis(), Vector3(5, 0, 0));
+	rs->skeleton_bone_set_transform(skeleton, 1, moved);
+	CHECK(rs->skeleton_bone_get_transform(skeleton, 1).is_equal_approx(moved));
+
+	const AABB skinned_aabb = mesh_storage->mesh_get_aabb(mesh, skeleton);
+	CHECK(skinned_aabb.grow(1e-4).has_point(Vector3(5, 2, 0)));
+	CHECK_FALSE_MESSAGE(mesh_storage->mesh_get_aabb(mesh).has_point(Vector3(5, 2, 0)), "Without a skeleton, the rest bounds should be used.");
+
+	// Changing the pose must invalidate the cached bounds.
+	rs->skeleton_bone_set_transform(skeleton, 1, Transform3D(Basis(), Vector3(0, 0, -3)));
+	CHECK(mesh_storage->mesh_get_aabb(mesh, skeleton).grow(1e-4).has_point(Vector3(0, 2, -3)));
+
+	rs->free(skeleton);
+	rs->free(mesh);
+}
+
+TEST_CASE("[SceneTree][CPUSkinning] Bake a mesh from the current skeleton pose") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->add_bone("root");
+	skeleton->add_bone("tip");
+	skeleton->set_bone_parent(1, 0);
+	skeleton->set_bone_rest(1, Transform3D(Basis(), Vector3(0, 1, 0)));
+	skeleton->reset_bone_poses();
+
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, _make_limb_arrays());
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(mesh);
+	skeleton->add_child(mesh_instance);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+
+	// Bend the tip a quarter turn around its joint.
+	skeleton->set_bone_pose_rotation(1, Quaternion(Vector3(0, 0, 1), Math_PI * 0.5));
+
+	Ref<ArrayMesh> baked = mesh_instance->bake_mesh_from_current_skeleton_pose();
+	REQUIRE(baked.is_valid());
+	REQUIRE(baked->get_surface_count() == 1);
+
+	const Array arrays = baked->surface_get_arrays(0);
+	const PackedVector3Array vertices = arrays[Mesh::ARRAY_VERTEX];
+	REQUIRE(vertices.size() == 3);
+	CHECK(vertices[0].is_equal_approx(Vector3(0, 0, 0)));
+	CHECK(vertices[1].is_equal_approx(Vector3(0, 1, 0)));
+	CHECK(vertices[2].is_equal_approx(Vector3(-1, 1, 0)));
+	CHECK_MESSAGE((baked->surface_get_format(0) & Mesh::ARRAY_FORMAT_BONES) == 0, "The baked mesh should not be skinned again.");
+
+	memdelete(skeleton);
+}
+
+} // namespace TestCPUSkinning
+
+#endif // TEST_CPU_SKINNING_H
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Creating an occlusion culling implementation replaces the global one, so it has to be restored afterwards.
+class TestRasterOcclusionCull : public RasterOcclusionCull {
+public:
+	static void restore_singleton(RendererSceneOcclusionCull *p_singleton) {
+		singleton = p_singleton;
+	}
+};
+
+static bool _is_box_occluded(RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_aabb, const Projection &p_projection) {
+	const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.get_end().x, p_aabb.get_end().y, p_aabb.get_end().z };
+	uint64_t timeout = 0;
+	return p_buffer->is_occluded(bounds, Vector3(), Transform3D(), p_projection, p_projection.get_z_near(), timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Rasterized occluders hide instances behind them") {
+	RendererSceneOcclusionCull *previous = RendererSceneOcclusionCull::get_singleton();
+	bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	TestRasterOcclusionCull *occlusion_cull = memnew(TestRasterOcclusionCull);
+
+	// A 10x10 quad, 10 units in front of the camera.
+	PackedVector3Array vertices = { Vector3(-5, -5, 0), Vector3(5, -5, 0), Vector3(5, 5, 0), Vector3(-5, 5, 0) };
+	PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+
+	RID occluder = occlusion_cull->occluder_allocate();
+	occlusion_cull->occluder_initialize(occluder);
+	occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	occlusion_cull->add_scenario(scenario);
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+	occlusion_cull->add_buffer(buffer);
+	occlusion_cull->buffer_set_scenario(buffer, scenario);
+	occlusion_cull->buffer_set_size(buffer, Vector2i(64, 36));
+
+	Projection projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 100.0);
+	occlusion_cull->buffer_update(buffer, Transform3D(), projection, false);
+
+	RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+	REQUIRE(hz_buffer != nullptr);
+
+	CHECK_MESSAGE(_is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 1)), projection), "A box behind the occluder should be occluded.");
+	CHECK_FALSE_MESSAGE(_is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -6), Vector3(2, 2, 1)), projection), "A box in front of the occluder should not be occluded.");
+	CHECK_FALSE_MESSAGE(_is_box_occluded(hz_buffer, AABB(Vector3(15, -1, -21), Vector3(2, 2, 1)), projection), "A box beside the occluder should not be occluded.");
+
+	occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), false);
+	occlusion_cull->buffer_update(buffer, Transform3D(), projection, false);
+	CHECK_FALSE_MESSAGE(_is_box_occluded(hz_buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 1)), projection), "Disabled occluders should not occlude anything.");
+
+	// The debug texture is freed through the RenderingServer, which is not available here.
+	ERR_PRINT_OFF;
+	occlusion_cull->remove_buffer(buffer);
+	ERR_PRINT_ON;
+	occlusion_cull->remove_scenario(scenario);
+	occlusion_cull->free_occluder(occluder);
+	memdelete(occlusion_cull);
+
+	TestRasterOcclusionCull::restore_singleton(previous);
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
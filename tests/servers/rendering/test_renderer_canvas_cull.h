@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+class TestRendererCanvasCullInternalsAccessor {
+public:
+	// Culls the canvas like a viewport draw would, and returns the items in the order they are drawn.
+	static Vector<RendererCanvasRender::Item *> cull_canvas(RID p_canvas, uint32_t p_thread_cull_threshold) {
+		RendererCanvasCull *canvas_cull = RSG::canvas;
+		uint32_t prev_threshold = canvas_cull->thread_cull_threshold;
+		canvas_cull->thread_cull_threshold = p_thread_cull_threshold;
+		RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_canvas);
+		canvas_cull->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 1024, 1024), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, false, false, 0xffffffff);
+		canvas_cull->thread_cull_threshold = prev_threshold;
+
+		// The z lists are chained together before drawing, so the first one holds all the items.
+		Vector<RendererCanvasRender::Item *> items;
+		for (int i = 0; i < canvas_cull->z_range; i++) {
+			if (canvas_cull->z_list[i]) {
+				for (RendererCanvasRender::Item *item = canvas_cull->z_list[i]; item; item = item->next) {
+					items.push_back(item);
+				}
+				break;
+			}
+		}
+		return items;
+	}
+};
+
+namespace TestRendererCanvasCull {
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Subtree rect covers the children") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID parent = rs->canvas_item_create();
+	RID child = rs->canvas_item_create();
+	rs->canvas_item_set_parent(child, parent);
+	rs->canvas_item_add_rect(parent, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	rs->canvas_item_add_rect(child, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	rs->canvas_item_set_transform(child, Transform2D(0.0, Vector2(100, 0)));
+
+	RendererCanvasCull::Item *parent_item = RSG::canvas->canvas_item_owner.get_or_null(parent);
+	RSG::canvas->_update_subtree_rect(parent_item);
+	CHECK_FALSE(parent_item->subtree_unbounded);
+	CHECK_FALSE(parent_item->subtree_empty);
+	CHECK(parent_item->subtree_rect.is_equal_approx(Rect2(0, 0, 110, 10)));
+
+	rs->canvas_item_set_transform(child, Transform2D(0.0, Vector2(0, 50)));
+	CHECK_MESSAGE(parent_item->subtree_rect_dirty, "Moving a child should invalidate the subtree rect of its parents.");
+	RSG::canvas->_update_subtree_rect(parent_item);
+	CHECK(parent_item->subtree_rect.is_equal_approx(Rect2(0, 0, 10, 60)));
+
+	rs->free(child);
+	rs->free(parent);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Items with a changing rect are never culled by subtree") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID parent = rs->canvas_item_create();
+	RID child = rs->canvas_item_create();
+	rs->canvas_item_set_parent(child, parent);
+	rs->canvas_item_add_rect(parent, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	rs->canvas_item_add_rect(child, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+
+	RendererCanvasCull::Item *parent_item = RSG::canvas->canvas_item_owner.get_or_null(parent);
+	RSG::canvas->_update_subtree_rect(parent_item);
+	CHECK_FALSE(parent_item->subtree_unbounded);
+
+	SUBCASE("Update when visible") {
+		rs->canvas_item_set_update_when_visible(child, true);
+		RSG::canvas->_update_subtree_rect(parent_item);
+		CHECK_MESSAGE(parent_item->subtree_unbounded, "The rect of an item updated when visible is recomputed on every draw, so it can't be cached.");
+
+		rs->canvas_item_set_custom_rect(child, true, Rect2(0, 0, 20, 20));
+		RSG::canvas->_update_subtree_rect(parent_item);
+		CHECK_MESSAGE(!parent_item->subtree_unbounded, "A custom rect is used as is, so it can be cached.");
+		CHECK(parent_item->subtree_rect.is_equal_approx(Rect2(0, 0, 20, 20)));
+	}
+
+	SUBCASE("Skeleton") {
+		RID skeleton = rs->skeleton_create();
+		rs->canvas_item_attach_skeleton(child, skeleton);
+		RSG::canvas->_update_subtree_rect(parent_item);
+		CHECK_MESSAGE(parent_item->subtree_unbounded, "The rect of a skinned item is recomputed on every draw, so it can't be cached.");
+
+		rs->canvas_item_attach_skeleton(child, RID());
+		RSG::canvas->_update_subtree_rect(parent_item);
+		CHECK_FALSE(parent_item->subtree_unbounded);
+		rs->free(skeleton);
+	}
+
+	rs->free(child);
+	rs->free(parent);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling keeps the serial draw order") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	Vector<RID> items;
+
+	// Overlapping items spread over several z indices, with children drawn both behind and in front of their parents.
+	for (int i = 0; i < 48; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas);
+		rs->canvas_item_add_rect(item, Rect2(i * 4, i * 4, 64, 64), Color(1, 1, 1));
+		rs->canvas_item_set_z_index(item, (i * 7) % 9 - 4);
+		items.push_back(item);
+
+		for (int j = 0; j < 3; j++) {
+			RID child = rs->canvas_item_create();
+			rs->canvas_item_set_parent(child, item);
+			rs->canvas_item_add_rect(child, Rect2(j * 8, 0, 32, 32), Color(1, 1, 1));
+			rs->canvas_item_set_z_index(child, j - 1);
+			rs->canvas_item_set_draw_behind_parent(child, j == 0);
+			items.push_back(child);
+		}
+	}
+
+	// A y-sorted parent, whose flattened children are culled on worker threads too.
+	RID ysort_parent = rs->canvas_item_create();
+	rs->canvas_item_set_parent(ysort_parent, canvas);
+	rs->canvas_item_set_sort_children_by_y(ysort_parent, true);
+	items.push_back(ysort_parent);
+	for (int i = 0; i < 32; i++) {
+		RID child = rs->canvas_item_create();
+		rs->canvas_item_set_parent(child, ysort_parent);
+		rs->canvas_item_add_rect(child, Rect2(0, 0, 48, 48), Color(1, 1, 1));
+		rs->canvas_item_set_transform(child, Transform2D(0.0, Vector2(i * 3, (i * 13) % 32)));
+		rs->canvas_item_set_z_index(child, i % 3);
+		items.push_back(child);
+	}
+
+	Vector<RendererCanvasRender::Item *> serial = TestRendererCanvasCullInternalsAccessor::cull_canvas(canvas, UINT32_MAX);
+	Vector<RendererCanvasRender::Item *> threaded = TestRendererCanvasCullInternalsAccessor::cull_canvas(canvas, 4);
+	CHECK(serial.size() == items.size() - 1); // The y-sorted parent draws nothing.
+	CHECK_MESSAGE(threaded == serial, "Items culled on worker threads should be drawn in the same order as when culled serially.");
+
+	for (int i = items.size() - 1; i >= 0; i--) {
+		rs->free(items[i]);
+	}
+	rs->free(canvas);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,301 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+static RendererSceneCull::Frustum _make_test_frustum() {
+	Projection projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 500.0);
+	Transform3D camera;
+	camera.basis = Basis::from_euler(Vector3(-0.2, 0.7, 0.0));
+	camera.origin = Vector3(3.0, 2.0, -4.0);
+	return RendererSceneCull::Frustum(projection.get_projection_planes(camera));
+}
+
+static LocalVector<RendererSceneCull::InstanceBounds> _make_test_bounds(uint32_t p_count) {
+	RandomPCG rng(0x5eed);
+	LocalVector<RendererSceneCull::InstanceBounds> bounds;
+	bounds.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Vector3 position(rng.random(-600.0, 600.0), rng.random(-50.0, 50.0), rng.random(-600.0, 600.0));
+		Vector3 size(rng.random(0.1, 20.0), rng.random(0.1, 20.0), rng.random(0.1, 20.0));
+		bounds[i] = RendererSceneCull::InstanceBounds(AABB(position, size));
+	}
+	return bounds;
+}
+
+TEST_CASE("[RendererSceneCull] Batched frustum culling matches per-instance culling") {
+	const RendererSceneCull::Frustum frustum = _make_test_frustum();
+	const LocalVector<RendererSceneCull::InstanceBounds> bounds = _make_test_bounds(1000);
+
+	RendererSceneCull::CullBatch batch;
+	uint32_t visible_count = 0;
+	bool matches = true;
+
+	for (uint32_t from = 0; from < bounds.size(); from += RendererSceneCull::CullBatch::SIZE) {
+		uint32_t to = MIN(from + RendererSceneCull::CullBatch::SIZE, bounds.size());
+		batch.count = 0;
+		for (uint32_t i = from; i < to; i++) {
+			// Reject every seventh instance by its layers, to cover the mask too.
+			batch.add(bounds[i], i % 7 != 0);
+		}
+		batch.cull_frustum(frustum);
+
+		for (uint32_t i = from; i < to; i++) {
+			bool expected = i % 7 != 0 && bounds[i].in_frustum(frustum);
+			matches = matches && bool(batch.visible[i - from]) == expected;
+			visible_count += expected;
+		}
+	}
+
+	CHECK(matches);
+	CHECK_MESSAGE(visible_count > 0, "The test frustum should contain some instances.");
+	CHECK_MESSAGE(visible_count < bounds.size(), "The test frustum should reject some instances.");
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Cull cache key changes with the scene and the camera") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	RID instance = rs->instance_create2(mesh, scenario);
+	scene_cull->update_dirty_instances();
+
+	Projection projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 500.0);
+	RendererSceneRender::CameraData camera;
+	camera.set_camera(Transform3D(), projection, false, false);
+
+	RendererSceneCull::CullCacheKey key = scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID());
+	CHECK_MESSAGE(scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID()) == key, "The key should not change when nothing changed.");
+
+	rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(2, 0, 0)));
+	scene_cull->update_dirty_instances();
+	RendererSceneCull::CullCacheKey moved_key = scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID());
+	CHECK_MESSAGE(moved_key != key, "Moving an instance should invalidate the cached results.");
+	key = moved_key;
+
+	rs->instance_set_visible(instance, false);
+	scene_cull->update_dirty_instances();
+	RendererSceneCull::CullCacheKey hidden_key = scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID());
+	CHECK_MESSAGE(hidden_key != key, "Hiding an instance should invalidate the cached results.");
+	key = hidden_key;
+
+	rs->instance_set_visible(instance, true);
+	scene_cull->update_dirty_instances();
+	RendererSceneCull::CullCacheKey shown_key = scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID());
+	CHECK_MESSAGE(shown_key != key, "Showing an instance should invalidate the cached results.");
+	key = shown_key;
+
+	rs->instance_set_layer_mask(instance, 2);
+	scene_cull->update_dirty_instances();
+	RendererSceneCull::CullCacheKey layer_key = scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID());
+	CHECK_MESSAGE(layer_key != key, "Changing the layers of an instance should invalidate the cached results.");
+	key = layer_key;
+
+	CHECK_MESSAGE(scene_cull->_get_cull_cache_key(&camera, 3, scenario, RID()) != key, "Changing the camera layers should invalidate the cached results.");
+
+	RendererSceneRender::CameraData moved_camera;
+	moved_camera.set_camera(Transform3D(Basis(), Vector3(0, 0, 1)), projection, false, false);
+	CHECK_MESSAGE(scene_cull->_get_cull_cache_key(&moved_camera, 1, scenario, RID()) != key, "Moving the camera should invalidate the cached results.");
+
+	Projection zoomed_projection;
+	zoomed_projection.set_perspective(40.0, 16.0 / 9.0, 0.05, 500.0);
+	RendererSceneRender::CameraData zoomed_camera;
+	zoomed_camera.set_camera(Transform3D(), zoomed_projection, false, false);
+	CHECK_MESSAGE(scene_cull->_get_cull_cache_key(&zoomed_camera, 1, scenario, RID()) != key, "Changing the camera projection should invalidate the cached results.");
+
+	CHECK_MESSAGE(scene_cull->_get_cull_cache_key(&camera, 1, scenario, RID()) == key, "The key should not change when nothing changed.");
+
+	rs->free(instance);
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+// The dummy renderer has no render buffers, but culling requires some.
+class TestRenderSceneBuffers : public RenderSceneBuffers {
+public:
+	virtual void configure(const RenderSceneBuffersConfiguration *p_config) override {}
+	virtual void set_fsr_sharpness(float p_fsr_sharpness) override {}
+	virtual void set_texture_mipmap_bias(float p_texture_mipmap_bias) override {}
+	virtual void set_use_debanding(bool p_use_debanding) override {}
+};
+
+static LocalVector<RenderGeometryInstance *> _cull_visible(const RendererSceneRender::CameraData &p_camera, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_scenario, RID p_viewport) {
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	scene_cull->_render_scene(&p_camera, p_render_buffers, RID(), RID(), RID(), 1, p_scenario, p_viewport, RID(), RID(), 0, 0.0, false);
+
+	LocalVector<RenderGeometryInstance *> visible;
+	for (uint64_t i = 0; i < scene_cull->scene_cull_result.geometry_instances.size(); i++) {
+		visible.push_back(scene_cull->scene_cull_result.geometry_instances[i]);
+	}
+	return visible;
+}
+
+static bool _is_same_cull_result(const LocalVector<RenderGeometryInstance *> &p_a, const LocalVector<RenderGeometryInstance *> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a.size(); i++) {
+		if (p_a[i] != p_b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Reused cull results match a fresh cull") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = RendererSceneCull::singleton;
+	const bool reuse_cull_results = scene_cull->reuse_cull_results;
+
+	RID scenario = rs->scenario_create();
+	RID viewport = rs->viewport_create();
+	rs->viewport_set_scenario(viewport, scenario);
+	RID mesh = rs->mesh_create();
+	LocalVector<RID> instances;
+	for (int i = 0; i < 40; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), Vector3((i - 20) * 2.0, 0, -10)));
+		instances.push_back(instance);
+	}
+	scene_cull->update_dirty_instances();
+
+	Ref<RenderSceneBuffers> render_buffers = memnew(TestRenderSceneBuffers);
+	Projection projection;
+	projection.set_perspective(70.0, 16.0 / 9.0, 0.05, 500.0);
+	RendererSceneRender::CameraData camera;
+	camera.set_camera(Transform3D(), projection, false, false);
+
+	SUBCASE("[RendererSceneCull] Same visible set when nothing changed") {
+		scene_cull->reuse_cull_results = true;
+		const LocalVector<RenderGeometryInstance *> first = _cull_visible(camera, render_buffers, scenario, viewport);
+		CHECK(first.size() > 0);
+		CHECK(first.size() < instances.size());
+		REQUIRE(scene_cull->cull_caches.has(viewport));
+		CHECK(scene_cull->cull_caches[viewport]->valid);
+
+		const LocalVector<RenderGeometryInstance *> reused = _cull_visible(camera, render_buffers, scenario, viewport);
+		CHECK(_is_same_cull_result(reused, first));
+
+		scene_cull->reuse_cull_results = false;
+		const LocalVector<RenderGeometryInstance *> fresh = _cull_visible(camera, render_buffers, scenario, viewport);
+		CHECK(_is_same_cull_result(fresh, first));
+
+		// An instance moving into view invalidates the cached result.
+		scene_cull->reuse_cull_results = true;
+		rs->instance_set_transform(instances[0], Transform3D(Basis(), Vector3(0, 0, -5)));
+		scene_cull->update_dirty_instances();
+		const LocalVector<RenderGeometryInstance *> moved = _cull_visible(camera, render_buffers, scenario, viewport);
+		CHECK(moved.size() == first.size() + 1);
+
+		scene_cull->reuse_cull_results = false;
+		const LocalVector<RenderGeometryInstance *> moved_fresh = _cull_visible(camera, render_buffers, scenario, viewport);
+		CHECK(_is_same_cull_result(moved, moved_fresh));
+	}
+
+	SUBCASE("[RendererSceneCull] Cull cache is freed with the viewport") {
+		// The scenario has no visibility ranges, so the viewport never gets a visibility mask.
+		scene_cull->reuse_cull_results = true;
+		_cull_visible(camera, render_buffers, scenario, viewport);
+		REQUIRE(scene_cull->cull_caches.has(viewport));
+
+		rs->viewport_set_scenario(viewport, RID());
+		CHECK_FALSE(scene_cull->cull_caches.has(viewport));
+
+		rs->viewport_set_scenario(viewport, scenario);
+		_cull_visible(camera, render_buffers, scenario, viewport);
+		REQUIRE(scene_cull->cull_caches.has(viewport));
+		rs->free(viewport);
+		CHECK_FALSE(scene_cull->cull_caches.has(viewport));
+		viewport = RID();
+	}
+
+	scene_cull->reuse_cull_results = reuse_cull_results;
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	if (viewport.is_valid()) {
+		rs->free(viewport);
+	}
+	rs->free(scenario);
+}
+
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[RendererSceneCull][Benchmark] Frustum culling of 1M instances" * doctest::skip()) {
+	// Only measures the CPU side of culling, so no rendering driver is needed.
+	const RendererSceneCull::Frustum frustum = _make_test_frustum();
+	const LocalVector<RendererSceneCull::InstanceBounds> bounds = _make_test_bounds(1000000);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t scalar_visible = 0;
+	for (const RendererSceneCull::InstanceBounds &instance_bounds : bounds) {
+		scalar_visible += instance_bounds.in_frustum(frustum);
+	}
+	uint64_t scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t batch_visible = 0;
+	RendererSceneCull::CullBatch batch;
+	for (uint32_t from = 0; from < bounds.size(); from += RendererSceneCull::CullBatch::SIZE) {
+		uint32_t to = MIN(from + RendererSceneCull::CullBatch::SIZE, bounds.size());
+		batch.count = 0;
+		for (uint32_t i = from; i < to; i++) {
+			batch.add(bounds[i], true);
+		}
+		batch.cull_frustum(frustum);
+		for (uint32_t i = 0; i < batch.count; i++) {
+			batch_visible += batch.visible[i];
+		}
+	}
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(scalar_visible == batch_visible);
+	MESSAGE(vformat("Per-instance: %d usec, batched: %d usec, %d instances visible.", scalar_usec, batch_usec, batch_visible));
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,212 @@
+/**************************************************************************/
+/*  test_rendering_light_culler.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_LIGHT_CULLER_H
+#define TEST_RENDERING_LIGHT_CULLER_H
+
+#include "servers/rendering/rendering_light_culler.h"
+
+#include "core/math/random_pcg.h"
+#include "servers/rendering/dummy/storage/light_storage.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingLightCuller {
+
+// The dummy renderer doesn't keep light parameters, but the light culler reads them.
+class TestLightStorage : public RendererDummy::LightStorage {
+public:
+	struct Light {
+		RS::LightType type = RS::LIGHT_OMNI;
+		float range = 0.0;
+		float spot_angle = 0.0;
+	};
+
+	HashMap<RID, Light> lights;
+
+	virtual RS::LightType light_get_type(RID p_light) const override {
+		return lights.has(p_light) ? lights[p_light].type : RS::LIGHT_OMNI;
+	}
+
+	virtual float light_get_param(RID p_light, RS::LightParam p_param) override {
+		if (!lights.has(p_light)) {
+			return 0.0;
+		}
+		switch (p_param) {
+			case RS::LIGHT_PARAM_RANGE:
+				return lights[p_light].range;
+			case RS::LIGHT_PARAM_SPOT_ANGLE:
+				return lights[p_light].spot_angle;
+			default:
+				return 0.0;
+		}
+	}
+};
+
+struct TestLight {
+	RendererSceneCull::Instance instance;
+	TestLightStorage::Light light;
+};
+
+static void _add_test_light(TestLightStorage &r_storage, LocalVector<TestLight *> &r_lights, RS::LightType p_type, const Transform3D &p_transform, float p_range = 0.0, float p_spot_angle = 0.0) {
+	TestLight *light = memnew(TestLight);
+	light->light.type = p_type;
+	light->light.range = p_range;
+	light->light.spot_angle = p_spot_angle;
+	light->instance.base = RID::from_uint64(r_lights.size() + 1);
+	light->instance.transform = p_transform;
+	r_storage.lights.insert(light->instance.base, light->light);
+	r_lights.push_back(light);
+}
+
+// Whether a point in view is lit by the light, in which case a caster there must not be culled.
+static bool _is_lit(const TestLight &p_light, const Vector3 &p_point) {
+	const Vector3 to_point = p_point - p_light.instance.transform.origin;
+	switch (p_light.light.type) {
+		case RS::LIGHT_DIRECTIONAL:
+			return true;
+		case RS::LIGHT_OMNI:
+			return to_point.length() < p_light.light.range;
+		case RS::LIGHT_SPOT: {
+			const Vector3 dir = -p_light.instance.transform.basis.get_column(2).normalized();
+			return to_point.length() < p_light.light.range && Math::rad_to_deg(dir.angle_to(to_point)) < p_light.light.spot_angle;
+		}
+		default:
+			return true;
+	}
+}
+
+TEST_CASE("[RenderingLightCuller] Culling prepared lights together matches culling them one by one") {
+	RendererLightStorage *prev_light_storage = RSG::light_storage;
+	TestLightStorage *light_storage = memnew(TestLightStorage);
+	RSG::light_storage = light_storage;
+
+	// The camera looks down -Z from the origin.
+	const Transform3D camera_transform;
+	Projection camera_projection;
+	camera_projection.set_perspective(60.0, 16.0 / 9.0, 0.1, 100.0);
+	const Vector<Plane> camera_planes = camera_projection.get_projection_planes(camera_transform);
+
+	LocalVector<TestLight *> lights;
+	// Outside the view, on every side.
+	_add_test_light(*light_storage, lights, RS::LIGHT_OMNI, Transform3D(Basis(), Vector3(-40, 0, -30)), 30.0);
+	_add_test_light(*light_storage, lights, RS::LIGHT_OMNI, Transform3D(Basis(), Vector3(0, 30, -20)), 25.0);
+	_add_test_light(*light_storage, lights, RS::LIGHT_OMNI, Transform3D(Basis(), Vector3(0, 0, 20)), 25.0);
+	// In view.
+	_add_test_light(*light_storage, lights, RS::LIGHT_OMNI, Transform3D(Basis(), Vector3(2, -1, -15)), 8.0);
+	// The camera is inside these light volumes.
+	_add_test_light(*light_storage, lights, RS::LIGHT_OMNI, Transform3D(Basis(), Vector3(1, 1, 1)), 10.0);
+	_add_test_light(*light_storage, lights, RS::LIGHT_SPOT, Transform3D(Basis(), Vector3(0, 0, 3)), 40.0, 50.0);
+	// Spot lights pointing into the view from the side and away from it.
+	_add_test_light(*light_storage, lights, RS::LIGHT_SPOT, Transform3D().looking_at(Vector3(1, 0, -1), Vector3(0, 1, 0)).translated(Vector3(-30, 0, -20)), 50.0, 30.0);
+	_add_test_light(*light_storage, lights, RS::LIGHT_SPOT, Transform3D().looking_at(Vector3(0, 1, 0), Vector3(0, 0, 1)).translated(Vector3(0, 20, -20)), 30.0, 20.0);
+	// Directional lights, shining away from and towards the camera.
+	_add_test_light(*light_storage, lights, RS::LIGHT_DIRECTIONAL, Transform3D().looking_at(Vector3(1, -1, -1), Vector3(0, 1, 0)));
+	_add_test_light(*light_storage, lights, RS::LIGHT_DIRECTIONAL, Transform3D().looking_at(Vector3(0, -1, 1), Vector3(0, 1, 0)));
+
+	RandomPCG rng(0x5eed);
+	LocalVector<AABB> casters;
+	for (int i = 0; i < 2000; i++) {
+		const Vector3 position(rng.random(-80.0, 80.0), rng.random(-80.0, 80.0), rng.random(-120.0, 40.0));
+		casters.push_back(AABB(position, Vector3(rng.random(0.1, 2.0), rng.random(0.1, 2.0), rng.random(0.1, 2.0))));
+	}
+
+	RenderingLightCuller *culler = memnew(RenderingLightCuller);
+
+	// Reference: each light prepared right before culling its casters.
+	LocalVector<LocalVector<bool>> expected;
+	expected.resize(lights.size());
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		culler->prepare_camera(camera_transform, camera_projection);
+		expected[i].resize(casters.size());
+		if (lights[i]->light.type == RS::LIGHT_DIRECTIONAL) {
+			culler->prepare_directional_light(&lights[i]->instance, 0);
+			for (uint32_t j = 0; j < casters.size(); j++) {
+				expected[i][j] = culler->cull_directional_light(RendererSceneCull::InstanceBounds(casters[j]), 0);
+			}
+		} else {
+			culler->prepare_regular_light(lights[i]->instance, 0);
+			for (uint32_t j = 0; j < casters.size(); j++) {
+				expected[i][j] = culler->cull_regular_light(casters[j], 0);
+			}
+		}
+	}
+
+	// Batched: every light is prepared first, then all of them are culled.
+	culler->prepare_camera(camera_transform, camera_projection);
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		if (lights[i]->light.type == RS::LIGHT_DIRECTIONAL) {
+			culler->prepare_directional_light(&lights[i]->instance, i);
+		} else {
+			culler->prepare_regular_light(lights[i]->instance, i);
+		}
+	}
+
+	bool matches = true;
+	bool lit_casters_kept = true;
+	uint32_t culled_count = 0;
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		for (uint32_t j = 0; j < casters.size(); j++) {
+			bool kept;
+			if (lights[i]->light.type == RS::LIGHT_DIRECTIONAL) {
+				kept = culler->cull_directional_light(RendererSceneCull::InstanceBounds(casters[j]), i);
+			} else {
+				kept = culler->cull_regular_light(casters[j], i);
+			}
+			matches = matches && kept == expected[i][j];
+			culled_count += !kept;
+
+			const Vector3 center = casters[j].get_center();
+			bool in_view = true;
+			for (const Plane &plane : camera_planes) {
+				in_view = in_view && !plane.is_point_over(center);
+			}
+			if (in_view && _is_lit(*lights[i], center)) {
+				lit_casters_kept = lit_casters_kept && kept;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(matches, "Lights culled together should keep the same casters as lights culled one by one.");
+	CHECK_MESSAGE(lit_casters_kept, "Casters lit in view should never be culled.");
+	CHECK_MESSAGE(culled_count > 0, "The test should cull some casters.");
+
+	memdelete(culler);
+	for (TestLight *light : lights) {
+		memdelete(light);
+	}
+	RSG::light_storage = prev_light_storage;
+	memdelete(light_storage);
+}
+
+} // namespace TestRenderingLightCuller
+
+#endif // TEST_RENDERING_LIGHT_CULLER_H
@@ -0,0 +1,267 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "servers/rendering/shader_compiler.h"
+
+#include "core/io/dir_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderCompiler {
+
+struct CompileResult {
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	int blend_mode = 0;
+	bool unshaded = false;
+	bool uses_time = false;
+	bool uses_screen_uv = false;
+	bool writes_color = false;
+	bool writes_vertex = false;
+};
+
+static Error _compile(ShaderCompiler &p_compiler, const String &p_code, CompileResult &r_result) {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&r_result.blend_mode, 1);
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&r_result.blend_mode, 2);
+	actions.render_mode_flags["unshaded"] = &r_result.unshaded;
+	actions.usage_flag_pointers["TIME"] = &r_result.uses_time;
+	actions.usage_flag_pointers["SCREEN_UV"] = &r_result.uses_screen_uv;
+	actions.write_flag_pointers["COLOR"] = &r_result.writes_color;
+	actions.write_flag_pointers["VERTEX"] = &r_result.writes_vertex;
+	actions.uniforms = &r_result.uniforms;
+
+	return p_compiler.compile(RS::SHADER_CANVAS_ITEM, p_code, &actions, "", r_result.gen_code);
+}
+
+static const char *test_shader_code = R"(
+shader_type canvas_item;
+render_mode blend_add, unshaded;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform float strength : hint_range(0.0, 2.0, 0.1) = 0.5;
+uniform sampler2D noise : filter_nearest, repeat_enable;
+
+void fragment() {
+	COLOR = texture(noise, UV) * tint;
+	COLOR.a *= strength * sin(TIME);
+}
+)";
+
+TEST_CASE("[ShaderCompiler] Cached compilation matches a full compilation") {
+	const String cache_base = TestUtils::get_temp_path("shader_compiler_cache_test");
+	DirAccess::make_dir_absolute(cache_base);
+
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	CompileResult uncached;
+	REQUIRE(_compile(compiler, test_shader_code, uncached) == OK);
+
+	ShaderCompiler::set_cache_dir(cache_base);
+	REQUIRE_FALSE(ShaderCompiler::get_cache_dir().is_empty());
+
+	CompileResult stored;
+	REQUIRE(_compile(compiler, test_shader_code, stored) == OK);
+
+	PackedStringArray cache_files = DirAccess::get_files_at(ShaderCompiler::get_cache_dir());
+	CHECK_MESSAGE(cache_files.size() == 1, "Compiling with a cache folder should store the result.");
+
+	CompileResult cached;
+	REQUIRE(_compile(compiler, test_shader_code, cached) == OK);
+
+	for (const CompileResult *result : { &stored, &cached }) {
+		CHECK(result->blend_mode == uncached.blend_mode);
+		CHECK(result->unshaded == uncached.unshaded);
+		CHECK(result->uses_time == uncached.uses_time);
+		CHECK(result->uses_screen_uv == uncached.uses_screen_uv);
+		CHECK(result->writes_color == uncached.writes_color);
+		CHECK(result->writes_vertex == uncached.writes_vertex);
+
+		CHECK(result->gen_code.defines == uncached.gen_code.defines);
+		CHECK(result->gen_code.uniforms == uncached.gen_code.uniforms);
+		CHECK(result->gen_code.uniform_offsets == uncached.gen_code.uniform_offsets);
+		CHECK(result->gen_code.uniform_total_size == uncached.gen_code.uniform_total_size);
+		CHECK(result->gen_code.uses_fragment_time == uncached.gen_code.uses_fragment_time);
+		CHECK(result->gen_code.code.size() == uncached.gen_code.code.size());
+		for (const KeyValue<String, String> &E : uncached.gen_code.code) {
+			CHECK(result->gen_code.code.has(E.key));
+			CHECK(result->gen_code.code[E.key] == E.value);
+		}
+		for (int i = 0; i < ShaderCompiler::STAGE_MAX; i++) {
+			CHECK(result->gen_code.stage_globals[i] == uncached.gen_code.stage_globals[i]);
+		}
+
+		REQUIRE(result->gen_code.texture_uniforms.size() == uncached.gen_code.texture_uniforms.size());
+		for (int i = 0; i < uncached.gen_code.texture_uniforms.size(); i++) {
+			CHECK(result->gen_code.texture_uniforms[i].name == uncached.gen_code.texture_uniforms[i].name);
+			CHECK(result->gen_code.texture_uniforms[i].filter == uncached.gen_code.texture_uniforms[i].filter);
+			CHECK(result->gen_code.texture_uniforms[i].repeat == uncached.gen_code.texture_uniforms[i].repeat);
+		}
+
+		REQUIRE(result->uniforms.size() == uncached.uniforms.size());
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : uncached.uniforms) {
+			REQUIRE(result->uniforms.has(E.key));
+			const ShaderLanguage::ShaderNode::Uniform &uniform = result->uniforms[E.key];
+			CHECK(uniform.order == E.value.order);
+			CHECK(uniform.type == E.value.type);
+			CHECK(uniform.hint == E.value.hint);
+			CHECK(uniform.default_value.size() == E.value.default_value.size());
+			CHECK(uniform.hint_range[1] == E.value.hint_range[1]);
+		}
+	}
+
+	CHECK(cached.blend_mode == 2);
+	CHECK(cached.unshaded);
+	CHECK(cached.uses_time);
+	CHECK_FALSE(cached.uses_screen_uv);
+	CHECK(cached.writes_color);
+
+	// Invalid code is never cached, so its errors are reported again.
+	CompileResult invalid;
+	ERR_PRINT_OFF;
+	CHECK(_compile(compiler, "shader_type canvas_item; void fragment() { COLOR = undefined_value; }", invalid) != OK);
+	ERR_PRINT_ON;
+	CHECK(DirAccess::get_files_at(ShaderCompiler::get_cache_dir()).size() == 1);
+
+	Ref<DirAccess> da = DirAccess::open(cache_base);
+	REQUIRE(da.is_valid());
+	da->erase_contents_recursive();
+	ShaderCompiler::set_cache_dir(String());
+}
+
+struct ParallelCompileData {
+	ShaderCompiler *compiler = nullptr;
+	Vector<String> shaders;
+	Vector<CompileResult> results;
+	Vector<Error> errors;
+};
+
+static void _compile_task(void *p_userdata, uint32_t p_index) {
+	ParallelCompileData *data = (ParallelCompileData *)p_userdata;
+	data->errors.write[p_index] = _compile(*data->compiler, data->shaders[p_index], data->results.write[p_index]);
+}
+
+TEST_CASE("[ShaderCompiler] Compiling on several threads with one compiler") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	ParallelCompileData data;
+	data.compiler = &compiler;
+	for (int i = 0; i < 32; i++) {
+		String code = String(test_shader_code).replace("0.25", rtos(i * 0.01));
+		if (i % 2) {
+			// Mix shaders touching different flags, to catch state leaking between compilations.
+			code = code.replace("sin(TIME)", "SCREEN_UV.x");
+		}
+		data.shaders.push_back(code);
+	}
+	data.results.resize(data.shaders.size());
+	data.errors.resize(data.shaders.size());
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_compile_task, &data, data.shaders.size(), -1, true, "ShaderCompilerTest");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	for (int i = 0; i < data.shaders.size(); i++) {
+		CompileResult expected;
+		REQUIRE(_compile(compiler, data.shaders[i], expected) == OK);
+		CHECK(data.errors[i] == OK);
+
+		const CompileResult &result = data.results[i];
+		CHECK(result.uses_time == expected.uses_time);
+		CHECK(result.uses_screen_uv == expected.uses_screen_uv);
+		CHECK(result.uses_time == (i % 2 == 0));
+		CHECK(result.gen_code.defines == expected.gen_code.defines);
+		CHECK(result.gen_code.uniforms == expected.gen_code.uniforms);
+		CHECK(result.uniforms.size() == expected.uniforms.size());
+		for (const KeyValue<String, String> &E : expected.gen_code.code) {
+			CHECK(result.gen_code.code.has(E.key));
+			CHECK(result.gen_code.code[E.key] == E.value);
+		}
+	}
+}
+
+// Skipped by default, run with `--test --test-case="*[Benchmark]*" --no-skip`.
+TEST_CASE("[ShaderCompiler][Benchmark] Cold and warm compilation" * doctest::skip()) {
+	const String cache_base = TestUtils::get_temp_path("shader_compiler_cache_benchmark");
+	DirAccess::make_dir_absolute(cache_base);
+
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const int shader_count = 200;
+	Vector<String> shaders;
+	for (int i = 0; i < shader_count; i++) {
+		shaders.push_back(String(test_shader_code).replace("0.25", rtos(i * 0.001)));
+	}
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (const String &code : shaders) {
+		CompileResult result;
+		_compile(compiler, code, result);
+	}
+	uint64_t uncached_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	ShaderCompiler::set_cache_dir(cache_base);
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (const String &code : shaders) {
+		CompileResult result;
+		_compile(compiler, code, result);
+	}
+	uint64_t cold_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (const String &code : shaders) {
+		CompileResult result;
+		_compile(compiler, code, result);
+	}
+	uint64_t warm_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	MESSAGE(vformat("%d shaders: no cache %.2f ms, cold cache %.2f ms, warm cache %.2f ms.", shader_count, uncached_usec / 1000.0, cold_usec / 1000.0, warm_usec / 1000.0));
+
+	Ref<DirAccess> da = DirAccess::open(cache_base);
+	REQUIRE(da.is_valid());
+	da->erase_contents_recursive();
+	ShaderCompiler::set_cache_dir(String());
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
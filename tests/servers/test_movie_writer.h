@@ -0,0 +1,229 @@
+/**************************************************************************/
+/*  test_movie_writer.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MOVIE_WRITER_H
+#define TEST_MOVIE_WRITER_H
+
+#include "servers/movie_writer/movie_writer_pipelined.h"
+#include "servers/movie_writer/movie_writer_qoiwav.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMovieWriter {
+
+// Minimal QOI decoder following the specification, to check the encoder output.
+static Ref<Image> _decode_qoi(const Vector<uint8_t> &p_data) {
+	const uint8_t *src = p_data.ptr();
+	if (p_data.size() < 22 || memcmp(src, "qoif", 4) != 0) {
+		return Ref<Image>();
+	}
+	const uint32_t width = (src[4] << 24) | (src[5] << 16) | (src[6] << 8) | src[7];
+	const uint32_t height = (src[8] << 24) | (src[9] << 16) | (src[10] << 8) | src[11];
+	const uint32_t channels = src[12];
+
+	Vector<uint8_t> pixels;
+	pixels.resize(width * height * channels);
+	uint8_t *dst = pixels.ptrw();
+
+	uint8_t index[64][4] = {};
+	uint8_t px[4] = { 0, 0, 0, 255 };
+	int ofs = 14;
+	int run = 0;
+	for (uint32_t i = 0; i < width * height; i++) {
+		if (run > 0) {
+			run--;
+		} else {
+			uint8_t b1 = src[ofs++];
+			if (b1 == 0xfe) {
+				px[0] = src[ofs++];
+				px[1] = src[ofs++];
+				px[2] = src[ofs++];
+			} else if (b1 == 0xff) {
+				px[0] = src[ofs++];
+				px[1] = src[ofs++];
+				px[2] = src[ofs++];
+				px[3] = src[ofs++];
+			} else if ((b1 & 0xc0) == 0x00) {
+				memcpy(px, index[b1], 4);
+			} else if ((b1 & 0xc0) == 0x40) {
+				px[0] += ((b1 >> 4) & 0x03) - 2;
+				px[1] += ((b1 >> 2) & 0x03) - 2;
+				px[2] += (b1 & 0x03) - 2;
+			} else if ((b1 & 0xc0) == 0x80) {
+				uint8_t b2 = src[ofs++];
+				int vg = (b1 & 0x3f) - 32;
+				px[0] += vg - 8 + ((b2 >> 4) & 0x0f);
+				px[1] += vg;
+				px[2] += vg - 8 + (b2 & 0x0f);
+			} else {
+				run = b1 & 0x3f;
+			}
+			memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64], px, 4);
+		}
+		memcpy(&dst[i * channels], px, channels);
+	}
+
+	const uint8_t end_marker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+	if (ofs + 8 != p_data.size() || memcmp(&src[ofs], end_marker, 8) != 0) {
+		return Ref<Image>();
+	}
+
+	return Image::create_from_data(width, height, false, channels == 4 ? Image::FORMAT_RGBA8 : Image::FORMAT_RGB8, pixels);
+}
+
+static Color _color8(int p_r, int p_g, int p_b, int p_a = 255) {
+	return Color(p_r / 255.0f, p_g / 255.0f, p_b / 255.0f, p_a / 255.0f);
+}
+
+static Ref<Image> _make_test_image(Image::Format p_format) {
+	Ref<Image> image = Image::create_empty(37, 23, false, p_format);
+	for (int y = 0; y < image->get_height(); y++) {
+		for (int x = 0; x < image->get_width(); x++) {
+			if (y < 4) {
+				// Long runs.
+				image->set_pixel(x, y, Color(0.2, 0.4, 0.6, 1.0));
+			} else if (y < 10) {
+				// Small gradients, covered by the diff and luma operations.
+				image->set_pixel(x, y, _color8(100 + x, 50 + x * 2, 20 + x, 255));
+			} else if (y < 16) {
+				// Repeated colors, covered by the index operation.
+				image->set_pixel(x, y, (x % 3) == 0 ? Color(1, 0, 0, 0.5) : Color(0, 0, 1, 1));
+			} else {
+				// Noise.
+				image->set_pixel(x, y, _color8((x * 73 + y * 151) & 0xff, (x * 31 + y * 17) & 0xff, (x * 7 + y * 211) & 0xff, (x * 13 + y) & 0xff));
+			}
+		}
+	}
+	return image;
+}
+
+TEST_CASE("[MovieWriter] QOI encoding is lossless") {
+	for (Image::Format format : { Image::FORMAT_RGBA8, Image::FORMAT_RGB8 }) {
+		Ref<Image> image = _make_test_image(format);
+		Vector<uint8_t> encoded = MovieWriterQOIWAV::encode_qoi(image);
+		REQUIRE_FALSE(encoded.is_empty());
+		CHECK(encoded[12] == (format == Image::FORMAT_RGBA8 ? 4 : 3));
+
+		Ref<Image> decoded = _decode_qoi(encoded);
+		REQUIRE(decoded.is_valid());
+		CHECK(decoded->get_format() == format);
+		CHECK(decoded->get_size() == image->get_size());
+		CHECK(decoded->get_data() == image->get_data());
+	}
+
+	// Other formats are converted to RGBA8.
+	Ref<Image> image = _make_test_image(Image::FORMAT_RGBAF);
+	Ref<Image> decoded = _decode_qoi(MovieWriterQOIWAV::encode_qoi(image));
+	REQUIRE(decoded.is_valid());
+	image->convert(Image::FORMAT_RGBA8);
+	CHECK(decoded->get_data() == image->get_data());
+}
+
+class TestPipelinedWriter : public MovieWriterPipelined {
+	GDCLASS(TestPipelinedWriter, MovieWriterPipelined)
+
+protected:
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_data) const override {
+		// Make frames finish out of order.
+		const uint8_t frame = p_image->get_pixel(0, 0).get_r8();
+		OS::get_singleton()->delay_usec((frame % 3) * 500);
+		r_data.push_back(frame);
+		return OK;
+	}
+
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_data, const int32_t *p_audio_data) override {
+		written_frames.push_back(p_data[0]);
+		return OK;
+	}
+
+	virtual void write_encoded_end() override {
+		ended = true;
+	}
+
+public:
+	Vector<uint8_t> written_frames;
+	bool ended = false;
+
+	Error submit(const Ref<Image> &p_image) {
+		return write_frame(p_image, nullptr);
+	}
+
+	void finish() {
+		write_end();
+	}
+
+	~TestPipelinedWriter() {
+		finish_encoding();
+	}
+};
+
+TEST_CASE("[MovieWriter] Pipelined writer keeps frame order") {
+	TestPipelinedWriter *writer = memnew(TestPipelinedWriter);
+	writer->set_max_queued_frames(4);
+
+	const int frame_count = 40;
+	for (int i = 0; i < frame_count; i++) {
+		Ref<Image> image = Image::create_empty(1, 1, false, Image::FORMAT_RGBA8);
+		image->set_pixel(0, 0, _color8(i, 0, 0));
+		CHECK(writer->submit(image) == OK);
+	}
+	CHECK_FALSE(writer->ended);
+	CHECK_MESSAGE(writer->written_frames.size() >= frame_count - 4, "No more than the maximum number of frames should be queued.");
+
+	writer->finish();
+	CHECK(writer->ended);
+	REQUIRE(writer->written_frames.size() == frame_count);
+	for (int i = 0; i < frame_count; i++) {
+		CHECK(writer->written_frames[i] == i);
+	}
+
+	memdelete(writer);
+}
+
+TEST_CASE("[MovieWriter] Pipelined writer can be freed with frames in flight") {
+	TestPipelinedWriter *writer = memnew(TestPipelinedWriter);
+	writer->set_max_queued_frames(8);
+
+	for (int i = 0; i < 8; i++) {
+		Ref<Image> image = Image::create_empty(1, 1, false, Image::FORMAT_RGBA8);
+		image->set_pixel(0, 0, _color8(i, 0, 0));
+		CHECK(writer->submit(image) == OK);
+	}
+	CHECK(writer->written_frames.is_empty());
+
+	// The frames are dropped, but encode_frame() must not be called on a partially destroyed writer.
+	memdelete(writer);
+}
+
+} // namespace TestMovieWriter
+
+#endif // TEST_MOVIE_WRITER_H
@@ -33,12 +33,52 @@
 
 #ifdef TOOLS_ENABLED
 
+#include "core/object/worker_thread_pool.h"
 #include "editor/themes/builtin_fonts.gen.h"
 #include "servers/text_server.h"
 #include "tests/test_macros.h"
 
 namespace TestTextServer {
 
+struct ConcurrentShaping {
+	Ref<TextServer> ts;
+	LocalVector<RID> buffers;
+
+	void shape(uint32_t p_index, void *p_userdata) {
+		ts->shaped_text_shape(buffers[p_index]);
+		ts->shaped_text_get_line_breaks(buffers[p_index], 100);
+	}
+};
+
+// Shapes new buffers with objects and custom punctuation on one thread while tab aligning on another.
+struct ShapingAgainstTabAlign {
+	Ref<TextServer> ts;
+	Array font;
+	PackedFloat32Array tab_stops;
+	double expected_width = 0.0;
+	SafeFlag width_mismatch;
+
+	void run(uint32_t p_index, void *p_userdata) {
+		for (int i = 0; i < 200; i++) {
+			RID ctx = ts->create_shaped_text();
+			if (p_index == 0) {
+				ts->shaped_text_add_string(ctx, vformat(U"shaping الحمد %d", i), font, 16);
+				ts->shaped_text_add_object(ctx, i, Size2(8, 8));
+				ts->shaped_text_set_custom_punctuation(ctx, " .,");
+				ts->shaped_text_shape(ctx);
+			} else {
+				ts->shaped_text_add_string(ctx, U"tab\tالحمد\ttest", font, 16);
+				ts->shaped_text_tab_align(ctx, tab_stops);
+				if (ts->shaped_text_get_width(ctx) != expected_width) {
+					width_mismatch.set();
+				}
+				ts->shaped_text_get_underline_thickness(ctx);
+			}
+			ts->free_rid(ctx);
+		}
+	}
+};
+
 TEST_SUITE("[TextServer]") {
 	TEST_CASE("[TextServer] Init, font loading and shaping") {
 		SUBCASE("[TextServer] Loading fonts") {
@@ -616,6 +656,211 @@ TEST_SUITE("[TextServer]") {
 			}
 		}
 
+		SUBCASE("[TextServer] Text layout: Shaped run reuse") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || !ts->has_feature(TextServer::FEATURE_SIMPLE_LAYOUT)) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoNaskhArabicUI_Regular, _font_NotoNaskhArabicUI_Regular_size);
+
+				Array font;
+				font.push_back(font1);
+				font.push_back(font2);
+
+				String test = U"test الحمد test";
+
+				// Identical text in separate buffers, the second one is laid out from the reused runs.
+				RID ctx1 = ts->create_shaped_text();
+				bool ok = ts->shaped_text_add_string(ctx1, test, font, 16);
+				CHECK_FALSE_MESSAGE(!ok, "Adding text to the buffer failed.");
+				RID ctx2 = ts->create_shaped_text();
+				ok = ts->shaped_text_add_string(ctx2, test, font, 16);
+				CHECK_FALSE_MESSAGE(!ok, "Adding text to the buffer failed.");
+
+				int gl_size = ts->shaped_text_get_glyph_count(ctx1);
+				CHECK_FALSE_MESSAGE(gl_size == 0, "Shaping failed.");
+				CHECK_MESSAGE(ts->shaped_text_get_glyph_count(ctx2) == gl_size, "Glyph count mismatch.");
+				if (ts->shaped_text_get_glyph_count(ctx2) == gl_size) {
+					const Glyph *glyphs1 = ts->shaped_text_get_glyphs(ctx1);
+					const Glyph *glyphs2 = ts->shaped_text_get_glyphs(ctx2);
+					for (int j = 0; j < gl_size; j++) {
+						CHECK_FALSE_MESSAGE((glyphs1[j].start != glyphs2[j].start || glyphs1[j].end != glyphs2[j].end), "Glyph range mismatch.");
+						CHECK_FALSE_MESSAGE((glyphs1[j].index != glyphs2[j].index || glyphs1[j].font_rid != glyphs2[j].font_rid), "Glyph mismatch.");
+						CHECK_FALSE_MESSAGE((glyphs1[j].advance != glyphs2[j].advance || glyphs1[j].flags != glyphs2[j].flags), "Glyph metrics mismatch.");
+					}
+				}
+				CHECK(ts->shaped_text_get_width(ctx1) == ts->shaped_text_get_width(ctx2));
+				CHECK(ts->shaped_text_get_ascent(ctx1) == ts->shaped_text_get_ascent(ctx2));
+				CHECK(ts->shaped_text_get_descent(ctx1) == ts->shaped_text_get_descent(ctx2));
+
+				// Same run at a different offset in the string.
+				RID ctx3 = ts->create_shaped_text();
+				ok = ts->shaped_text_add_string(ctx3, String(U"test ") + test, font, 16);
+				CHECK_FALSE_MESSAGE(!ok, "Adding text to the buffer failed.");
+				const Glyph *glyphs3 = ts->shaped_text_get_glyphs(ctx3);
+				int gl_size3 = ts->shaped_text_get_glyph_count(ctx3);
+				CHECK_FALSE_MESSAGE(gl_size3 == 0, "Shaping failed.");
+				for (int j = 0; j < gl_size3; j++) {
+					CHECK_FALSE_MESSAGE((glyphs3[j].start < 0 || glyphs3[j].end > test.length() + 5), "Incorrect glyph range.");
+				}
+
+				// Font changes must not reuse stale runs.
+				double width_old = ts->shaped_text_get_width(ctx1);
+				ts->font_set_spacing(font1, TextServer::SPACING_GLYPH, 10);
+				RID ctx4 = ts->create_shaped_text();
+				ok = ts->shaped_text_add_string(ctx4, test, font, 16);
+				CHECK_FALSE_MESSAGE(!ok, "Adding text to the buffer failed.");
+				CHECK_MESSAGE(ts->shaped_text_get_width(ctx4) > width_old, "Font spacing change ignored.");
+
+				ts->free_rid(ctx1);
+				ts->free_rid(ctx2);
+				ts->free_rid(ctx3);
+				ts->free_rid(ctx4);
+
+				for (int j = 0; j < font.size(); j++) {
+					ts->free_rid(font[j]);
+				}
+				font.clear();
+			}
+		}
+
+		SUBCASE("[TextServer] Text layout: Concurrent shaping") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || !ts->has_feature(TextServer::FEATURE_SIMPLE_LAYOUT)) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoNaskhArabicUI_Regular, _font_NotoNaskhArabicUI_Regular_size);
+
+				Array font;
+				font.push_back(font1);
+				font.push_back(font2);
+
+				ConcurrentShaping cs;
+				cs.ts = ts;
+				for (int j = 0; j < 64; j++) {
+					RID ctx = ts->create_shaped_text();
+					ts->shaped_text_add_string(ctx, vformat(U"paragraph %d الحمد test %d", j % 8, j), font, 16);
+					cs.buffers.push_back(ctx);
+				}
+
+				WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&cs, &ConcurrentShaping::shape, nullptr, cs.buffers.size());
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+				for (int j = 0; j < 64; j++) {
+					RID ctx = ts->create_shaped_text();
+					ts->shaped_text_add_string(ctx, vformat(U"paragraph %d الحمد test %d", j % 8, j), font, 16);
+					CHECK_MESSAGE(ts->shaped_text_is_ready(cs.buffers[j]), "Buffer was not shaped.");
+					CHECK_MESSAGE(ts->shaped_text_get_glyph_count(ctx) == ts->shaped_text_get_glyph_count(cs.buffers[j]), "Glyph count mismatch.");
+					CHECK_MESSAGE(ts->shaped_text_get_width(ctx) == ts->shaped_text_get_width(cs.buffers[j]), "Width mismatch.");
+					ts->free_rid(ctx);
+				}
+
+				for (const RID &ctx : cs.buffers) {
+					ts->free_rid(ctx);
+				}
+				for (int j = 0; j < font.size(); j++) {
+					ts->free_rid(font[j]);
+				}
+				font.clear();
+			}
+		}
+
+		SUBCASE("[TextServer] Text layout: Shaping against tab align") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || !ts->has_feature(TextServer::FEATURE_SIMPLE_LAYOUT)) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoNaskhArabicUI_Regular, _font_NotoNaskhArabicUI_Regular_size);
+
+				ShapingAgainstTabAlign st;
+				st.ts = ts;
+				st.font.push_back(font1);
+				st.font.push_back(font2);
+				st.tab_stops.push_back(64);
+
+				RID ctx = ts->create_shaped_text();
+				ts->shaped_text_add_string(ctx, U"tab\tالحمد\ttest", st.font, 16);
+				ts->shaped_text_tab_align(ctx, st.tab_stops);
+				st.expected_width = ts->shaped_text_get_width(ctx);
+				ts->free_rid(ctx);
+
+				// Both threads pin the same fonts, this used to deadlock when the server lock was taken in between.
+				WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&st, &ShapingAgainstTabAlign::run, nullptr, 2);
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+				CHECK_FALSE_MESSAGE(st.width_mismatch.is_set(), "Tab aligned width mismatch.");
+
+				for (int j = 0; j < st.font.size(); j++) {
+					ts->free_rid(st.font[j]);
+				}
+				st.font.clear();
+			}
+		}
+
+		SUBCASE("[TextServer] Font cache: Pre-rendering") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC)) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+
+				// Enough glyphs to be rasterized in parallel.
+				String test;
+				for (char32_t c = 0x21; c < 0x7f; c++) {
+					test += c;
+				}
+				test += test;
+
+				Vector2i size = Vector2i(16, 0);
+				ts->font_render_string(font1, size, test);
+				for (int j = 0; j < test.length(); j++) {
+					ts->font_render_range(font2, size, test[j], test[j]);
+				}
+
+				PackedInt32Array glyphs1 = ts->font_get_glyph_list(font1, size);
+				PackedInt32Array glyphs2 = ts->font_get_glyph_list(font2, size);
+				CHECK_FALSE_MESSAGE(glyphs1.is_empty(), "Pre-rendering failed.");
+				CHECK_MESSAGE(glyphs1.size() == glyphs2.size(), "Glyph count mismatch.");
+				for (int j = 0; j < glyphs1.size(); j++) {
+					int32_t gl = glyphs1[j];
+					CHECK_MESSAGE(glyphs2.has(gl), "Glyph missing.");
+					CHECK_FALSE_MESSAGE(ts->font_get_glyph_size(font1, size, gl) != ts->font_get_glyph_size(font2, size, gl), "Glyph size mismatch.");
+					CHECK_FALSE_MESSAGE(ts->font_get_glyph_offset(font1, size, gl) != ts->font_get_glyph_offset(font2, size, gl), "Glyph offset mismatch.");
+					CHECK_FALSE_MESSAGE(ts->font_get_glyph_advance(font1, size.x, gl) != ts->font_get_glyph_advance(font2, size.x, gl), "Glyph advance mismatch.");
+				}
+
+				ts->free_rid(font1);
+				ts->free_rid(font2);
+			}
+		}
+
 		SUBCASE("[TextServer] Unicode identifiers") {
 			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
 				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);